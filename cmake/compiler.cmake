@@ -43,6 +43,92 @@ if( ENABLE_SANITIZERS )
   endif()
 endif()
 
+option( ENABLE_LTO "Enable link-time optimization (thin LTO with Clang)" OFF )
+if( ENABLE_LTO )
+  include( CheckIPOSupported )
+  check_ipo_supported( RESULT LTO_SUPPORTED OUTPUT LTO_ERROR LANGUAGES C CXX )
+  if( NOT LTO_SUPPORTED )
+    message( FATAL_ERROR "Link-time optimization is not supported: ${LTO_ERROR}" )
+  endif()
+
+  if( CMAKE_CXX_COMPILER_ID MATCHES "Clang" AND NOT CMAKE_CXX_COMPILER_FRONTEND_VARIANT MATCHES "^MSVC$" )
+    # NOTE: Thin LTO links the world server in parallel and with a fraction of the memory of full LTO
+    set( CMAKE_C_COMPILE_OPTIONS_IPO -flto=thin )
+    set( CMAKE_CXX_COMPILE_OPTIONS_IPO -flto=thin )
+    message( STATUS "Enabling thin LTO..." )
+  else()
+    message( STATUS "Enabling LTO..." )
+  endif()
+
+  set( CMAKE_INTERPROCEDURAL_OPTIMIZATION ON )
+endif()
+
+# Two stage profile-guided optimization of world, lobby and api:
+#  1. configure with -DSAPPHIRE_PGO=GENERATE, build and run bin/pgo_train.sh
+#  2. reconfigure the same build folder with -DSAPPHIRE_PGO=USE and rebuild
+# GCC names the profiles after the object paths, both stages have to build in the same folder.
+set( SAPPHIRE_PGO "OFF" CACHE STRING "Profile-guided optimization stage: OFF, GENERATE or USE" )
+set_property( CACHE SAPPHIRE_PGO PROPERTY STRINGS OFF GENERATE USE )
+set( SAPPHIRE_PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Folder the training run writes profiles to" )
+
+if( NOT SAPPHIRE_PGO STREQUAL "OFF" )
+  if( MSVC OR NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang" )
+    message( FATAL_ERROR "SAPPHIRE_PGO is only supported with GCC and Clang" )
+  endif()
+
+  if( CMAKE_CXX_COMPILER_ID MATCHES "Clang" )
+    # NOTE: Clang writes raw profiles, pgo_train.sh merges them into this file
+    find_program( SAPPHIRE_LLVM_PROFDATA NAMES llvm-profdata
+                  HINTS "${CMAKE_CXX_COMPILER}/.." ENV LLVM_PATH )
+    set( SAPPHIRE_PGO_PROFILE "${SAPPHIRE_PGO_DIR}/sapphire.profdata" )
+  else()
+    set( SAPPHIRE_LLVM_PROFDATA "" )
+    set( SAPPHIRE_PGO_PROFILE "${SAPPHIRE_PGO_DIR}" )
+  endif()
+
+  if( SAPPHIRE_PGO STREQUAL "GENERATE" )
+    message( STATUS "Building instrumented binaries, profiles go to ${SAPPHIRE_PGO_DIR}" )
+
+    # NOTE: common is instrumented, so everything linking it needs the profiling runtime
+    string( APPEND CMAKE_EXE_LINKER_FLAGS " -fprofile-generate=${SAPPHIRE_PGO_DIR}" )
+    string( APPEND CMAKE_SHARED_LINKER_FLAGS " -fprofile-generate=${SAPPHIRE_PGO_DIR}" )
+    string( APPEND CMAKE_MODULE_LINKER_FLAGS " -fprofile-generate=${SAPPHIRE_PGO_DIR}" )
+  elseif( SAPPHIRE_PGO STREQUAL "USE" )
+    if( NOT EXISTS "${SAPPHIRE_PGO_PROFILE}" )
+      message( FATAL_ERROR "No profile at ${SAPPHIRE_PGO_PROFILE}, build with -DSAPPHIRE_PGO=GENERATE and run pgo_train.sh first" )
+    endif()
+    message( STATUS "Optimizing with the profile at ${SAPPHIRE_PGO_PROFILE}" )
+  else()
+    message( FATAL_ERROR "Unknown SAPPHIRE_PGO stage ${SAPPHIRE_PGO}, use OFF, GENERATE or USE" )
+  endif()
+endif()
+
+# Applies the current SAPPHIRE_PGO stage to a target
+function( sapphire_enable_pgo target )
+  if( SAPPHIRE_PGO STREQUAL "GENERATE" )
+    target_compile_options( ${target} PRIVATE "-fprofile-generate=${SAPPHIRE_PGO_DIR}" )
+    if( CMAKE_CXX_COMPILER_ID STREQUAL "GNU" )
+      # the servers are multithreaded, racy counter updates would make the profiles differ between runs
+      target_compile_options( ${target} PRIVATE -fprofile-update=atomic )
+    endif()
+    target_compile_definitions( ${target} PRIVATE SAPPHIRE_PGO_GENERATE )
+  elseif( SAPPHIRE_PGO STREQUAL "USE" )
+    target_compile_options( ${target} PRIVATE "-fprofile-use=${SAPPHIRE_PGO_PROFILE}" )
+    if( CMAKE_CXX_COMPILER_ID STREQUAL "GNU" )
+      # code the training does not reach keeps its regular optimization instead of being treated as cold
+      target_compile_options( ${target} PRIVATE -fprofile-partial-training -Wno-missing-profile )
+    else()
+      target_compile_options( ${target} PRIVATE -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date )
+    endif()
+  endif()
+endfunction()
+
+# Script modules are only called through their exported factories, nothing interposes their symbols
+include( CheckCXXCompilerFlag )
+if( NOT MSVC )
+  check_cxx_compiler_flag( -fno-semantic-interposition SAPPHIRE_HAS_NO_SEMANTIC_INTERPOSITION )
+endif()
+
 # C++ standard
 set( CMAKE_CXX_STANDARD 17 )
 set( CMAKE_CXX_STANDARD_REQUIRED ON )
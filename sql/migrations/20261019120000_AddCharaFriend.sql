@@ -0,0 +1,7 @@
+CREATE TABLE IF NOT EXISTS `charafriend` (
+  `CharacterId` bigint(20) NOT NULL,
+  `FriendCharacterId` bigint(20) NOT NULL,
+  `HierarchyData` bigint(20) unsigned NOT NULL DEFAULT 0,
+  `UPDATE_DATE` datetime DEFAULT NULL,
+  PRIMARY KEY (`CharacterId`, `FriendCharacterId`)
+) ENGINE=InnoDB DEFAULT CHARSET=latin1;
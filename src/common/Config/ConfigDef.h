@@ -45,8 +45,16 @@ namespace Sapphire::Common::Config
       uint16_t disconnectTimeout;
 
       float inRangeDistance;
+
+      uint32_t outQueueBudget;
     } network;
 
+    struct Metrics
+    {
+      std::string listenIp;
+      uint16_t listenPort;
+    } metrics;
+
     struct Housing
     {
       std::string defaultEstateName;
@@ -57,6 +65,7 @@ namespace Sapphire::Common::Config
       std::string path;
       std::string cachePath;
       bool hotSwap;
+      uint32_t reloadDebounceMs;
     } scripts;
 
     struct Navigation
@@ -64,8 +73,18 @@ namespace Sapphire::Common::Config
       std::string meshPath;
     } navigation;
 
+    struct Territory
+    {
+      bool hibernate;
+      uint32_t hibernateDelay;
+      uint32_t hibernateWakeInterval;
+      uint32_t bootstrapThreads;
+      std::string snapshotPath;
+    } territory;
+
     std::string motd;
     bool skipOpening;
+    uint64_t randomSeed;
   };
 
   struct LobbyConfig
@@ -3,6 +3,7 @@
 #include "PreparedStatement.h"
 #include <MySqlConnector.h>
 #include "StatementTask.h"
+#include "Transaction.h"
 #include "Operation.h"
 #include "ZoneDbConnection.h"
 
@@ -153,6 +154,12 @@ void Sapphire::Db::DbWorkerPool< T >::keepAlive()
     enqueue( std::make_shared< PingOperation >() );
 }
 
+template< class T >
+std::size_t Sapphire::Db::DbWorkerPool< T >::getQueueSize()
+{
+  return m_queue->size();
+}
+
 template< class T >
 uint32_t Sapphire::Db::DbWorkerPool< T >::openConnections( InternalIndex type, uint8_t numConnections )
 {
@@ -254,5 +261,23 @@ void Sapphire::Db::DbWorkerPool< T >::directExecute( std::shared_ptr< PreparedSt
   connection->unlock();
 }
 
+template< class T >
+void Sapphire::Db::DbWorkerPool< T >::commitTransaction( std::shared_ptr< Transaction > transaction,
+                                                         std::function< void( bool ) > callback )
+{
+  auto task = std::make_shared< TransactionTask >( transaction, std::move( callback ) );
+  enqueue( task );
+}
+
+template< class T >
+bool Sapphire::Db::DbWorkerPool< T >::directCommitTransaction( std::shared_ptr< Transaction > transaction )
+{
+  auto connection = getFreeConnection();
+  auto result = TransactionTask::commit( *connection, *transaction );
+  connection->unlock();
+
+  return result;
+}
+
 template
 class Sapphire::Db::DbWorkerPool< Sapphire::Db::ZoneDbConnection >;
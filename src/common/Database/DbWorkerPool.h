@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <string>
 #include <vector>
 #include <ResultSet.h>
@@ -17,6 +18,8 @@ namespace Sapphire::Db
 
   class PreparedStatement;
 
+  class Transaction;
+
   struct ConnectionInfo;
 
   template< class T >
@@ -58,6 +61,11 @@ namespace Sapphire::Db
 
     void directExecute( std::shared_ptr< PreparedStatement > stmt );
 
+    // Transactions, every statement has to be prepared for the connection type used
+    void commitTransaction( std::shared_ptr< Transaction > transaction, std::function< void( bool ) > callback = nullptr );
+
+    bool directCommitTransaction( std::shared_ptr< Transaction > transaction );
+
     std::shared_ptr< Mysql::ResultSet >
     query( const std::string& sql, std::shared_ptr< T > connection = nullptr );
 
@@ -71,6 +79,9 @@ namespace Sapphire::Db
 
     void keepAlive();
 
+    /*! @return number of async operations waiting for a worker */
+    std::size_t getQueueSize();
+
   private:
     uint32_t openConnections( InternalIndex type, uint8_t numConnections );
 
@@ -0,0 +1,89 @@
+#include "Transaction.h"
+#include "DbConnection.h"
+#include "PreparedStatement.h"
+
+#include <MySqlConnector.h>
+
+#include "Logging/Logger.h"
+
+void Sapphire::Db::Transaction::append( const std::string& sql )
+{
+  m_entries.push_back( { sql, nullptr } );
+}
+
+void Sapphire::Db::Transaction::append( std::shared_ptr< PreparedStatement > stmt )
+{
+  m_entries.push_back( { std::string(), std::move( stmt ) } );
+}
+
+std::size_t Sapphire::Db::Transaction::getSize() const
+{
+  return m_entries.size();
+}
+
+bool Sapphire::Db::Transaction::isEmpty() const
+{
+  return m_entries.empty();
+}
+
+Sapphire::Db::TransactionTask::TransactionTask( std::shared_ptr< Transaction > transaction, Callback callback ) :
+  m_transaction( std::move( transaction ) ),
+  m_callback( std::move( callback ) )
+{
+}
+
+bool Sapphire::Db::TransactionTask::execute()
+{
+  bool success = commit( *m_pConn, *m_transaction );
+
+  if( m_callback )
+    m_callback( success );
+
+  return success;
+}
+
+bool Sapphire::Db::TransactionTask::commit( DbConnection& connection, const Transaction& transaction )
+{
+  // DbConnection::execute swallows errors, statements are run on the raw connection to see them
+  auto pConnection = connection.getConnection();
+
+  try
+  {
+    pConnection->beginTransaction();
+
+    for( const auto& entry : transaction.m_entries )
+    {
+      if( !entry.stmt )
+      {
+        pConnection->createStatement()->execute( entry.sql );
+        continue;
+      }
+
+      auto pStmt = connection.getPreparedStatement( entry.stmt->getIndex() );
+      if( !pStmt )
+        throw std::runtime_error( "Statement " + std::to_string( entry.stmt->getIndex() ) + " is not prepared on this connection" );
+
+      entry.stmt->setMysqlPS( pStmt );
+      entry.stmt->bindParameters();
+      pStmt->execute();
+    }
+
+    pConnection->commitTransaction();
+    return true;
+  }
+  catch( std::runtime_error& e )
+  {
+    Logger::error( "Transaction of {0} statements failed: {1}", transaction.getSize(), e.what() );
+
+    try
+    {
+      pConnection->rollbackTransaction();
+    }
+    catch( std::runtime_error& rollbackError )
+    {
+      Logger::error( "Rollback failed: {0}", rollbackError.what() );
+    }
+
+    return false;
+  }
+}
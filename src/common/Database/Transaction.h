@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Operation.h"
+
+namespace Sapphire::Db
+{
+  class PreparedStatement;
+
+  /*!
+   * @brief A list of statements which are committed together or not at all.
+   */
+  class Transaction
+  {
+  public:
+    Transaction() = default;
+
+    void append( const std::string& sql );
+
+    void append( std::shared_ptr< PreparedStatement > stmt );
+
+    std::size_t getSize() const;
+
+    bool isEmpty() const;
+
+  private:
+    friend class TransactionTask;
+
+    struct Entry
+    {
+      std::string sql;
+      std::shared_ptr< PreparedStatement > stmt;
+    };
+
+    std::vector< Entry > m_entries;
+  };
+
+  /*!
+   * @brief Runs a Transaction on a worker connection, rolls it back if any statement fails.
+   *
+   * The callback is invoked on the worker thread with the outcome.
+   */
+  class TransactionTask : public Operation
+  {
+  public:
+    using Callback = std::function< void( bool ) >;
+
+    TransactionTask( std::shared_ptr< Transaction > transaction, Callback callback = nullptr );
+
+    bool execute() override;
+
+    /*!
+     * @brief Runs the transaction on the given connection
+     * @return true if every statement succeeded and the transaction was committed
+     */
+    static bool commit( DbConnection& connection, const Transaction& transaction );
+
+  private:
+    std::shared_ptr< Transaction > m_transaction;
+    Callback m_callback;
+  };
+
+}
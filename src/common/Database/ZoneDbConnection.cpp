@@ -256,6 +256,19 @@ void Sapphire::Db::ZoneDbConnection::doPrepareStatements()
                                            "WHERE CharacterId = ?;",
                      CONNECTION_SYNC );
 
+  prepareStatement( CHARA_FRIEND_UP,
+                    "INSERT INTO charafriend ( CharacterId, FriendCharacterId, HierarchyData, UPDATE_DATE ) "
+                    " VALUES ( ?, ?, ?, NOW() ) "
+                    "ON DUPLICATE KEY UPDATE HierarchyData = ?, UPDATE_DATE = NOW();",
+                    CONNECTION_ASYNC );
+
+  prepareStatement( CHARA_FRIEND_DEL, "DELETE FROM charafriend WHERE CharacterId = ? AND FriendCharacterId = ?;",
+                    CONNECTION_ASYNC );
+
+  prepareStatement( CHARA_FRIEND_SEL, "SELECT FriendCharacterId, HierarchyData FROM charafriend "
+                                      "WHERE CharacterId = ?;",
+                    CONNECTION_SYNC );
+
   /// CHARA BLACKLIST
   prepareStatement( CHARA_BLACKLIST_INS,
                     "INSERT INTO charainfoblacklist ( CharacterId, CharacterIdList, UPDATE_DATE ) "
@@ -298,6 +311,12 @@ void Sapphire::Db::ZoneDbConnection::doPrepareStatements()
                     "UPDATE charaglobalitem SET deleted = 1 WHERE ItemId = ?;",
                     CONNECTION_BOTH );
 
+  // replaying an already committed insert leaves the row as it is, later stack changes are written by CHARA_ITEMGLOBAL_UP
+  prepareStatement( CHARA_ITEMGLOBAL_UPSERT,
+                    "INSERT INTO charaglobalitem ( CharacterId, ItemId, catalogId, stack, UPDATE_DATE ) VALUES ( ?, ?, ?, ?, NOW() ) "
+                    "ON DUPLICATE KEY UPDATE ItemId = ItemId;",
+                    CONNECTION_BOTH );
+
   /// HOUSING
   prepareStatement( HOUSING_HOUSE_INS,
                     "INSERT INTO house ( LandSetId, HouseId, HouseName ) VALUES ( ?, ?, ? );",
@@ -75,6 +75,7 @@ namespace Sapphire::Db
     CHARA_ITEMGLOBAL_INS,
     CHARA_ITEMGLOBAL_UP,
     CHARA_ITEMGLOBAL_DELETE,
+    CHARA_ITEMGLOBAL_UPSERT,
 
     CHARA_MONSTERNOTE_INS,
     CHARA_MONSTERNOTE_UP,
@@ -84,6 +85,10 @@ namespace Sapphire::Db
     CHARA_FRIENDLIST_UP,
     CHARA_FRIENDLIST_SEL,
 
+    CHARA_FRIEND_UP,
+    CHARA_FRIEND_DEL,
+    CHARA_FRIEND_SEL,
+
     CHARA_BLACKLIST_INS,
     CHARA_BLACKLIST_UP,
     CHARA_BLACKLIST_SEL,
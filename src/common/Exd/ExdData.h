@@ -4,6 +4,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <map>
 #include <cstdint>
 
 #include <typeindex>
@@ -28,9 +29,28 @@ namespace Sapphire::Data
   public:
     bool init( const std::string& path );
 
+    /*!
+     * @brief Registers a row built in code, rows are only served from these while no game data is loaded.
+     *
+     * Lets tools run the server code on generated fixtures without a game install.
+     */
+    template< typename T >
+    void setFixtureRow( uint32_t row, std::shared_ptr< Excel::ExcelStruct< T > > pRow )
+    {
+      getFixtureSheet< T >()[ row ] = std::move( pRow );
+    }
+
     template< typename T >
     std::shared_ptr< Excel::ExcelStruct< T > > getRow( uint32_t row, uint32_t subrow = 0 )
     {
+      if( !m_exd_data )
+      {
+        auto& fixtureSheet = getFixtureSheet< T >();
+        auto it = fixtureSheet.find( row );
+        // handed out as copy like a parsed row
+        return it != fixtureSheet.end() ? std::make_shared< Excel::ExcelStruct< T > >( *it->second ) : nullptr;
+      }
+
       auto& sheet = getSheet< T >();
       try
       {
@@ -49,6 +69,14 @@ namespace Sapphire::Data
     template< typename T >
     std::vector< uint32_t > getIdList()
     {
+      if( !m_exd_data )
+      {
+        std::vector< uint32_t > ids;
+        for( const auto& row : getFixtureSheet< T >() )
+          ids.push_back( row.first );
+        return ids;
+      }
+
       auto& sheet = getSheet< T >();
       const auto& rows = sheet.get_rows();
       std::vector< uint32_t > ids;
@@ -129,7 +157,20 @@ namespace Sapphire::Data
       }
     }
 
+    template< typename T >
+    std::map< uint32_t, std::shared_ptr< Excel::ExcelStruct< T > > >& getFixtureSheet()
+    {
+      using FixtureSheet = std::map< uint32_t, std::shared_ptr< Excel::ExcelStruct< T > > >;
+
+      auto& pSheet = m_fixtureSheets[ typeid( T ) ];
+      if( !pSheet )
+        pSheet = std::make_shared< FixtureSheet >();
+      return *std::static_pointer_cast< FixtureSheet >( pSheet );
+    }
+
     std::unordered_map< std::type_index, xiv::exd::Exd* > m_sheets;
+    // rows of setFixtureRow by sheet, each one a map of row id to row
+    std::unordered_map< std::type_index, std::shared_ptr< void > > m_fixtureSheets;
 
     std::shared_ptr< xiv::dat::GameData > m_data;
     std::shared_ptr< xiv::exd::ExdData > m_exd_data;
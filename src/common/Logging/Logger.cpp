@@ -36,6 +36,7 @@ void Sapphire::Logger::init( const std::string& logPath )
   spdlog::register_logger( logger );
   spdlog::set_pattern( "[%H:%M:%S.%e] [%^%l%$] %v" );
   spdlog::set_level( spdlog::level::debug );
+  s_logLevel = spdlog::level::debug;
   // always flush the log on criticial messages, otherwise it's done by libc
   // see: https://github.com/gabime/spdlog/wiki/7.-Flush-policy
   // nb: if the server crashes, log data can be missing from the file unless something logs critical just before it does
@@ -45,6 +46,7 @@ void Sapphire::Logger::init( const std::string& logPath )
 void Sapphire::Logger::setLogLevel( uint8_t logLevel )
 {
   spdlog::set_level( static_cast< spdlog::level::level_enum >( logLevel ) );
+  s_logLevel = logLevel;
 }
 
 void Sapphire::Logger::error( const std::string& text )
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <spdlog/fmt/fmt.h>
 
@@ -11,6 +12,8 @@ namespace Sapphire
 
   private:
     std::string m_logFile;
+    /*! mirrors the spdlog level so disabled messages are not formatted */
+    inline static std::atomic< uint8_t > s_logLevel{ 1 };
     Logger() = default;
     ~Logger() = default;
 
@@ -44,10 +47,17 @@ namespace Sapphire
     }
 
 
+    static bool isDebugEnabled()
+    {
+      return s_logLevel.load( std::memory_order_relaxed ) <= 1;
+    }
+
     static void debug( const std::string& text );
     template< typename... Args >
     static void debug( const std::string& text, const Args&... args )
     {
+      if( !isDebugEnabled() )
+        return;
       debug( fmt::format( text, args... ) );
     }
 
@@ -10,13 +10,18 @@ bool Common::Navi::NaviMgr::setupTerritory( const std::string& bgPath, uint32_t
   std::string bg = getBgName( bgPath );
 
   // check if a provider exists already
-  if( m_naviProviderTerritoryMap.find( guid ) != m_naviProviderTerritoryMap.end() )
-    return true;
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    if( m_naviProviderTerritoryMap.find( guid ) != m_naviProviderTerritoryMap.end() )
+      return true;
+  }
 
+  // loading the mesh is the expensive part, keep it outside of the lock
   auto provider = std::make_shared< Common::Navi::NaviProvider >( bg );
 
   if( provider->init( m_naviPath ) )
   {
+    std::lock_guard< std::mutex > lock( m_mutex );
     m_naviProviderTerritoryMap[ guid ] = provider;
     return true;
   }
@@ -28,6 +33,7 @@ Common::Navi::NaviProviderPtr Common::Navi::NaviMgr::getNaviProvider( const std:
 {
   std::string bg = getBgName( bgPath );
 
+  std::lock_guard< std::mutex > lock( m_mutex );
   if( m_naviProviderTerritoryMap.find( guid ) != m_naviProviderTerritoryMap.end() )
     return m_naviProviderTerritoryMap[ guid ];
 
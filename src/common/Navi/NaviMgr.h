@@ -2,6 +2,7 @@
 
 #include <Forwards.h>
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -24,6 +25,8 @@ namespace Sapphire::Common::Navi
     std::string getBgName( const std::string& bgPath );
 
     std::unordered_map< uint32_t, NaviProviderPtr > m_naviProviderTerritoryMap;
+    // territories are set up from worker threads during bootstrap
+    std::mutex m_mutex;
 
     std::string m_naviPath;
   };
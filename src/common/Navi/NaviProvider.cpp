@@ -1,7 +1,6 @@
 #include <Common.h>
 #include <Logging/Logger.h>
 
-#include <Random/RNGMgr.h>
 
 #include "NaviProvider.h"
 
@@ -11,11 +10,13 @@
 #include <recastnavigation/Recast/Include/Recast.h>
 #include <filesystem>
 #include <Service.h>
+#include <Util/UtilMath.h>
 
 Sapphire::Common::Navi::NaviProvider::NaviProvider( const std::string& internalName ) :
   m_naviMesh( nullptr ),
   m_naviMeshQuery( nullptr ),
-  m_internalName( internalName )
+  m_internalName( internalName ),
+  m_moveRequestCount( 0 )
 {
   // Set defaults
   m_polyFindRange[ 0 ] = 20;
@@ -38,9 +39,11 @@ bool Sapphire::Common::Navi::NaviProvider::init( const std::string& naviPath )
 
     m_pCrowd = std::make_unique< dtCrowd >();
 
-    if( !m_pCrowd->init( 1000, 10.f, m_naviMesh ) )
+    if( !m_pCrowd->init( MAX_AGENTS, 10.f, m_naviMesh ) )
       return false;
 
+    m_agentMoveStates.assign( MAX_AGENTS, AgentMoveState{} );
+
     dtObstacleAvoidanceParams params;
     // Use mostly default settings, copy from dtCrowd.
     memcpy(&params, m_pCrowd->getObstacleAvoidanceParams(0), sizeof(dtObstacleAvoidanceParams));
@@ -248,15 +251,19 @@ bool Sapphire::Common::Navi::NaviProvider::getSteerTarget( dtNavMeshQuery* navQu
   return true;
 }
 
+// detour only takes a plain function, the stream of the current query is handed over through this
+static thread_local Sapphire::Common::Random::RandomStream* s_pRandomStream = nullptr;
+
 static float frand()
 {
-  return ( float ) rand() / (float)RAND_MAX;
+  return s_pRandomStream->nextFloat();
 }
 
 
 Sapphire::Common::FFXIVARR_POSITION3
   Sapphire::Common::Navi::NaviProvider::findRandomPositionInCircle( const Sapphire::Common::FFXIVARR_POSITION3& startPos,
-                                                                   float maxRadius )
+                                                                   float maxRadius,
+                                                                   Random::RandomStream& randomStream )
 {
   dtStatus status;
 
@@ -289,10 +296,10 @@ Sapphire::Common::FFXIVARR_POSITION3
     return {};
   }
 
-  auto& RNGMgr = Common::Service< Common::Random::RNGMgr >::ref();
-  auto rng = RNGMgr.getRandGenerator< float >( 0.f, 1.f );
+  s_pRandomStream = &randomStream;
   status = m_naviMeshQuery->findRandomPointAroundCircle( startRef, spos, maxRadius, &filter, frand,
              &randomRef, randomPt );
+  s_pRandomStream = nullptr;
 
   if( dtStatusFailed( status ) )
   {
@@ -620,13 +627,29 @@ int32_t Sapphire::Common::Navi::NaviProvider::addAgent( const Common::FFXIVARR_P
   params.updateFlags = 0;
   params.updateFlags |= DT_CROWD_ANTICIPATE_TURNS;
   float position[] = { pos.x, pos.y, pos.z };
-  return m_pCrowd->addAgent( position, &params );
+  auto naviAgentId = m_pCrowd->addAgent( position, &params );
+
+  // slots are recycled by the crowd, never inherit the state of a previous agent
+  if( naviAgentId >= 0 && naviAgentId < static_cast< int32_t >( m_agentMoveStates.size() ) )
+    m_agentMoveStates[ naviAgentId ] = AgentMoveState{};
+
+  return naviAgentId;
 }
 
 void Sapphire::Common::Navi::NaviProvider::updateAgentParameters( int32_t naviAgentId, float radius, bool isRunning )
 {
-  if( naviAgentId == -1 )
+  if( naviAgentId < 0 || naviAgentId >= static_cast< int32_t >( m_agentMoveStates.size() ) )
     return;
+
+  // called every ai tick, only touch the crowd when something actually changed
+  auto& moveState = m_agentMoveStates[ naviAgentId ];
+  if( moveState.hasParameters && moveState.radius == radius && moveState.isRunning == isRunning )
+    return;
+
+  moveState.hasParameters = true;
+  moveState.radius = radius;
+  moveState.isRunning = isRunning;
+
   dtCrowdAgentParams params{};
   std::memset( &params, 0, sizeof( params ) );
   params.height = 3.f;
@@ -646,11 +669,36 @@ void Sapphire::Common::Navi::NaviProvider::updateCrowd( float timeInSeconds )
   dtCrowdAgentDebugInfo info{};
   info.idx = -1;
   info.vod = m_vod;
+
+  m_moveRequestCount = 0;
+  flushPendingMoveRequests();
+
   m_pCrowd->update( timeInSeconds, &info );
 }
 
+void Sapphire::Common::Navi::NaviProvider::flushPendingMoveRequests()
+{
+  while( !m_pendingMoveRequests.empty() && m_moveRequestCount < MAX_MOVE_REQUESTS_PER_UPDATE )
+  {
+    auto naviAgentId = m_pendingMoveRequests.front();
+    m_pendingMoveRequests.pop_front();
+
+    auto& moveState = m_agentMoveStates[ naviAgentId ];
+
+    // agent was removed or reset since it got queued
+    if( !moveState.isPending )
+      continue;
+
+    moveState.isPending = false;
+    requestMoveTarget( naviAgentId, moveState.target );
+  }
+}
+
 void Sapphire::Common::Navi::NaviProvider::removeAgent( int32_t naviAgentId )
 {
+  if( naviAgentId >= 0 && naviAgentId < static_cast< int32_t >( m_agentMoveStates.size() ) )
+    m_agentMoveStates[ naviAgentId ] = AgentMoveState{};
+
   m_pCrowd->removeAgent( naviAgentId );
 }
 
@@ -664,15 +712,60 @@ void Sapphire::Common::Navi::NaviProvider::calcVel( float* vel, const float* pos
 
 void Sapphire::Common::Navi::NaviProvider::resetMoveTarget( int32_t naviAgentId )
 {
+  if( naviAgentId >= 0 && naviAgentId < static_cast< int32_t >( m_agentMoveStates.size() ) )
+  {
+    auto& moveState = m_agentMoveStates[ naviAgentId ];
+    moveState.hasTarget = false;
+    moveState.isPending = false;
+  }
+
   m_pCrowd->resetMoveTarget( naviAgentId );
 }
 
+bool Sapphire::Common::Navi::NaviProvider::hasValidCorridor( int32_t naviAgentId ) const
+{
+  const dtCrowdAgent* ag = m_pCrowd->getAgent( naviAgentId );
+  if( !ag || !ag->active )
+    return false;
+
+  return ag->targetState != DT_CROWDAGENT_TARGET_NONE && ag->targetState != DT_CROWDAGENT_TARGET_FAILED;
+}
+
 void Sapphire::Common::Navi::NaviProvider::setMoveTarget( int32_t naviAgentId,
                                                          const Sapphire::Common::FFXIVARR_POSITION3& endPos )
 {
-  // Find nearest point on navmesh and set move request to that location.
-  dtNavMeshQuery* navquery = m_naviMeshQuery;
+  if( naviAgentId < 0 || naviAgentId >= static_cast< int32_t >( m_agentMoveStates.size() ) )
+    return;
+
+  auto& moveState = m_agentMoveStates[ naviAgentId ];
+
+  // target barely moved since the last request, keep following the current corridor
+  if( moveState.hasTarget && ( moveState.isPending || hasValidCorridor( naviAgentId ) ) &&
+      Common::Util::distance( moveState.target, endPos ) < RETARGET_DISTANCE )
+    return;
 
+  moveState.hasTarget = true;
+  moveState.target = endPos;
+
+  if( moveState.isPending )
+    return;
+
+  if( m_moveRequestCount >= MAX_MOVE_REQUESTS_PER_UPDATE )
+  {
+    moveState.isPending = true;
+    m_pendingMoveRequests.push_back( naviAgentId );
+    return;
+  }
+
+  requestMoveTarget( naviAgentId, endPos );
+}
+
+bool Sapphire::Common::Navi::NaviProvider::requestMoveTarget( int32_t naviAgentId,
+                                                             const Sapphire::Common::FFXIVARR_POSITION3& endPos )
+{
+  ++m_moveRequestCount;
+
+  // Find nearest point on navmesh and set move request to that location.
   const dtQueryFilter* filter = m_pCrowd->getFilter( 0 );
   const float* halfExtents = m_pCrowd->getQueryExtents();
 
@@ -687,14 +780,15 @@ void Sapphire::Common::Navi::NaviProvider::setMoveTarget( int32_t naviAgentId,
     Logger::error( "Failed to find nearest poly for Chara-Agent#{} for pos X: {} Y: {} Z: {}",
                    naviAgentId, endPos.x, endPos.y, endPos.z );
 
-    return;
+    m_agentMoveStates[ naviAgentId ].hasTarget = false;
+    return false;
   }
 
   const dtCrowdAgent* ag = m_pCrowd->getAgent( naviAgentId );
   if( ag && ag->active )
-  {
-    m_pCrowd->requestMoveTarget( naviAgentId, ref, p );
-  }
+    return m_pCrowd->requestMoveTarget( naviAgentId, ref, p );
+
+  return false;
 }
 
 Sapphire::Common::FFXIVARR_POSITION3 Sapphire::Common::Navi::NaviProvider::getMovePos( int32_t naviAgentId )
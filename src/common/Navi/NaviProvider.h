@@ -1,14 +1,24 @@
 #pragma once
 
 #include <Common.h>
+#include <deque>
+#include <memory>
+#include <vector>
 #include "recastnavigation/Detour/Include/DetourNavMesh.h"
 #include "recastnavigation/Detour/Include/DetourNavMeshQuery.h"
 #include "recastnavigation/DetourCrowd/Include/DetourCrowd.h"
+#include <Random/RandomStream.h>
 
 namespace Sapphire::Common::Navi
 {
   const int32_t MAX_POLYS = 32;
   const int32_t MAX_SMOOTH = 2048;
+  const int32_t MAX_AGENTS = 1000;
+
+  // move targets closer than this to the last requested one keep the current corridor
+  const float RETARGET_DISTANCE = 1.0f;
+  // crowd path requests issued per provider per update, the rest is deferred to the next update
+  const uint32_t MAX_MOVE_REQUESTS_PER_UPDATE = 8;
 
   const int32_t NAVMESHSET_MAGIC = 'M' << 24 | 'S' << 16 | 'E' << 8 | 'T'; //'MSET'
   const int32_t NAVMESHSET_VERSION = 1;
@@ -41,8 +51,10 @@ namespace Sapphire::Common::Navi
 
     std::vector< Common::FFXIVARR_POSITION3 > findFollowPath( const Common::FFXIVARR_POSITION3& startPos,
                                                               const Common::FFXIVARR_POSITION3& endPos );
+
+    /*! @param randomStream stream of the territory, roam targets are reproducible with its seed */
     Common::FFXIVARR_POSITION3 findRandomPositionInCircle( const Common::FFXIVARR_POSITION3& startPos,
-                                                           float maxRadius );
+                                                           float maxRadius, Random::RandomStream& randomStream );
 
     Common::FFXIVARR_POSITION3 findNearestPosition( float x, float z );
 
@@ -86,6 +98,23 @@ namespace Sapphire::Common::Navi
     float m_polyFindRange[ 3 ];
 
   private:
+    struct AgentMoveState
+    {
+      Common::FFXIVARR_POSITION3 target;
+      bool hasTarget;
+      bool isPending;
+      bool hasParameters;
+      float radius;
+      bool isRunning;
+    };
+
+    std::vector< AgentMoveState > m_agentMoveStates;
+    std::deque< int32_t > m_pendingMoveRequests;
+    uint32_t m_moveRequestCount;
+
+    bool requestMoveTarget( int32_t naviAgentId, const Common::FFXIVARR_POSITION3& endPos );
+    void flushPendingMoveRequests();
+    bool hasValidCorridor( int32_t naviAgentId ) const;
     int32_t fixupCorridor( dtPolyRef* path, int32_t npath, int32_t maxPath, const dtPolyRef* visited, int32_t nvisited );
     int32_t fixupShortcuts( dtPolyRef* path, int32_t npath, dtNavMeshQuery* navQuery );
     inline bool inRange( const float* v1, const float* v2, const float r, const float h );
@@ -120,6 +120,14 @@ namespace Sapphire::Network::Packets
       return m_segmentType;
     }
 
+    /**
+    * @brief Gets the IPC type of this packet, 0 for packets without an IPC header.
+    */
+    virtual uint16_t getIpcType() const
+    {
+      return 0;
+    }
+
     /**
     * @brief gets current packet size
     * @return packet size in bytes
@@ -262,6 +270,11 @@ namespace Sapphire::Network::Packets
       return static_cast< T1 >( m_data._ServerIpcType );
     };
 
+    uint16_t getIpcType() const override
+    {
+      return m_ipcHdr.type;
+    }
+
     /** Gets a reference to the underlying IPC data structure. */
     T& data()
     {
@@ -10,6 +10,8 @@
 
 #include <Logging/Logger.h>
 
+#include "RandomStream.h"
+
 namespace Sapphire::Common::Random
 {
   /*!
@@ -19,8 +21,8 @@ namespace Sapphire::Common::Random
   class RandGenerator
   {
   public:
-    RandGenerator( std::shared_ptr< std::mt19937 > pEngine, T minRange = std::numeric_limits< T >::min(), T maxRange = std::numeric_limits< T >::max() )
-      : m_engine( pEngine ), m_fpuDist( minRange, maxRange ), m_intDist( minRange, maxRange )
+    RandGenerator( RandomStream& engine, T minRange = std::numeric_limits< T >::min(), T maxRange = std::numeric_limits< T >::max() )
+      : m_engine( &engine ), m_fpuDist( minRange, maxRange ), m_intDist( minRange, maxRange )
     {
 
     }
@@ -54,16 +56,20 @@ namespace Sapphire::Common::Random
   protected:
     std::uniform_real_distribution<> m_fpuDist;
     std::uniform_int_distribution<> m_intDist;
-    std::shared_ptr< std::mt19937 > m_engine;
+    RandomStream* m_engine;
   };
 
   class RNGMgr
   {
   public:
-    // Constructs a manager to supply states for random integer and float distribution using a Mersenne Twister engine
-    RNGMgr()
+    /*!
+     * @brief Constructs a manager to supply random streams derived from one root seed
+     * @param rootSeed seed all streams are derived from, 0 picks a random one
+     */
+    explicit RNGMgr( uint64_t rootSeed = 0 )
     {
-      m_engine = std::make_shared< std::mt19937 >( *engineSeed< std::mt19937::state_size >() );
+      m_rootSeed = rootSeed != 0 ? rootSeed : randomSeed();
+      m_engine.reseed( RandomStream::deriveSeed( m_rootSeed, 0 ) );
     }
 
     virtual ~RNGMgr() = default;
@@ -95,33 +101,35 @@ namespace Sapphire::Common::Random
       return RandGenerator< T >( m_engine );
     }
 
-    std::shared_ptr< std::mt19937 > getRNGEngine()
+    /*! shared stream for draws which are not bound to a territory */
+    RandomStream& getRNGEngine()
     {
       return m_engine;
     }
 
-  private:
+    uint64_t getRootSeed() const
+    {
+      return m_rootSeed;
+    }
 
-    template< std::size_t STATE_SIZE >
-    std::unique_ptr< std::seed_seq > engineSeed()
+    /*! @return independent stream for streamId, the same root seed and id always yield the same stream */
+    RandomStream createStream( uint64_t streamId ) const
     {
-      // initialize mt engine with manually seeded random_device
+      return RandomStream( RandomStream::deriveSeed( m_rootSeed, streamId ) );
+    }
 
-      std::array< uint32_t, STATE_SIZE > seedArray;
+  private:
+    static uint64_t randomSeed()
+    {
       std::random_device rd;
-
-      // check if kernel can supply sufficiently non-deterministic output
-
-      //if( rd.entropy() == 0.f )
-      //  Logger::error( "Kernel random device entropy reported zero - Random number generator may be poor quality" );
-
-      std::generate_n( seedArray.data(), seedArray.size(), std::ref( rd ) );
-      auto pSeq = std::make_unique< std::seed_seq >( std::begin( seedArray ), std::end( seedArray ) );
-
-      return pSeq;
+      uint64_t seed = 0;
+      while( seed == 0 )
+        seed = ( static_cast< uint64_t >( rd() ) << 32 ) | rd();
+      return seed;
     }
 
-    std::shared_ptr< std::mt19937 > m_engine;
+    uint64_t m_rootSeed{ 0 };
+    RandomStream m_engine;
   };
 
 }
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace Sapphire::Common::Random
+{
+
+  /*!
+   * @brief xoshiro256** generator, one stream per territory or encounter.
+   *
+   * Streams are derived from a root seed and an id, so a stream drawn in the same order
+   * yields the same values again. Satisfies UniformRandomBitGenerator.
+   */
+  class RandomStream
+  {
+  public:
+    using result_type = uint64_t;
+
+    explicit RandomStream( uint64_t seed = 0 )
+    {
+      reseed( seed );
+    }
+
+    /*! @return seed of a stream, mixing the root seed with the stream id */
+    static uint64_t deriveSeed( uint64_t rootSeed, uint64_t streamId )
+    {
+      uint64_t state = rootSeed ^ ( streamId * 0xD1B54A32D192ED03ull );
+      return splitMix( state );
+    }
+
+    void reseed( uint64_t seed )
+    {
+      m_seed = seed;
+      uint64_t state = seed;
+      for( auto& word : m_state )
+        word = splitMix( state );
+    }
+
+    uint64_t getSeed() const
+    {
+      return m_seed;
+    }
+
+    static constexpr result_type min()
+    {
+      return 0;
+    }
+
+    static constexpr result_type max()
+    {
+      return std::numeric_limits< result_type >::max();
+    }
+
+    result_type operator()()
+    {
+      const auto result = rotl( m_state[ 1 ] * 5, 7 ) * 9;
+      const auto t = m_state[ 1 ] << 17;
+
+      m_state[ 2 ] ^= m_state[ 0 ];
+      m_state[ 3 ] ^= m_state[ 1 ];
+      m_state[ 1 ] ^= m_state[ 2 ];
+      m_state[ 0 ] ^= m_state[ 3 ];
+      m_state[ 2 ] ^= t;
+      m_state[ 3 ] = rotl( m_state[ 3 ], 45 );
+
+      return result;
+    }
+
+    /*! @return integer in [minValue, maxValue] */
+    uint32_t nextInt( uint32_t minValue, uint32_t maxValue )
+    {
+      if( maxValue <= minValue )
+        return minValue;
+
+      // multiply-shift range reduction, the bias is below 2^-32 for 32 bit ranges
+      auto range = static_cast< uint64_t >( maxValue - minValue ) + 1;
+      auto value = static_cast< uint32_t >( ( ( *this )() >> 32 ) * range >> 32 );
+      return minValue + value;
+    }
+
+    /*! @return float in [minValue, maxValue) */
+    float nextFloat( float minValue = 0.f, float maxValue = 1.f )
+    {
+      // 24 random bits fill the float mantissa
+      auto unit = static_cast< float >( ( *this )() >> 40 ) * ( 1.f / 16777216.f );
+      return minValue + unit * ( maxValue - minValue );
+    }
+
+  private:
+    static uint64_t rotl( uint64_t value, int shift )
+    {
+      return ( value << shift ) | ( value >> ( 64 - shift ) );
+    }
+
+    static uint64_t splitMix( uint64_t& state )
+    {
+      uint64_t z = ( state += 0x9E3779B97F4A7C15ull );
+      z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+      z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+      return z ^ ( z >> 31 );
+    }
+
+    uint64_t m_seed{ 0 };
+    uint64_t m_state[ 4 ]{};
+  };
+
+}
@@ -29,6 +29,30 @@ inline std::string basename( const std::string& file )
 
 #endif
 
+#if defined( SAPPHIRE_PGO_GENERATE ) && !defined( _WIN32 )
+#include <unistd.h>
+
+// instrumented builds only write their profile on a normal exit, the training run stops the servers with SIGTERM
+#ifdef __clang__
+extern "C" int __llvm_profile_write_file( void );
+#else
+extern "C" void __gcov_dump( void );
+#endif
+
+namespace
+{
+  void profileFlushHandler( int )
+  {
+#ifdef __clang__
+    __llvm_profile_write_file();
+#else
+    __gcov_dump();
+#endif
+    _exit( 0 );
+  }
+}
+#endif
+
 using namespace Sapphire::Common;
 
 Util::CrashHandler::CrashHandler()
@@ -43,9 +67,33 @@ Util::CrashHandler::CrashHandler()
   signal( SIGBUS, signalHandler );
 #endif
 
+#if defined( SAPPHIRE_PGO_GENERATE ) && !defined( _WIN32 )
+  signal( SIGTERM, profileFlushHandler );
+  signal( SIGINT, profileFlushHandler );
+#endif
+
 #undef REGISTER_SIGNAL
 }
 
+Util::CrashHandler::ShutdownHandler Util::CrashHandler::s_shutdownHandler = nullptr;
+
+void Util::CrashHandler::setShutdownHandler( ShutdownHandler handler )
+{
+  s_shutdownHandler = handler;
+
+  // a server shutting down on its own exits normally, so instrumented builds write their profile as well
+  signal( SIGTERM, shutdownSignalHandler );
+  signal( SIGINT, shutdownSignalHandler );
+}
+
+void Util::CrashHandler::shutdownSignalHandler( int sigNum )
+{
+  signal( sigNum, SIG_DFL );
+
+  if( s_shutdownHandler )
+    s_shutdownHandler();
+}
+
 void Util::CrashHandler::signalHandler( int sigNum )
 {
 #define ADD_SIGNAL_MAP( x ) case x: name = #x; break;
@@ -18,9 +18,23 @@ namespace Sapphire::Common::Util
     CrashHandler();
     virtual ~CrashHandler() = default;
 
+    using ShutdownHandler = void ( * )();
+
+    /*!
+     * @brief Calls handler on SIGTERM and SIGINT instead of terminating, a second signal terminates right away
+     *
+     * The handler runs inside the signal handler, it should only flag the server to stop and leave the
+     * cleanup to the main thread.
+     */
+    static void setShutdownHandler( ShutdownHandler handler );
+
   private:
     static void signalHandler( int sigNum );
 
+    static void shutdownSignalHandler( int sigNum );
+
+    static ShutdownHandler s_shutdownHandler;
+
     static void printStackTrace( unsigned int max_frames = 63 );
   };
 }
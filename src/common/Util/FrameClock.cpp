@@ -0,0 +1,95 @@
+#include "FrameClock.h"
+#include "Util.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+using namespace Sapphire::Common::Util;
+
+namespace
+{
+  uint64_t steadyMs()
+  {
+    return static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::milliseconds >(
+      std::chrono::steady_clock::now().time_since_epoch() ).count() );
+  }
+
+  struct ClockState
+  {
+    std::mutex mutex;
+    FrameClock::TimeSource source{ steadyMs };
+    uint64_t lastSourceMs{ steadyMs() };
+    uint64_t fixedStepMs{ 0 };
+    double rate{ 1.0 };
+    // sub millisecond remainder of accelerated or slowed down frames
+    double carryMs{ 0.0 };
+    std::atomic< uint64_t > frameMs{ Sapphire::Common::Util::getTimeMs() };
+  };
+
+  ClockState& getState()
+  {
+    static ClockState state;
+    return state;
+  }
+}
+
+void FrameClock::setTimeSource( TimeSource source )
+{
+  auto& state = getState();
+  std::lock_guard< std::mutex > lock( state.mutex );
+  state.source = source ? std::move( source ) : TimeSource( steadyMs );
+  state.lastSourceMs = state.source();
+  state.carryMs = 0.0;
+}
+
+void FrameClock::setFixedStep( uint64_t stepMs )
+{
+  auto& state = getState();
+  std::lock_guard< std::mutex > lock( state.mutex );
+  state.fixedStepMs = stepMs;
+}
+
+void FrameClock::setRate( double rate )
+{
+  auto& state = getState();
+  std::lock_guard< std::mutex > lock( state.mutex );
+  state.rate = rate > 0.0 ? rate : 1.0;
+  state.carryMs = 0.0;
+}
+
+uint64_t FrameClock::advance()
+{
+  auto& state = getState();
+  std::lock_guard< std::mutex > lock( state.mutex );
+
+  auto sourceMs = state.source();
+  // a misbehaving source must not move the frame back
+  auto elapsedMs = sourceMs > state.lastSourceMs ? sourceMs - state.lastSourceMs : 0;
+  state.lastSourceMs = sourceMs;
+
+  uint64_t stepMs = state.fixedStepMs;
+  if( stepMs == 0 )
+  {
+    if( state.rate == 1.0 )
+      stepMs = elapsedMs;
+    else
+    {
+      state.carryMs += static_cast< double >( elapsedMs ) * state.rate;
+      stepMs = static_cast< uint64_t >( state.carryMs );
+      state.carryMs -= static_cast< double >( stepMs );
+    }
+  }
+
+  return state.frameMs.fetch_add( stepMs, std::memory_order_release ) + stepMs;
+}
+
+uint64_t FrameClock::getTimeMs()
+{
+  return getState().frameMs.load( std::memory_order_acquire );
+}
+
+uint32_t FrameClock::getTimeSeconds()
+{
+  return static_cast< uint32_t >( getTimeMs() / 1000 );
+}
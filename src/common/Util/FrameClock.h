@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Sapphire::Common::Util
+{
+
+  /*!
+   * @brief Monotonic simulation time, sampled once per world loop iteration.
+   *
+   * Timers, cooldowns and AI compare against the frame time instead of reading the system clock
+   * themselves, so they are cheap to query and unaffected by wall clock steps. Frame time starts
+   * at the wall clock when the process starts and only advances from a monotonic source, so it
+   * stays comparable with timestamps taken from getTimeMs()/getTimeSeconds(). Those remain the
+   * clock for anything persisted, sent to clients as a date or used for Eorzea time.
+   *
+   * The source can be replaced to run the simulation at a fixed step or accelerated rate.
+   */
+  class FrameClock
+  {
+  public:
+    /*! returns milliseconds from an arbitrary, never decreasing origin */
+    using TimeSource = std::function< uint64_t() >;
+
+    /*! @param source nullptr restores the steady clock */
+    static void setTimeSource( TimeSource source );
+
+    /*! @param stepMs every advance() moves frame time by stepMs regardless of the source, 0 disables */
+    static void setFixedStep( uint64_t stepMs );
+
+    /*! @param rate multiplier applied to elapsed source time */
+    static void setRate( double rate );
+
+    /*!
+     * @brief samples the source and starts a new frame
+     * @return frame time in milliseconds
+     */
+    static uint64_t advance();
+
+    /*! @return frame time in milliseconds */
+    static uint64_t getTimeMs();
+
+    /*! @return frame time in seconds */
+    static uint32_t getTimeSeconds();
+  };
+
+}
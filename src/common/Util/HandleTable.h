@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Sapphire::Common::Util
+{
+
+  /*!
+   * @brief Packed slot index ( low 32 bits ) and slot generation ( high 32 bits ).
+   *
+   * Generations start at 1, so a zero handle never resolves.
+   */
+  using Handle = uint64_t;
+
+  const Handle InvalidHandle = 0;
+
+  /*!
+   * @brief Slot table resolving handles to objects in O(1).
+   *
+   * Removing an object bumps the generation of its slot, handles still pointing at the old generation
+   * resolve to nullptr instead of whatever object reuses the slot later on.
+   * Live objects are additionally kept densely packed for iteration.
+   */
+  template< class T >
+  class HandleTable
+  {
+  public:
+    using ObjectPtr = std::shared_ptr< T >;
+
+    static uint32_t getIndex( Handle handle )
+    {
+      return static_cast< uint32_t >( handle & 0xFFFFFFFF );
+    }
+
+    static uint32_t getGeneration( Handle handle )
+    {
+      return static_cast< uint32_t >( handle >> 32 );
+    }
+
+    Handle insert( ObjectPtr pObject )
+    {
+      uint32_t index;
+      if( !m_freeSlots.empty() )
+      {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+      }
+      else
+      {
+        index = static_cast< uint32_t >( m_slots.size() );
+        m_slots.push_back( { 1, 0, false } );
+      }
+
+      auto& slot = m_slots[ index ];
+      slot.denseIndex = static_cast< uint32_t >( m_dense.size() );
+      slot.isUsed = true;
+
+      m_dense.push_back( std::move( pObject ) );
+      m_denseSlots.push_back( index );
+
+      return makeHandle( index, slot.generation );
+    }
+
+    bool remove( Handle handle )
+    {
+      if( !isValid( handle ) )
+        return false;
+
+      auto& slot = m_slots[ getIndex( handle ) ];
+
+      // keep the dense array packed by moving the last object into the hole
+      auto lastDense = static_cast< uint32_t >( m_dense.size() - 1 );
+      if( slot.denseIndex != lastDense )
+      {
+        m_dense[ slot.denseIndex ] = std::move( m_dense[ lastDense ] );
+        m_denseSlots[ slot.denseIndex ] = m_denseSlots[ lastDense ];
+        m_slots[ m_denseSlots[ slot.denseIndex ] ].denseIndex = slot.denseIndex;
+      }
+      m_dense.pop_back();
+      m_denseSlots.pop_back();
+
+      slot.isUsed = false;
+      if( ++slot.generation == 0 )
+        slot.generation = 1;
+
+      m_freeSlots.push_back( getIndex( handle ) );
+      return true;
+    }
+
+    bool isValid( Handle handle ) const
+    {
+      auto index = getIndex( handle );
+      if( index >= m_slots.size() )
+        return false;
+
+      const auto& slot = m_slots[ index ];
+      return slot.isUsed && slot.generation == getGeneration( handle );
+    }
+
+    /*! @return the object the handle refers to, nullptr if the handle is stale */
+    ObjectPtr resolve( Handle handle ) const
+    {
+      if( !isValid( handle ) )
+        return nullptr;
+
+      return m_dense[ m_slots[ getIndex( handle ) ].denseIndex ];
+    }
+
+    /*! @return all live objects, packed and in no particular order */
+    const std::vector< ObjectPtr >& getObjects() const
+    {
+      return m_dense;
+    }
+
+    std::size_t size() const
+    {
+      return m_dense.size();
+    }
+
+    void clear()
+    {
+      while( !m_dense.empty() )
+        remove( makeHandle( m_denseSlots.back(), m_slots[ m_denseSlots.back() ].generation ) );
+    }
+
+  private:
+    struct Slot
+    {
+      uint32_t generation;
+      uint32_t denseIndex;
+      bool isUsed;
+    };
+
+    static Handle makeHandle( uint32_t index, uint32_t generation )
+    {
+      return static_cast< Handle >( generation ) << 32 | index;
+    }
+
+    std::vector< Slot > m_slots;
+    std::vector< uint32_t > m_freeSlots;
+
+    std::vector< ObjectPtr > m_dense;
+    std::vector< uint32_t > m_denseSlots;
+  };
+
+}
@@ -42,6 +42,13 @@ namespace Sapphire::Common::Util
       return m_queue.empty();
     }
 
+    std::size_t size()
+    {
+      std::lock_guard< std::mutex > lock( m_queueLock );
+
+      return m_queue.size();
+    }
+
     bool pop( T& value )
     {
       std::lock_guard< std::mutex > lock( m_queueLock );
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Sapphire::Common::Util
+{
+
+  /*!
+   * @brief Bounded lock-free multi producer, single consumer queue with bulk drain.
+   *
+   * Producers claim ring slots with a single compare and swap, the consumer takes every published
+   * element in one call without locking. Pushes never fail: once the ring is full, elements go to a
+   * locked overflow list until the consumer has emptied it, which keeps the order of each producer.
+   */
+  template< class T >
+  class MpscQueue
+  {
+  public:
+    /*! @param capacity ring size, rounded up to a power of two */
+    explicit MpscQueue( std::size_t capacity = 1024 )
+    {
+      std::size_t size = 2;
+      while( size < capacity )
+        size <<= 1;
+
+      m_mask = size - 1;
+      m_pSlots = std::make_unique< Slot[] >( size );
+      for( std::size_t i = 0; i < size; ++i )
+        m_pSlots[ i ].sequence.store( i, std::memory_order_relaxed );
+    }
+
+    MpscQueue( const MpscQueue& ) = delete;
+    MpscQueue& operator=( const MpscQueue& ) = delete;
+
+    /*! thread safe, may be called by any number of producers */
+    void push( T value )
+    {
+      if( !m_overflowing.load( std::memory_order_acquire ) && tryPush( value ) )
+        return;
+
+      std::lock_guard< std::mutex > lock( m_overflowMutex );
+      m_overflow.push_back( std::move( value ) );
+      m_overflowing.store( true, std::memory_order_release );
+    }
+
+    /*!
+     * @brief moves every element published so far into out, consumer only
+     * @return number of elements appended
+     */
+    std::size_t drain( std::vector< T >& out )
+    {
+      auto before = out.size();
+
+      while( true )
+      {
+        auto& slot = m_pSlots[ m_tail & m_mask ];
+        if( slot.sequence.load( std::memory_order_acquire ) != m_tail + 1 )
+          break;
+
+        out.push_back( std::move( slot.value ) );
+        slot.value = T();
+        slot.sequence.store( m_tail + m_mask + 1, std::memory_order_release );
+        ++m_tail;
+      }
+
+      // overflowed elements were pushed after everything their producer has in the ring, they have to
+      // wait while a claimed slot is still being written
+      if( m_overflowing.load( std::memory_order_acquire ) && m_head.load( std::memory_order_acquire ) == m_tail )
+      {
+        std::lock_guard< std::mutex > lock( m_overflowMutex );
+        for( auto& value : m_overflow )
+          out.push_back( std::move( value ) );
+        m_overflow.clear();
+        m_overflowing.store( false, std::memory_order_release );
+      }
+
+      return out.size() - before;
+    }
+
+    /*! @return true if nothing is queued, only exact for the consumer */
+    bool empty() const
+    {
+      return m_pSlots[ m_tail & m_mask ].sequence.load( std::memory_order_acquire ) != m_tail + 1 &&
+             !m_overflowing.load( std::memory_order_acquire );
+    }
+
+    std::size_t getCapacity() const
+    {
+      return m_mask + 1;
+    }
+
+  private:
+    struct Slot
+    {
+      std::atomic< std::size_t > sequence{ 0 };
+      T value{};
+    };
+
+    bool tryPush( T& value )
+    {
+      auto pos = m_head.load( std::memory_order_relaxed );
+
+      while( true )
+      {
+        auto& slot = m_pSlots[ pos & m_mask ];
+        auto sequence = slot.sequence.load( std::memory_order_acquire );
+        auto diff = static_cast< std::ptrdiff_t >( sequence ) - static_cast< std::ptrdiff_t >( pos );
+
+        if( diff == 0 )
+        {
+          if( m_head.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+          {
+            slot.value = std::move( value );
+            slot.sequence.store( pos + 1, std::memory_order_release );
+            return true;
+          }
+        }
+        else if( diff < 0 )
+          return false;
+        else
+          pos = m_head.load( std::memory_order_relaxed );
+      }
+    }
+
+    std::unique_ptr< Slot[] > m_pSlots;
+    std::size_t m_mask{ 0 };
+
+    alignas( 64 ) std::atomic< std::size_t > m_head{ 0 };
+    alignas( 64 ) std::size_t m_tail{ 0 };
+
+    std::atomic< bool > m_overflowing{ false };
+    std::mutex m_overflowMutex;
+    std::vector< T > m_overflow;
+  };
+
+}
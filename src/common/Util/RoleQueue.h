@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Sapphire::Common::Util
+{
+
+  /*!
+   * @brief FIFO buckets of waiting entries per role, popped as groups of a fixed role composition.
+   *
+   * An entry can wait in several queues at once. When it leaves one of them (matched elsewhere,
+   * withdrawn) the owner only calls leave(), the stale entry stays in its bucket and is dropped
+   * once it reaches the front or the bucket is compacted. The owner tells stale entries apart
+   * with the predicate passed to popMatch and compact.
+   */
+  template< class T, std::size_t RoleCount >
+  class RoleQueue
+  {
+  public:
+    using Requirement = std::array< uint8_t, RoleCount >;
+
+    RoleQueue() = default;
+
+    explicit RoleQueue( const Requirement& requirement ) :
+      m_requirement( requirement )
+    {
+    }
+
+    const Requirement& getRequirement() const
+    {
+      return m_requirement;
+    }
+
+    /*! @return size of a full group, 0 if this queue can't be matched */
+    std::size_t getGroupSize() const
+    {
+      std::size_t size = 0;
+      for( auto count : m_requirement )
+        size += count;
+      return size;
+    }
+
+    /*! adds an available entry, entries returning to the queue can keep their old place by going to the front */
+    void push( std::size_t role, T value, bool front = false )
+    {
+      if( front )
+        m_buckets[ role ].push_front( std::move( value ) );
+      else
+        m_buckets[ role ].push_back( std::move( value ) );
+      ++m_available[ role ];
+    }
+
+    /*! an entry of role is no longer available, its bucket slot is cleaned up lazily */
+    void leave( std::size_t role )
+    {
+      if( m_available[ role ] > 0 )
+        --m_available[ role ];
+    }
+
+    /*! @return number of available entries of role */
+    std::size_t getCount( std::size_t role ) const
+    {
+      return m_available[ role ];
+    }
+
+    /*! @return number of available entries of role, capped to the amount one group needs */
+    std::size_t getGroupCount( std::size_t role ) const
+    {
+      return m_available[ role ] < m_requirement[ role ] ? m_available[ role ] : m_requirement[ role ];
+    }
+
+    bool canMatch() const
+    {
+      if( getGroupSize() == 0 )
+        return false;
+
+      for( std::size_t role = 0; role < RoleCount; ++role )
+      {
+        if( m_available[ role ] < m_requirement[ role ] )
+          return false;
+      }
+      return true;
+    }
+
+    /*!
+     * @brief pops the longest waiting available entries of each role for one group
+     * @param isAvailable predicate telling if a popped entry is still waiting
+     * @return false if not enough entries are available, nothing is popped in that case
+     */
+    template< class Pred >
+    bool popMatch( std::vector< T >& out, Pred isAvailable )
+    {
+      if( !canMatch() )
+        return false;
+
+      for( std::size_t role = 0; role < RoleCount; ++role )
+      {
+        auto& bucket = m_buckets[ role ];
+        std::size_t needed = m_requirement[ role ];
+
+        while( needed > 0 && !bucket.empty() )
+        {
+          auto value = std::move( bucket.front() );
+          bucket.pop_front();
+
+          if( !isAvailable( value ) )
+            continue;
+
+          out.push_back( std::move( value ) );
+          --m_available[ role ];
+          --needed;
+        }
+      }
+
+      return true;
+    }
+
+    /*! drops stale entries of buckets which hold more than twice their available entries */
+    template< class Pred >
+    void compact( Pred isAvailable )
+    {
+      for( std::size_t role = 0; role < RoleCount; ++role )
+      {
+        auto& bucket = m_buckets[ role ];
+        if( bucket.size() <= 2 * m_available[ role ] + 16 )
+          continue;
+
+        std::deque< T > kept;
+        for( auto& value : bucket )
+        {
+          if( isAvailable( value ) )
+            kept.push_back( std::move( value ) );
+        }
+        bucket.swap( kept );
+        m_available[ role ] = bucket.size();
+      }
+    }
+
+    /*! @return true if no entry is waiting */
+    bool empty() const
+    {
+      for( auto count : m_available )
+      {
+        if( count > 0 )
+          return false;
+      }
+      return true;
+    }
+
+  private:
+    Requirement m_requirement{};
+    std::array< std::deque< T >, RoleCount > m_buckets;
+    std::array< std::size_t, RoleCount > m_available{};
+  };
+
+}
@@ -67,6 +67,11 @@ namespace Sapphire::Common::Util
       m_actorIdToAllocatedMap.clear();
     }
 
+    bool hasFreeSpawnIndex() const
+    {
+      return !m_availableIds.empty();
+    }
+
     bool isSpawnIndexValid( T spawnIndex )
     {
       return spawnIndex != getAllocFailId();
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Sapphire::Common::Util
+{
+
+  /*!
+   * @brief Fixed size pool of worker threads consuming a shared job queue.
+   *
+   * Jobs are run in the order they were queued, their result ( or exception ) is handed back through a future.
+   * The destructor finishes every job that is still pending before joining the workers.
+   */
+  class ThreadPool
+  {
+  public:
+    /*!
+     * @param numWorkers number of worker threads to spawn, 0 uses the hardware concurrency
+     */
+    explicit ThreadPool( uint32_t numWorkers = 0 )
+    {
+      if( numWorkers == 0 )
+        numWorkers = std::max( 1u, std::thread::hardware_concurrency() );
+
+      m_workers.reserve( numWorkers );
+      for( uint32_t i = 0; i < numWorkers; ++i )
+        m_workers.emplace_back( [ this ]() { run(); } );
+    }
+
+    ~ThreadPool()
+    {
+      {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_shutdown = true;
+      }
+      m_condition.notify_all();
+
+      for( auto& worker : m_workers )
+        worker.join();
+    }
+
+    ThreadPool( const ThreadPool& ) = delete;
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+    template< class Func, class Ret = std::invoke_result_t< Func& > >
+    std::future< Ret > queue( Func&& func )
+    {
+      auto pTask = std::make_shared< std::packaged_task< Ret() > >( std::forward< Func >( func ) );
+      auto result = pTask->get_future();
+      {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_pendingJobs.emplace_back( [ pTask ]() { ( *pTask )(); } );
+      }
+      m_condition.notify_one();
+
+      return result;
+    }
+
+    std::size_t getWorkerCount() const
+    {
+      return m_workers.size();
+    }
+
+  private:
+    void run()
+    {
+      while( true )
+      {
+        std::function< void() > job;
+        {
+          std::unique_lock< std::mutex > lock( m_mutex );
+          m_condition.wait( lock, [ this ]() { return m_shutdown || !m_pendingJobs.empty(); } );
+
+          if( m_pendingJobs.empty() )
+            return;
+
+          job = std::move( m_pendingJobs.front() );
+          m_pendingJobs.pop_front();
+        }
+
+        job();
+      }
+    }
+
+    std::vector< std::thread > m_workers;
+    std::deque< std::function< void() > > m_pendingJobs;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_shutdown{ false };
+  };
+
+}
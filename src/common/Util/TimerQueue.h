@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+namespace Sapphire::Common::Util
+{
+
+  /*!
+   * @brief Min-heap of values keyed on the time they are due.
+   *
+   * Values due at the same time come out in the order they were scheduled.
+   * Entries can't be removed, owners invalidate them lazily by comparing the popped due time
+   * against the one they expect.
+   */
+  template< class T >
+  class TimerQueue
+  {
+  public:
+    void schedule( uint64_t dueTime, T value )
+    {
+      m_entries.push( Entry{ dueTime, m_sequence++, std::move( value ) } );
+    }
+
+    /*!
+     * @brief moves every value due at or before time into out
+     * @return number of values appended to out
+     */
+    std::size_t popDue( uint64_t time, std::vector< std::pair< uint64_t, T > >& out )
+    {
+      std::size_t count = 0;
+      while( !m_entries.empty() && m_entries.top().dueTime <= time )
+      {
+        auto& top = m_entries.top();
+        out.emplace_back( top.dueTime, std::move( const_cast< Entry& >( top ).value ) );
+        m_entries.pop();
+        ++count;
+      }
+      return count;
+    }
+
+    /*! @return due time of the next entry, UINT64_MAX if the queue is empty */
+    uint64_t getNextDueTime() const
+    {
+      return m_entries.empty() ? UINT64_MAX : m_entries.top().dueTime;
+    }
+
+    bool empty() const
+    {
+      return m_entries.empty();
+    }
+
+    std::size_t size() const
+    {
+      return m_entries.size();
+    }
+
+    void clear()
+    {
+      m_entries = {};
+    }
+
+  private:
+    struct Entry
+    {
+      uint64_t dueTime;
+      uint64_t sequence;
+      T value;
+
+      bool operator>( const Entry& other ) const
+      {
+        return std::tie( dueTime, sequence ) > std::tie( other.dueTime, other.sequence );
+      }
+    };
+
+    std::priority_queue< Entry, std::vector< Entry >, std::greater< Entry > > m_entries;
+    uint64_t m_sequence{ 0 };
+  };
+
+}
@@ -1,6 +1,5 @@
 #include <ScriptObject.h>
 #include <Territory/InstanceContent.h>
-#include <Random/RNGMgr.h>
 
 #include <Actor/EventObject.h>
 #include <Actor/Player.h>
@@ -58,8 +57,7 @@ public:
   void onInit( InstanceContent& instance ) override
   {
     // Random coral
-    auto& RNGMgr = Common::Service< Common::Random::RNGMgr >::ref();
-    instance.setCustomVar( Coral, RNGMgr.getRandGenerator< uint32_t >( Corals::Blue, Corals::Green ).next() );
+    instance.setCustomVar( Coral, instance.getRandomStream().nextInt( Corals::Blue, Corals::Green ) );
 
     switch( instance.getCustomVar( Coral ) )
     {
@@ -11,7 +11,7 @@
 #include <Network/CommonActorControl.h>
 
 #include <Math/CalcStats.h>
-#include <stdlib.h>
+#include <Manager/TerritoryMgr.h>
 
 using namespace Sapphire;
 using namespace Sapphire::World::Action;
@@ -38,7 +38,8 @@ public:
 
     statusEffectMgr().damage( pSource, actor.getAsChara(), static_cast< int32_t >( damageVal ) );
 
-    if( pPlayer && damageType == Common::CalcResultType::TypeCriticalDamageHp && pPlayer->getLevel() >= 48 && ( float ) rand() / ( float ) RAND_MAX <= 0.5 )
+    if( pPlayer && damageType == Common::CalcResultType::TypeCriticalDamageHp && pPlayer->getLevel() >= 48 &&
+        teriMgr().getRandomStream( *pPlayer ).nextFloat() <= 0.5f )
     {
       playerMgr().onSkillProc( *pPlayer, 1 );
     }
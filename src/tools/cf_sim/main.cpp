@@ -0,0 +1,308 @@
+#include <Logging/Logger.h>
+#include <Util/RoleQueue.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace Sapphire;
+
+// replays a synthetic duty finder load against the role bucket queues used by the world server and against
+// rescanning every waiting player each tick, both have to form exactly the same groups
+
+namespace
+{
+  const uint32_t ServerTickMs = 300;
+  const std::size_t RoleCount = 4;
+
+  using Requirement = Common::Util::RoleQueue< uint32_t, RoleCount >::Requirement;
+
+  struct Content
+  {
+    uint32_t id{ 0 };
+    Requirement requirement{};
+  };
+
+  struct Player
+  {
+    uint32_t id{ 0 };
+    uint8_t role{ 0 };
+    std::vector< uint32_t > contentIds;
+    uint32_t arrivalTick{ 0 };
+    uint32_t matchTick{ 0 };
+    bool waiting{ true };
+  };
+
+  struct Result
+  {
+    uint64_t groups{ 0 };
+    uint64_t matchedPlayers{ 0 };
+    uint64_t checksum{ 0 };
+    std::vector< uint32_t > latencies;
+    double elapsedMs{ 0.0 };
+    double worstTickMs{ 0.0 };
+  };
+
+  struct SimConfig
+  {
+    uint32_t players{ 5000 };
+    uint32_t contents{ 40 };
+    uint32_t rouletteShare{ 40 };
+    uint32_t durationMs{ 600000 };
+    uint32_t seed{ 1 };
+  };
+
+  std::vector< Content > createContents( const SimConfig& config )
+  {
+    std::vector< Content > contents;
+    for( uint32_t i = 0; i < config.contents; ++i )
+    {
+      Content content;
+      content.id = i + 1;
+      // every fourth content is a full party duty, the rest are light party dungeons
+      if( i % 4 == 3 )
+        content.requirement = { 2, 2, 2, 2 };
+      else
+        content.requirement = { 1, 1, 1, 1 };
+      contents.push_back( content );
+    }
+    return contents;
+  }
+
+  // arrivals are spread evenly over the first half of the run, the rest of it drains the queues
+  std::vector< Player > createPlayers( const SimConfig& config )
+  {
+    std::mt19937 rng( config.seed );
+    std::vector< Player > players;
+    uint32_t ticks = std::max( 1u, config.durationMs / ServerTickMs / 2 );
+
+    for( uint32_t i = 0; i < config.players; ++i )
+    {
+      Player player;
+      player.id = i + 1;
+      player.arrivalTick = static_cast< uint32_t >( static_cast< uint64_t >( i ) * ticks / config.players );
+
+      // roughly retail role shares, dps are split evenly between melee and ranged
+      auto roll = rng() % 100;
+      player.role = roll < 15 ? 0 : roll < 35 ? 1 : roll < 68 ? 2 : 3;
+
+      if( rng() % 100 < config.rouletteShare )
+      {
+        // roulettes cover a block of eight contents
+        auto first = static_cast< uint32_t >( rng() % std::max( 1u, config.contents / 8 ) ) * 8;
+        for( uint32_t contentId = first + 1; contentId <= std::min( config.contents, first + 8 ); ++contentId )
+          player.contentIds.push_back( contentId );
+      }
+      else
+        player.contentIds.push_back( 1 + static_cast< uint32_t >( rng() % config.contents ) );
+
+      players.push_back( player );
+    }
+    return players;
+  }
+
+  void onMatched( Result& result, std::vector< Player >& players, uint32_t contentId, const std::vector< uint32_t >& group, uint32_t tick )
+  {
+    ++result.groups;
+    for( auto playerId : group )
+    {
+      auto& player = players[ playerId - 1 ];
+      player.waiting = false;
+      player.matchTick = tick;
+      result.latencies.push_back( tick - player.arrivalTick );
+      result.checksum = result.checksum * 1000003 + contentId * 7919 + playerId;
+      ++result.matchedPlayers;
+    }
+  }
+
+  Result runBuckets( const SimConfig& config, const std::vector< Content >& contents, std::vector< Player > players )
+  {
+    Result result;
+    std::vector< Common::Util::RoleQueue< uint32_t, RoleCount > > queues;
+    for( const auto& content : contents )
+      queues.emplace_back( content.requirement );
+
+    std::set< uint32_t > dirtyContentIds;
+    auto isAvailable = [ &players ]( uint32_t playerId ) { return players[ playerId - 1 ].waiting; };
+
+    size_t nextArrival = 0;
+    uint32_t ticks = config.durationMs / ServerTickMs;
+    std::vector< uint32_t > group;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for( uint32_t tick = 0; tick <= ticks; ++tick )
+    {
+      auto tickBegin = std::chrono::steady_clock::now();
+
+      while( nextArrival < players.size() && players[ nextArrival ].arrivalTick == tick )
+      {
+        auto& player = players[ nextArrival++ ];
+        for( auto contentId : player.contentIds )
+        {
+          queues[ contentId - 1 ].push( player.role, player.id );
+          dirtyContentIds.insert( contentId );
+        }
+      }
+
+      for( auto contentId : dirtyContentIds )
+      {
+        auto& queue = queues[ contentId - 1 ];
+        queue.compact( isAvailable );
+
+        while( queue.popMatch( group, isAvailable ) )
+        {
+          onMatched( result, players, contentId, group, tick );
+
+          // the matched players leave every other queue they were waiting in
+          for( auto playerId : group )
+          {
+            const auto& player = players[ playerId - 1 ];
+            for( auto otherId : player.contentIds )
+            {
+              if( otherId != contentId )
+                queues[ otherId - 1 ].leave( player.role );
+            }
+          }
+          group.clear();
+        }
+      }
+      dirtyContentIds.clear();
+
+      auto tickMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - tickBegin ).count();
+      result.worstTickMs = std::max( result.worstTickMs, tickMs );
+    }
+
+    result.elapsedMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - begin ).count();
+    return result;
+  }
+
+  Result runRescan( const SimConfig& config, const std::vector< Content >& contents, std::vector< Player > players )
+  {
+    Result result;
+    std::vector< uint32_t > waiting;
+
+    size_t nextArrival = 0;
+    uint32_t ticks = config.durationMs / ServerTickMs;
+    std::vector< uint32_t > group;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for( uint32_t tick = 0; tick <= ticks; ++tick )
+    {
+      auto tickBegin = std::chrono::steady_clock::now();
+
+      while( nextArrival < players.size() && players[ nextArrival ].arrivalTick == tick )
+        waiting.push_back( players[ nextArrival++ ].id );
+
+      // every content walks every waiting player in arrival order until no further group fits
+      for( const auto& content : contents )
+      {
+        while( true )
+        {
+          std::array< uint8_t, RoleCount > found{};
+          group.clear();
+
+          for( auto playerId : waiting )
+          {
+            const auto& player = players[ playerId - 1 ];
+            if( !player.waiting || found[ player.role ] >= content.requirement[ player.role ] )
+              continue;
+
+            if( std::find( player.contentIds.begin(), player.contentIds.end(), content.id ) == player.contentIds.end() )
+              continue;
+
+            ++found[ player.role ];
+            group.push_back( playerId );
+          }
+
+          if( found != content.requirement )
+            break;
+
+          // the bucket queues hand out groups ordered by role
+          std::stable_sort( group.begin(), group.end(), [ &players ]( uint32_t left, uint32_t right )
+                            { return players[ left - 1 ].role < players[ right - 1 ].role; } );
+          onMatched( result, players, content.id, group, tick );
+        }
+      }
+
+      waiting.erase( std::remove_if( waiting.begin(), waiting.end(), [ &players ]( uint32_t playerId )
+                                     { return !players[ playerId - 1 ].waiting; } ), waiting.end() );
+
+      auto tickMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - tickBegin ).count();
+      result.worstTickMs = std::max( result.worstTickMs, tickMs );
+    }
+
+    result.elapsedMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - begin ).count();
+    return result;
+  }
+
+  void printResult( const std::string& name, Result& result, const SimConfig& config )
+  {
+    auto ticks = config.durationMs / ServerTickMs + 1;
+    std::sort( result.latencies.begin(), result.latencies.end() );
+
+    auto percentile = [ &result ]( uint32_t p ) -> double
+    {
+      if( result.latencies.empty() )
+        return 0.0;
+      auto idx = std::min( result.latencies.size() - 1, result.latencies.size() * p / 100 );
+      return result.latencies[ idx ] * ServerTickMs / 1000.0;
+    };
+
+    Logger::info( "{:<8} {:>9.2f}ms total, {:>8.2f}us per tick, worst tick {:.3f}ms, {} groups, {} players matched",
+                  name, result.elapsedMs, result.elapsedMs * 1000.0 / ticks, result.worstTickMs, result.groups, result.matchedPlayers );
+    Logger::info( "{:<8} wait p50 {:.1f}s, p95 {:.1f}s, max {:.1f}s", name, percentile( 50 ), percentile( 95 ), percentile( 100 ) );
+  }
+}
+
+int main( int argc, char* argv[] )
+{
+  Logger::init( "cf_sim" );
+
+  SimConfig config;
+  std::vector< std::string > args( argv + 1, argv + argc );
+  for( size_t i = 0; i + 1 < args.size(); i += 2 )
+  {
+    auto val = static_cast< uint32_t >( std::stoul( args[ i + 1 ] ) );
+    if( args[ i ] == "--players" )
+      config.players = val;
+    else if( args[ i ] == "--contents" )
+      config.contents = std::max( 1u, val );
+    else if( args[ i ] == "--roulette" )
+      config.rouletteShare = std::min( 100u, val );
+    else if( args[ i ] == "--duration" )
+      config.durationMs = val;
+    else if( args[ i ] == "--seed" )
+      config.seed = val;
+    else
+    {
+      Logger::error( "usage: cf_sim [--players n] [--contents n] [--roulette percent] [--duration ms] [--seed n]" );
+      return 1;
+    }
+  }
+
+  Logger::info( "{} players queueing for {} contents, {}% in roulettes, {}ms simulated at {}ms per tick",
+                config.players, config.contents, config.rouletteShare, config.durationMs, ServerTickMs );
+
+  auto contents = createContents( config );
+  auto players = createPlayers( config );
+
+  auto buckets = runBuckets( config, contents, players );
+  auto rescan = runRescan( config, contents, players );
+
+  printResult( "buckets", buckets, config );
+  printResult( "rescan", rescan, config );
+
+  if( buckets.groups != rescan.groups || buckets.checksum != rescan.checksum )
+  {
+    Logger::error( "Both implementations formed different groups" );
+    return 1;
+  }
+
+  return 0;
+}
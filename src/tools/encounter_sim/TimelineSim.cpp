@@ -0,0 +1,608 @@
+#include "TimelineSim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <Actor/BNpc.h>
+#include <Actor/Player.h>
+#include <Encounter/Selector.h>
+#include <Encounter/TimelineActor.h>
+#include <Encounter/TimelinePack.h>
+#include <Encounter/Timepoint.h>
+#include <Event/Director.h>
+#include <Territory/Territory.h>
+#include <Util/UtilMath.h>
+
+#include <spdlog/fmt/fmt.h>
+
+using namespace Sapphire;
+
+namespace EncounterSim
+{
+  namespace
+  {
+    // ids handed out to simulated charas, players first, then actors in timeline order
+    const uint32_t PlayerIdBase = 0x10000000;
+    const uint32_t BNpcIdBase = 0x40000000;
+
+    // simulation clock starts here, 0 means "not started" in the condition state like on the server
+    const uint64_t SimEpoch = 1000000;
+
+    // stand-in classes of the roles of a full party, tanks first
+    const Common::ClassJob PartyClasses[] =
+    {
+      Common::ClassJob::Paladin, Common::ClassJob::Warrior, Common::ClassJob::Whitemage, Common::ClassJob::Scholar,
+      Common::ClassJob::Monk, Common::ClassJob::Dragoon, Common::ClassJob::Bard, Common::ClassJob::Blackmage
+    };
+
+    const char* getTimepointTypeName( TimepointDataType type )
+    {
+      static const char* names[] =
+      {
+        "idle", "castAction", "setPos", "actionTimeline", "logMessage", "battleTalk",
+        "directorVar", "directorVarLR", "directorSeq", "directorFlags",
+        "addStatusEffect", "removeStatusEffect",
+        "bNpcSpawn", "bNpcDespawn", "bNpcFlags", "setEObjState", "setBGM",
+        "setCondition", "snapshot"
+      };
+
+      auto index = static_cast< uint32_t >( type );
+      return index < std::size( names ) ? names[ index ] : "unknown";
+    }
+  }
+
+  TimelineSim::TimelineSim( const std::string& timelineName, const SimConfig& config ) :
+    Encounter( nullptr, std::make_shared< Event::Director >( Event::Director::InstanceContent, 0 ), timelineName ),
+    m_config( config ),
+    m_rng( config.seed ),
+    m_pTerritory( std::make_shared< Territory >() )
+  {
+  }
+
+  TimelineSim::~TimelineSim()
+  {
+    // in range sets and hate lists reference each other, the territory breaks those links when the charas leave
+    for( auto& chara : m_charas )
+      if( chara.spawned )
+        m_pTerritory->removeActor( chara.pChara );
+  }
+
+  void TimelineSim::spawnCharas()
+  {
+    for( uint32_t i = 0; i < m_config.playerCount; ++i )
+    {
+      auto pPlayer = Entity::make_Player();
+      pPlayer->setId( PlayerIdBase + i );
+      pPlayer->setClassJob( PartyClasses[ i % std::size( PartyClasses ) ] );
+      pPlayer->setLoadingComplete( true );
+
+      // tanks stay close, everyone else spreads around the boss
+      auto radius = pPlayer->getRole() == Common::Role::Tank ? 3.f + nextRandom( 3 ) : 5.f + nextRandom( 15 );
+      auto angle = Common::Util::degreesToRadians( static_cast< float >( nextRandom( 360 ) ) );
+      pPlayer->setPos( { radius * std::cos( angle ), 0.f, radius * std::sin( angle ) }, false );
+
+      SimChara player;
+      player.id = pPlayer->getId();
+      player.name = fmt::format( "Player {}", i + 1 );
+      player.isPlayer = true;
+      player.spawned = true;
+      player.pChara = pPlayer;
+      player.hp = player.maxHp = 1;
+
+      m_pTerritory->pushActor( pPlayer );
+      m_charas.push_back( player );
+    }
+
+    // every timeline actor and sub actor gets a chara up front, only the first one starts out spawned
+    uint32_t nextBNpcId = BNpcIdBase;
+    for( const auto& actor : m_pTimeline->getTimelineActors() )
+    {
+      SimChara chara;
+      chara.id = nextBNpcId++;
+      chara.layoutId = actor.getLayoutId();
+      chara.name = actor.getName();
+      chara.maxHp = std::max( actor.m_hp, 1u );
+      chara.hp = chara.maxHp;
+      chara.pChara = createBNpc( chara );
+
+      m_actorCharas.push_back( static_cast< uint32_t >( m_charas.size() ) );
+      m_charas.push_back( chara );
+
+      auto& subActorCharas = m_subActorCharas.emplace_back();
+      for( const auto& subActor : actor.getSubActorNames() )
+      {
+        SimChara subChara;
+        subChara.id = nextBNpcId++;
+        subChara.layoutId = actor.getLayoutId();
+        subChara.name = subActor;
+        subChara.pChara = createBNpc( subChara );
+
+        subActorCharas.push_back( static_cast< uint32_t >( m_charas.size() ) );
+        m_charas.push_back( subChara );
+      }
+    }
+
+    if( !m_actorCharas.empty() )
+    {
+      auto& boss = m_charas[ m_actorCharas[ 0 ] ];
+      boss.spawned = true;
+      m_pTerritory->pushActor( boss.pChara );
+    }
+  }
+
+  Entity::CharaPtr TimelineSim::createBNpc( const SimChara& chara )
+  {
+    // there is no game data, the bnpc only gets what its cache entry defines
+    auto pInfo = std::make_shared< Common::BNpcCacheEntry >();
+    pInfo->instanceId = chara.layoutId;
+    pInfo->Level = Common::MAX_PLAYER_LEVEL;
+
+    auto pBNpc = std::make_shared< Entity::BNpc >( chara.id, pInfo, *m_pTerritory, chara.maxHp, Common::BNpcType::Enemy );
+    pBNpc->setStatus( Common::ActorStatus::Idle );
+    return pBNpc;
+  }
+
+  void TimelineSim::updatePlayers( uint64_t time )
+  {
+    // players drift a little every tick so selector results change over the fight
+    for( auto& chara : m_charas )
+    {
+      if( !chara.isPlayer )
+        continue;
+
+      auto pos = chara.pChara->getPos();
+      pos.x += static_cast< float >( static_cast< int32_t >( nextRandom( 201 ) ) - 100 ) / 100.f;
+      pos.z += static_cast< float >( static_cast< int32_t >( nextRandom( 201 ) ) - 100 ) / 100.f;
+
+      // keep everyone inside the arena
+      auto dist = std::sqrt( pos.x * pos.x + pos.z * pos.z );
+      if( dist > 20.f )
+      {
+        pos.x *= 20.f / dist;
+        pos.z *= 20.f / dist;
+      }
+
+      moveChara( chara, pos, chara.pChara->getRot() );
+    }
+  }
+
+  void TimelineSim::updateBoss( uint64_t time )
+  {
+    for( auto& chara : m_charas )
+    {
+      if( chara.isPlayer || !chara.spawned )
+        continue;
+
+      if( chara.currentAction != 0 && time >= chara.actionEndTime )
+        chara.currentAction = 0;
+    }
+
+    if( m_actorCharas.empty() )
+      return;
+
+    auto& boss = m_charas[ m_actorCharas[ 0 ] ];
+    if( !boss.spawned )
+      return;
+
+    switch( boss.state )
+    {
+      case Entity::BNpcState::Idle:
+      {
+        if( time >= m_pullTime )
+        {
+          boss.state = Entity::BNpcState::Combat;
+          if( m_config.playerCount > 0 )
+            boss.targetId = PlayerIdBase;
+
+          // the first player holds aggro, everyone else follows in order
+          auto pBoss = boss.pChara->getAsBNpc();
+          for( uint32_t i = 0; i < m_config.playerCount; ++i )
+            pBoss->hateListAdd( m_charas[ i ].pChara, static_cast< int32_t >( m_config.playerCount - i ) );
+
+          log( fmt::format( "{} engaged", boss.name ) );
+        }
+      }
+      break;
+      case Entity::BNpcState::Combat:
+      {
+        auto elapsed = time - m_pullTime;
+        if( elapsed >= m_config.killTimeMs )
+        {
+          boss.hp = 0;
+          boss.state = Entity::BNpcState::JustDied;
+          boss.pChara->setStatus( Common::ActorStatus::Dead );
+          log( fmt::format( "{} died", boss.name ) );
+        }
+        else
+        {
+          auto remaining = static_cast< uint64_t >( boss.maxHp ) * ( m_config.killTimeMs - elapsed ) / m_config.killTimeMs;
+          boss.hp = std::max( static_cast< uint32_t >( remaining ), 1u );
+        }
+      }
+      break;
+      case Entity::BNpcState::JustDied:
+        boss.state = Entity::BNpcState::Dead;
+        break;
+      default:
+        break;
+    }
+
+    // adds spawned by the timeline fall over after the same share of the kill time as their hp
+    for( size_t i = 1; i < m_actorCharas.size(); ++i )
+    {
+      auto& add = m_charas[ m_actorCharas[ i ] ];
+      if( !add.spawned || add.state != Entity::BNpcState::Combat )
+        continue;
+
+      auto addKillTime = std::max< uint64_t >( static_cast< uint64_t >( m_config.killTimeMs ) * add.maxHp / boss.maxHp, m_config.tickMs );
+      if( time >= add.spawnTime + addKillTime )
+      {
+        add.hp = 0;
+        add.state = Entity::BNpcState::Dead;
+        add.pChara->setStatus( Common::ActorStatus::Dead );
+        log( fmt::format( "{} died", add.name ) );
+      }
+    }
+  }
+
+  void TimelineSim::run()
+  {
+    init();
+    start();
+    spawnCharas();
+
+    m_simStartTime = SimEpoch;
+    m_pullTime = m_simStartTime + m_config.pullDelayMs;
+
+    auto endTime = m_simStartTime + m_config.durationMs;
+    uint64_t deadTime = 0;
+
+    for( auto time = m_simStartTime; time <= endTime; time += m_config.tickMs )
+    {
+      auto begin = std::chrono::steady_clock::now();
+      tick( time );
+      auto end = std::chrono::steady_clock::now();
+
+      auto ns = static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( end - begin ).count() );
+      m_stats.ticks++;
+      m_stats.totalNs += ns;
+      m_stats.maxNs = std::max( m_stats.maxNs, ns );
+
+      // let the death and reset schedules play out for a bit before stopping
+      if( !m_actorCharas.empty() && m_charas[ m_actorCharas[ 0 ] ].state == Entity::BNpcState::Dead )
+      {
+        if( deadTime == 0 )
+          deadTime = time;
+        else if( time >= deadTime + 10000 )
+          break;
+      }
+    }
+  }
+
+  void TimelineSim::tick( uint64_t time )
+  {
+    m_time = time;
+    updatePlayers( time );
+    updateBoss( time );
+
+    update( time );
+  }
+
+  std::optional< uint32_t > TimelineSim::getBNpcHpPercent( uint32_t layoutId )
+  {
+    auto pChara = getCharaByLayoutId( layoutId );
+    if( !pChara )
+      return std::nullopt;
+    return pChara->hp * 100 / pChara->maxHp;
+  }
+
+  std::optional< Entity::BNpcState > TimelineSim::getBNpcState( uint32_t layoutId )
+  {
+    auto pChara = getCharaByLayoutId( layoutId );
+    if( !pChara )
+      return std::nullopt;
+    return pChara->state;
+  }
+
+  bool TimelineSim::hasBNpcFlags( uint32_t layoutId, uint32_t flags )
+  {
+    auto pChara = getCharaByLayoutId( layoutId );
+    return pChara && ( pChara->flags & flags );
+  }
+
+  bool TimelineSim::isBNpcCasting( uint32_t layoutId, uint32_t actionId )
+  {
+    auto pChara = getCharaByLayoutId( layoutId );
+    return pChara && pChara->currentAction == actionId;
+  }
+
+  void TimelineSim::spawnSubActors( TimelineActor& actor )
+  {
+    const auto& actors = m_pTimeline->getTimelineActors();
+    for( size_t i = 0; i < actors.size(); ++i )
+    {
+      if( actors[ i ].getName() != actor.getName() )
+        continue;
+
+      for( auto index : m_subActorCharas[ i ] )
+        if( !m_charas[ index ].spawned )
+          spawnChara( m_charas[ index ], 0 );
+      break;
+    }
+  }
+
+  bool TimelineSim::castAction( TimelinePack& pack, const TimepointDataAction& data )
+  {
+    auto pSource = getCharaByRef( data.m_source );
+    if( !pSource )
+    {
+      log( fmt::format( "action {} has no spawned source", data.m_actionId ) );
+      return true;
+    }
+
+    uint32_t targetId = pSource->id;
+    switch( data.m_targetType )
+    {
+      case ActionTargetType::None:
+        targetId = Common::INVALID_GAME_OBJECT_ID;
+        break;
+      case ActionTargetType::Target:
+        targetId = pSource->targetId;
+        break;
+      case ActionTargetType::Selector:
+      {
+        const auto& results = pack.getSnapshotTargetIds( data.m_selector );
+        if( data.m_selectorIndex < results.size() )
+          targetId = results[ data.m_selectorIndex ];
+      }
+      break;
+      default:
+        break;
+    }
+
+    // the server skips casts while the actor is still busy
+    if( pSource->currentAction != 0 )
+    {
+      log( fmt::format( "action {} dropped, {} still casting {}", data.m_actionId, pSource->name, pSource->currentAction ) );
+      return false;
+    }
+
+    pSource->currentAction = data.m_actionId;
+    pSource->actionEndTime = m_time + m_config.castTimeMs;
+    log( fmt::format( "{} casts {} on {:08X}", pSource->name, data.m_actionId, targetId ) );
+    return true;
+  }
+
+  void TimelineSim::setPos( TimelinePack& pack, const TimepointDataSetPos& data )
+  {
+    auto pChara = getCharaByRef( data.m_actor );
+    if( !pChara )
+      return;
+
+    auto pos = pChara->pChara->getPos();
+    float rot = 0.f;
+    switch( data.m_targetType )
+    {
+      case SetPosTargetType::Target:
+      {
+        if( auto pTarget = getCharaById( pChara->targetId ) )
+        {
+          pos = pTarget->pChara->getPos();
+          rot = pTarget->pChara->getRot();
+        }
+      }
+      break;
+      case SetPosTargetType::Selector:
+      {
+        const auto& results = pack.getSnapshotResults( data.m_selector );
+        if( data.m_selectorIndex < results.size() )
+        {
+          pos = results[ data.m_selectorIndex ].m_pos;
+          rot = results[ data.m_selectorIndex ].m_rot;
+        }
+      }
+      break;
+      default:
+        break;
+    }
+
+    switch( data.m_posType )
+    {
+      case SetPosType::Absolute:
+        moveChara( *pChara, { data.m_x, data.m_y, data.m_z }, data.m_rot );
+        break;
+      case SetPosType::Relative:
+        moveChara( *pChara, Common::Util::getOffsettedPosition( pos, rot, data.m_x, data.m_y, data.m_z ), rot );
+        break;
+      default:
+        break;
+    }
+
+    const auto& newPos = pChara->pChara->getPos();
+    log( fmt::format( "{} moved to {:.2f} {:.2f} {:.2f}", pChara->name, newPos.x, newPos.y, newPos.z ) );
+  }
+
+  void TimelineSim::playActionTimeline( TimelinePack& pack, const TimepointDataActionTimeLine& data )
+  {
+    // only visible to clients
+  }
+
+  void TimelineSim::sendLogMessage( const TimepointDataLogMessage& data )
+  {
+    // only visible to clients
+  }
+
+  void TimelineSim::sendBattleTalk( TimelinePack& pack, const TimepointDataBattleTalk& data )
+  {
+    // only visible to clients
+  }
+
+  void TimelineSim::spawnBNpc( uint32_t layoutId, uint32_t flags )
+  {
+    if( auto pChara = getCharaByLayoutId( layoutId, false ) )
+      spawnChara( *pChara, flags );
+  }
+
+  void TimelineSim::despawnBNpc( uint32_t layoutId )
+  {
+    if( auto pChara = getCharaByLayoutId( layoutId ) )
+    {
+      pChara->spawned = false;
+      m_pTerritory->removeActor( pChara->pChara );
+      log( fmt::format( "{} despawned", pChara->name ) );
+    }
+  }
+
+  void TimelineSim::setBNpcFlags( uint32_t layoutId, uint32_t flags )
+  {
+    if( auto pChara = getCharaByLayoutId( layoutId ) )
+    {
+      pChara->flags = flags;
+      log( fmt::format( "{} flags {:X}", pChara->name, pChara->flags ) );
+    }
+  }
+
+  void TimelineSim::setEObjState( uint32_t eobjId, uint32_t state )
+  {
+    // there are no event objects in the simulation
+  }
+
+  void TimelineSim::setBgm( uint32_t bgmId )
+  {
+    // only visible to clients
+  }
+
+  void TimelineSim::createSnapshot( TimelinePack& pack, const TimepointDataSnapshot& data )
+  {
+    auto pSource = getCharaByRef( data.m_actor );
+    auto pSelector = pack.getSelector( data.m_selector );
+    if( !pSource || !pSelector )
+      return;
+
+    m_stats.snapshots++;
+
+    // picked from the in range set of the stand-in like Encounter::createSnapshot does for the spawned bnpc
+    const auto& exclude = pack.getSnapshotTargetIds( data.m_excludeSelector );
+    pack.createSnapshot( data.m_selector, pSource->pChara, exclude );
+
+    std::string names;
+    for( auto targetId : pSelector->getTargetIds() )
+    {
+      auto pTarget = getCharaById( targetId );
+      auto name = pTarget ? pTarget->name : fmt::format( "{:08X}", targetId );
+      names += names.empty() ? name : ", " + name;
+    }
+
+    log( fmt::format( "selector {}: [{}]", pSelector->getName(), names ) );
+  }
+
+  void TimelineSim::onTimepoint( const TimelineActor& self, const Timepoint& timepoint, uint64_t time )
+  {
+    m_stats.timepointsFired++;
+    log( fmt::format( "{} {} \"{}\"", self.getName(), getTimepointTypeName( timepoint.m_type ), timepoint.m_description ) );
+
+    auto pDirector = getDirector();
+    switch( timepoint.m_type )
+    {
+      case TimepointDataType::DirectorVar:
+      case TimepointDataType::DirectorVarLR:
+      {
+        auto pData = std::dynamic_pointer_cast< TimepointDataDirector >( timepoint.getData() );
+        log( fmt::format( "director var {} = {}", pData->m_data.index, pDirector->getDirectorVar( pData->m_data.index ) ) );
+      }
+      break;
+      case TimepointDataType::DirectorSeq:
+        log( fmt::format( "director seq = {}", pDirector->getSequence() ) );
+        break;
+      case TimepointDataType::DirectorFlags:
+        log( fmt::format( "director flags = {}", pDirector->getFlags() ) );
+        break;
+      default:
+        break;
+    }
+  }
+
+  TimelineSim::SimChara* TimelineSim::getCharaByRef( const TimelineActorRef& ref )
+  {
+    if( !ref.valid() || static_cast< size_t >( ref.m_actorIndex ) >= m_actorCharas.size() )
+      return nullptr;
+
+    uint32_t index = m_actorCharas[ ref.m_actorIndex ];
+    if( ref.m_subActorIndex >= 0 )
+    {
+      const auto& subActorCharas = m_subActorCharas[ ref.m_actorIndex ];
+      if( static_cast< size_t >( ref.m_subActorIndex ) >= subActorCharas.size() )
+        return nullptr;
+      index = subActorCharas[ ref.m_subActorIndex ];
+    }
+
+    auto& chara = m_charas[ index ];
+    return chara.spawned ? &chara : nullptr;
+  }
+
+  TimelineSim::SimChara* TimelineSim::getCharaByLayoutId( uint32_t layoutId, bool spawnedOnly )
+  {
+    // sub actors share the layout id of their parent, lookups only ever find the parent
+    for( auto index : m_actorCharas )
+    {
+      auto& chara = m_charas[ index ];
+      if( chara.layoutId == layoutId )
+        return chara.spawned || !spawnedOnly ? &chara : nullptr;
+    }
+    return nullptr;
+  }
+
+  TimelineSim::SimChara* TimelineSim::getCharaById( uint32_t id )
+  {
+    for( auto& chara : m_charas )
+      if( chara.id == id && chara.spawned )
+        return &chara;
+    return nullptr;
+  }
+
+  void TimelineSim::spawnChara( SimChara& chara, uint32_t flags )
+  {
+    chara.spawned = true;
+    chara.flags = flags;
+    chara.hp = chara.maxHp;
+    chara.currentAction = 0;
+    chara.state = chara.maxHp > 1 ? Entity::BNpcState::Combat : Entity::BNpcState::Idle;
+    chara.spawnTime = m_time;
+    chara.pChara->setStatus( Common::ActorStatus::Idle );
+    m_pTerritory->pushActor( chara.pChara );
+    log( fmt::format( "{} spawned", chara.name ) );
+  }
+
+  void TimelineSim::moveChara( SimChara& chara, const Common::FFXIVARR_POSITION3& pos, float rot )
+  {
+    chara.pChara->setPos( pos, false );
+    chara.pChara->setRot( rot );
+
+    // the stand-ins are not known to TerritoryMgr, their in range sets are updated here instead of by setPos
+    if( chara.spawned )
+      m_pTerritory->updateActorPosition( *chara.pChara );
+  }
+
+  uint32_t TimelineSim::nextRandom( uint32_t range )
+  {
+    // raw engine output, distributions are not guaranteed to match between standard libraries
+    return range == 0 ? 0 : static_cast< uint32_t >( m_rng() % range );
+  }
+
+  void TimelineSim::log( const std::string& text )
+  {
+    m_trace.push_back( fmt::format( "[{:>8}] {}", m_time - m_simStartTime, text ) );
+  }
+
+  const std::vector< std::string >& TimelineSim::getTrace() const
+  {
+    return m_trace;
+  }
+
+  const TickStats& TimelineSim::getStats() const
+  {
+    return m_stats;
+  }
+
+}
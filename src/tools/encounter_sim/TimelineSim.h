@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <Encounter/Encounter.h>
+#include <ForwardsZone.h>
+
+namespace EncounterSim
+{
+
+  /*!
+   * @brief Settings of a single simulated encounter.
+   *
+   * Everything the simulation does is derived from these values, the same settings always produce the same trace.
+   */
+  struct SimConfig
+  {
+    uint32_t seed{ 1 };
+    uint32_t tickMs{ 300 };
+    uint32_t durationMs{ 600000 };
+    uint32_t playerCount{ 8 };
+    // time until the first player pulls the boss
+    uint32_t pullDelayMs{ 1000 };
+    // time from the pull until the boss hp reaches 0, hp drains linearly
+    uint32_t killTimeMs{ 480000 };
+    // how long a cast keeps the actor busy, casts issued meanwhile are dropped like on the server
+    uint32_t castTimeMs{ 2700 };
+  };
+
+  struct TickStats
+  {
+    uint64_t ticks{ 0 };
+    uint64_t totalNs{ 0 };
+    uint64_t maxNs{ 0 };
+    uint64_t timepointsFired{ 0 };
+    uint64_t snapshots{ 0 };
+  };
+
+  /*!
+   * @brief Encounter of the world server running against synthetic players instead of a zone.
+   *
+   * The timeline is compiled, scheduled and executed by the server implementation, the director is a real
+   * Event::Director. Only the world access hooks of Encounter are replaced, the fight itself is simulated on
+   * plain structs. Every chara has a stand-in Player or BNpc in a territory of its own, selectors pick their
+   * targets from those with the server filters. Every fired timepoint, cast, spawn and selector result is
+   * appended to the trace.
+   */
+  class TimelineSim : public Sapphire::Encounter
+  {
+  public:
+    TimelineSim( const std::string& timelineName, const SimConfig& config );
+    ~TimelineSim() override;
+
+    /*! runs the encounter for the configured duration or until the boss is dead */
+    void run();
+
+    const std::vector< std::string >& getTrace() const;
+    const TickStats& getStats() const;
+
+    std::optional< uint32_t > getBNpcHpPercent( uint32_t layoutId ) override;
+    std::optional< Sapphire::Entity::BNpcState > getBNpcState( uint32_t layoutId ) override;
+    bool hasBNpcFlags( uint32_t layoutId, uint32_t flags ) override;
+    bool isBNpcCasting( uint32_t layoutId, uint32_t actionId ) override;
+
+    void spawnSubActors( Sapphire::TimelineActor& actor ) override;
+
+    bool castAction( Sapphire::TimelinePack& pack, const Sapphire::TimepointDataAction& data ) override;
+    void setPos( Sapphire::TimelinePack& pack, const Sapphire::TimepointDataSetPos& data ) override;
+    void playActionTimeline( Sapphire::TimelinePack& pack, const Sapphire::TimepointDataActionTimeLine& data ) override;
+    void sendLogMessage( const Sapphire::TimepointDataLogMessage& data ) override;
+    void sendBattleTalk( Sapphire::TimelinePack& pack, const Sapphire::TimepointDataBattleTalk& data ) override;
+
+    void spawnBNpc( uint32_t layoutId, uint32_t flags ) override;
+    void despawnBNpc( uint32_t layoutId ) override;
+    void setBNpcFlags( uint32_t layoutId, uint32_t flags ) override;
+    void setEObjState( uint32_t eobjId, uint32_t state ) override;
+    void setBgm( uint32_t bgmId ) override;
+
+    void createSnapshot( Sapphire::TimelinePack& pack, const Sapphire::TimepointDataSnapshot& data ) override;
+
+    void onTimepoint( const Sapphire::TimelineActor& self, const Sapphire::Timepoint& timepoint, uint64_t time ) override;
+
+  private:
+    struct SimChara
+    {
+      uint32_t id{ 0 };
+      uint32_t layoutId{ 0 };
+      std::string name;
+      bool isPlayer{ false };
+      bool spawned{ false };
+      // position, class and hate of the chara, in the territory while spawned
+      Sapphire::Entity::CharaPtr pChara;
+      uint32_t hp{ 0 };
+      uint32_t maxHp{ 1 };
+      uint32_t flags{ 0 };
+      Sapphire::Entity::BNpcState state{ Sapphire::Entity::BNpcState::Idle };
+      uint32_t targetId{ 0 };
+      uint32_t currentAction{ 0 };
+      uint64_t actionEndTime{ 0 };
+      uint64_t spawnTime{ 0 };
+    };
+
+    void spawnCharas();
+    Sapphire::Entity::CharaPtr createBNpc( const SimChara& chara );
+    void updatePlayers( uint64_t time );
+    void updateBoss( uint64_t time );
+    void tick( uint64_t time );
+
+    SimChara* getCharaByRef( const Sapphire::TimelineActorRef& ref );
+    SimChara* getCharaByLayoutId( uint32_t layoutId, bool spawnedOnly = true );
+    SimChara* getCharaById( uint32_t id );
+    void spawnChara( SimChara& chara, uint32_t flags );
+    void moveChara( SimChara& chara, const Sapphire::Common::FFXIVARR_POSITION3& pos, float rot );
+
+    uint32_t nextRandom( uint32_t range );
+    void log( const std::string& text );
+
+    SimConfig m_config;
+    std::mt19937 m_rng;
+
+    uint64_t m_simStartTime{ 0 };
+    uint64_t m_pullTime{ 0 };
+    uint64_t m_time{ 0 };
+
+    Sapphire::TerritoryPtr m_pTerritory;
+    std::vector< SimChara > m_charas;
+    // chara of every timeline actor and its sub actors, by the indexes timepoints ref them with
+    std::vector< uint32_t > m_actorCharas;
+    std::vector< std::vector< uint32_t > > m_subActorCharas;
+
+    std::vector< std::string > m_trace;
+    TickStats m_stats;
+  };
+  using TimelineSimPtr = std::shared_ptr< TimelineSim >;
+
+}
@@ -0,0 +1,270 @@
+#include <Exd/ExdData.h>
+#include <Logging/Logger.h>
+#include <Random/RNGMgr.h>
+#include <Service.h>
+#include <Util/ThreadPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Encounter/TimelinePack.h>
+#include <Manager/TerritoryMgr.h>
+#include <WorldServer.h>
+
+#include "TimelineSim.h"
+
+using namespace Sapphire;
+using namespace EncounterSim;
+
+namespace
+{
+  void printUsage()
+  {
+    Logger::info( "usage: encounter_sim <timeline name or json path> [options]" );
+    Logger::info( "  --data <dir>           directory holding the timelines, default data/EncounterTimelines" );
+    Logger::info( "  --seed <n>             rng seed, default 1" );
+    Logger::info( "  --tick <ms>            simulation step, default 300" );
+    Logger::info( "  --duration <ms>        maximum encounter length, default 600000" );
+    Logger::info( "  --players <n>          number of synthetic players, default 8" );
+    Logger::info( "  --kill-time <ms>       time from pull to boss death, default 480000" );
+    Logger::info( "  --trace                print the event trace" );
+    Logger::info( "  --write-golden <file>  write the event trace to a file" );
+    Logger::info( "  --golden <file>        compare the event trace against a file, exits with 1 on mismatch" );
+    Logger::info( "  --bench <n>            run n encounters in parallel and report the tick cost" );
+    Logger::info( "  --threads <n>          worker threads for --bench, default hardware concurrency" );
+  }
+
+  // the stand-in players and bnpcs look these up like on the server, the packets they send are dropped without sessions
+  void initServices( uint32_t seed )
+  {
+    // no game data is loaded, bnpcs are created from their cache entry only
+    Common::Service< Data::ExdData >::set();
+    // random selector fills draw from the shared stream, the stand-in territories are not known to TerritoryMgr
+    Common::Service< Common::Random::RNGMgr >::set( seed );
+    Common::Service< World::Manager::TerritoryMgr >::set();
+    Common::Service< World::WorldServer >::set( "world.ini" );
+  }
+
+  int32_t compareGolden( const std::vector< std::string >& trace, const std::string& path )
+  {
+    std::ifstream f( path );
+    if( !f.is_open() )
+    {
+      Logger::error( "Unable to open golden trace {}", path );
+      return 1;
+    }
+
+    std::vector< std::string > golden;
+    std::string line;
+    while( std::getline( f, line ) )
+      golden.push_back( line );
+
+    auto count = std::min( trace.size(), golden.size() );
+    for( size_t i = 0; i < count; ++i )
+    {
+      if( trace[ i ] != golden[ i ] )
+      {
+        Logger::error( "Trace differs from {} at line {}", path, i + 1 );
+        Logger::error( "  expected: {}", golden[ i ] );
+        Logger::error( "  actual:   {}", trace[ i ] );
+        return 1;
+      }
+    }
+
+    if( trace.size() != golden.size() )
+    {
+      Logger::error( "Trace has {} lines, {} expects {}", trace.size(), path, golden.size() );
+      return 1;
+    }
+
+    Logger::info( "Trace matches {} ( {} lines )", path, trace.size() );
+    return 0;
+  }
+
+  int32_t runBench( const std::string& timeline, const SimConfig& config, uint32_t count, uint32_t threads )
+  {
+    Common::Util::ThreadPool pool( threads );
+    Logger::info( "Running {} encounters on {} threads", count, pool.getWorkerCount() );
+
+    auto begin = std::chrono::steady_clock::now();
+
+    std::vector< std::future< TickStats > > results;
+    results.reserve( count );
+    for( uint32_t i = 0; i < count; ++i )
+    {
+      auto instanceConfig = config;
+      instanceConfig.seed = config.seed + i;
+
+      // compiled packs are shared through the cache, every instance only owns its runtime state
+      results.push_back( pool.queue( [ timeline, instanceConfig ]()
+      {
+        auto pSim = std::make_shared< TimelineSim >( timeline, instanceConfig );
+        pSim->run();
+        return pSim->getStats();
+      } ) );
+    }
+
+    TickStats total;
+    for( auto& result : results )
+    {
+      auto stats = result.get();
+      total.ticks += stats.ticks;
+      total.totalNs += stats.totalNs;
+      total.maxNs = std::max( total.maxNs, stats.maxNs );
+      total.timepointsFired += stats.timepointsFired;
+      total.snapshots += stats.snapshots;
+    }
+
+    auto wallMs = std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::steady_clock::now() - begin ).count();
+
+    Logger::info( "{} ticks, {} timepoints, {} snapshots in {}ms wall time", total.ticks, total.timepointsFired, total.snapshots, wallMs );
+    if( total.ticks > 0 )
+    {
+      Logger::info( "tick cost avg {:.2f}us, max {:.2f}us", static_cast< double >( total.totalNs ) / total.ticks / 1000.0,
+                    static_cast< double >( total.maxNs ) / 1000.0 );
+    }
+    return 0;
+  }
+}
+
+int main( int argc, char* argv[] )
+{
+  Logger::init( "encounter_sim" );
+
+  std::vector< std::string > args( argv + 1, argv + argc );
+  if( args.empty() || args[ 0 ] == "--help" )
+  {
+    printUsage();
+    return args.empty() ? 1 : 0;
+  }
+
+  SimConfig config;
+  std::string timeline = args[ 0 ];
+  std::string dataPath = "data/EncounterTimelines";
+  std::string writeGolden;
+  std::string golden;
+  bool printTrace = false;
+  uint32_t benchCount = 0;
+  uint32_t benchThreads = 0;
+
+  try
+  {
+    for( size_t i = 1; i < args.size(); ++i )
+    {
+      const auto& arg = args[ i ];
+      if( arg == "--trace" )
+      {
+        printTrace = true;
+        continue;
+      }
+
+      if( i + 1 >= args.size() )
+      {
+        Logger::error( "Missing value for {}", arg );
+        return 1;
+      }
+
+      const auto& val = args[ ++i ];
+      if( arg == "--data" )
+        dataPath = val;
+      else if( arg == "--seed" )
+        config.seed = static_cast< uint32_t >( std::stoul( val ) );
+      else if( arg == "--tick" )
+        config.tickMs = std::max( 1u, static_cast< uint32_t >( std::stoul( val ) ) );
+      else if( arg == "--duration" )
+        config.durationMs = static_cast< uint32_t >( std::stoul( val ) );
+      else if( arg == "--players" )
+        config.playerCount = static_cast< uint32_t >( std::stoul( val ) );
+      else if( arg == "--kill-time" )
+        config.killTimeMs = std::max( 1u, static_cast< uint32_t >( std::stoul( val ) ) );
+      else if( arg == "--write-golden" )
+        writeGolden = val;
+      else if( arg == "--golden" )
+        golden = val;
+      else if( arg == "--bench" )
+        benchCount = static_cast< uint32_t >( std::stoul( val ) );
+      else if( arg == "--threads" )
+        benchThreads = static_cast< uint32_t >( std::stoul( val ) );
+      else
+      {
+        Logger::error( "Unknown option {}", arg );
+        printUsage();
+        return 1;
+      }
+    }
+  }
+  catch( const std::exception& e )
+  {
+    Logger::error( "Invalid option value: {}", e.what() );
+    return 1;
+  }
+
+  // json paths point the server lookup at their directory, plain names use the data directory like the server does
+  if( timeline.size() > 5 && timeline.compare( timeline.size() - 5, 5, ".json" ) == 0 )
+  {
+    std::filesystem::path path( timeline );
+    dataPath = path.has_parent_path() ? path.parent_path().string() : ".";
+    timeline = path.stem().string();
+  }
+  TimelinePack::setTimelineDirectory( dataPath );
+
+  // compile once up front so parse errors are reported before any instance runs
+  try
+  {
+    if( !TimelinePack::getCompiledPack( timeline ) )
+    {
+      Logger::error( "Unable to open timeline {}/{}.json", dataPath, timeline );
+      return 1;
+    }
+  }
+  catch( const std::exception& e )
+  {
+    Logger::error( "Failed to compile timeline {}/{}.json: {}", dataPath, timeline, e.what() );
+    return 1;
+  }
+
+  initServices( config.seed );
+
+  if( benchCount > 0 )
+    return runBench( timeline, config, benchCount, benchThreads );
+
+  auto pSim = std::make_shared< TimelineSim >( timeline, config );
+  pSim->run();
+
+  const auto& trace = pSim->getTrace();
+  const auto& stats = pSim->getStats();
+
+  if( printTrace )
+    for( const auto& line : trace )
+      std::cout << line << "\n";
+
+  Logger::info( "{}: {} ticks, {} timepoints fired, {} snapshots, tick cost avg {:.2f}us max {:.2f}us",
+                timeline, stats.ticks, stats.timepointsFired, stats.snapshots,
+                stats.ticks ? static_cast< double >( stats.totalNs ) / stats.ticks / 1000.0 : 0.0,
+                static_cast< double >( stats.maxNs ) / 1000.0 );
+
+  if( !writeGolden.empty() )
+  {
+    std::ofstream out( writeGolden );
+    if( !out.is_open() )
+    {
+      Logger::error( "Unable to write golden trace {}", writeGolden );
+      return 1;
+    }
+
+    for( const auto& line : trace )
+      out << line << "\n";
+    Logger::info( "Wrote {} trace lines to {}", trace.size(), writeGolden );
+  }
+
+  if( !golden.empty() )
+    return compareGolden( trace, golden );
+
+  return 0;
+}
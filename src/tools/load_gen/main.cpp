@@ -0,0 +1,679 @@
+#include <Logging/Logger.h>
+#include <Network/Connection.h>
+#include <Network/Hive.h>
+#include <Network/GamePacket.h>
+#include <Network/GamePacketParser.h>
+#include <Network/PacketContainer.h>
+#include <Network/PacketDef/Zone/ClientZoneDef.h>
+#include <Network/PacketDef/Zone/ServerZoneDef.h>
+#include <Random/RandomStream.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace Sapphire;
+using namespace Sapphire::Network::Packets;
+
+// drives synthetic characters against a running world server and reports how long the server takes to answer
+// every scripted request. Every request is followed by a sync in the same segment list, the server handles the
+// in queue of a session in order and answers the sync right after the request itself has been handled.
+//
+// The lobby login is skipped: a world session is opened by the session init segment with the entity id of an
+// existing character, which the world server accepts without a lobby session.
+
+namespace
+{
+  const uint16_t ZoneConnection = 1;
+  const uint16_t ChatConnection = 2;
+
+  // the world server only looks at the first segment list per read, keep requests of one client well apart
+  const uint32_t MinIntervalMs = 100;
+
+  // server timestamps further apart than this belong to different territory ticks
+  const uint64_t TickGapMs = 50;
+
+  using Clock = std::chrono::steady_clock;
+
+  struct FFXIVIpcSetLanguage : FFXIVIpcBasePacket< WorldPackets::Client::SetLanguage >
+  {
+    uint32_t language;
+    uint32_t __padding1;
+  };
+
+  enum class Script : uint8_t
+  {
+    Sync,
+    Move,
+    Chat,
+    Action,
+    ItemMove,
+    Invite,
+  };
+
+  // share of each scripted request in percent, roughly a busy city aetheryte plaza
+  const std::vector< std::pair< Script, uint32_t > > ScriptMix = {
+    { Script::Move, 50 },
+    { Script::Action, 15 },
+    { Script::Sync, 10 },
+    { Script::Chat, 10 },
+    { Script::ItemMove, 10 },
+    { Script::Invite, 5 },
+  };
+
+  struct LoadConfig
+  {
+    std::string host{ "127.0.0.1" };
+    uint32_t port{ 54992 };
+    std::vector< uint32_t > entityIds;
+    uint32_t firstEntityId{ 0 };
+    uint32_t clients{ 10 };
+    uint32_t intervalMs{ 1000 };
+    uint32_t rampMs{ 10000 };
+    uint32_t durationMs{ 60000 };
+    uint32_t actionId{ 3 };
+    uint32_t threads{ 1 };
+    uint32_t seed{ 1 };
+  };
+
+  class Stats
+  {
+  public:
+    void addLatency( uint16_t opcode, double ms )
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+      m_latencies[ opcode ].push_back( ms );
+    }
+
+    void addServerTimestamp( uint64_t timestamp )
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+      m_serverTimestamps.push_back( timestamp );
+    }
+
+    void addFailure()
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+      ++m_failures;
+    }
+
+    void print( uint32_t clients, uint32_t unanswered )
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+
+      Logger::info( "{} clients, {} failed to zone in, {} requests unanswered", clients, m_failures, unanswered );
+      Logger::info( "{:<14} {:>8} {:>9} {:>9} {:>9} {:>9}", "opcode", "count", "p50 ms", "p95 ms", "p99 ms", "max ms" );
+      for( auto& [ opcode, latencies ] : m_latencies )
+      {
+        std::sort( latencies.begin(), latencies.end() );
+        Logger::info( "{:<14} {:>8} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f}", getName( opcode ), latencies.size(),
+                      percentile( latencies, 50 ), percentile( latencies, 95 ), percentile( latencies, 99 ),
+                      percentile( latencies, 100 ) );
+      }
+
+      // replies of one territory tick are flushed together, the gap between bursts is the tick interval and
+      // the length of a burst is the time the tick spent updating sessions
+      std::sort( m_serverTimestamps.begin(), m_serverTimestamps.end() );
+      std::vector< double > intervals;
+      std::vector< double > spans;
+      uint64_t burstBegin = 0;
+      uint64_t burstEnd = 0;
+      for( auto timestamp : m_serverTimestamps )
+      {
+        if( burstBegin == 0 )
+        {
+          burstBegin = burstEnd = timestamp;
+          continue;
+        }
+
+        if( timestamp - burstEnd > TickGapMs )
+        {
+          intervals.push_back( static_cast< double >( timestamp - burstBegin ) );
+          spans.push_back( static_cast< double >( burstEnd - burstBegin ) );
+          burstBegin = timestamp;
+        }
+        burstEnd = timestamp;
+      }
+
+      std::sort( intervals.begin(), intervals.end() );
+      std::sort( spans.begin(), spans.end() );
+      Logger::info( "tick interval  {:>8} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f}", intervals.size(), percentile( intervals, 50 ),
+                    percentile( intervals, 95 ), percentile( intervals, 99 ), percentile( intervals, 100 ) );
+      Logger::info( "tick flush     {:>8} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f}", spans.size(), percentile( spans, 50 ),
+                    percentile( spans, 95 ), percentile( spans, 99 ), percentile( spans, 100 ) );
+    }
+
+  private:
+    static double percentile( const std::vector< double >& values, std::size_t p )
+    {
+      if( values.empty() )
+        return 0.0;
+      return values[ std::min( values.size() - 1, values.size() * p / 100 ) ];
+    }
+
+    static std::string getName( uint16_t opcode )
+    {
+      switch( opcode )
+      {
+        case WorldPackets::Client::Login:
+          return "Login";
+        case WorldPackets::Client::Sync:
+          return "Sync";
+        case WorldPackets::Client::Move:
+          return "Move";
+        case WorldPackets::Client::ChatHandler:
+          return "ChatHandler";
+        case WorldPackets::Client::ActionRequest:
+          return "ActionRequest";
+        case WorldPackets::Client::ClientItemOperation:
+          return "ItemOperation";
+        case WorldPackets::Client::Invite:
+          return "Invite";
+        default:
+          return fmt::format( "{:04X}", opcode );
+      }
+    }
+
+    std::mutex m_mutex;
+    std::map< uint16_t, std::vector< double > > m_latencies;
+    std::vector< uint64_t > m_serverTimestamps;
+    uint32_t m_failures{ 0 };
+  };
+
+  class SyntheticClient;
+
+  class SyntheticConnection : public Network::Connection
+  {
+  public:
+    SyntheticConnection( Network::HivePtr pHive, SyntheticClient& client, uint16_t connectionType ) :
+      Network::Connection( pHive ),
+      m_client( client ),
+      m_connectionType( connectionType )
+    {
+    }
+
+    /*! sends packets as one segment list, the container does not know about connection types */
+    void sendPackets( const std::vector< FFXIVPacketBasePtr >& packets )
+    {
+      PacketContainer container;
+      for( const auto& pPacket : packets )
+        container.addPacket( pPacket );
+
+      std::vector< uint8_t > buffer;
+      container.fillSendBuffer( buffer );
+      reinterpret_cast< FFXIVARR_PACKET_HEADER* >( buffer.data() )->connectionType = m_connectionType;
+      send( buffer );
+    }
+
+    /*! closes the socket on the strand of the connection, pending reads finish with an error */
+    void close()
+    {
+      getStrand().post( [ pSelf = shared_from_this() ]() { pSelf->disconnect(); } );
+    }
+
+  private:
+    void onConnect( const std::string& host, uint16_t port ) override;
+
+    void onRecv( std::vector< uint8_t >& buffer ) override;
+
+    void onError( const asio::error_code& error ) override;
+
+    SyntheticClient& m_client;
+    uint16_t m_connectionType;
+    std::vector< uint8_t > m_packets;
+  };
+
+  class SyntheticClient
+  {
+  public:
+    enum class State : uint8_t
+    {
+      Connecting,
+      ZoneConnected,
+      LoggingIn,
+      InWorld,
+      Failed,
+    };
+
+    SyntheticClient( uint32_t entityId, const LoadConfig& config, Stats& stats ) :
+      m_entityId( entityId ),
+      m_config( config ),
+      m_stats( stats ),
+      m_rng( Common::Random::RandomStream::deriveSeed( config.seed, entityId ) )
+    {
+    }
+
+    void start( Network::HivePtr pHive )
+    {
+      m_pZone = std::make_shared< SyntheticConnection >( pHive, *this, ZoneConnection );
+      m_pChat = std::make_shared< SyntheticConnection >( pHive, *this, ChatConnection );
+      m_connectTime = Clock::now();
+      m_pZone->connect( m_config.host, static_cast< uint16_t >( m_config.port ) );
+    }
+
+    void stop()
+    {
+      if( m_pZone )
+        m_pZone->close();
+      if( m_pChat )
+        m_pChat->close();
+    }
+
+    void setInviteTarget( const SyntheticClient* pTarget )
+    {
+      m_pInviteTarget = pTarget;
+    }
+
+    std::string getName() const
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+      return m_name;
+    }
+
+    uint32_t getUnanswered() const
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+      return static_cast< uint32_t >( m_pending.size() );
+    }
+
+    void onConnected( uint16_t connectionType )
+    {
+      // the session init carries the entity id as a decimal string at offset 4
+      auto pInit = std::make_shared< FFXIVRawPacket >( SEGMENTTYPE_SESSIONINIT, 0x70, 0, 0 );
+      auto id = std::to_string( m_entityId );
+      memcpy( &pInit->data()[ 4 ], id.c_str(), id.size() );
+
+      getConnection( connectionType ).sendPackets( { pInit } );
+    }
+
+    void onPacket( uint16_t connectionType, uint64_t serverTimestamp, const FFXIVARR_PACKET_RAW& packet )
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+
+      if( packet.segHdr.type == 2 )
+      {
+        // session init answered, the chat connection has to join before the first sync of the zone connection
+        if( connectionType == ZoneConnection && m_state == State::Connecting )
+        {
+          m_state = State::ZoneConnected;
+          m_pChat->connect( m_config.host, static_cast< uint16_t >( m_config.port ) );
+        }
+        else if( connectionType == ChatConnection && m_state == State::ZoneConnected )
+        {
+          m_state = State::LoggingIn;
+          m_pZone->sendPackets( { makeZonePacket< WorldPackets::Client::FFXIVIpcLoginHandler >( m_entityId ) } );
+        }
+        return;
+      }
+
+      if( packet.segHdr.type != SEGMENTTYPE_IPC || packet.data.size() < sizeof( FFXIVARR_IPC_HEADER ) )
+        return;
+
+      const auto& ipcHdr = *reinterpret_cast< const FFXIVARR_IPC_HEADER* >( packet.data.data() );
+      const auto* pData = packet.data.data() + sizeof( FFXIVARR_IPC_HEADER );
+      const auto dataSize = packet.data.size() - sizeof( FFXIVARR_IPC_HEADER );
+
+      switch( ipcHdr.type )
+      {
+        case WorldPackets::Server::InitZone:
+        {
+          if( m_state != State::LoggingIn || dataSize < sizeof( WorldPackets::Server::FFXIVIpcInitZone ) )
+            break;
+
+          const auto& initZone = *reinterpret_cast< const WorldPackets::Server::FFXIVIpcInitZone* >( pData );
+          m_pos = { initZone.Pos[ 0 ], initZone.Pos[ 1 ], initZone.Pos[ 2 ] };
+          m_origin = m_pos;
+
+          // finishes loading the zone, the player is spawned afterwards
+          m_pZone->sendPackets( { makeZonePacket< FFXIVIpcSetLanguage >( m_entityId ) } );
+
+          m_state = State::InWorld;
+          m_nextRequest = Clock::now() + std::chrono::milliseconds( m_rng.nextInt( 0, m_config.intervalMs ) );
+          m_stats.addLatency( WorldPackets::Client::Login, elapsedMs( m_connectTime ) );
+          break;
+        }
+        case WorldPackets::Server::PlayerStatus:
+        {
+          if( dataSize < sizeof( WorldPackets::Server::FFXIVIpcPlayerStatus ) )
+            break;
+
+          const auto& status = *reinterpret_cast< const WorldPackets::Server::FFXIVIpcPlayerStatus* >( pData );
+          m_name.assign( reinterpret_cast< const char* >( status.Name ), strnlen( reinterpret_cast< const char* >( status.Name ), sizeof( status.Name ) ) );
+          break;
+        }
+        case WorldPackets::Server::SyncReply:
+        {
+          if( dataSize < sizeof( WorldPackets::Server::FFXIVIpcSync ) )
+            break;
+
+          const auto& sync = *reinterpret_cast< const WorldPackets::Server::FFXIVIpcSync* >( pData );
+          auto it = m_pending.find( sync.clientTimeValue );
+          if( it == m_pending.end() )
+            break;
+
+          m_stats.addLatency( it->second.first, elapsedMs( it->second.second ) );
+          m_stats.addServerTimestamp( serverTimestamp );
+          m_pending.erase( it );
+          break;
+        }
+        default:
+          break;
+      }
+    }
+
+    void onFailed()
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+      if( m_state == State::Failed )
+        return;
+
+      if( m_state != State::InWorld )
+        m_stats.addFailure();
+      m_state = State::Failed;
+    }
+
+    /*! sends the next scripted request once it is due */
+    void update( Clock::time_point now )
+    {
+      std::lock_guard< std::mutex > lock( m_mutex );
+      if( m_state != State::InWorld || now < m_nextRequest )
+        return;
+
+      // up to a quarter of the interval of jitter keeps clients from sending in lock step
+      auto jitter = m_rng.nextInt( 0, m_config.intervalMs / 4 );
+      m_nextRequest = now + std::chrono::milliseconds( m_config.intervalMs - m_config.intervalMs / 8 + jitter );
+
+      std::vector< FFXIVPacketBasePtr > packets;
+      uint16_t opcode = WorldPackets::Client::Sync;
+
+      switch( pickScript() )
+      {
+        case Script::Sync:
+          break;
+        case Script::Move:
+        {
+          auto pMove = makeZonePacket< WorldPackets::Client::FFXIVIpcUpdatePosition >( m_entityId );
+          // wander around the spawn point so the actor stays in range of the others
+          m_pos.x = std::clamp( m_pos.x + m_rng.nextFloat( -2.f, 2.f ), m_origin.x - 20.f, m_origin.x + 20.f );
+          m_pos.z = std::clamp( m_pos.z + m_rng.nextFloat( -2.f, 2.f ), m_origin.z - 20.f, m_origin.z + 20.f );
+          pMove->data().dir = m_rng.nextFloat( -3.14f, 3.14f );
+          pMove->data().pos = m_pos;
+          packets.push_back( pMove );
+          opcode = WorldPackets::Client::Move;
+          break;
+        }
+        case Script::Chat:
+        {
+          auto pChat = makeZonePacket< WorldPackets::Client::FFXIVIpcChatHandler >( m_entityId );
+          pChat->data().chatType = Common::ChatType::Say;
+          auto message = fmt::format( "load_gen {} #{}", m_entityId, m_sequence );
+          strncpy( pChat->data().message, message.c_str(), sizeof( pChat->data().message ) - 1 );
+          packets.push_back( pChat );
+          opcode = WorldPackets::Client::ChatHandler;
+          break;
+        }
+        case Script::Action:
+        {
+          auto pAction = makeZonePacket< WorldPackets::Client::FFXIVIpcActionRequest >( m_entityId );
+          pAction->data().ActionKind = 1;
+          pAction->data().ActionKey = m_config.actionId;
+          pAction->data().RequestId = m_sequence;
+          pAction->data().Target = m_entityId;
+          packets.push_back( pAction );
+          opcode = WorldPackets::Client::ActionRequest;
+          break;
+        }
+        case Script::ItemMove:
+        {
+          // shuffles the first two slots of the first bag back and forth
+          auto pItem = makeZonePacket< WorldPackets::Client::FFXIVIpcClientInventoryItemOperation >( m_entityId );
+          auto& data = pItem->data();
+          data.ContextId = m_sequence;
+          data.OperationType = Common::ITEM_OPERATION_TYPE_MOVEITEM;
+          data.SrcActorId = data.DstActorId = m_entityId;
+          data.SrcContainerIndex = static_cast< int16_t >( m_sequence & 1 );
+          data.DstContainerIndex = static_cast< int16_t >( 1 - ( m_sequence & 1 ) );
+          packets.push_back( pItem );
+          opcode = WorldPackets::Client::ClientItemOperation;
+          break;
+        }
+        case Script::Invite:
+        {
+          if( !m_pInviteTarget )
+            break;
+
+          auto targetName = m_pInviteTarget->getName();
+          if( targetName.empty() )
+            break;
+
+          auto pInvite = makeZonePacket< WorldPackets::Client::FFXIVIpcInvite >( m_entityId );
+          pInvite->data().AuthType = Common::HierarchyType::PCPARTY;
+          strncpy( pInvite->data().TargetName, targetName.c_str(), sizeof( pInvite->data().TargetName ) - 1 );
+          packets.push_back( pInvite );
+          opcode = WorldPackets::Client::Invite;
+          break;
+        }
+      }
+
+      auto pSync = makeZonePacket< WorldPackets::Client::FFXIVIpcPingHandler >( m_entityId );
+      pSync->data().clientTimeValue = m_sequence;
+      packets.push_back( pSync );
+
+      m_pending[ m_sequence++ ] = { opcode, now };
+      m_pZone->sendPackets( packets );
+    }
+
+  private:
+    SyntheticConnection& getConnection( uint16_t connectionType )
+    {
+      return connectionType == ZoneConnection ? *m_pZone : *m_pChat;
+    }
+
+    Script pickScript()
+    {
+      auto roll = m_rng.nextInt( 0, 99 );
+      for( const auto& [ script, share ] : ScriptMix )
+      {
+        if( roll < share )
+          return script;
+        roll -= share;
+      }
+      return Script::Sync;
+    }
+
+    static double elapsedMs( Clock::time_point since )
+    {
+      return std::chrono::duration< double, std::milli >( Clock::now() - since ).count();
+    }
+
+    uint32_t m_entityId;
+    const LoadConfig& m_config;
+    Stats& m_stats;
+    Common::Random::RandomStream m_rng;
+
+    mutable std::mutex m_mutex;
+    State m_state{ State::Connecting };
+    std::string m_name;
+    std::shared_ptr< SyntheticConnection > m_pZone;
+    std::shared_ptr< SyntheticConnection > m_pChat;
+    const SyntheticClient* m_pInviteTarget{ nullptr };
+
+    Common::FFXIVARR_POSITION3 m_pos{};
+    Common::FFXIVARR_POSITION3 m_origin{};
+    Clock::time_point m_connectTime;
+    Clock::time_point m_nextRequest;
+    uint32_t m_sequence{ 1 };
+    std::unordered_map< uint32_t, std::pair< uint16_t, Clock::time_point > > m_pending;
+  };
+
+  void SyntheticConnection::onConnect( const std::string& host, uint16_t port )
+  {
+    m_client.onConnected( m_connectionType );
+  }
+
+  void SyntheticConnection::onRecv( std::vector< uint8_t >& buffer )
+  {
+    m_packets.insert( m_packets.end(), buffer.begin(), buffer.end() );
+
+    // unlike the server side, several segment lists per read are expected here
+    while( true )
+    {
+      FFXIVARR_PACKET_HEADER packetHeader{};
+      auto headerResult = getHeader( m_packets, 0, packetHeader );
+      if( headerResult == Incomplete )
+        return;
+
+      std::vector< FFXIVARR_PACKET_RAW > packetList;
+      auto packetResult = headerResult == Success ?
+                          getPackets( m_packets, sizeof( FFXIVARR_PACKET_HEADER ), packetHeader, packetList ) : Malformed;
+      if( packetResult == Incomplete )
+        return;
+
+      if( packetResult == Malformed )
+      {
+        Logger::error( "Malformed packet from server, dropping connection" );
+        m_client.onFailed();
+        disconnect();
+        return;
+      }
+
+      for( const auto& packet : packetList )
+        m_client.onPacket( m_connectionType, packetHeader.timestamp, packet );
+
+      m_packets.erase( m_packets.begin(), m_packets.begin() + packetHeader.size );
+    }
+  }
+
+  void SyntheticConnection::onError( const asio::error_code& error )
+  {
+    Logger::debug( "Connection error: {}", error.message() );
+    m_client.onFailed();
+  }
+
+  std::vector< uint32_t > parseIds( const std::string& list )
+  {
+    std::vector< uint32_t > ids;
+    std::stringstream stream( list );
+    std::string id;
+    while( std::getline( stream, id, ',' ) )
+    {
+      if( !id.empty() )
+        ids.push_back( static_cast< uint32_t >( std::stoul( id ) ) );
+    }
+    return ids;
+  }
+}
+
+int main( int argc, char* argv[] )
+{
+  Logger::init( "load_gen" );
+
+  LoadConfig config;
+  std::vector< std::string > args( argv + 1, argv + argc );
+  for( size_t i = 0; i + 1 < args.size(); i += 2 )
+  {
+    const auto& val = args[ i + 1 ];
+    if( args[ i ] == "--host" )
+      config.host = val;
+    else if( args[ i ] == "--port" )
+      config.port = static_cast< uint32_t >( std::stoul( val ) );
+    else if( args[ i ] == "--ids" )
+      config.entityIds = parseIds( val );
+    else if( args[ i ] == "--first" )
+      config.firstEntityId = static_cast< uint32_t >( std::stoul( val ) );
+    else if( args[ i ] == "--clients" )
+      config.clients = static_cast< uint32_t >( std::stoul( val ) );
+    else if( args[ i ] == "--interval" )
+      config.intervalMs = std::max( MinIntervalMs, static_cast< uint32_t >( std::stoul( val ) ) );
+    else if( args[ i ] == "--ramp" )
+      config.rampMs = static_cast< uint32_t >( std::stoul( val ) );
+    else if( args[ i ] == "--duration" )
+      config.durationMs = static_cast< uint32_t >( std::stoul( val ) );
+    else if( args[ i ] == "--action" )
+      config.actionId = static_cast< uint32_t >( std::stoul( val ) );
+    else if( args[ i ] == "--threads" )
+      config.threads = std::max( 1u, static_cast< uint32_t >( std::stoul( val ) ) );
+    else if( args[ i ] == "--seed" )
+      config.seed = static_cast< uint32_t >( std::stoul( val ) );
+    else
+    {
+      Logger::error( "usage: load_gen (--ids id,id,.. | --first entityid [--clients n]) [--host ip] [--port n] "
+                     "[--interval ms] [--ramp ms] [--duration ms] [--action id] [--threads n] [--seed n]" );
+      return 1;
+    }
+  }
+
+  // characters have to exist in the world database, consecutive entity ids are the common case for test accounts
+  if( config.entityIds.empty() && config.firstEntityId != 0 )
+  {
+    for( uint32_t i = 0; i < config.clients; ++i )
+      config.entityIds.push_back( config.firstEntityId + i );
+  }
+
+  if( config.entityIds.empty() )
+  {
+    Logger::error( "No characters given, pass --ids or --first" );
+    return 1;
+  }
+
+  Logger::info( "{} synthetic clients against {}:{}, one request every {}ms per client, {}ms ramp up, {}ms run",
+                config.entityIds.size(), config.host, config.port, config.intervalMs, config.rampMs, config.durationMs );
+
+  Stats stats;
+  auto pHive = std::make_shared< Network::Hive >();
+
+  std::vector< std::unique_ptr< SyntheticClient > > clients;
+  for( auto entityId : config.entityIds )
+    clients.push_back( std::make_unique< SyntheticClient >( entityId, config, stats ) );
+
+  // every client invites the next one, which makes the invites cross sessions
+  for( size_t i = 0; i < clients.size(); ++i )
+    clients[ i ]->setInviteTarget( clients.size() > 1 ? clients[ ( i + 1 ) % clients.size() ].get() : nullptr );
+
+  std::vector< std::thread > networkThreads;
+  for( uint32_t i = 0; i < config.threads; ++i )
+    networkThreads.emplace_back( [ pHive ]() { pHive->run(); } );
+
+  auto begin = Clock::now();
+  auto end = begin + std::chrono::milliseconds( config.rampMs + config.durationMs );
+  size_t started = 0;
+
+  while( Clock::now() < end )
+  {
+    auto now = Clock::now();
+
+    // connects are spread over the ramp up so logins do not all land in the same tick
+    auto elapsed = std::chrono::duration_cast< std::chrono::milliseconds >( now - begin ).count();
+    auto due = config.rampMs == 0 ? clients.size() :
+               std::min< size_t >( clients.size(), clients.size() * static_cast< size_t >( elapsed ) / config.rampMs + 1 );
+    for( ; started < due; ++started )
+      clients[ started ]->start( pHive );
+
+    for( auto& pClient : clients )
+      pClient->update( now );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+  }
+
+  uint32_t unanswered = 0;
+  for( auto& pClient : clients )
+  {
+    unanswered += pClient->getUnanswered();
+    pClient->stop();
+  }
+
+  pHive->stop();
+  for( auto& thread : networkThreads )
+    thread.join();
+
+  stats.print( static_cast< uint32_t >( clients.size() ), unanswered );
+  return 0;
+}
@@ -6,12 +6,16 @@
 #include "obj_exporter.h"
 #include "threadpool.h"
 
+#include <algorithm>
+#include <thread>
+
 class ExportMgr
 {
 public:
   ExportMgr( unsigned int maxJobs = 0 )
   {
     m_threadpool.addWorkers( maxJobs );
+    NavmeshExporter::getTilePool().addWorkers( getTileJobs( maxJobs ) );
   }
   ~ExportMgr()
   {
@@ -28,6 +32,14 @@ public:
     m_threadpool.addWorkers( maxJobs );
   }
 
+  // zone jobs wait on their tiles, the tile pool needs at least one worker of its own
+  static unsigned int getTileJobs( unsigned int maxJobs )
+  {
+    if( maxJobs == 0 )
+      maxJobs = std::thread::hardware_concurrency();
+    return std::max( 1u, maxJobs );
+  }
+
   void exportZone(const ExportedZone& zone, ExportFileType exportFileTypes)
   {
     m_threadpool.queue( [zone, exportFileTypes]()
@@ -43,6 +55,7 @@ public:
   void waitForTasks()
   {
     m_threadpool.complete();
+    NavmeshExporter::getTilePool().complete();
   }
 private:
   ThreadPool m_threadpool;
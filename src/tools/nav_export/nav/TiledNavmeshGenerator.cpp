@@ -2,9 +2,12 @@
 
 #include <filesystem>
 #include <cstring>
+#include <future>
 
 #include <recastnavigation/Detour/Include/DetourNavMeshBuilder.h>
 
+#include "../threadpool.h"
+
 namespace fs = std::filesystem;
 
 
@@ -37,9 +40,6 @@ bool TiledNavmeshGenerator::init( const std::string& path )
   if( !fs::exists( path ) )
     throw std::runtime_error( "what" );
 
-  // ignore logging/bullshit/etc
-  m_ctx = new rcContext( false );
-
   printf( "[Navmesh] loading obj: %s\n", path.substr( path.find( "navi" ) ).c_str() );
 
   m_mesh = new rcMeshLoaderObj;
@@ -90,18 +90,169 @@ TiledNavmeshGenerator::~TiledNavmeshGenerator()
   delete m_mesh;
   delete m_chunkyMesh;
 
-  if( m_triareas )
-    delete[] m_triareas;
-  delete m_ctx;
-
-  rcFreeContourSet( m_cset );
-  rcFreeHeightField( m_solid );
-  rcFreeCompactHeightfield(m_chf);
-  rcFreePolyMesh( m_pmesh );
-  rcFreePolyMeshDetail( m_dmesh );
   dtFreeNavMesh( m_navMesh );
 }
 
+TiledNavmeshGenerator::TileBuildContext::~TileBuildContext()
+{
+  rcFreeHeightField( solid );
+  rcFreeCompactHeightfield( chf );
+  rcFreeContourSet( cset );
+  rcFreePolyMesh( pmesh );
+  rcFreePolyMeshDetail( dmesh );
+}
+
+void TiledNavmeshGenerator::setTilePool( ThreadPool* pTilePool )
+{
+  m_pTilePool = pTilePool;
+}
+
+bool TiledNavmeshGenerator::loadPreviousBuild( const std::string& name )
+{
+  m_previousTiles.clear();
+  m_previousHashes.clear();
+
+  auto dir = fs::current_path() / "navi" / name;
+
+  FILE* fp = fopen( ( dir / ( name + ".navhash" ) ).string().c_str(), "rb" );
+  if( !fp )
+    return false;
+
+  NavHashHeader hashHeader{};
+  if( fread( &hashHeader, sizeof( hashHeader ), 1, fp ) != 1 || hashHeader.magic != NAVHASH_MAGIC ||
+      hashHeader.version != NAVHASH_VERSION )
+  {
+    fclose( fp );
+    return false;
+  }
+
+  for( int i = 0; i < hashHeader.numTiles; ++i )
+  {
+    NavHashEntry entry{};
+    if( fread( &entry, sizeof( entry ), 1, fp ) != 1 )
+      break;
+    m_previousHashes[ { entry.tileX, entry.tileY } ] = entry.hash;
+  }
+  fclose( fp );
+
+  fp = fopen( ( dir / ( name + ".nav" ) ).string().c_str(), "rb" );
+  if( !fp )
+  {
+    m_previousHashes.clear();
+    return false;
+  }
+
+  NavMeshSetHeader header{};
+  if( fread( &header, sizeof( header ), 1, fp ) != 1 || header.magic != NAVMESHSET_MAGIC ||
+      header.version != NAVMESHSET_VERSION )
+  {
+    fclose( fp );
+    m_previousHashes.clear();
+    return false;
+  }
+  m_previousParams = header.params;
+
+  for( int i = 0; i < header.numTiles; ++i )
+  {
+    NavMeshTileHeader tileHeader{};
+    if( fread( &tileHeader, sizeof( tileHeader ), 1, fp ) != 1 || tileHeader.dataSize <= 0 )
+      break;
+
+    std::vector< unsigned char > data( tileHeader.dataSize );
+    if( fread( data.data(), data.size(), 1, fp ) != 1 )
+      break;
+
+    auto meshHeader = reinterpret_cast< const dtMeshHeader* >( data.data() );
+    m_previousTiles[ { meshHeader->x, meshHeader->y } ] = std::move( data );
+  }
+  fclose( fp );
+
+  return true;
+}
+
+void TiledNavmeshGenerator::getTileBounds( const int tx, const int ty, float* bmin, float* bmax ) const
+{
+  const float tcs = m_tileSize * m_cellSize;
+
+  bmin[ 0 ] = m_meshBMin[ 0 ] + tx * tcs;
+  bmin[ 1 ] = m_meshBMin[ 1 ];
+  bmin[ 2 ] = m_meshBMin[ 2 ] + ty * tcs;
+
+  bmax[ 0 ] = m_meshBMin[ 0 ] + ( tx + 1 ) * tcs;
+  bmax[ 1 ] = m_meshBMax[ 1 ];
+  bmax[ 2 ] = m_meshBMin[ 2 ] + ( ty + 1 ) * tcs;
+}
+
+// FNV-1a
+inline uint64_t hashBytes( uint64_t hash, const void* data, size_t size )
+{
+  auto bytes = static_cast< const unsigned char* >( data );
+  for( size_t i = 0; i < size; ++i )
+  {
+    hash ^= bytes[ i ];
+    hash *= 0x100000001B3ull;
+  }
+  return hash;
+}
+
+uint64_t TiledNavmeshGenerator::hashTileInput( const int tx, const int ty ) const
+{
+  // bump when the build itself changes in a way the config does not cover
+  const uint32_t buildVersion = 1;
+
+  float bmin[ 3 ];
+  float bmax[ 3 ];
+  getTileBounds( tx, ty, bmin, bmax );
+
+  rcConfig cfg;
+  initConfig( cfg, bmin, bmax );
+
+  uint64_t hash = 0xCBF29CE484222325ull;
+  hash = hashBytes( hash, &buildVersion, sizeof( buildVersion ) );
+  hash = hashBytes( hash, &cfg, sizeof( cfg ) );
+  hash = hashBytes( hash, &m_partitionType, sizeof( m_partitionType ) );
+  hash = hashBytes( hash, &m_agentHeight, sizeof( m_agentHeight ) );
+  hash = hashBytes( hash, &m_agentRadius, sizeof( m_agentRadius ) );
+  hash = hashBytes( hash, &m_agentMaxClimb, sizeof( m_agentMaxClimb ) );
+
+  float tbmin[ 2 ] = { cfg.bmin[ 0 ], cfg.bmin[ 2 ] };
+  float tbmax[ 2 ] = { cfg.bmax[ 0 ], cfg.bmax[ 2 ] };
+
+  int cid[512];
+  const int ncid = rcGetChunksOverlappingRect( m_chunkyMesh, tbmin, tbmax, cid, 512 );
+
+  // only triangles reaching into the tile can change it. Summing the triangle hashes keeps the result
+  // independent of the chunk layout, which moves whenever geometry elsewhere in the zone changes.
+  const float* verts = m_mesh->getVerts();
+  uint64_t triSum = 0;
+  uint32_t triCount = 0;
+  for( int i = 0; i < ncid; ++i )
+  {
+    const rcChunkyTriMeshNode& node = m_chunkyMesh->nodes[ cid[ i ] ];
+    const int* ctris = &m_chunkyMesh->tris[ node.i * 3 ];
+
+    for( int j = 0; j < node.n; ++j )
+    {
+      float tri[ 9 ];
+      for( int k = 0; k < 3; ++k )
+        rcVcopy( &tri[ k * 3 ], &verts[ ctris[ j * 3 + k ] * 3 ] );
+
+      if( rcMax( rcMax( tri[ 0 ], tri[ 3 ] ), tri[ 6 ] ) < tbmin[ 0 ] ||
+          rcMin( rcMin( tri[ 0 ], tri[ 3 ] ), tri[ 6 ] ) > tbmax[ 0 ] ||
+          rcMax( rcMax( tri[ 2 ], tri[ 5 ] ), tri[ 8 ] ) < tbmin[ 1 ] ||
+          rcMin( rcMin( tri[ 2 ], tri[ 5 ] ), tri[ 8 ] ) > tbmax[ 1 ] )
+        continue;
+
+      triSum += hashBytes( 0xCBF29CE484222325ull, tri, sizeof( tri ) );
+      ++triCount;
+    }
+  }
+
+  hash = hashBytes( hash, &triSum, sizeof( triSum ) );
+  hash = hashBytes( hash, &triCount, sizeof( triCount ) );
+  return hash;
+}
+
 void TiledNavmeshGenerator::saveNavmesh( const std::string& name )
 {
   assert( m_navMesh );
@@ -152,6 +303,22 @@ void TiledNavmeshGenerator::saveNavmesh( const std::string& name )
 
   fclose( fp );
 
+  // tile hashes go last, an export cut short keeps the hashes of the previous navmesh
+  fp = fopen( ( dir / ( name + ".navhash" ) ).string().c_str(), "wb" );
+  if( fp )
+  {
+    NavHashHeader hashHeader{ NAVHASH_MAGIC, NAVHASH_VERSION, static_cast< int >( m_tileHashes.size() ) };
+    fwrite( &hashHeader, sizeof( hashHeader ), 1, fp );
+
+    for( const auto& [ key, hash ] : m_tileHashes )
+    {
+      NavHashEntry entry{ key.first, key.second, hash };
+      fwrite( &entry, sizeof( entry ), 1, fp );
+    }
+
+    fclose( fp );
+  }
+
   printf( "[Navmesh] Saved navmesh to '%s.nav'\n", name.c_str() );
 }
 
@@ -188,69 +355,129 @@ bool TiledNavmeshGenerator::buildNavmesh()
   auto ts = static_cast< uint32_t >( m_tileSize );
   const int tw = ( gw + ts - 1 ) / ts;
   const int th = ( gh + ts - 1 ) / ts;
-  const float tcs = m_tileSize * m_cellSize;
 
+  // tile refs and salts of the previous navmesh only line up with the same grid
+  const bool canReuse = memcmp( &params, &m_previousParams, sizeof( params ) ) == 0;
+
+  struct TileResult
+  {
+    uint64_t hash{ 0 };
+    unsigned char* data{ nullptr };
+    int dataSize{ 0 };
+    bool rebuilt{ false };
+  };
+  std::vector< TileResult > tiles( tw * th );
+
+  auto buildTile = [ this, tw, canReuse, &tiles ]( int x, int y )
+  {
+    auto& tile = tiles[ y * tw + x ];
+    tile.hash = hashTileInput( x, y );
+
+    if( canReuse )
+    {
+      auto hashIt = m_previousHashes.find( { x, y } );
+      if( hashIt != m_previousHashes.end() && hashIt->second == tile.hash )
+      {
+        // an unchanged tile without polygons has no data in the previous navmesh either
+        auto tileIt = m_previousTiles.find( { x, y } );
+        if( tileIt != m_previousTiles.end() )
+        {
+          tile.dataSize = static_cast< int >( tileIt->second.size() );
+          tile.data = static_cast< unsigned char* >( dtAlloc( tile.dataSize, DT_ALLOC_PERM ) );
+          memcpy( tile.data, tileIt->second.data(), tile.dataSize );
+        }
+        return;
+      }
+    }
+
+    float bmin[ 3 ];
+    float bmax[ 3 ];
+    getTileBounds( x, y, bmin, bmax );
+
+    TileBuildContext build;
+    tile.data = buildTileMesh( build, x, y, bmin, bmax, tile.dataSize );
+    tile.rebuilt = true;
+  };
+
+  if( m_pTilePool )
+  {
+    std::vector< std::future< void > > pending;
+    pending.reserve( tiles.size() );
+    for( int y = 0; y < th; y++ )
+    {
+      for( int x = 0; x < tw; x++ )
+        pending.push_back( m_pTilePool->queue( [ &buildTile, x, y ]() { buildTile( x, y ); } ) );
+    }
+
+    for( auto& result : pending )
+      result.get();
+  }
+  else
+  {
+    for( int y = 0; y < th; y++ )
+    {
+      for( int x = 0; x < tw; x++ )
+        buildTile( x, y );
+    }
+  }
+
+  // tiles are added in grid order regardless of which worker finished first, the saved navmesh stays the same
+  int rebuiltCount = 0;
+  m_tileHashes.clear();
   for( int y = 0; y < th; y++ )
   {
     for( int x = 0; x < tw; x++ )
     {
-      m_lastBuiltTileBmin[ 0 ] = m_meshBMin[ 0 ] + x * tcs;
-      m_lastBuiltTileBmin[ 1 ] = m_meshBMin[ 1 ];
-      m_lastBuiltTileBmin[ 2 ] = m_meshBMin[ 2 ] + y * tcs;
-
-      m_lastBuiltTileBmax[ 0 ] = m_meshBMin[ 0 ] + ( x + 1 ) * tcs;
-      m_lastBuiltTileBmax[ 1 ] = m_meshBMax[ 1 ];
-      m_lastBuiltTileBmax[ 2 ] = m_meshBMin[ 2 ] + ( y + 1 ) * tcs;
+      auto& tile = tiles[ y * tw + x ];
+      m_tileHashes[ { x, y } ] = tile.hash;
+      if( tile.rebuilt )
+        ++rebuiltCount;
 
-      int dataSize = 0;
+      if( !tile.data )
+        continue;
 
-      unsigned char* data = buildTileMesh( x, y, m_lastBuiltTileBmin, m_lastBuiltTileBmax, dataSize );
-      if( data )
-      {
-        // Remove any previous data (navmesh owns and deletes the data).
-        m_navMesh->removeTile( m_navMesh->getTileRefAt( x, y, 0 ), nullptr, nullptr );
+      // Remove any previous data (navmesh owns and deletes the data).
+      m_navMesh->removeTile( m_navMesh->getTileRefAt( x, y, 0 ), nullptr, nullptr );
 
-        // Let the navmesh own the data.
-        status = m_navMesh->addTile( data, dataSize, DT_TILE_FREE_DATA, 0, nullptr );
+      // Let the navmesh own the data.
+      status = m_navMesh->addTile( tile.data, tile.dataSize, DT_TILE_FREE_DATA, 0, nullptr );
 
-        if( dtStatusFailed( status ) )
-        {
-          dtFree( data );
-        }
+      if( dtStatusFailed( status ) )
+      {
+        dtFree( tile.data );
       }
     }
   }
 
+  printf( "[Navmesh]  - Rebuilt %d of %d tiles\n", rebuiltCount, tw * th );
+
+  m_previousTiles.clear();
+
   return true;
 }
 
 
-unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty, const float* bmin, const float* bmax,
-                                                     int& dataSize )
+void TiledNavmeshGenerator::initConfig( rcConfig& cfg, const float* bmin, const float* bmax ) const
 {
-  const float* verts = m_mesh->getVerts();
-  const int nverts = m_mesh->getVertCount();
-  const int ntris = m_mesh->getTriCount();
-
   // Init build configuration from GUI
-  memset( &m_cfg, 0, sizeof( m_cfg ) );
-  m_cfg.cs = m_cellSize;
-  m_cfg.ch = m_cellHeight;
-  m_cfg.walkableSlopeAngle = m_agentMaxSlope;
-  m_cfg.walkableHeight = static_cast< int >( ceilf( m_agentHeight / m_cfg.ch ) );
-  m_cfg.walkableClimb = static_cast< int >( floorf( m_agentMaxClimb / m_cfg.ch ) );
-  m_cfg.walkableRadius = static_cast< int >( ceilf( m_agentRadius / m_cfg.cs ) );
-  m_cfg.maxEdgeLen = static_cast< int >( m_edgeMaxLen / m_cellSize );
-  m_cfg.maxSimplificationError = m_edgeMaxError;
-  m_cfg.minRegionArea = static_cast< int >( rcSqr( m_regionMinSize ) ); // Note: area = size*size
-  m_cfg.mergeRegionArea = static_cast< int >( rcSqr( m_regionMergeSize ) ); // Note: area = size*size
-  m_cfg.maxVertsPerPoly = static_cast< int >( m_vertsPerPoly );
-  m_cfg.tileSize = static_cast< int >( m_tileSize );
-  m_cfg.borderSize = m_cfg.walkableRadius + 3; // Reserve enough padding.
-  m_cfg.width = m_cfg.tileSize + m_cfg.borderSize * 2;
-  m_cfg.height = m_cfg.tileSize + m_cfg.borderSize * 2;
-  m_cfg.detailSampleDist = m_detailSampleDist < 0.9f ? 0 : m_cellSize * m_detailSampleDist;
-  m_cfg.detailSampleMaxError = m_cellHeight * m_detailSampleMaxError;
+  memset( &cfg, 0, sizeof( cfg ) );
+  cfg.cs = m_cellSize;
+  cfg.ch = m_cellHeight;
+  cfg.walkableSlopeAngle = m_agentMaxSlope;
+  cfg.walkableHeight = static_cast< int >( ceilf( m_agentHeight / cfg.ch ) );
+  cfg.walkableClimb = static_cast< int >( floorf( m_agentMaxClimb / cfg.ch ) );
+  cfg.walkableRadius = static_cast< int >( ceilf( m_agentRadius / cfg.cs ) );
+  cfg.maxEdgeLen = static_cast< int >( m_edgeMaxLen / m_cellSize );
+  cfg.maxSimplificationError = m_edgeMaxError;
+  cfg.minRegionArea = static_cast< int >( rcSqr( m_regionMinSize ) ); // Note: area = size*size
+  cfg.mergeRegionArea = static_cast< int >( rcSqr( m_regionMergeSize ) ); // Note: area = size*size
+  cfg.maxVertsPerPoly = static_cast< int >( m_vertsPerPoly );
+  cfg.tileSize = static_cast< int >( m_tileSize );
+  cfg.borderSize = cfg.walkableRadius + 3; // Reserve enough padding.
+  cfg.width = cfg.tileSize + cfg.borderSize * 2;
+  cfg.height = cfg.tileSize + cfg.borderSize * 2;
+  cfg.detailSampleDist = m_detailSampleDist < 0.9f ? 0 : m_cellSize * m_detailSampleDist;
+  cfg.detailSampleMaxError = m_cellHeight * m_detailSampleMaxError;
 
   // Expand the heighfield bounding box by border size to find the extents of geometry we need to build this tile.
   //
@@ -273,21 +500,31 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
   // For example if you build a navmesh for terrain, and want the navmesh tiles to match the terrain tile size
   // you will need to pass in data from neighbour terrain tiles too! In a simple case, just pass in all the 8 neighbours,
   // or use the bounding box below to only pass in a sliver of each of the 8 neighbours.
-  rcVcopy( m_cfg.bmin, bmin );
-  rcVcopy( m_cfg.bmax, bmax );
-  m_cfg.bmin[ 0 ] -= m_cfg.borderSize * m_cfg.cs;
-  m_cfg.bmin[ 2 ] -= m_cfg.borderSize * m_cfg.cs;
-  m_cfg.bmax[ 0 ] += m_cfg.borderSize * m_cfg.cs;
-  m_cfg.bmax[ 2 ] += m_cfg.borderSize * m_cfg.cs;
+  rcVcopy( cfg.bmin, bmin );
+  rcVcopy( cfg.bmax, bmax );
+  cfg.bmin[ 0 ] -= cfg.borderSize * cfg.cs;
+  cfg.bmin[ 2 ] -= cfg.borderSize * cfg.cs;
+  cfg.bmax[ 0 ] += cfg.borderSize * cfg.cs;
+  cfg.bmax[ 2 ] += cfg.borderSize * cfg.cs;
+}
+
+unsigned char* TiledNavmeshGenerator::buildTileMesh( TileBuildContext& build, const int tx, const int ty,
+                                                     const float* bmin, const float* bmax, int& dataSize ) const
+{
+  const float* verts = m_mesh->getVerts();
+  const int nverts = m_mesh->getVertCount();
 
-  m_solid = rcAllocHeightfield();
-  if( !m_solid )
+  auto& cfg = build.cfg;
+  initConfig( cfg, bmin, bmax );
+
+  build.solid = rcAllocHeightfield();
+  if( !build.solid )
   {
     printf( "[Navmesh] buildNavigation: Out of memory 'solid'.\n" );
     return nullptr;
   }
 
-  if( !rcCreateHeightfield( m_ctx, *m_solid, m_cfg.width, m_cfg.height, m_cfg.bmin, m_cfg.bmax, m_cfg.cs, m_cfg.ch ) )
+  if( !rcCreateHeightfield( &build.ctx, *build.solid, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch ) )
   {
     printf( "[Navmesh] buildNavigation: Could not create solid heightfield.\n" );
     return nullptr;
@@ -296,78 +533,65 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
   // Allocate array that can hold triangle flags.
   // If you have multiple meshes you need to process, allocate
   // and array which can hold the max number of triangles you need to process.
-  m_triareas = new unsigned char[ m_chunkyMesh->maxTrisPerChunk ];
-  if( !m_triareas )
-  {
-    printf( "[Navmesh] buildNavigation: Out of memory 'm_triareas' (%d).\n", m_chunkyMesh->maxTrisPerChunk );
-    return nullptr;
-  }
+  build.triareas.resize( m_chunkyMesh->maxTrisPerChunk );
 
   float tbmin[ 2 ];
   float tbmax[ 2 ];
-  tbmin[ 0 ] = m_cfg.bmin[ 0 ];
-  tbmin[ 1 ] = m_cfg.bmin[ 2 ];
-  tbmax[ 0 ] = m_cfg.bmax[ 0 ];
-  tbmax[ 1 ] = m_cfg.bmax[ 2 ];
+  tbmin[ 0 ] = cfg.bmin[ 0 ];
+  tbmin[ 1 ] = cfg.bmin[ 2 ];
+  tbmax[ 0 ] = cfg.bmax[ 0 ];
+  tbmax[ 1 ] = cfg.bmax[ 2 ];
 
   int cid[512];// TODO: Make grow when returning too many items.
   const int ncid = rcGetChunksOverlappingRect( m_chunkyMesh, tbmin, tbmax, cid, 512 );
 
   if( !ncid )
   {
-    rcFreeHeightField( m_solid );
-    m_solid = nullptr;
-    delete[] m_triareas;
-    m_triareas = nullptr;
+    rcFreeHeightField( build.solid );
+    build.solid = nullptr;
     return nullptr;
   }
 
-  m_tileTriCount = 0;
-
   for( int i = 0; i < ncid; ++i )
   {
     const rcChunkyTriMeshNode& node = m_chunkyMesh->nodes[ cid[ i ] ];
     const int* ctris = &m_chunkyMesh->tris[ node.i * 3 ];
     const int nctris = node.n;
 
-    m_tileTriCount += nctris;
-
-    memset( m_triareas, 0, nctris * sizeof( unsigned char ) );
-    rcMarkWalkableTriangles( m_ctx, m_cfg.walkableSlopeAngle, verts, nverts, ctris, nctris, m_triareas );
-    if( !rcRasterizeTriangles( m_ctx, verts, nverts, ctris, m_triareas, nctris, *m_solid, m_cfg.walkableClimb ) )
+    memset( build.triareas.data(), 0, nctris * sizeof( unsigned char ) );
+    rcMarkWalkableTriangles( &build.ctx, cfg.walkableSlopeAngle, verts, nverts, ctris, nctris, build.triareas.data() );
+    if( !rcRasterizeTriangles( &build.ctx, verts, nverts, ctris, build.triareas.data(), nctris, *build.solid,
+                               cfg.walkableClimb ) )
       return nullptr;
   }
 
-  delete[] m_triareas;
-  m_triareas = nullptr;
-
   // Once all geometry is rasterized, we do initial pass of filtering to
   // remove unwanted overhangs caused by the conservative rasterization
   // as well as filter spans where the character cannot possibly stand.
-  rcFilterLowHangingWalkableObstacles( m_ctx, m_cfg.walkableClimb, *m_solid );
-  rcFilterLedgeSpans( m_ctx, m_cfg.walkableHeight, m_cfg.walkableClimb, *m_solid );
-  rcFilterWalkableLowHeightSpans( m_ctx, m_cfg.walkableHeight, *m_solid );
+  rcFilterLowHangingWalkableObstacles( &build.ctx, cfg.walkableClimb, *build.solid );
+  rcFilterLedgeSpans( &build.ctx, cfg.walkableHeight, cfg.walkableClimb, *build.solid );
+  rcFilterWalkableLowHeightSpans( &build.ctx, cfg.walkableHeight, *build.solid );
 
   // Compact the heightfield so that it is faster to handle from now on.
   // This will result more cache coherent data as well as the neighbours
   // between walkable cells will be calculated.
-  m_chf = rcAllocCompactHeightfield();
-  if( !m_chf )
+  build.chf = rcAllocCompactHeightfield();
+  if( !build.chf )
   {
     printf( "[Navmesh] buildNavigation: Out of memory 'chf'." );
     return nullptr;
   }
-  if( !rcBuildCompactHeightfield( m_ctx, m_cfg.walkableHeight, m_cfg.walkableClimb, *m_solid, *m_chf ) )
+  if( !rcBuildCompactHeightfield( &build.ctx, cfg.walkableHeight, cfg.walkableClimb, *build.solid, *build.chf ) )
   {
     printf( "[Navmesh] buildNavigation: Could not build compact data." );
     return nullptr;
   }
 
-  rcFreeHeightField( m_solid );
-  m_solid = nullptr;
+  rcFreeHeightField( build.solid );
+  build.solid = nullptr;
 
   // Erode the walkable area by agent radius.
-  if( !rcErodeWalkableArea( m_ctx, m_cfg.walkableRadius, *m_chf ) )
+  if( !rcErodeWalkableArea( &build.ctx, cfg.walkableRadius, *build.chf ) )
   {
     printf( "[Navmesh] buildNavigation: Could not erode." );
     return nullptr;
@@ -376,7 +600,7 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
   // (Optional) Mark areas.
 //  const ConvexVolume* vols = m_mesh->getConvexVolumes();
 //  for (int i  = 0; i < m_geom->getConvexVolumeCount(); ++i)
-//    rcMarkConvexPolyArea(m_ctx, vols[i].verts, vols[i].nverts, vols[i].hmin, vols[i].hmax, (unsigned char)vols[i].area, *m_chf);
+//    rcMarkConvexPolyArea(&build.ctx, vols[i].verts, vols[i].nverts, vols[i].hmin, vols[i].hmax, (unsigned char)vols[i].area, *build.chf);
 
   // Partition the heightfield so that we can use simple algorithm later to triangulate the walkable areas.
   // There are 3 martitioning methods, each with some pros and cons:
@@ -407,14 +631,14 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
   if( m_partitionType == SAMPLE_PARTITION_WATERSHED )
   {
     // Prepare for region partitioning, by calculating distance field along the walkable surface.
-    if( !rcBuildDistanceField( m_ctx, *m_chf ) )
+    if( !rcBuildDistanceField( &build.ctx, *build.chf ) )
     {
       printf( "[Navmesh] buildNavigation: Could not build distance field." );
       return nullptr;
     }
 
     // Partition the walkable surface into simple regions without holes.
-    if( !rcBuildRegions( m_ctx, *m_chf, m_cfg.borderSize, m_cfg.minRegionArea, m_cfg.mergeRegionArea ) )
+    if( !rcBuildRegions( &build.ctx, *build.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea ) )
     {
       printf( "[Navmesh] buildNavigation: Could not build watershed regions." );
       return nullptr;
@@ -424,7 +648,7 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
   {
     // Partition the walkable surface into simple regions without holes.
     // Monotone partitioning does not need distancefield.
-    if( !rcBuildRegionsMonotone( m_ctx, *m_chf, m_cfg.borderSize, m_cfg.minRegionArea, m_cfg.mergeRegionArea ) )
+    if( !rcBuildRegionsMonotone( &build.ctx, *build.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea ) )
     {
       printf( "[Navmesh] buildNavigation: Could not build monotone regions." );
       return nullptr;
@@ -433,7 +657,7 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
   else // SAMPLE_PARTITION_LAYERS
   {
     // Partition the walkable surface into simple regions without holes.
-    if( !rcBuildLayerRegions( m_ctx, *m_chf, m_cfg.borderSize, m_cfg.minRegionArea ) )
+    if( !rcBuildLayerRegions( &build.ctx, *build.chf, cfg.borderSize, cfg.minRegionArea ) )
     {
       printf( "[Navmesh] buildNavigation: Could not build layer regions." );
       return nullptr;
@@ -441,108 +665,108 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
   }
 
   // Create contours.
-  m_cset = rcAllocContourSet();
-  if( !m_cset )
+  build.cset = rcAllocContourSet();
+  if( !build.cset )
   {
     printf( "[Navmesh] buildNavigation: Out of memory 'cset'." );
     return nullptr;
   }
-  if( !rcBuildContours( m_ctx, *m_chf, m_cfg.maxSimplificationError, m_cfg.maxEdgeLen, *m_cset ) )
+  if( !rcBuildContours( &build.ctx, *build.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *build.cset ) )
   {
     printf( "[Navmesh] buildNavigation: Could not create contours." );
     return nullptr;
   }
 
-  if( m_cset->nconts == 0 )
+  if( build.cset->nconts == 0 )
   {
-    rcFreeCompactHeightfield( m_chf );
-    rcFreeContourSet( m_cset );
-    m_chf = nullptr;
-    m_cset = nullptr;
+    rcFreeCompactHeightfield( build.chf );
+    rcFreeContourSet( build.cset );
+    build.chf = nullptr;
+    build.cset = nullptr;
     return nullptr;
   }
 
   // Build polygon navmesh from the contours.
-  m_pmesh = rcAllocPolyMesh();
-  if( !m_pmesh )
+  build.pmesh = rcAllocPolyMesh();
+  if( !build.pmesh )
   {
     printf( "[Navmesh] buildNavigation: Out of memory 'pmesh'." );
     return nullptr;
   }
-  if( !rcBuildPolyMesh( m_ctx, *m_cset, m_cfg.maxVertsPerPoly, *m_pmesh ) )
+  if( !rcBuildPolyMesh( &build.ctx, *build.cset, cfg.maxVertsPerPoly, *build.pmesh ) )
   {
     printf( "[Navmesh] buildNavigation: Could not triangulate contours." );
     return nullptr;
   }
 
   // Build detail mesh.
-  m_dmesh = rcAllocPolyMeshDetail();
-  if( !m_dmesh )
+  build.dmesh = rcAllocPolyMeshDetail();
+  if( !build.dmesh )
   {
     printf( "[Navmesh] buildNavigation: Out of memory 'dmesh'." );
     return nullptr;
   }
 
-  if( !rcBuildPolyMeshDetail( m_ctx, *m_pmesh, *m_chf,
-                              m_cfg.detailSampleDist, m_cfg.detailSampleMaxError,
-                              *m_dmesh ) )
+  if( !rcBuildPolyMeshDetail( &build.ctx, *build.pmesh, *build.chf,
+                              cfg.detailSampleDist, cfg.detailSampleMaxError,
+                              *build.dmesh ) )
   {
     printf( "[Navmesh] buildNavigation: Could build polymesh detail." );
     return nullptr;
   }
 
-  rcFreeCompactHeightfield( m_chf );
-  rcFreeContourSet( m_cset );
-  m_chf = nullptr;
-  m_cset = nullptr;
+  rcFreeCompactHeightfield( build.chf );
+  rcFreeContourSet( build.cset );
+  build.chf = nullptr;
+  build.cset = nullptr;
 
   unsigned char* navData = 0;
   int navDataSize = 0;
-  if( m_cfg.maxVertsPerPoly <= DT_VERTS_PER_POLYGON )
+  if( cfg.maxVertsPerPoly <= DT_VERTS_PER_POLYGON )
   {
-    if( m_pmesh->nverts >= 0xffff )
+    if( build.pmesh->nverts >= 0xffff )
     {
       // The vertex indices are ushorts, and cannot point to more than 0xffff vertices.
-      printf( "[Navmesh] Too many vertices per tile %d (max: %d).", m_pmesh->nverts, 0xffff );
+      printf( "[Navmesh] Too many vertices per tile %d (max: %d).", build.pmesh->nverts, 0xffff );
       return nullptr;
     }
 
     // Update poly flags from areas.
-    for( int i = 0; i < m_pmesh->npolys; ++i )
+    for( int i = 0; i < build.pmesh->npolys; ++i )
     {
-      if( m_pmesh->areas[ i ] == RC_WALKABLE_AREA )
-        m_pmesh->areas[ i ] = SAMPLE_POLYAREA_GROUND;
+      if( build.pmesh->areas[ i ] == RC_WALKABLE_AREA )
+        build.pmesh->areas[ i ] = SAMPLE_POLYAREA_GROUND;
 
-      if( m_pmesh->areas[ i ] == SAMPLE_POLYAREA_GROUND ||
-          m_pmesh->areas[ i ] == SAMPLE_POLYAREA_GRASS ||
-          m_pmesh->areas[ i ] == SAMPLE_POLYAREA_ROAD )
+      if( build.pmesh->areas[ i ] == SAMPLE_POLYAREA_GROUND ||
+          build.pmesh->areas[ i ] == SAMPLE_POLYAREA_GRASS ||
+          build.pmesh->areas[ i ] == SAMPLE_POLYAREA_ROAD )
       {
-        m_pmesh->flags[ i ] = SAMPLE_POLYFLAGS_WALK;
+        build.pmesh->flags[ i ] = SAMPLE_POLYFLAGS_WALK;
       }
-      else if( m_pmesh->areas[ i ] == SAMPLE_POLYAREA_WATER )
+      else if( build.pmesh->areas[ i ] == SAMPLE_POLYAREA_WATER )
       {
-        m_pmesh->flags[ i ] = SAMPLE_POLYFLAGS_SWIM;
+        build.pmesh->flags[ i ] = SAMPLE_POLYFLAGS_SWIM;
       }
-      else if( m_pmesh->areas[ i ] == SAMPLE_POLYAREA_DOOR )
+      else if( build.pmesh->areas[ i ] == SAMPLE_POLYAREA_DOOR )
       {
-        m_pmesh->flags[ i ] = SAMPLE_POLYFLAGS_WALK | SAMPLE_POLYFLAGS_DOOR;
+        build.pmesh->flags[ i ] = SAMPLE_POLYFLAGS_WALK | SAMPLE_POLYFLAGS_DOOR;
       }
     }
 
     dtNavMeshCreateParams params;
     memset( &params, 0, sizeof( params ) );
-    params.verts = m_pmesh->verts;
-    params.vertCount = m_pmesh->nverts;
-    params.polys = m_pmesh->polys;
-    params.polyAreas = m_pmesh->areas;
-    params.polyFlags = m_pmesh->flags;
-    params.polyCount = m_pmesh->npolys;
-    params.nvp = m_pmesh->nvp;
-    params.detailMeshes = m_dmesh->meshes;
-    params.detailVerts = m_dmesh->verts;
-    params.detailVertsCount = m_dmesh->nverts;
-    params.detailTris = m_dmesh->tris;
-    params.detailTriCount = m_dmesh->ntris;
+    params.verts = build.pmesh->verts;
+    params.vertCount = build.pmesh->nverts;
+    params.polys = build.pmesh->polys;
+    params.polyAreas = build.pmesh->areas;
+    params.polyFlags = build.pmesh->flags;
+    params.polyCount = build.pmesh->npolys;
+    params.nvp = build.pmesh->nvp;
+    params.detailMeshes = build.dmesh->meshes;
+    params.detailVerts = build.dmesh->verts;
+    params.detailVertsCount = build.dmesh->nverts;
+    params.detailTris = build.dmesh->tris;
+    params.detailTriCount = build.dmesh->ntris;
 
     params.offMeshConVerts = nullptr;
     params.offMeshConRad = nullptr;
@@ -558,10 +782,10 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
     params.tileX = tx;
     params.tileY = ty;
     params.tileLayer = 0;
-    rcVcopy( params.bmin, m_pmesh->bmin );
-    rcVcopy( params.bmax, m_pmesh->bmax );
-    params.cs = m_cfg.cs;
-    params.ch = m_cfg.ch;
+    rcVcopy( params.bmin, build.pmesh->bmin );
+    rcVcopy( params.bmax, build.pmesh->bmax );
+    params.cs = cfg.cs;
+    params.ch = cfg.ch;
     params.buildBvTree = true;
 
     if( !dtCreateNavMeshData( &params, &navData, &navDataSize ) )
@@ -571,10 +795,10 @@ unsigned char* TiledNavmeshGenerator::buildTileMesh( const int tx, const int ty,
     }
   }
 
-  rcFreePolyMesh( m_pmesh );
-  rcFreePolyMeshDetail( m_dmesh );
-  m_pmesh = nullptr;
-  m_dmesh = nullptr;
+  rcFreePolyMesh( build.pmesh );
+  rcFreePolyMeshDetail( build.dmesh );
+  build.pmesh = nullptr;
+  build.dmesh = nullptr;
 
   dataSize = navDataSize;
   return navData;
@@ -4,6 +4,10 @@
 #include <string>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
 
 #include "ext/MeshLoaderObj.h"
 #include "ext/ChunkyTriMesh.h"
@@ -12,6 +16,8 @@
 #include "recastnavigation/Detour/Include/DetourNavMeshQuery.h"
 #include "recastnavigation/Recast/Include/Recast.h"
 
+class ThreadPool;
+
 class TiledNavmeshGenerator
 {
 public:
@@ -58,45 +64,85 @@ public:
     int dataSize;
   };
 
+  // <name>.navhash next to the .nav, the input hash of every tile of the last build
+  static const int NAVHASH_MAGIC = 'N'<<24 | 'H'<<16 | 'S'<<8 | 'H'; //'NHSH';
+  static const int NAVHASH_VERSION = 1;
+
+  struct NavHashHeader
+  {
+    int magic;
+    int version;
+    int numTiles;
+  };
+
+  struct NavHashEntry
+  {
+    int tileX;
+    int tileY;
+    uint64_t hash;
+  };
+
+  // scratch data of a single tile build, every worker builds with its own
+  struct TileBuildContext
+  {
+    rcContext ctx{ false };
+    rcConfig cfg{};
+    rcHeightfield* solid{ nullptr };
+    rcCompactHeightfield* chf{ nullptr };
+    rcContourSet* cset{ nullptr };
+    rcPolyMesh* pmesh{ nullptr };
+    rcPolyMeshDetail* dmesh{ nullptr };
+    std::vector< unsigned char > triareas;
+
+    ~TileBuildContext();
+  };
+
 
   TiledNavmeshGenerator() = default;
   ~TiledNavmeshGenerator();
 
   bool init( const std::string& path );
-  unsigned char* buildTileMesh( const int tx, const int ty, const float* bmin, const float* bmax, int& dataSize );
+
+  // tiles are built on this pool when set, otherwise one after another on the calling thread
+  void setTilePool( ThreadPool* pTilePool );
+
+  // reads the navmesh and tile hashes of the last export, unchanged tiles are taken from it instead of rebuilt
+  bool loadPreviousBuild( const std::string& name );
+
+  unsigned char* buildTileMesh( TileBuildContext& build, const int tx, const int ty, const float* bmin,
+                                const float* bmax, int& dataSize ) const;
   bool buildNavmesh();
   void saveNavmesh( const std::string& name );
 
 private:
-  rcConfig m_cfg;
+  using TileKey = std::pair< int, int >;
+
+  void initConfig( rcConfig& cfg, const float* bmin, const float* bmax ) const;
+  void getTileBounds( const int tx, const int ty, float* bmin, float* bmax ) const;
+  uint64_t hashTileInput( const int tx, const int ty ) const;
+
+  rcMeshLoaderObj* m_mesh = nullptr;
+  rcChunkyTriMesh* m_chunkyMesh = nullptr;
 
-  rcMeshLoaderObj* m_mesh;
-  rcChunkyTriMesh* m_chunkyMesh;
+  dtNavMesh* m_navMesh = nullptr;
 
-  rcContext* m_ctx;
-  dtNavMesh* m_navMesh;
-  rcHeightfield* m_solid;
-  rcContourSet* m_cset;
-  rcPolyMesh* m_pmesh;
-  rcPolyMeshDetail* m_dmesh;
+  ThreadPool* m_pTilePool = nullptr;
 
-  rcCompactHeightfield* m_chf;
+  // tile data and input hashes of the last export
+  dtNavMeshParams m_previousParams{};
+  std::map< TileKey, std::vector< unsigned char > > m_previousTiles;
+  std::map< TileKey, uint64_t > m_previousHashes;
 
-  unsigned char* m_triareas;
+  std::map< TileKey, uint64_t > m_tileHashes;
 
   int m_maxTiles = 0;
   int m_maxPolysPerTile = 0;
 
-  int m_tileTriCount = 0;
-
   int m_partitionType = SamplePartitionType::SAMPLE_PARTITION_WATERSHED;
 
   float m_meshBMin[ 3 ];
   float m_meshBMax[ 3 ];
 
-  float m_lastBuiltTileBmin[ 3 ];
-  float m_lastBuiltTileBmax[ 3 ];
-
   // options
   float m_tileSize = 160.f;
   float m_cellSize = 0.2f;
@@ -11,6 +11,7 @@
 #include "exporter.h"
 #include "obj_exporter.h"
 #include "nav/TiledNavmeshGenerator.h"
+#include "threadpool.h"
 
 #include <filesystem>
 
@@ -19,6 +20,13 @@ namespace fs = std::filesystem;
 class NavmeshExporter
 {
 public:
+  // tiles of every zone are built here, zone jobs only wait for them and never hold a tile worker
+  static ThreadPool& getTilePool()
+  {
+    static ThreadPool tilePool;
+    return tilePool;
+  }
+
   static void exportZone( const ExportedZone& zone )
   {
     auto start = std::chrono::high_resolution_clock::now();
@@ -32,6 +40,7 @@ public:
       ObjExporter::exportZone( zone );
 
     TiledNavmeshGenerator gen;
+    gen.setTilePool( &getTilePool() );
 
     if( !gen.init( objPath.string() ) )
     {
@@ -39,6 +48,9 @@ public:
       return;
     }
 
+    // tiles whose geometry and settings did not change since the last export are copied from it
+    gen.loadPreviousBuild( zone.name );
+
     if( !gen.buildNavmesh() )
     {
       printf( "[Navmesh] Failed to build navmesh for '%s'\n", zone.name.c_str() );
@@ -0,0 +1,168 @@
+#include <Logging/Logger.h>
+#include <Util/LockedQueue.h>
+#include <Util/MpscQueue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Sapphire;
+
+// producers push packets into one session queue while the consumer drains it once per world tick,
+// compares the mutex guarded queue against the lock-free ring used by GameConnection
+
+namespace
+{
+  // stands in for a queued packet, both queues hold shared pointers
+  struct Packet
+  {
+    uint32_t producer{ 0 };
+    uint32_t sequence{ 0 };
+  };
+
+  using PacketPtr = std::shared_ptr< Packet >;
+
+  struct Result
+  {
+    uint64_t packets{ 0 };
+    uint64_t drains{ 0 };
+    uint64_t orderErrors{ 0 };
+    double elapsedMs{ 0.0 };
+  };
+
+  struct BenchConfig
+  {
+    uint32_t producers{ 4 };
+    uint32_t packets{ 1000000 };
+    uint32_t capacity{ 1024 };
+    uint32_t tickUs{ 50 };
+  };
+
+  // the world tick pops one packet at a time until the queue reports empty
+  void drainLocked( Common::Util::LockedQueue< PacketPtr >& queue, std::vector< PacketPtr >& out )
+  {
+    while( queue.size() )
+    {
+      if( auto pPacket = queue.pop() )
+        out.push_back( std::move( pPacket ) );
+    }
+  }
+
+  void drainMpsc( Common::Util::MpscQueue< PacketPtr >& queue, std::vector< PacketPtr >& out )
+  {
+    queue.drain( out );
+  }
+
+  template< class Queue, class Drain >
+  Result run( const BenchConfig& config, Queue& queue, Drain drain )
+  {
+    Result result;
+    std::atomic< uint32_t > running{ config.producers };
+    std::vector< uint32_t > lastSequence( config.producers, 0 );
+    std::vector< PacketPtr > drained;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    std::vector< std::thread > producers;
+    for( uint32_t producer = 0; producer < config.producers; ++producer )
+    {
+      producers.emplace_back( [ &, producer ]()
+      {
+        auto count = config.packets / config.producers;
+        for( uint32_t sequence = 1; sequence <= count; ++sequence )
+          queue.push( std::make_shared< Packet >( Packet{ producer, sequence } ) );
+        --running;
+      } );
+    }
+
+    while( true )
+    {
+      bool done = running == 0;
+
+      drain( queue, drained );
+      ++result.drains;
+
+      for( const auto& pPacket : drained )
+      {
+        if( pPacket->sequence != lastSequence[ pPacket->producer ] + 1 )
+          ++result.orderErrors;
+        lastSequence[ pPacket->producer ] = pPacket->sequence;
+      }
+      result.packets += drained.size();
+      drained.clear();
+
+      if( done )
+        break;
+
+      if( config.tickUs > 0 )
+        std::this_thread::sleep_for( std::chrono::microseconds( config.tickUs ) );
+    }
+
+    for( auto& thread : producers )
+      thread.join();
+
+    // the final drain ran after every producer finished
+    drain( queue, drained );
+    result.packets += drained.size();
+
+    result.elapsedMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - begin ).count();
+    return result;
+  }
+
+  void printResult( const std::string& name, const Result& result )
+  {
+    Logger::info( "{:<7} {:>9.2f}ms total, {:>7.1f}ns per packet, {} packets in {} drains, {} out of order",
+                  name, result.elapsedMs, result.elapsedMs * 1000000.0 / std::max< uint64_t >( 1, result.packets ),
+                  result.packets, result.drains, result.orderErrors );
+  }
+}
+
+int main( int argc, char* argv[] )
+{
+  Logger::init( "queue_bench" );
+
+  BenchConfig config;
+  std::vector< std::string > args( argv + 1, argv + argc );
+  for( size_t i = 0; i + 1 < args.size(); i += 2 )
+  {
+    auto val = static_cast< uint32_t >( std::stoul( args[ i + 1 ] ) );
+    if( args[ i ] == "--producers" )
+      config.producers = std::max( 1u, val );
+    else if( args[ i ] == "--packets" )
+      config.packets = val;
+    else if( args[ i ] == "--capacity" )
+      config.capacity = std::max( 2u, val );
+    else if( args[ i ] == "--tick" )
+      config.tickUs = val;
+    else
+    {
+      Logger::error( "usage: queue_bench [--producers n] [--packets n] [--capacity n] [--tick us]" );
+      return 1;
+    }
+  }
+
+  Logger::info( "{} producers pushing {} packets, consumer drains every {}us, ring capacity {}",
+                config.producers, config.packets, config.tickUs, config.capacity );
+
+  Common::Util::LockedQueue< PacketPtr > lockedQueue;
+  auto locked = run( config, lockedQueue, drainLocked );
+
+  Common::Util::MpscQueue< PacketPtr > mpscQueue( config.capacity );
+  auto mpsc = run( config, mpscQueue, drainMpsc );
+
+  printResult( "locked", locked );
+  printResult( "mpsc", mpsc );
+
+  auto expected = static_cast< uint64_t >( config.packets / config.producers ) * config.producers;
+  if( locked.packets != expected || mpsc.packets != expected || mpsc.orderErrors != 0 || locked.orderErrors != 0 )
+  {
+    Logger::error( "Packets were lost or reordered" );
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include <Common.h>
+#include <Exd/ExdData.h>
+#include <Random/RandomStream.h>
+
+#include <Action/ActionLut.h>
+#include <Actor/BNpc.h>
+#include <Math/CalcStats.h>
+#include <StatusEffect/StatusEffect.h>
+#include <Territory/Territory.h>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "Bench.h"
+
+using namespace Sapphire;
+
+// territory, chara and battle formula hot paths, run on the server classes linked from world_core.
+// The chara cases build bnpcs and status effects from the sheet rows of Bench::getExdData.
+
+namespace
+{
+  const uint32_t TerritoryActors = 500;
+  // bnpcs share a town sized area, about four cells wide
+  const float SpawnArea = 320.f;
+  const uint32_t FirstActorId = 0x40000000;
+
+  // the modifiers status effects of the current content use
+  const std::array< Common::ParamModifier, 8 > EffectModifiers = {
+    Common::ParamModifier::Strength, Common::ParamModifier::CriticalHit, Common::ParamModifier::EnmityReduction,
+    Common::ParamModifier::StrengthPercent, Common::ParamModifier::CriticalHitPercent,
+    Common::ParamModifier::DamageDealtPercent, Common::ParamModifier::DamageTakenPercent,
+    Common::ParamModifier::ParryPercent };
+
+  // a raid member under party buffs, food, debuffs and dots, close to the 30 status slots
+  Entity::BNpcPtr makeBuffedBNpc( const Bench::Fixture& fixture, uint32_t effects )
+  {
+    auto pExdData = Bench::getExdData( fixture );
+    if( !pExdData )
+      return nullptr;
+
+    Bench::initWorldServices( fixture );
+
+    auto statusIds = pExdData->getIdList< Excel::Status >();
+    auto pTerritory = std::make_shared< Territory >();
+    auto pBNpc = Bench::createBNpc( *pTerritory, FirstActorId, {} );
+    if( !pBNpc || statusIds.empty() )
+      return nullptr;
+
+    Common::Random::RandomStream rng( fixture.seed );
+    pBNpc->setStatValue( Common::BaseParam::AttackPower, rng.nextInt( 1000, 1500 ) );
+    pBNpc->setStatValue( Common::BaseParam::Determination, rng.nextInt( 400, 900 ) );
+    pBNpc->setStatValue( Common::BaseParam::CriticalHit, rng.nextInt( 400, 1200 ) );
+
+    for( uint32_t slot = 0; slot < effects; ++slot )
+    {
+      std::vector< World::Action::StatusModifier > modifiers;
+      auto modifierCount = rng.nextInt( 1, 3 );
+      for( uint32_t i = 0; i < modifierCount; ++i )
+      {
+        auto mod = EffectModifiers[ rng.nextInt( 0, EffectModifiers.size() - 1 ) ];
+        modifiers.push_back( { mod, static_cast< int32_t >( rng.nextInt( 1, 20 ) ) } );
+      }
+
+      auto statusId = statusIds[ rng.nextInt( 0, static_cast< uint32_t >( statusIds.size() - 1 ) ) ];
+      pBNpc->addStatusEffect( std::make_shared< StatusEffect::StatusEffect >( statusId, pBNpc, pBNpc, 0, modifiers, 0, 3000 ) );
+    }
+
+    return pBNpc;
+  }
+}
+
+// one actor moving per pass, every actor of the territory moves in turn
+SAPPHIRE_BENCH_CASE( territoryInRange, "territory/updateInRangeSet/500" )
+{
+  Bench::initWorldServices( fixture );
+
+  auto pTerritory = std::make_shared< Territory >();
+  auto pRng = std::make_shared< Common::Random::RandomStream >( fixture.seed );
+  auto pActors = std::make_shared< std::vector< Entity::BNpcPtr > >();
+
+  // players are left out, their in range changes queue spawn packets for a session
+  for( uint32_t i = 0; i < TerritoryActors; ++i )
+  {
+    auto pBNpc = std::make_shared< Entity::BNpc >();
+    pBNpc->setId( FirstActorId + i );
+    pBNpc->setPos( { pRng->nextFloat( -SpawnArea / 2, SpawnArea / 2 ), 0.f,
+                     pRng->nextFloat( -SpawnArea / 2, SpawnArea / 2 ) }, false );
+    pActors->push_back( pBNpc );
+  }
+
+  // fills the in range sets, the passes measure the steady state
+  for( const auto& pActor : *pActors )
+    pTerritory->updateActorPosition( *pActor );
+
+  return [ pTerritory, pRng, pActors ]( uint64_t iterations )
+  {
+    uint64_t inRange = 0;
+    for( uint64_t i = 0; i < iterations; ++i )
+    {
+      auto& actor = *( *pActors )[ i % pActors->size() ];
+
+      // a few yalms per update, bounced back into the area
+      auto pos = actor.getPos();
+      pos.x += pRng->nextFloat( -3.f, 3.f );
+      pos.z += pRng->nextFloat( -3.f, 3.f );
+      if( std::abs( pos.x ) > SpawnArea / 2 )
+        pos.x = -pos.x * 0.9f;
+      if( std::abs( pos.z ) > SpawnArea / 2 )
+        pos.z = -pos.z * 0.9f;
+
+      actor.setPos( pos, false );
+      pTerritory->updateActorPosition( actor );
+      inRange += actor.hasInRangeActor() ? 1 : 0;
+    }
+    return inRange;
+  };
+}
+
+SAPPHIRE_BENCH_CASE( charaGetModifier, "chara/getModifier/30effects" )
+{
+  auto pBNpc = makeBuffedBNpc( fixture, 30 );
+  if( !pBNpc )
+    return nullptr;
+
+  return [ pBNpc ]( uint64_t iterations )
+  {
+    float sum = 0.f;
+    for( uint64_t i = 0; i < iterations; ++i )
+      sum += pBNpc->getModifier( EffectModifiers[ i % EffectModifiers.size() ] );
+    return static_cast< uint64_t >( sum );
+  };
+}
+
+SAPPHIRE_BENCH_CASE( calcStatsActionDamage, "calcstats/calcActionDamage" )
+{
+  auto pBNpc = makeBuffedBNpc( fixture, 20 );
+  if( !pBNpc )
+    return nullptr;
+
+  return [ pBNpc ]( uint64_t iterations )
+  {
+    double damage = 0.0;
+    for( uint64_t i = 0; i < iterations; ++i )
+      damage += Math::CalcStats::calcActionDamage( *pBNpc, 150 + static_cast< uint32_t >( i % 8 ) * 50, 110.f ).first;
+    return static_cast< uint64_t >( damage );
+  };
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ForwardsZone.h>
+
+namespace Sapphire::Data
+{
+  class ExdData;
+}
+
+namespace Sapphire::Bench
+{
+
+  /*! inputs shared by every case, everything but --data is generated */
+  struct Fixture
+  {
+    // sqpack folder, the cases run on generated sheet rows without it
+    std::string dataPath;
+    // scratch folder for generated files such as the navmesh
+    std::string workPath;
+    uint64_t seed{ 1 };
+  };
+
+  /*!
+   * @brief Runs the measured operation the given number of times.
+   *
+   * The returned value is folded into a volatile sink so the work can not be optimized away.
+   */
+  using CaseBody = std::function< uint64_t( uint64_t iterations ) >;
+
+  /*! prepares a case outside of the timed region, an empty body skips the case */
+  using CaseSetup = std::function< CaseBody( const Fixture& fixture ) >;
+
+  struct Case
+  {
+    std::string name;
+    CaseSetup setup;
+  };
+
+  inline std::vector< Case >& getCases()
+  {
+    static std::vector< Case > cases;
+    return cases;
+  }
+
+  /*!
+   * game data of --data, or rows generated in code without it, registered as service for the server code.
+   * nullptr if --data fails to load.
+   */
+  std::shared_ptr< Data::ExdData > getExdData( const Fixture& fixture );
+
+  /*! registers the managers the server code under test looks up, none of them needs a database */
+  void initWorldServices( const Fixture& fixture );
+
+  /*! level capped bnpc of the first BNpcBase row, created like TerritoryMgr spawns them, needs getExdData */
+  Entity::BNpcPtr createBNpc( const Territory& territory, uint32_t id, const Common::FFXIVARR_POSITION3& pos );
+
+  struct CaseRegistrar
+  {
+    CaseRegistrar( std::string name, CaseSetup setup )
+    {
+      getCases().push_back( { std::move( name ), std::move( setup ) } );
+    }
+  };
+
+}
+
+#define SAPPHIRE_BENCH_CASE( id, name ) \
+  static Sapphire::Bench::CaseBody id( const Sapphire::Bench::Fixture& fixture ); \
+  static Sapphire::Bench::CaseRegistrar id##Registrar( name, &id ); \
+  static Sapphire::Bench::CaseBody id( const Sapphire::Bench::Fixture& fixture )
@@ -0,0 +1,66 @@
+#include <Exd/ExdData.h>
+#include <Random/RandomStream.h>
+
+#include <memory>
+#include <vector>
+
+#include "Bench.h"
+
+using namespace Sapphire;
+
+// row lookups of the sheets the world server reads on every action and stat update
+// with --data the rows are parsed from the sqpack, without it the generated rows measure the lookup alone
+
+namespace
+{
+  const uint32_t LookupsPerPass = 256;
+
+  // looks rows up in a random order, like requests of different players would
+  template< typename T >
+  Bench::CaseBody makeRowCase( const Bench::Fixture& fixture )
+  {
+    auto pExdData = Bench::getExdData( fixture );
+    if( !pExdData )
+      return nullptr;
+
+    auto ids = pExdData->getIdList< T >();
+    if( ids.empty() )
+      return nullptr;
+
+    Common::Random::RandomStream rng( fixture.seed );
+    std::vector< uint32_t > lookups;
+    for( uint32_t i = 0; i < LookupsPerPass; ++i )
+      lookups.push_back( ids[ rng.nextInt( 0, static_cast< uint32_t >( ids.size() - 1 ) ) ] );
+
+    return [ pExdData, lookups ]( uint64_t iterations )
+    {
+      uint64_t found = 0;
+      for( uint64_t i = 0; i < iterations; ++i )
+      {
+        if( pExdData->getRow< T >( lookups[ i % lookups.size() ] ) )
+          ++found;
+      }
+      return found;
+    };
+  }
+}
+
+SAPPHIRE_BENCH_CASE( exdClassJob, "exd/getRow/ClassJob" )
+{
+  return makeRowCase< Excel::ClassJob >( fixture );
+}
+
+SAPPHIRE_BENCH_CASE( exdAction, "exd/getRow/Action" )
+{
+  return makeRowCase< Excel::Action >( fixture );
+}
+
+SAPPHIRE_BENCH_CASE( exdItem, "exd/getRow/Item" )
+{
+  return makeRowCase< Excel::Item >( fixture );
+}
+
+SAPPHIRE_BENCH_CASE( exdStatus, "exd/getRow/Status" )
+{
+  return makeRowCase< Excel::Status >( fixture );
+}
@@ -0,0 +1,142 @@
+#include <Logging/Logger.h>
+#include <Navi/NaviProvider.h>
+#include <Random/RandomStream.h>
+
+#include <nav/TiledNavmeshGenerator.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "Bench.h"
+
+using namespace Sapphire;
+
+// path queries on a generated zone: a flat square with pillars in the way, built and saved by the nav_export
+// generator and loaded through NaviProvider like a territory mesh
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  const char* MeshName = "bench_field";
+
+  const float FieldSize = 256.f;
+  const uint32_t FloorQuads = 16;
+  const uint32_t Pillars = 48;
+  const float PillarSize = 4.f;
+  const float PillarHeight = 4.f;
+
+  const uint32_t PathsPerPass = 64;
+
+  // floor triangles face up, recast only walks on those
+  void writeFieldObj( const fs::path& objPath, uint64_t seed )
+  {
+    Common::Random::RandomStream rng( seed );
+    std::ofstream obj( objPath );
+
+    uint32_t vertexCount = 0;
+    auto addQuad = [ & ]( const Common::FFXIVARR_POSITION3& a, const Common::FFXIVARR_POSITION3& b,
+                          const Common::FFXIVARR_POSITION3& c, const Common::FFXIVARR_POSITION3& d )
+    {
+      for( const auto& v : { a, b, c, d } )
+        obj << "v " << v.x << " " << v.y << " " << v.z << "\n";
+      obj << "f " << vertexCount + 1 << " " << vertexCount + 2 << " " << vertexCount + 3 << "\n";
+      obj << "f " << vertexCount + 1 << " " << vertexCount + 3 << " " << vertexCount + 4 << "\n";
+      vertexCount += 4;
+    };
+
+    const float quadSize = FieldSize / FloorQuads;
+    const float origin = -FieldSize / 2;
+    for( uint32_t x = 0; x < FloorQuads; ++x )
+    {
+      for( uint32_t z = 0; z < FloorQuads; ++z )
+      {
+        float x0 = origin + x * quadSize;
+        float z0 = origin + z * quadSize;
+        addQuad( { x0, 0.f, z0 }, { x0, 0.f, z0 + quadSize }, { x0 + quadSize, 0.f, z0 + quadSize },
+                 { x0 + quadSize, 0.f, z0 } );
+      }
+    }
+
+    for( uint32_t i = 0; i < Pillars; ++i )
+    {
+      float x0 = rng.nextFloat( origin + 8.f, -origin - 8.f - PillarSize );
+      float z0 = rng.nextFloat( origin + 8.f, -origin - 8.f - PillarSize );
+      float x1 = x0 + PillarSize;
+      float z1 = z0 + PillarSize;
+      float h = PillarHeight;
+
+      addQuad( { x0, h, z0 }, { x0, h, z1 }, { x1, h, z1 }, { x1, h, z0 } );
+      addQuad( { x0, 0.f, z0 }, { x1, 0.f, z0 }, { x1, h, z0 }, { x0, h, z0 } );
+      addQuad( { x1, 0.f, z0 }, { x1, 0.f, z1 }, { x1, h, z1 }, { x1, h, z0 } );
+      addQuad( { x1, 0.f, z1 }, { x0, 0.f, z1 }, { x0, h, z1 }, { x1, h, z1 } );
+      addQuad( { x0, 0.f, z1 }, { x0, 0.f, z0 }, { x0, h, z0 }, { x0, h, z1 } );
+    }
+  }
+
+  // the generator reads from and saves to <working dir>/navi/<name>
+  bool buildFieldMesh( const fs::path& workPath, uint64_t seed )
+  {
+    auto meshDir = workPath / "navi" / MeshName;
+    auto objPath = meshDir / ( std::string( MeshName ) + ".obj" );
+    fs::create_directories( meshDir );
+    writeFieldObj( objPath, seed );
+
+    auto oldPath = fs::current_path();
+    fs::current_path( workPath );
+
+    bool built = false;
+    {
+      TiledNavmeshGenerator gen;
+      if( gen.init( objPath.string() ) && gen.buildNavmesh() )
+      {
+        gen.saveNavmesh( MeshName );
+        built = true;
+      }
+    }
+
+    fs::current_path( oldPath );
+    return built && fs::exists( meshDir / ( std::string( MeshName ) + ".nav" ) );
+  }
+}
+
+SAPPHIRE_BENCH_CASE( naviFindFollowPath, "navi/findFollowPath" )
+{
+  auto workPath = fs::path( fixture.workPath );
+  if( !buildFieldMesh( workPath, fixture.seed ) )
+  {
+    Logger::error( "Failed to build the navmesh fixture in {}", workPath.string() );
+    return nullptr;
+  }
+
+  auto pNavi = std::make_shared< Common::Navi::NaviProvider >( MeshName );
+  if( !pNavi->init( ( workPath / "navi" ).string() ) )
+  {
+    Logger::error( "Failed to load the navmesh fixture" );
+    return nullptr;
+  }
+
+  // start and end on opposite halves, most paths have to go around pillars
+  Common::Random::RandomStream rng( fixture.seed );
+  std::vector< std::pair< Common::FFXIVARR_POSITION3, Common::FFXIVARR_POSITION3 > > paths;
+  const float half = FieldSize / 2 - 4.f;
+  for( uint32_t i = 0; i < PathsPerPass; ++i )
+  {
+    Common::FFXIVARR_POSITION3 start{ rng.nextFloat( -half, 0.f ), 0.f, rng.nextFloat( -half, half ) };
+    Common::FFXIVARR_POSITION3 end{ rng.nextFloat( 0.f, half ), 0.f, rng.nextFloat( -half, half ) };
+    paths.emplace_back( start, end );
+  }
+
+  return [ pNavi, paths ]( uint64_t iterations )
+  {
+    uint64_t points = 0;
+    for( uint64_t i = 0; i < iterations; ++i )
+    {
+      const auto& [ start, end ] = paths[ i % paths.size() ];
+      points += pNavi->findFollowPath( start, end ).size();
+    }
+    return points;
+  };
+}
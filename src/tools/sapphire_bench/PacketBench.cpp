@@ -0,0 +1,114 @@
+#include <Network/GamePacket.h>
+#include <Network/GamePacketParser.h>
+#include <Network/PacketContainer.h>
+#include <Network/PacketDef/Zone/ServerZoneDef.h>
+#include <Random/RandomStream.h>
+
+#include <vector>
+
+#include "Bench.h"
+
+using namespace Sapphire;
+using namespace Sapphire::Network::Packets;
+
+// the packet mix of a busy territory tick: mostly movement and actor controls, some spawns and status updates
+
+namespace
+{
+  const uint32_t PacketsPerFlush = 32;
+
+  std::vector< FFXIVPacketBasePtr > makeTickPackets( uint64_t seed )
+  {
+    Common::Random::RandomStream rng( seed );
+    std::vector< FFXIVPacketBasePtr > packets;
+
+    for( uint32_t i = 0; i < PacketsPerFlush; ++i )
+    {
+      auto actorId = rng.nextInt( 0x10000000, 0x1FFFFFFF );
+      auto roll = rng.nextInt( 0, 99 );
+
+      if( roll < 50 )
+      {
+        auto pMove = makeZonePacket< WorldPackets::Server::FFXIVIpcActorMove >( actorId );
+        pMove->data().dir = static_cast< uint8_t >( rng.nextInt( 0, 255 ) );
+        pMove->data().speed = 0x3C;
+        for( auto& coord : pMove->data().pos )
+          coord = static_cast< uint16_t >( rng.nextInt( 0, 0xFFFF ) );
+        packets.push_back( pMove );
+      }
+      else if( roll < 85 )
+      {
+        auto pControl = makeZonePacket< WorldPackets::Server::FFXIVIpcActorControl >( actorId );
+        pControl->data().category = static_cast< uint16_t >( rng.nextInt( 0, 0x200 ) );
+        pControl->data().param1 = rng.nextInt( 0, 100000 );
+        packets.push_back( pControl );
+      }
+      else if( roll < 95 )
+      {
+        packets.push_back( makeZonePacket< WorldPackets::Server::FFXIVIpcStatus >( actorId ) );
+      }
+      else
+      {
+        packets.push_back( makeZonePacket< WorldPackets::Server::FFXIVIpcPlayerSpawn >( actorId ) );
+      }
+    }
+
+    return packets;
+  }
+}
+
+// one flush of GameConnection::processOutQueue
+SAPPHIRE_BENCH_CASE( packetFillSendBuffer, "packet/fillSendBuffer" )
+{
+  auto packets = makeTickPackets( fixture.seed );
+
+  return [ packets ]( uint64_t iterations )
+  {
+    uint64_t bytes = 0;
+    std::vector< uint8_t > buffer;
+
+    for( uint64_t i = 0; i < iterations; ++i )
+    {
+      PacketContainer container;
+      for( const auto& pPacket : packets )
+        container.addPacket( pPacket );
+
+      container.fillSendBuffer( buffer );
+      bytes += buffer.size();
+    }
+
+    return bytes;
+  };
+}
+
+// one read of Connection::onRecv, header check and segment split
+SAPPHIRE_BENCH_CASE( packetParseSegments, "packet/parseSegments" )
+{
+  PacketContainer container;
+  for( const auto& pPacket : makeTickPackets( fixture.seed ) )
+    container.addPacket( pPacket );
+
+  std::vector< uint8_t > buffer;
+  container.fillSendBuffer( buffer );
+
+  return [ buffer ]( uint64_t iterations )
+  {
+    uint64_t segments = 0;
+    std::vector< FFXIVARR_PACKET_RAW > packets;
+
+    for( uint64_t i = 0; i < iterations; ++i )
+    {
+      FFXIVARR_PACKET_HEADER header{};
+      if( getHeader( buffer, 0, header ) != Success )
+        return segments;
+
+      packets.clear();
+      if( getPackets( buffer, sizeof( header ), header, packets ) != Success )
+        return segments;
+
+      segments += packets.size();
+    }
+
+    return segments;
+  };
+}
@@ -0,0 +1,139 @@
+#include <Common.h>
+#include <Random/RandomStream.h>
+#include <Service.h>
+
+#include <Actor/Player.h>
+#include <Manager/PartyMgr.h>
+#include <Manager/PlayerMgr.h>
+#include <Network/Util/PacketUtil.h>
+
+#include <memory>
+#include <vector>
+
+#include "Bench.h"
+
+using namespace Sapphire;
+
+// party list updates of a full party in combat, run on PartyMgr with players registered in PlayerMgr.
+// Every hp and mp change goes through Util::Packet::sendHudParam like those of actions and regen,
+// one pass is one server tick of changes.
+
+namespace
+{
+  const uint32_t PartySize = 8;
+  // hp and mp changes of all members within one server tick of a fight
+  const uint32_t EventsPerTick = 24;
+  const uint32_t FirstActorId = 0x10000000;
+  const uint64_t FirstCharacterId = 0x1000000000;
+  const uint32_t TerritoryTypeId = 1000;
+
+  struct PartyFixture
+  {
+    std::vector< Entity::PlayerPtr > members;
+    Common::Random::RandomStream rng;
+
+    // a hit or a heal on one member, or mp spent by one
+    void changeMember()
+    {
+      auto& pMember = members[ rng.nextInt( 0, PartySize - 1 ) ];
+      if( rng.nextInt( 0, 1 ) == 0 )
+        pMember->setHp( rng.nextInt( pMember->getMaxHp() / 2, pMember->getMaxHp() ) );
+      else
+        pMember->setMp( rng.nextInt( pMember->getMaxMp() / 2, pMember->getMaxMp() ) );
+
+      Network::Util::Packet::sendHudParam( *pMember );
+    }
+  };
+
+  // members are created like logged in players, but from the generated sheet rows instead of the database
+  std::shared_ptr< PartyFixture > createParty( const Bench::Fixture& fixture )
+  {
+    if( !Bench::getExdData( fixture ) )
+      return nullptr;
+
+    Bench::initWorldServices( fixture );
+
+    auto& playerMgr = Common::Service< World::Manager::PlayerMgr >::ref();
+    auto& partyMgr = Common::Service< World::Manager::PartyMgr >::ref();
+
+    // every case has its own party, the players of all cases stay registered
+    static uint32_t partyCount = 0;
+    auto partyIndex = partyCount++;
+
+    auto pFixture = std::make_shared< PartyFixture >();
+    pFixture->rng = Common::Random::RandomStream( fixture.seed );
+
+    for( uint32_t i = 0; i < PartySize; ++i )
+    {
+      auto pPlayer = Entity::make_Player();
+      pPlayer->setId( FirstActorId + partyIndex * PartySize + i );
+      pPlayer->setCharacterId( FirstCharacterId + partyIndex * PartySize + i );
+      pPlayer->setConnected( true );
+      pPlayer->setClassJob( static_cast< Common::ClassJob >( 19 + i ) );
+      pPlayer->setLevel( Common::MAX_PLAYER_LEVEL );
+      pPlayer->setTerritoryTypeId( TerritoryTypeId );
+      // looks are not set without the database, the tribe picks the generated row
+      pPlayer->setLookAt( Common::CharaLook::Tribe, 0 );
+      pPlayer->initInventoryContainers();
+      pPlayer->calculateStats();
+      pPlayer->setHp( pPlayer->getMaxHp() );
+      pPlayer->setMp( pPlayer->getMaxMp() );
+
+      playerMgr.registerPlayer( pPlayer );
+      if( i > 0 )
+        partyMgr.onJoin( *pPlayer, *pFixture->members.front() );
+
+      pFixture->members.push_back( pPlayer );
+    }
+
+    // sends the complete list of the new party, the passes only send changed members
+    partyMgr.update();
+
+    return pFixture;
+  }
+}
+
+// changes are collected and sent once per tick, as the world server's main loop does
+SAPPHIRE_BENCH_CASE( partyUpdatePerTick, "party/updatePerTick/8" )
+{
+  auto pFixture = createParty( fixture );
+  if( !pFixture )
+    return nullptr;
+
+  return [ pFixture ]( uint64_t iterations )
+  {
+    auto& partyMgr = Common::Service< World::Manager::PartyMgr >::ref();
+
+    for( uint64_t i = 0; i < iterations; ++i )
+    {
+      for( uint32_t event = 0; event < EventsPerTick; ++event )
+        pFixture->changeMember();
+
+      partyMgr.update();
+    }
+    return static_cast< uint64_t >( pFixture->members.front()->getHp() );
+  };
+}
+
+// the same changes with the list sent after each one, what every member change cost before they were collected
+SAPPHIRE_BENCH_CASE( partyUpdatePerEvent, "party/updatePerEvent/8" )
+{
+  auto pFixture = createParty( fixture );
+  if( !pFixture )
+    return nullptr;
+
+  return [ pFixture ]( uint64_t iterations )
+  {
+    auto& partyMgr = Common::Service< World::Manager::PartyMgr >::ref();
+
+    for( uint64_t i = 0; i < iterations; ++i )
+    {
+      for( uint32_t event = 0; event < EventsPerTick; ++event )
+      {
+        pFixture->changeMember();
+        partyMgr.update();
+      }
+    }
+    return static_cast< uint64_t >( pFixture->members.front()->getHp() );
+  };
+}
@@ -0,0 +1,141 @@
+#include <Exd/ExdData.h>
+#include <Logging/Logger.h>
+#include <Random/RNGMgr.h>
+#include <Service.h>
+
+#include <Actor/BNpc.h>
+#include <Manager/ChatChannelMgr.h>
+#include <Manager/PartyMgr.h>
+#include <Manager/PlayerMgr.h>
+#include <Manager/TerritoryMgr.h>
+#include <Script/ScriptMgr.h>
+#include <WorldServer.h>
+
+#include "Bench.h"
+
+using namespace Sapphire;
+
+namespace
+{
+  // sizes of the generated sheets, in the range of the game's so lookups scale alike
+  const uint32_t FixtureStatusRows = 1024;
+  const uint32_t FixtureActionRows = 4096;
+  const uint32_t FixtureItemRows = 4096;
+  const uint32_t FixtureClassJobs = 34;
+
+  template< typename T >
+  std::shared_ptr< Excel::ExcelStruct< T > > makeRow()
+  {
+    return std::make_shared< Excel::ExcelStruct< T > >();
+  }
+
+  // rows of the sheets the cases read, with neutral values so formulas stay in a realistic range
+  void buildFixtureRows( Data::ExdData& exdData )
+  {
+    auto pBase = makeRow< Excel::BNpcBase >();
+    pBase->data().Scale = 1.f;
+    exdData.setFixtureRow( 1, pBase );
+
+    for( uint32_t id = 0; id < FixtureClassJobs; ++id )
+    {
+      auto pClassJob = makeRow< Excel::ClassJob >();
+      auto& classJob = pClassJob->data();
+      classJob.Hp = classJob.Mp = 100;
+      classJob.STR = classJob.VIT = classJob.DEX = classJob.INT_ = classJob.MND = classJob.PIE = 100;
+      exdData.setFixtureRow( id, pClassJob );
+    }
+
+    // players without looks or deity use the first rows, which add no stats
+    exdData.setFixtureRow( 0, makeRow< Excel::Tribe >() );
+    exdData.setFixtureRow( 0, makeRow< Excel::GuardianDeity >() );
+
+    for( uint32_t level = 1; level <= Common::MAX_PLAYER_LEVEL; ++level )
+    {
+      auto pGrow = makeRow< Excel::ParamGrow >();
+      // grows to the level cap main stat of the level table
+      pGrow->data().ParamBase = static_cast< int32_t >( 20 + level * 33 / 10 );
+      pGrow->data().Mp = 10000;
+      exdData.setFixtureRow( level, pGrow );
+    }
+
+    for( uint32_t id = 1; id <= FixtureStatusRows; ++id )
+    {
+      auto pStatus = makeRow< Excel::Status >();
+      pStatus->_strings = { "Status " + std::to_string( id ), "" };
+      pStatus->data().Text.Help.m_offset = 1;
+      // beneficial and detrimental alternate
+      pStatus->data().Category = static_cast< uint8_t >( 1 + id % 2 );
+      pStatus->data().CanOff = id % 2;
+      exdData.setFixtureRow( id, pStatus );
+    }
+
+    for( uint32_t id = 1; id <= FixtureActionRows; ++id )
+      exdData.setFixtureRow( id, makeRow< Excel::Action >() );
+
+    for( uint32_t id = 1; id <= FixtureItemRows; ++id )
+      exdData.setFixtureRow( id, makeRow< Excel::Item >() );
+  }
+}
+
+std::shared_ptr< Data::ExdData > Bench::getExdData( const Fixture& fixture )
+{
+  static std::shared_ptr< Data::ExdData > pExdData;
+  static bool initialized = false;
+
+  if( !initialized )
+  {
+    initialized = true;
+
+    auto pData = std::make_shared< Data::ExdData >();
+    if( fixture.dataPath.empty() )
+      buildFixtureRows( *pData );
+    else if( !pData->init( fixture.dataPath ) )
+    {
+      // results of the generated rows are not comparable with those of the game data, skip instead
+      Logger::error( "Failed to load game data from {}", fixture.dataPath );
+      return nullptr;
+    }
+    pExdData = pData;
+
+    // status effects, bnpcs and the stat formulas read their rows through the service
+    Common::Service< Data::ExdData >::set( pExdData );
+  }
+
+  return pExdData;
+}
+
+void Bench::initWorldServices( const Fixture& fixture )
+{
+  static bool initialized = false;
+  if( initialized )
+    return;
+  initialized = true;
+
+  // without sessions every packet the server code queues is dropped by the world server
+  Common::Service< World::WorldServer >::set( "world.ini" );
+  Common::Service< Common::Random::RNGMgr >::set( fixture.seed );
+  Common::Service< World::Manager::TerritoryMgr >::set();
+  // players of the cases are registered with PlayerMgr so it never falls back to the database
+  Common::Service< World::Manager::PlayerMgr >::set();
+  Common::Service< World::Manager::ChatChannelMgr >::set();
+  Common::Service< World::Manager::PartyMgr >::set();
+  // no script is loaded, status effects run their default behaviour
+  Common::Service< Scripting::ScriptMgr >::set();
+}
+
+Entity::BNpcPtr Bench::createBNpc( const Territory& territory, uint32_t id, const Common::FFXIVARR_POSITION3& pos )
+{
+  auto& exdData = Common::Service< Data::ExdData >::ref();
+  auto baseIds = exdData.getIdList< Excel::BNpcBase >();
+  if( baseIds.empty() )
+    return nullptr;
+
+  auto pInfo = std::make_shared< Common::BNpcCacheEntry >();
+  pInfo->BaseId = baseIds.front();
+  pInfo->Level = Common::MAX_PLAYER_LEVEL;
+  pInfo->x = pos.x;
+  pInfo->y = pos.y;
+  pInfo->z = pos.z;
+
+  return std::make_shared< Entity::BNpc >( id, pInfo, territory );
+}
@@ -0,0 +1,130 @@
+#include <Common.h>
+#include <Exd/ExdData.h>
+#include <Logging/Logger.h>
+#include <Random/RandomStream.h>
+#include <Util/FrameClock.h>
+
+#include <Action/ActionLut.h>
+#include <Actor/BNpc.h>
+#include <StatusEffect/StatusEffect.h>
+#include <StatusEffect/StatusEffectQueue.h>
+#include <Territory/Territory.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Bench.h"
+
+using namespace Sapphire;
+
+// the territory status effect queue over a full zone, one pass is one server tick.
+// Effects are created from the Status rows of Bench::getExdData.
+
+namespace
+{
+  const uint32_t Actors = 1000;
+  const uint32_t Effects = 10000;
+  const uint32_t TickRate = 3000;
+  const uint64_t ServerTickMs = 300;
+  const uint32_t FirstActorId = 0x40000000;
+  // bnpcs are spread like the mobs of an open world zone
+  const float SpawnArea = 2000.f;
+
+  struct StatusFixture
+  {
+    TerritoryPtr pTerritory;
+    std::vector< Entity::BNpcPtr > actors;
+    std::vector< uint32_t > statusIds;
+    Common::Random::RandomStream rng;
+    // expiry time of every active effect, expired ones are replaced to keep the effect count constant
+    std::multimap< uint64_t, Entity::BNpcPtr > expiries;
+
+    StatusEffect::StatusEffectPtr addEffect( const Entity::BNpcPtr& pBNpc )
+    {
+      auto statusId = statusIds[ rng.nextInt( 0, static_cast< uint32_t >( statusIds.size() - 1 ) ) ];
+      auto duration = rng.nextInt( 15000, 60000 );
+      std::vector< World::Action::StatusModifier > modifiers{ { Common::ParamModifier::DamageDealtPercent, 5 } };
+
+      auto pEffect = std::make_shared< StatusEffect::StatusEffect >( statusId, pBNpc, pBNpc, duration, modifiers, 0, TickRate );
+      pBNpc->addStatusEffect( pEffect );
+      expiries.emplace( pEffect->getStartTimeMs() + duration, pBNpc );
+      return pEffect;
+    }
+  };
+
+  // adding and removing effects logs every slot change, which would be most of the measured time
+  struct LogLevelGuard
+  {
+    LogLevelGuard()
+    {
+      Logger::setLogLevel( 4 );
+    }
+
+    ~LogLevelGuard()
+    {
+      Logger::setLogLevel( 1 );
+    }
+  };
+}
+
+SAPPHIRE_BENCH_CASE( statusQueueUpdate, "status/queueUpdate/10000" )
+{
+  auto pExdData = Bench::getExdData( fixture );
+  if( !pExdData )
+    return nullptr;
+
+  Bench::initWorldServices( fixture );
+  LogLevelGuard logLevel;
+
+  Common::Util::FrameClock::setFixedStep( ServerTickMs );
+  Common::Util::FrameClock::advance();
+
+  auto pFixture = std::make_shared< StatusFixture >();
+  pFixture->pTerritory = std::make_shared< Territory >();
+  pFixture->statusIds = pExdData->getIdList< Excel::Status >();
+  pFixture->rng = Common::Random::RandomStream( fixture.seed );
+  if( pFixture->statusIds.empty() )
+    return nullptr;
+
+  for( uint32_t i = 0; i < Actors; ++i )
+  {
+    Common::FFXIVARR_POSITION3 pos{ pFixture->rng.nextFloat( -SpawnArea / 2, SpawnArea / 2 ), 0.f,
+                                    pFixture->rng.nextFloat( -SpawnArea / 2, SpawnArea / 2 ) };
+    auto pBNpc = Bench::createBNpc( *pFixture->pTerritory, FirstActorId + i, pos );
+    if( !pBNpc )
+      return nullptr;
+    pFixture->actors.push_back( pBNpc );
+  }
+
+  // effects applied before entering are queued by the territory, like those of a chara changing zones
+  for( uint32_t i = 0; i < Effects; ++i )
+    pFixture->addEffect( pFixture->actors[ i % Actors ] );
+
+  for( const auto& pBNpc : pFixture->actors )
+    pFixture->pTerritory->pushActor( pBNpc );
+
+  return [ pFixture ]( uint64_t iterations )
+  {
+    LogLevelGuard logLevel;
+    auto& queue = pFixture->pTerritory->getStatusEffectQueue();
+
+    for( uint64_t i = 0; i < iterations; ++i )
+    {
+      auto tickCount = Common::Util::FrameClock::advance();
+      queue.update( *pFixture->pTerritory, tickCount );
+
+      // the queue expires an effect on the first tick past its duration
+      auto& expiries = pFixture->expiries;
+      while( !expiries.empty() && expiries.begin()->first < tickCount )
+      {
+        auto pBNpc = expiries.begin()->second;
+        expiries.erase( expiries.begin() );
+
+        // the bench territory is not known to TerritoryMgr, the new effect is queued here instead of by the chara
+        queue.schedule( pFixture->addEffect( pBNpc ) );
+      }
+    }
+    return static_cast< uint64_t >( queue.size() );
+  };
+}
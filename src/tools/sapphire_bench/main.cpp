@@ -0,0 +1,215 @@
+#include <Logging/Logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+
+using namespace Sapphire;
+
+// microbenchmarks of server hot paths on generated fixtures, headless and without a database.
+// Sheet rows are generated too unless --data points at a game sqpack folder, baselines only compare within one of both.
+// Every case is calibrated to run for --min-time per repetition, the median time per operation is reported.
+// --save writes the results as a baseline, --baseline compares against one and fails on regressions above
+// --tolerance percent, which lets a CI job gate on it.
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  struct BenchConfig
+  {
+    std::string filter;
+    std::string baselinePath;
+    std::string savePath;
+    std::string dataPath;
+    uint32_t minTimeMs{ 200 };
+    uint32_t repetitions{ 5 };
+    double tolerance{ 10.0 };
+    uint64_t seed{ 1 };
+  };
+
+  struct Result
+  {
+    std::string name;
+    double nsPerOp{ 0.0 };
+    double minNsPerOp{ 0.0 };
+    uint64_t iterations{ 0 };
+  };
+
+  volatile uint64_t g_sink = 0;
+
+  double runTimed( const Bench::CaseBody& body, uint64_t iterations )
+  {
+    auto start = Clock::now();
+    g_sink = g_sink + body( iterations );
+    return std::chrono::duration< double, std::nano >( Clock::now() - start ).count();
+  }
+
+  Result runCase( const std::string& name, const Bench::CaseBody& body, const BenchConfig& config )
+  {
+    const double targetNs = config.minTimeMs * 1000000.0;
+
+    // grows the iteration count until one pass is long enough to scale from
+    uint64_t iterations = 1;
+    double elapsedNs = runTimed( body, iterations );
+    while( elapsedNs < targetNs / 10 && iterations < ( 1ull << 40 ) )
+    {
+      iterations *= 10;
+      elapsedNs = runTimed( body, iterations );
+    }
+    iterations = std::max< uint64_t >( 1, static_cast< uint64_t >( iterations * targetNs / std::max( elapsedNs, 1.0 ) ) );
+
+    std::vector< double > samples;
+    for( uint32_t i = 0; i < config.repetitions; ++i )
+      samples.push_back( runTimed( body, iterations ) / iterations );
+
+    std::sort( samples.begin(), samples.end() );
+
+    Result result;
+    result.name = name;
+    result.nsPerOp = samples[ samples.size() / 2 ];
+    result.minNsPerOp = samples.front();
+    result.iterations = iterations;
+    return result;
+  }
+
+  // one "name ns_per_op" line per case
+  std::map< std::string, double > loadBaseline( const std::string& path )
+  {
+    std::map< std::string, double > baseline;
+    std::ifstream file( path );
+    std::string line;
+    while( std::getline( file, line ) )
+    {
+      std::istringstream stream( line );
+      std::string name;
+      double nsPerOp;
+      if( stream >> name >> nsPerOp )
+        baseline[ name ] = nsPerOp;
+    }
+    return baseline;
+  }
+
+  bool saveResults( const std::string& path, const std::vector< Result >& results )
+  {
+    std::ofstream file( path, std::ios::trunc );
+    if( !file )
+      return false;
+
+    for( const auto& result : results )
+      file << result.name << " " << result.nsPerOp << "\n";
+    return true;
+  }
+}
+
+int main( int argc, char* argv[] )
+{
+  Logger::init( "sapphire_bench" );
+
+  BenchConfig config;
+  std::vector< std::string > args( argv + 1, argv + argc );
+  for( size_t i = 0; i + 1 < args.size(); i += 2 )
+  {
+    const auto& val = args[ i + 1 ];
+    if( args[ i ] == "--filter" )
+      config.filter = val;
+    else if( args[ i ] == "--min-time" )
+      config.minTimeMs = std::max( 1u, static_cast< uint32_t >( std::stoul( val ) ) );
+    else if( args[ i ] == "--repetitions" )
+      config.repetitions = std::max( 1u, static_cast< uint32_t >( std::stoul( val ) ) );
+    else if( args[ i ] == "--baseline" )
+      config.baselinePath = val;
+    else if( args[ i ] == "--save" )
+      config.savePath = val;
+    else if( args[ i ] == "--tolerance" )
+      config.tolerance = std::stod( val );
+    else if( args[ i ] == "--data" )
+      config.dataPath = val;
+    else if( args[ i ] == "--seed" )
+      config.seed = std::stoull( val );
+    else
+    {
+      Logger::error( "usage: sapphire_bench [--filter text] [--min-time ms] [--repetitions n] [--data sqpackpath] "
+                     "[--save file] [--baseline file [--tolerance percent]] [--seed n]" );
+      return 1;
+    }
+  }
+
+  Bench::Fixture fixture;
+  fixture.dataPath = config.dataPath;
+  fixture.seed = config.seed;
+  fixture.workPath = ( std::filesystem::temp_directory_path() / "sapphire_bench" ).string();
+  std::filesystem::create_directories( fixture.workPath );
+
+  auto cases = Bench::getCases();
+  std::sort( cases.begin(), cases.end(), []( const auto& left, const auto& right ) { return left.name < right.name; } );
+
+  std::vector< Result > results;
+  for( const auto& benchCase : cases )
+  {
+    if( !config.filter.empty() && benchCase.name.find( config.filter ) == std::string::npos )
+      continue;
+
+    auto body = benchCase.setup( fixture );
+    if( !body )
+    {
+      Logger::info( "{:<36} skipped", benchCase.name );
+      continue;
+    }
+
+    auto result = runCase( benchCase.name, body, config );
+    Logger::info( "{:<36} {:>12.1f} ns/op (min {:.1f}, {} iterations x {})", result.name, result.nsPerOp,
+                  result.minNsPerOp, result.iterations, config.repetitions );
+    results.push_back( result );
+  }
+
+  if( !config.savePath.empty() )
+  {
+    if( !saveResults( config.savePath, results ) )
+    {
+      Logger::error( "Failed to write results to {}", config.savePath );
+      return 1;
+    }
+    Logger::info( "Saved {} results to {}", results.size(), config.savePath );
+  }
+
+  if( config.baselinePath.empty() )
+    return 0;
+
+  auto baseline = loadBaseline( config.baselinePath );
+  if( baseline.empty() )
+  {
+    Logger::error( "No results in baseline {}", config.baselinePath );
+    return 1;
+  }
+
+  uint32_t regressions = 0;
+  for( const auto& result : results )
+  {
+    auto it = baseline.find( result.name );
+    if( it == baseline.end() || it->second <= 0.0 )
+      continue;
+
+    auto change = ( result.nsPerOp - it->second ) / it->second * 100.0;
+    bool regressed = change > config.tolerance;
+    if( regressed )
+      ++regressions;
+
+    Logger::info( "{:<36} {:>+8.1f}% against baseline{}", result.name, change, regressed ? " REGRESSION" : "" );
+  }
+
+  if( regressions > 0 )
+  {
+    Logger::error( "{} cases regressed by more than {}%", regressions, config.tolerance );
+    return 2;
+  }
+
+  return 0;
+}
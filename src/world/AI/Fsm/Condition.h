@@ -2,6 +2,7 @@
 #include "ForwardsZone.h"
 #include "Actor/BNpc.h"
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Util/UtilMath.h>
 
 #pragma once
@@ -28,7 +29,7 @@ namespace Sapphire::World::AI::Fsm
   public:
     bool isConditionMet( Sapphire::Entity::BNpc& src ) const override
     {
-      if( ( Common::Util::getTimeSeconds() - src.getLastRoamTargetReachedTime() ) > 20 )
+      if( ( Common::Util::FrameClock::getTimeSeconds() - src.getLastRoamTargetReachedTime() ) > 20 )
         return true;
       return false;
     }
@@ -1,6 +1,7 @@
 #include "StateIdle.h"
 #include "Actor/BNpc.h"
 #include "Logging/Logger.h"
+#include <Util/FrameClock.h>
 
 using namespace Sapphire::World;
 
@@ -11,7 +12,7 @@ void AI::Fsm::StateIdle::onUpdate( Entity::BNpc& bnpc, uint64_t tickCount )
 
 void AI::Fsm::StateIdle::onEnter( Entity::BNpc& bnpc )
 {
-  bnpc.setLastRoamTargetReachedTime( Common::Util::getTimeSeconds() );
+  bnpc.setLastRoamTargetReachedTime( Common::Util::FrameClock::getTimeSeconds() );
 }
 
 void AI::Fsm::StateIdle::onExit( Entity::BNpc& bnpc )
@@ -2,6 +2,7 @@
 #include "Actor/BNpc.h"
 #include "Logging/Logger.h"
 #include <Service.h>
+#include <Util/FrameClock.h>
 #include <Manager/TerritoryMgr.h>
 
 #include <Territory/Territory.h>
@@ -14,7 +15,7 @@ void AI::Fsm::StateRetreat::onUpdate( Entity::BNpc& bnpc, uint64_t tickCount )
   if( bnpc.moveTo( bnpc.getSpawnPos() ) )
   {
     bnpc.setRoamTargetReached( true );
-    bnpc.setLastRoamTargetReachedTime( Common::Util::getTimeSeconds() );
+    bnpc.setLastRoamTargetReachedTime( Common::Util::FrameClock::getTimeSeconds() );
   }
 }
 
@@ -2,6 +2,7 @@
 #include "Actor/BNpc.h"
 #include "Logging/Logger.h"
 #include <Service.h>
+#include <Util/FrameClock.h>
 #include <Manager/TerritoryMgr.h>
 
 #include <Territory/Territory.h>
@@ -27,7 +28,7 @@ void AI::Fsm::StateRoam::onUpdate( Entity::BNpc& bnpc, uint64_t tickCount )
   if( bnpc.moveTo( bnpc.getRoamTargetPos() ) )
   {
     bnpc.setRoamTargetReached( true );
-    bnpc.setLastRoamTargetReachedTime( Common::Util::getTimeSeconds() );
+    bnpc.setLastRoamTargetReachedTime( Common::Util::FrameClock::getTimeSeconds() );
   }
 
 }
@@ -44,7 +45,8 @@ void AI::Fsm::StateRoam::onEnter( Entity::BNpc& bnpc )
     return;
   }
 
-  auto pos = pNaviProvider->findRandomPositionInCircle( bnpc.getSpawnPos(), bnpc.getInstanceObjectInfo()->WanderingRange );
+  auto pos = pNaviProvider->findRandomPositionInCircle( bnpc.getSpawnPos(), bnpc.getInstanceObjectInfo()->WanderingRange,
+                                                        pZone->getRandomStream() );
   bnpc.setRoamTargetPos( pos );
 }
 
@@ -1,6 +1,7 @@
 #include <cstdint>
 #include <ForwardsZone.h>
 #include <Service.h>
+#include <Util/FrameClock.h>
 #include <Manager/ActionMgr.h>
 #include <Action/Action.h>
 #include "GambitTargetCondition.h"
@@ -22,7 +23,7 @@ AI::GambitTimeLinePack::GambitTimeLinePack( int8_t loopCount ) :
 
 void AI::GambitTimeLinePack::start()
 {
-  m_startTimeMs = Common::Util::getTimeMs();
+  m_startTimeMs = Common::Util::FrameClock::getTimeMs();
 }
 
 void AI::GambitTimeLinePack::addTimeLine( const GambitRulePtr& pRule, uint32_t offsetInSeconds )
@@ -61,7 +62,7 @@ void AI::GambitTimeLinePack::update( Entity::BNpc& bnpc, uint64_t tickCount )
     {
       m_currentIndex = 0;
       m_currentLoop++;
-      m_startTimeMs = Common::Util::getTimeMs();
+      m_startTimeMs = Common::Util::FrameClock::getTimeMs();
     }
     else
     {
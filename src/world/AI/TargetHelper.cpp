@@ -6,7 +6,8 @@
 #include <Actor/Chara.h>
 #include <Actor/Player.h>
 #include <Manager/PartyMgr.h>
-#include <Random/RNGMgr.h>
+#include <Manager/TerritoryMgr.h>
+#include <Random/RandomStream.h>
 #include <Util/UtilMath.h>
 #include <Service.h>
 
@@ -209,7 +210,7 @@ namespace Sapphire::World::AI
     m_results.clear();
     m_targetIds.clear();
 
-    auto& RNGMgr = Common::Service< Common::Random::RNGMgr >::ref();
+    auto& randomStream = Common::Service< World::Manager::TerritoryMgr >::ref().getRandomStream( *pSrc );
     for( const auto& pActor : inRange )
     {
       auto pChara = pActor->getAsChara();
@@ -277,7 +278,7 @@ namespace Sapphire::World::AI
       while( m_results.size() < count && !remaining.empty() )
       {
         // idk
-        std::shuffle( remaining.begin(), remaining.end(), *RNGMgr.getRNGEngine() );
+        std::shuffle( remaining.begin(), remaining.end(), randomStream );
 
         auto pChara = remaining.back();
         CharaEntry entry{};
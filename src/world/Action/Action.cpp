@@ -4,6 +4,7 @@
 
 #include <Exd/ExdData.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Util/UtilMath.h>
 #include "Common.h"
 #include "Script/ScriptMgr.h"
@@ -273,7 +274,7 @@ bool Action::Action::update()
     // todo: check if the target is still in range
   }
 
-  auto tickCount = static_cast< time_t >( Common::Util::getTimeMs() );
+  auto tickCount = static_cast< time_t >( Common::Util::FrameClock::getTimeMs() );
   auto startTime = static_cast< time_t >( m_startTime );
   uint64_t castTime = m_castTimeMs;
 
@@ -327,7 +328,7 @@ bool Action::Action::update()
 void Action::Action::start()
 {
   assert( m_pSource );
-  m_startTime = Common::Util::getTimeMs();
+  m_startTime = Common::Util::FrameClock::getTimeMs();
 
   auto player = m_pSource->getAsPlayer();
   
@@ -679,7 +680,7 @@ void Action::Action::applyStatusEffect( bool isSelf, Entity::CharaPtr& target, E
       int64_t remainingDuration = 0;
       if( hasSameStatus )
       {
-        remainingDuration = static_cast< int64_t >( referenceStatus->getDuration() ) - ( Common::Util::getTimeMs() - referenceStatus->getStartTimeMs() );
+        remainingDuration = static_cast< int64_t >( referenceStatus->getDuration() ) - ( Common::Util::FrameClock::getTimeMs() - referenceStatus->getStartTimeMs() );
         if( remainingDuration < 0 )
           remainingDuration = 0;
       }
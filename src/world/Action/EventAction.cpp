@@ -1,4 +1,5 @@
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Logging/Logger.h>
 #include <Exd/ExdData.h>
 #include <Exd/Structs.h>
@@ -51,7 +52,7 @@ void Action::EventAction::start()
   if( !m_pSource )
     return;
 
-  m_startTime = Common::Util::getTimeMs();
+  m_startTime = Common::Util::FrameClock::getTimeMs();
 
   auto control = makeActorControl( m_pSource->getId(), ActorControlType::CastStart, 1, m_id, 0x4000004E );
 
@@ -3,6 +3,7 @@
 
 #include <Exd/ExdData.h>
 #include <Exd/Structs.h>
+#include <Util/FrameClock.h>
 
 #include <Actor/Player.h>
 
@@ -98,5 +99,5 @@ void EventItemAction::execute()
 
 void EventItemAction::onStart()
 {
-  m_startTime = Common::Util::getTimeMs();
+  m_startTime = Common::Util::FrameClock::getTimeMs();
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <Logging/Logger.h>
 
 #include <Service.h>
+#include <Util/FrameClock.h>
 #include "WorldServer.h"
 
 using namespace Sapphire;
@@ -29,7 +30,7 @@ ItemManipulationAction::ItemManipulationAction( Entity::CharaPtr source, uint32_
 void ItemManipulationAction::start()
 {
   assert( m_pSource );
-  m_startTime = Common::Util::getTimeMs();
+  m_startTime = Common::Util::FrameClock::getTimeMs();
 
   onStart();
 
@@ -57,7 +58,7 @@ bool ItemManipulationAction::update()
   if( m_startTime == 0 )
     return false;
 
-  uint64_t tickCount = Common::Util::getTimeMs();
+  uint64_t tickCount = Common::Util::FrameClock::getTimeMs();
   uint32_t delayTime = m_delayTimeMs;
 
   if( std::difftime( static_cast< time_t >( tickCount ), static_cast< time_t >( m_startTime ) ) > delayTime )
@@ -4,7 +4,9 @@
 #include <Action/Action.h>
 #include <Actor/Player.h>
 #include <StatusEffect/StatusEffect.h>
-#include <stdlib.h>
+#include <Manager/TerritoryMgr.h>
+#include <Random/RandomStream.h>
+#include <Service.h>
 
 using namespace Sapphire;
 using namespace Sapphire::World::Action;
@@ -15,7 +17,8 @@ void Bard::onAction( Entity::Player& player, Action& action )
   {
     case HeavyShot:
     {
-      if( player.getLevel() >= 8 && ( float ) rand() / ( float ) RAND_MAX <= 0.2 )
+      auto& teriMgr = Common::Service< World::Manager::TerritoryMgr >::ref();
+      if( player.getLevel() >= 8 && teriMgr.getRandomStream( player ).nextFloat() <= 0.2f )
       {
         auto pActionBuilder = action.getActionResultBuilder();
         if( !pActionBuilder )
@@ -10,6 +10,7 @@
 
 #include <Service.h>
 #include <Util/UtilMath.h>
+#include <Util/FrameClock.h>
 
 #include "WorldServer.h"
 #include "Session.h"
@@ -39,7 +40,7 @@ void MountAction::start()
 {
   assert( m_pSource );
 
-  m_startTime = Common::Util::getTimeMs();
+  m_startTime = Common::Util::FrameClock::getTimeMs();
 
   auto player = m_pSource->getAsPlayer();
 
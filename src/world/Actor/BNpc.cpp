@@ -1,4 +1,5 @@
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Util/UtilMath.h>
 #include <Network/PacketContainer.h>
 #include <Exd/ExdData.h>
@@ -32,7 +33,6 @@
 #include "Common.h"
 
 #include <Manager/TerritoryMgr.h>
-#include <Random/RNGMgr.h>
 #include <Manager/InventoryMgr.h>
 #include <Manager/LootTableMgr.h>
 #include <Manager/PlayerMgr.h>
@@ -227,18 +227,6 @@ BNpc::BNpc( uint32_t id, std::shared_ptr< Common::BNpcCacheEntry > pInfo, const
   if( pInfo->WanderingRange == 0 || pInfo->BoundInstanceID != 0 )
     setFlag( Immobile | NoRoam );
 
-  auto& exdData = Common::Service< Data::ExdData >::ref();
-
-  auto bNpcBaseData = exdData.getRow< Excel::BNpcBase >( m_bNpcBaseId );
-  if( !bNpcBaseData )
-  {
-    Logger::debug( "BNpcBase#{0} not found in exd data!", m_bNpcBaseId );
-    return;
-  }
-
-  m_modelChara = bNpcBaseData->data().Model;
-  m_enemyType = bNpcBaseData->data().Battalion;
-
   m_class = ClassJob::Gladiator;
 
   m_spawnPos = m_pos;
@@ -255,10 +243,26 @@ BNpc::BNpc( uint32_t id, std::shared_ptr< Common::BNpcCacheEntry > pInfo, const
   m_status = ActorStatus::Idle;
 
   m_bnpcType = type;
+  // battalion of the base row, the type stands in for it without one
+  m_enemyType = type;
+  m_modelChara = 0;
+  m_naviTargetReachedDistance = m_radius;
 
   memset( m_customize, 0, sizeof( m_customize ) );
   memset( m_modelEquip, 0, sizeof( m_modelEquip ) );
 
+  auto& exdData = Common::Service< Data::ExdData >::ref();
+
+  auto bNpcBaseData = exdData.getRow< Excel::BNpcBase >( m_bNpcBaseId );
+  if( !bNpcBaseData )
+  {
+    Logger::debug( "BNpcBase#{0} not found in exd data!", m_bNpcBaseId );
+    return;
+  }
+
+  m_modelChara = bNpcBaseData->data().Model;
+  m_enemyType = bNpcBaseData->data().Battalion;
+
 
   m_radius = bNpcBaseData->data().Scale;
   if( bNpcBaseData->data().Customize != 0 )
@@ -349,7 +353,7 @@ uint32_t BNpc::getBNpcNameId() const
 
 void BNpc::spawn( PlayerPtr pTarget )
 {
-  m_lastRoamTargetReachedTime = Common::Util::getTimeSeconds();
+  m_lastRoamTargetReachedTime = Common::Util::FrameClock::getTimeSeconds();
 
   auto& server = Common::Service< World::WorldServer >::ref();
   server.queueForPlayer( pTarget->getCharacterId(), std::make_shared< NpcSpawnPacket >( *this, *pTarget ) );
@@ -453,7 +457,7 @@ void BNpc::sendPositionUpdate()
   if( m_lastPos.x != m_pos.x || m_lastPos.y != m_pos.y || m_lastPos.z != m_lastPos.z )
   {
     auto movePacket = std::make_shared< MoveActorPacket >( *getAsChara(), 0x3A, animationType, 0, 0x5A / 4 );
-    server().queueForPlayers( getInRangePlayerIds(), movePacket );
+    server().queueDroppableForPlayers( getInRangePlayerIds(), movePacket );
   }
   m_lastPos = m_pos;
 }
@@ -653,8 +657,8 @@ void BNpc::hateListUpdatePlayers()
 
 void BNpc::aggro( const Sapphire::Entity::CharaPtr& pChara )
 {
-  auto& pRNGMgr = Common::Service< Common::Random::RNGMgr >::ref();
-  auto variation = static_cast< uint32_t >( pRNGMgr.getRandGenerator< float >( 500, 1000 ).next() );
+  auto& teriMgr = Common::Service< World::Manager::TerritoryMgr >::ref();
+  auto variation = teriMgr.getRandomStream( *this ).nextInt( 500, 999 );
 
 
   if( !hateListHasActor( pChara ) )
@@ -676,7 +680,7 @@ void BNpc::aggro( const Sapphire::Entity::CharaPtr& pChara )
     m_pGambitPack->getAsTimeLine()->start();
   }
 
-  m_lastAttack = Common::Util::getTimeMs() + variation;
+  m_lastAttack = Common::Util::FrameClock::getTimeMs() + variation;
 
   setStance( Stance::Active );
   m_state = BNpcState::Combat;
@@ -782,7 +786,7 @@ void BNpc::onDeath()
   setTargetId( INVALID_GAME_OBJECT_ID64 );
   m_currentStance = Stance::Passive;
   m_state = BNpcState::Dead;
-  m_timeOfDeath = Common::Util::getTimeSeconds();
+  m_timeOfDeath = Common::Util::FrameClock::getTimeSeconds();
   setOwner( nullptr );
 
   taskMgr.queueTask( World::makeFadeBNpcTask( 10000, getAsBNpc() ) );
@@ -1139,7 +1143,7 @@ void BNpc::autoAttack( CharaPtr pTarget )
   auto& actionMgr = Common::Service< World::Manager::ActionMgr >::ref();
   auto& exdData = Common::Service< Data::ExdData >::ref();
 
-  uint64_t tick = Common::Util::getTimeMs();
+  uint64_t tick = Common::Util::FrameClock::getTimeMs();
 
   // todo: this needs to use the auto attack delay for the equipped weapon
   if( ( tick - m_lastAttack ) > 2500 )
@@ -1226,7 +1230,7 @@ void BNpc::init()
   m_maxHp = Math::CalcStats::calculateMaxHp( *getAsChara() );
   m_hp = m_maxHp;
 
-  m_lastRoamTargetReachedTime = Common::Util::getTimeSeconds();
+  m_lastRoamTargetReachedTime = Common::Util::FrameClock::getTimeSeconds();
 
   /*
   //setup a test gambit
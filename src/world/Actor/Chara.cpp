@@ -1,4 +1,5 @@
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Util/UtilMath.h>
 #include <Exd/ExdData.h>
 #include <utility>
@@ -49,7 +50,7 @@ Chara::Chara( ObjKind type ) :
 
   m_lastTickTime = 0;
   m_lastUpdate = 0;
-  m_lastAttack = Common::Util::getTimeMs();
+  m_lastAttack = Common::Util::FrameClock::getTimeMs();
 
   m_bonusStats.fill( 0 );
 }
@@ -366,8 +367,6 @@ bool Chara::checkAction()
 
 void Chara::update( uint64_t tickCount )
 {
-  updateStatusEffects();
-
   if( std::difftime( static_cast< time_t >( tickCount ), m_lastTickTime ) > 3000 )
   {
     onTick();
@@ -498,16 +497,15 @@ Will have to be extended for ranged attacks.
 */
 void Chara::autoAttack( CharaPtr pTarget )
 {
-  uint64_t tick = Common::Util::getTimeMs();
+  uint64_t tick = Common::Util::FrameClock::getTimeMs();
 
   // todo: this needs to use the auto attack delay for the equipped weapon
   if( ( tick - m_lastAttack ) > 2500 )
   {
     pTarget->onActionHostile( getAsChara(), 1 );
     m_lastAttack = tick;
-    srand( static_cast< uint32_t >( tick ) );
-
-    auto damage = static_cast< uint16_t >( 10 + rand() % 12 );
+    auto& teriMgr = Common::Service< World::Manager::TerritoryMgr >::ref();
+    auto damage = static_cast< uint16_t >( teriMgr.getRandomStream( *this ).nextInt( 10, 21 ) );
 
     auto effectPacket = std::make_shared< EffectPacket1 >( getId(), pTarget->getId(), 7 );
     effectPacket->setRotation( Common::Util::floatToUInt16Rot( getRot() ) );
@@ -539,6 +537,10 @@ void Chara::addStatusEffect( StatusEffect::StatusEffectPtr pEffect )
   pEffect->setSlot( nextSlot );
   m_statusEffectMap[ nextSlot ] = pEffect;
   pEffect->applyStatus();
+
+  // ticks and expiry are driven by the territory from here on
+  if( pZone )
+    pZone->getStatusEffectQueue().schedule( pEffect );
 }
 
 /*! \param StatusEffectPtr to be applied to the actor */
@@ -585,6 +587,10 @@ void Chara::replaceSingleStatusEffect( uint32_t slotId, StatusEffect::StatusEffe
   pStatus->setSlot( slotId );
   m_statusEffectMap[ slotId ] = pStatus;
   pStatus->applyStatus();
+
+  auto& teriMgr = Common::Service< Manager::TerritoryMgr >::ref();
+  if( auto pZone = teriMgr.getTerritoryByGuId( getTerritoryId() ) )
+    pZone->getStatusEffectQueue().schedule( pStatus );
 }
 
 void Chara::replaceSingleStatusEffectById( uint32_t id )
@@ -695,7 +701,7 @@ std::map< uint8_t, Sapphire::StatusEffect::StatusEffectPtr >::iterator Chara::re
   return it;
 }
 
-std::map< uint8_t, StatusEffect::StatusEffectPtr > Chara::getStatusEffectMap() const
+const std::map< uint8_t, StatusEffect::StatusEffectPtr >& Chara::getStatusEffectMap() const
 {
   return m_statusEffectMap;
 }
@@ -733,7 +739,7 @@ void Chara::setPose( uint8_t pose )
 
 void Chara::sendStatusEffectUpdate()
 {
-  uint64_t currentTimeMs = Common::Util::getTimeMs();
+  uint64_t currentTimeMs = Common::Util::FrameClock::getTimeMs();
 
   auto statusEffectList = makeZonePacket< FFXIVIpcStatus >( getId() );
   uint8_t slot = 0;
@@ -750,33 +756,6 @@ void Chara::sendStatusEffectUpdate()
   server().queueForPlayers( getInRangePlayerIds( isPlayer() ), statusEffectList );
 }
 
-void Chara::updateStatusEffects()
-{
-  uint64_t currentTimeMs = Common::Util::getTimeMs();
-
-  for( auto effectIt = m_statusEffectMap.begin(); effectIt != m_statusEffectMap.end(); )
-  {
-    uint8_t effectIndex = effectIt->first;
-    auto effect = effectIt->second;
-
-    uint64_t lastTick = effect->getLastTickMs();
-    uint64_t startTime = effect->getStartTimeMs();
-    uint32_t duration = effect->getDuration();
-    uint32_t tickRate = effect->getTickRate();
-
-    if( duration > 0 && ( currentTimeMs - startTime ) > duration )
-      effectIt = removeStatusEffect( effectIndex );
-    else
-      ++effectIt;
-
-    if( ( currentTimeMs - lastTick ) > tickRate )
-    {
-      effect->setLastTick( currentTimeMs );
-      effect->onTick();
-    }
-  }
-}
-
 bool Chara::hasStatusEffect( uint32_t id )
 {
   for( const auto& [ key, val ] : m_statusEffectMap )
@@ -796,7 +775,7 @@ int64_t Chara::getLastUpdateTime() const
 void Chara::setLastComboActionId( uint32_t actionId )
 {
   m_lastComboActionId = actionId;
-  m_lastComboActionTime = Common::Util::getTimeMs();
+  m_lastComboActionTime = Common::Util::FrameClock::getTimeMs();
 }
 
 uint32_t Chara::getLastComboActionId() const
@@ -804,7 +783,7 @@ uint32_t Chara::getLastComboActionId() const
   // initially check for the time passed first, if it's more than the threshold just return 0 for the combo
   // we can hide the implementation detail this way and it just works:tm: for anything that uses it
 
-  if( std::difftime( static_cast< time_t >( Common::Util::getTimeMs() ),
+  if( std::difftime( static_cast< time_t >( Common::Util::FrameClock::getTimeMs() ),
                      static_cast< time_t >( m_lastComboActionTime ) ) > Common::MAX_COMBO_LENGTH )
   {
     return 0;
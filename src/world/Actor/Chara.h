@@ -135,8 +135,6 @@ namespace Sapphire::Entity
 
     void removeStatusEffectByFlag( Common::StatusEffectFlag flag );
 
-    void updateStatusEffects();
-
     bool hasStatusEffect( uint32_t id );
 
     int8_t getStatusEffectFreeSlot();
@@ -147,7 +145,7 @@ namespace Sapphire::Entity
 
     void setPose( uint8_t pose );
 
-    std::map< uint8_t, Sapphire::StatusEffect::StatusEffectPtr > getStatusEffectMap() const;
+    const std::map< uint8_t, Sapphire::StatusEffect::StatusEffectPtr >& getStatusEffectMap() const;
 
     Sapphire::StatusEffect::StatusEffectPtr getStatusEffectById( uint32_t id ) const;
 
@@ -206,7 +206,11 @@ void GameObject::addInRangeActor( GameObjectPtr pActor )
   {
     auto pPlayer = pActor->getAsPlayer();
 
-    spawn( pPlayer );
+    // charas compete for the limited actor spawn slots of the player, the spawn budget decides when they show up
+    if( isPlayer() || isBattleNpc() )
+      pPlayer->requestActorSpawn( getId() );
+    else
+      spawn( pPlayer );
 
     // if actor is a player, add it to the in range player set
     m_inRangePlayers.insert( pPlayer );
@@ -372,3 +376,13 @@ void GameObject::setCellId( CellId cellId )
 {
   m_cellId = cellId;
 }
+
+Util::Handle GameObject::getHandle() const
+{
+  return m_handle;
+}
+
+void GameObject::setHandle( Util::Handle handle )
+{
+  m_handle = handle;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Common.h>
+#include <Util/HandleTable.h>
 #include <memory>
 
 #include "ForwardsZone.h"
@@ -39,6 +40,8 @@ namespace Sapphire::Entity
 
     /*! Parent cell in the zone */
     Common::CellId m_cellId;
+    /*! Handle of the actor inside the actor table of its current zone */
+    Common::Util::Handle m_handle{ Common::Util::InvalidHandle };
 
   public:
     explicit GameObject( Common::ObjKind type );
@@ -135,6 +138,10 @@ namespace Sapphire::Entity
     // set the current cell
     void setCellId( Common::CellId cellId );
 
+    // handle inside the actor table of the current zone, only valid while the actor is in that zone
+    Common::Util::Handle getHandle() const;
+    void setHandle( Common::Util::Handle handle );
+
   };
 
 }
\ No newline at end of file
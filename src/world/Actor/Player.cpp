@@ -13,7 +13,6 @@
 #include "BNpc.h"
 
 #include "Manager/TerritoryMgr.h"
-#include <Random/RNGMgr.h>
 #include "Manager/PlayerMgr.h"
 #include "Manager/PartyMgr.h"
 #include "Manager/WarpMgr.h"
@@ -22,6 +21,7 @@
 #include "Manager/MgrUtil.h"
 #include "Manager/ActionMgr.h"
 #include "Manager/AchievementMgr.h"
+#include "Manager/PresenceMgr.h"
 
 #include "Territory/InstanceContent.h"
 
@@ -83,7 +83,8 @@ Player::Player() :
   m_partyId( 0 ),
   m_onlineStatusCustom( 0 ),
   m_onlineStatus( 0 ),
-  m_bIsConnected( false )
+  m_bIsConnected( false ),
+  m_spawnBudget( *this )
 {
   m_id = 0;
   m_currentStance = Stance::Passive;
@@ -414,6 +415,7 @@ uint8_t Player::getGender() const
 void Player::initSpawnIdQueue()
 {
   m_actorSpawnIndexAllocator.freeAllSpawnIndexes();
+  m_spawnBudget.clear();
 }
 
 uint8_t Player::getSpawnIdForActorId( uint32_t actorId )
@@ -437,6 +439,16 @@ bool Player::isActorSpawnIdValid( uint8_t spawnIndex )
   return m_actorSpawnIndexAllocator.isSpawnIndexValid( spawnIndex );
 }
 
+bool Player::hasFreeActorSpawnId() const
+{
+  return m_actorSpawnIndexAllocator.hasFreeSpawnIndex();
+}
+
+void Player::requestActorSpawn( uint32_t actorId )
+{
+  m_spawnBudget.requestSpawn( actorId );
+}
+
 void Player::registerAetheryte( uint8_t aetheryteId )
 {
   uint16_t index;
@@ -695,7 +707,7 @@ void Player::despawn( Entity::PlayerPtr pTarget )
   Logger::debug( "Despawning {0} for {1}", getName(), pTarget->getName() );
 
   pPlayer->freePlayerSpawnId( getId() );
-  Network::Util::Packet::sendActorControlSelf( *this, pTarget->getId(), WarpStart, 4, getId(), 1 );
+  Network::Util::Packet::sendActorControlSelf( *pTarget, getId(), WarpStart, 4, getId(), 1 );
 }
 
 GameObjectPtr Player::lookupTargetById( uint64_t targetId )
@@ -726,6 +738,7 @@ void Player::setGrandCompany( uint8_t gc )
   if( m_gcRank[ gc ] == 0 )
     m_gcRank[ gc ] = 1;
   Network::Util::Packet::sendGrandCompany( *this );
+  Common::Service< World::Manager::PresenceMgr >::ref().onProfileChanged( *this );
 }
 
 void Player::setGrandCompanyRankAt( uint8_t index, uint8_t rank )
@@ -797,11 +810,15 @@ void Player::update( uint64_t tickCount )
   // todo: better way to handle this override chara update
   Service< World::Manager::PlayerMgr >::ref().onUpdate( *this, tickCount );
 
+  m_spawnBudget.update( tickCount );
+
   Chara::update( tickCount );
 }
 
 void Player::freePlayerSpawnId( uint32_t actorId )
 {
+  m_spawnBudget.cancelSpawn( actorId );
+
   auto spawnId = m_actorSpawnIndexAllocator.freeUsedSpawnIndex( actorId );
 
   // actor was never spawned for this player
@@ -904,6 +921,11 @@ uint64_t Player::getCharacterId() const
   return m_characterId;
 }
 
+void Player::setCharacterId( uint64_t characterId )
+{
+  m_characterId = characterId;
+}
+
 uint8_t Player::getVoiceId() const
 {
   return m_voice;
@@ -1118,6 +1140,23 @@ const Player::AchievementData& Player::getAchievementData() const
 void Player::setAchievementData( const Player::AchievementData& achievementData )
 {
   m_achievementData = achievementData;
+  m_achievementDataDirty = true;
+}
+
+uint32_t Player::addAchievementProgress( uint32_t dataKey, uint32_t amount )
+{
+  m_achievementDataDirty = true;
+  return m_achievementData.progressData[ dataKey ] += amount;
+}
+
+void Player::setAchievementProgress( uint32_t dataKey, uint32_t value )
+{
+  auto& progress = m_achievementData.progressData[ dataKey ];
+  if( progress == value )
+    return;
+
+  progress = value;
+  m_achievementDataDirty = true;
 }
 
 void Player::setMaxGearSets( uint8_t amount )
@@ -1209,8 +1248,7 @@ void Player::autoAttack( CharaPtr pTarget )
   if( weaponType == ItemUICategory::ArchersArm || weaponType == ItemUICategory::MachinistsArm)
     attackId = 8;
 
-  auto& RNGMgr = Common::Service< Common::Random::RNGMgr >::ref();
-  auto variation = static_cast< uint32_t >( RNGMgr.getRandGenerator< float >( 0, 3 ).next() );
+  auto variation = pZone->getRandomStream().nextInt( 0, 2 );
 
   actionMgr.handleTargetedAction( *this, attackId, pTarget->getId(), 0 );
 
@@ -10,6 +10,7 @@
 #include "Chara.h"
 #include "Quest/Quest.h"
 #include "Event/EventHandler.h"
+#include "Util/SpawnBudget.h"
 
 #include <map>
 #include <queue>
@@ -295,6 +296,9 @@ namespace Sapphire::Entity
     /*! return the characterId */
     uint64_t getCharacterId() const;
 
+    /*! sets the characterId, set by loadFromDb for players of a session */
+    void setCharacterId( uint64_t characterId );
+
     /*! return max hp */
     uint32_t getMaxHp();
 
@@ -360,6 +364,12 @@ namespace Sapphire::Entity
     /*! set player's achievement data */
     void setAchievementData( const AchievementData& achievementData );
 
+    /*! add to the achievement progress stored under dataKey, returns the new progress */
+    uint32_t addAchievementProgress( uint32_t dataKey, uint32_t amount );
+
+    /*! set the achievement progress stored under dataKey */
+    void setAchievementProgress( uint32_t dataKey, uint32_t value );
+
     /*! set number of gear sets */
     void setMaxGearSets( uint8_t amount );
 
@@ -497,6 +507,12 @@ namespace Sapphire::Entity
     /*! checks if the given spawn id is valid */
     bool isActorSpawnIdValid( uint8_t spawnId );
 
+    /*! checks if there is at least one actor spawn id left */
+    bool hasFreeActorSpawnId() const;
+
+    /*! queue the actor to be spawned for this player once the spawn budget allows it */
+    void requestActorSpawn( uint32_t actorId );
+
     /*! send spawn packets to pTarget */
     void spawn( PlayerPtr pTarget ) override;
 
@@ -664,7 +680,11 @@ namespace Sapphire::Entity
 
     void updateDbMonsterNote();
 
-    void updateDbFriendList();
+    /*! write a single friend list entry */
+    void updateDbFriend( uint64_t friendCharacterId, const Common::HierarchyData& hierarchy );
+
+    /*! remove a single friend list entry */
+    void removeDbFriend( uint64_t friendCharacterId );
 
     void updateDbBlacklist();
 
@@ -699,6 +719,9 @@ namespace Sapphire::Entity
     //////////////////////////////////////////////////////////////////////////////////////////////////////
     void initInventory();
 
+    /*! creates the empty inventory containers, initInventory fills them from the db */
+    void initInventoryContainers();
+
     void setRunning( bool isRunning );
     bool isRunning() const;
 
@@ -864,6 +887,8 @@ namespace Sapphire::Entity
     } m_retainerInfo[8]{};
 
     AchievementData m_achievementData{};
+    /*! achievement data changed since the last db write */
+    bool m_achievementDataDirty{ false };
     
     uint16_t m_activeTitle{};
     TitleList m_titleList{};
@@ -959,6 +984,7 @@ namespace Sapphire::Entity
 
     Common::Util::SpawnIndexAllocator< uint8_t > m_objSpawnIndexAllocator;
     Common::Util::SpawnIndexAllocator< uint8_t > m_actorSpawnIndexAllocator;
+    World::Util::SpawnBudget m_spawnBudget;
 
     std::array< Common::HuntingLogEntry, Common::ARRSIZE_MONSTERNOTE > m_huntingLogEntries{};
 
@@ -7,6 +7,7 @@
 
 #include "Inventory/Item.h"
 #include "Inventory/ItemContainer.h"
+#include "Inventory/InventoryJournal.h"
 
 #include <Exd/ExdData.h>
 #include <Database/DatabaseDef.h>
@@ -38,11 +39,21 @@ using namespace Sapphire::Network::ActorControl;
 
 
 void Player::initInventory()
+{
+  initInventoryContainers();
+  loadInventory();
+  calculateItemLevel();
+}
+
+void Player::initInventoryContainers()
 {
   const uint8_t inventorySize = 25;
   auto setupContainer = [ this ]( InventoryType type, uint8_t maxSize, const std::string& tableName,
                                   bool isMultiStorage, bool isPersistentStorage = true )
-  { m_storageMap[ type ] = make_ItemContainer( type, maxSize, tableName, isMultiStorage, isPersistentStorage ); };
+  {
+    m_storageMap[ type ] = make_ItemContainer( type, maxSize, tableName, isMultiStorage, isPersistentStorage );
+    m_storageMap[ type ]->setOwnerCharacterId( getCharacterId() );
+  };
 
   // main bags
   setupContainer( Bag0, inventorySize, "charaiteminventory", true );
@@ -101,9 +112,6 @@ void Player::initInventory()
   // item hand in container
   // non-persistent container, will not save its contents
   setupContainer( HandIn, 10, "", true, false );
-
-  loadInventory();
-  calculateItemLevel();
 }
 
 void Player::equipWeapon( const Item& item )
@@ -537,70 +545,45 @@ uint32_t Player::getCrystal( CrystalType type )
 
 void Player::writeInventory( InventoryType type )
 {
-  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
+  auto& journal = Common::Service< Inventory::InventoryJournal >::ref();
 
   auto storage = m_storageMap[ type ];
 
   if( !storage->isPersistentStorage() )
     return;
 
-  std::string query = "UPDATE " + storage->getTableName() + " SET ";
+  int32_t storageId = storage->isMultiStorage() ? static_cast< uint16_t >( type ) : -1;
 
   for( int32_t i = 0; i <= storage->getMaxSize(); i++ )
   {
     auto currItem = storage->getItem( i );
-
-    if( i > 0 )
-      query += ", ";
-
-    query += "container_" + std::to_string( i ) + " = " + std::to_string(  currItem ? currItem->getUId() : 0 );
+    journal.setContainerSlot( getCharacterId(), storage->getTableName(), storageId, static_cast< uint16_t >( i ),
+                              currItem ? currItem->getUId() : 0 );
   }
-
-  query += " WHERE CharacterId = " + std::to_string( getCharacterId() );
-
-  if( storage->isMultiStorage() )
-    query += " AND storageId = " + std::to_string( static_cast< uint16_t >( type ) );
-
-  db.execute( query );
 }
 
 void Player::writeItem( ItemPtr pItem ) const
 {
-  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
-  auto stmt = db.getPreparedStatement( Db::CHARA_ITEMGLOBAL_UP );
+  auto& journal = Common::Service< Inventory::InventoryJournal >::ref();
 
   // todo: add more fields
-  stmt->setInt( 1, pItem->getStackSize() );
-  stmt->setInt( 2, pItem->getDurability() );
-  stmt->setInt( 3, pItem->getStain() );
-  stmt->setInt( 4, pItem->getPattern() );
-
-  stmt->setInt64( 5, pItem->getUId() );
-
-  db.directExecute( stmt );
+  journal.updateItem( getCharacterId(), *pItem );
 }
 
 void Player::writeCurrencyItem( CurrencyType type )
 {
-  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
+  auto& journal = Common::Service< Inventory::InventoryJournal >::ref();
 
   auto money = m_storageMap[ Currency ]->getItem( static_cast< uint16_t >( type ) - 1 )->getStackSize();
 
-  std::string query = fmt::format(
-    "UPDATE charaitemcurrency SET container_{0} = {1} WHERE CharacterId = {2};",
-    std::to_string( static_cast< int16_t >( type ) - 1 ), std::to_string( money ), std::to_string( getCharacterId() ) );
-
-  db.execute( query );
+  journal.setContainerSlot( getCharacterId(), "charaitemcurrency", -1, static_cast< uint16_t >( type ) - 1, money );
 }
 
 void Player::deleteItemDb( ItemPtr item ) const
 {
-  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
-  auto stmt = db.getPreparedStatement( Db::CHARA_ITEMGLOBAL_DELETE );
-
-  stmt->setInt64( 1, item->getUId() );
+  auto& journal = Common::Service< Inventory::InventoryJournal >::ref();
 
-  db.directExecute( stmt );
+  journal.deleteItem( getCharacterId(), item->getUId() );
 }
 
 
@@ -909,7 +892,7 @@ void Player::mergeItem( uint16_t fromInventoryId, uint16_t fromSlotId, uint16_t
   // we can destroy the original stack if there's no overflow
   if( stackOverflow == 0 )
   {
-    m_storageMap[ fromInventoryId ]->removeItem( fromSlotId );
+    m_storageMap[ fromInventoryId ]->removeItem( fromSlotId, false );
     deleteItemDb( fromItem );
   }
   else
@@ -968,7 +951,7 @@ void Player::discardItem( uint16_t fromInventoryId, uint16_t fromSlotId )
 
   deleteItemDb( fromItem );
 
-  m_storageMap[ fromInventoryId ]->removeItem( fromSlotId );
+  m_storageMap[ fromInventoryId ]->removeItem( fromSlotId, false );
   updateContainer( fromInventoryId, fromSlotId, nullptr );
 
   auto invTransPacket = makeZonePacket< FFXIVIpcItemOperation >( getId() );
@@ -9,6 +9,7 @@
 #include "Network/PacketWrappers/PlayerSetupPacket.h"
 
 #include "Manager/TerritoryMgr.h"
+#include "Inventory/InventoryJournal.h"
 #include "Inventory/Item.h"
 #include "Inventory/ItemContainer.h"
 #include "Manager/ItemMgr.h"
@@ -343,14 +344,12 @@ void Player::updateSql()
   ////// MonterNote
   updateDbMonsterNote();
 
-  ////// FriendList
-  updateDbFriendList();
-
   ////// Blacklist
   updateDbBlacklist();
 
-  ////// Achievement
-  updateDbAchievement();
+  ////// Achievement, progress piles up in memory between writes
+  if( m_achievementDataDirty )
+    updateDbAchievement();
 
   ///// Store last write
   syncLastDBWrite();
@@ -523,20 +522,25 @@ void Player::updateDbMonsterNote()
   db.execute( stmt );
 }
 
-void Player::updateDbFriendList()
+void Player::updateDbFriend( uint64_t friendCharacterId, const Common::HierarchyData& hierarchy )
 {
   auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
 
-  auto stmt = db.getPreparedStatement( Db::CHARA_FRIENDLIST_UP );
+  auto stmt = db.getPreparedStatement( Db::CHARA_FRIEND_UP );
+  stmt->setUInt64( 1, m_characterId );
+  stmt->setUInt64( 2, friendCharacterId );
+  stmt->setUInt64( 3, hierarchy.u64 );
+  stmt->setUInt64( 4, hierarchy.u64 );
+  db.execute( stmt );
+}
 
-  std::vector< uint8_t > friendIds( 1600 );
-  std::vector< uint8_t > inviteIds( 1600 );
+void Player::removeDbFriend( uint64_t friendCharacterId )
+{
+  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
 
-  memcpy( friendIds.data(), m_friendList.data(), 1600 );
-  memcpy( inviteIds.data(), m_friendInviteList.data(), 1600 );
-  stmt->setBinary( 1, friendIds );
-  stmt->setBinary( 2, inviteIds );
-  stmt->setUInt64( 3, m_characterId );
+  auto stmt = db.getPreparedStatement( Db::CHARA_FRIEND_DEL );
+  stmt->setUInt64( 1, m_characterId );
+  stmt->setUInt64( 2, friendCharacterId );
   db.execute( stmt );
 }
 
@@ -561,7 +565,8 @@ void Player::updateDbAchievement()
 
   auto stmt = db.getPreparedStatement( Db::CHARA_ACHIEV_UP );
 
-  std::vector< int > flattenMap( m_achievementData.progressData.size() * 2 );
+  std::vector< int > flattenMap;
+  flattenMap.reserve( m_achievementData.progressData.size() * 2 );
 
   for( const auto& [ key, val ] : m_achievementData.progressData )
   {
@@ -582,6 +587,8 @@ void Player::updateDbAchievement()
   stmt->setBinary( 3, history );
   stmt->setUInt64( 4, m_characterId );
   db.execute( stmt );
+
+  m_achievementDataDirty = false;
 }
 
 
@@ -695,26 +702,20 @@ void Player::insertDbQuest( const World::Quest& quest, uint8_t index ) const
 ItemPtr Player::createItem( uint32_t catalogId, uint32_t quantity )
 {
   auto& exdData = Common::Service< Data::ExdData >::ref();
-  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
   auto& itemMgr = Common::Service< World::Manager::ItemMgr >::ref();
+  auto& journal = Common::Service< Inventory::InventoryJournal >::ref();
 
   auto itemInfo = exdData.getRow< Excel::Item >( catalogId );
 
   if( !itemInfo )
     return nullptr;
 
-  uint8_t flags = 0;
-
   ItemPtr pItem = make_Item( itemMgr.getNextUId(), catalogId );
 
   pItem->setStackSize( quantity );
 
-  db.execute( "INSERT INTO charaglobalitem ( CharacterId, itemId, catalogId, stack, flags ) VALUES ( " +
-               std::to_string( m_characterId ) + ", " +
-               std::to_string( pItem->getUId() ) + ", " +
-               std::to_string( pItem->getId() ) + ", " +
-               std::to_string( quantity ) + ", " +
-               std::to_string( flags ) + ");" );
+  // lands before the container write pointing at it, both go out with the next journal flush
+  journal.createItem( m_characterId, m_characterId, *pItem );
 
   return pItem;
 }
@@ -821,24 +822,57 @@ bool Player::loadInventory()
 bool Player::loadFriendList()
 {
   auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
-  auto stmt = db.getPreparedStatement( Db::ZoneDbStatements::CHARA_FRIENDLIST_SEL );
+  auto stmt = db.getPreparedStatement( Db::ZoneDbStatements::CHARA_FRIEND_SEL );
   stmt->setUInt64( 1, m_characterId );
   auto res = db.query( stmt );
 
-  if( !res->next() )
+  size_t idx = 0;
+  while( res->next() && idx < m_friendList.size() )
   {
-    Logger::error( "Failed to load friendlist data for character#{}", m_characterId );
-    return false;
+    m_friendList[ idx ] = res->getUInt64( 1 );
+    m_friendInviteList[ idx ].u64 = res->getUInt64( 2 );
+    ++idx;
   }
 
-  auto friendList = res->getBlobVector( "CharacterIdList" );
-  auto friendInviteList = res->getBlobVector( "InviteDataList" );
+  if( idx > 0 )
+    return true;
+
+  // nothing in the friend table yet, move over the list from the old blob storage if there is one
+  auto legacyStmt = db.getPreparedStatement( Db::ZoneDbStatements::CHARA_FRIENDLIST_SEL );
+  legacyStmt->setUInt64( 1, m_characterId );
+  auto legacyRes = db.query( legacyStmt );
+
+  if( !legacyRes->next() )
+    return true;
+
+  auto friendList = legacyRes->getBlobVector( "CharacterIdList" );
+  auto friendInviteList = legacyRes->getBlobVector( "InviteDataList" );
 
   if( !friendList.empty() )
-    std::memcpy( m_friendList.data(), friendList.data(), friendList.size() );
+    std::memcpy( m_friendList.data(), friendList.data(), std::min( friendList.size(), sizeof( m_friendList ) ) );
 
   if( !friendInviteList.empty() )
-    std::memcpy( m_friendInviteList.data(), friendInviteList.data(), friendInviteList.size() );
+    std::memcpy( m_friendInviteList.data(), friendInviteList.data(), std::min( friendInviteList.size(), sizeof( m_friendInviteList ) ) );
+
+  bool hasEntries = false;
+  for( size_t i = 0; i < m_friendList.size(); ++i )
+  {
+    if( m_friendList[ i ] == 0 )
+      continue;
+
+    updateDbFriend( m_friendList[ i ], m_friendInviteList[ i ] );
+    hasEntries = true;
+  }
+
+  // clear the blob so removed friends don't come back with the next import
+  if( hasEntries )
+  {
+    auto clearStmt = db.getPreparedStatement( Db::ZoneDbStatements::CHARA_FRIENDLIST_UP );
+    clearStmt->setBinary( 1, std::vector< uint8_t >( sizeof( m_friendList ), 0 ) );
+    clearStmt->setBinary( 2, std::vector< uint8_t >( sizeof( m_friendInviteList ), 0 ) );
+    clearStmt->setUInt64( 3, m_characterId );
+    db.execute( clearStmt );
+  }
 
   return true;
 }
@@ -16,6 +16,9 @@
 #include "Manager/PlayerMgr.h"
 #include "Manager/TerritoryMgr.h"
 #include "Manager/WarpMgr.h"
+#include "Manager/TaskMgr.h"
+
+#include "Task/ContentReadyCheckTask.h"
 
 #include <WorldServer.h>
 
@@ -31,6 +34,15 @@ void World::ContentFinder::update()
 {
   auto& exdData = Service< Data::ExdData >::ref();
   auto& server = Service< WorldServer >::ref();
+
+  // only contents with new players can produce a match
+  auto dirtyContentIds = std::move( m_dirtyContentIds );
+  m_dirtyContentIds.clear();
+  for( auto contentId : dirtyContentIds )
+    matchContent( contentId );
+
+  std::vector< uint32_t > removedRegisterIds;
+
   for( auto& contentIt : m_queuedContent )
   {
     auto& content = contentIt.second;
@@ -62,6 +74,9 @@ void World::ContentFinder::update()
         }
 
         content->setState( WaitingForAccept );
+
+        auto& taskMgr = Service< TaskMgr >::ref();
+        taskMgr.queueTask( makeContentReadyCheckTask( ReadyCheckTimeoutMs, content->getRegisterId() ) );
         break;
       }
 
@@ -92,7 +107,11 @@ void World::ContentFinder::update()
           }
         }
 
-        content->setState( InProgress );
+        // the players are done with the finder and can queue again, the group is not tracked any further
+        for( auto& queuedPlayer : content->m_players )
+          m_queuedPlayer.erase( queuedPlayer->getEntityId() );
+
+        content->setState( ToBeRemoved );
         break;
       }
       case InProgress:
@@ -100,28 +119,36 @@ void World::ContentFinder::update()
       case InProgressRefill:
         break;
       case ToBeRemoved:
-        auto regId = content->getRegisterId();
-        bool contentRemoved = removeContentByRegisterId( regId );
-        if( contentRemoved )
-        {
-          Logger::info( "[ContentFinder] registerId#{} removed", regId );
-          return;
-        }
+        removedRegisterIds.push_back( content->getRegisterId() );
         break;
     }
   }
 
+  for( auto regId : removedRegisterIds )
+  {
+    if( removeContentByRegisterId( regId ) )
+      Logger::info( "[ContentFinder] registerId#{} removed", regId );
+  }
 }
 
 void World::ContentFinder::registerContentsRequest( Entity::Player &player, const std::vector< uint32_t >& contentIds )
 {
-  queueForContent( player, contentIds );
-  completeRegistration( player );
+  if( queueForContent( player, contentIds ) )
+    completeRegistration( player );
 }
 
 void World::ContentFinder::registerContentRequest( Entity::Player &player, uint32_t contentId, uint8_t flags )
 {
-  queueForContent( player, { contentId } );
+  if( !queueForContent( player, { contentId } ) )
+    return;
+
+  // Undersized, the player enters alone without waiting for others
+  if( flags & 0x01 )
+  {
+    auto pContent = createGroup( contentId, { m_queuedPlayer[ player.getId() ] } );
+    pContent->m_flags |= FindContentFlag::Undersized;
+  }
+
   completeRegistration( player, flags );
 }
 
@@ -140,22 +167,25 @@ void World::ContentFinder::registerRandomContentRequest( Entity::Player &player,
     }
   }
 
-  queueForContent( player, idList );
-  completeRegistration( player );
+  if( queueForContent( player, idList ) )
+    completeRegistration( player );
 }
 
 void World::ContentFinder::completeRegistration( const Entity::Player &player, uint8_t flags )
 {
   auto& server = Service< WorldServer >::ref();
-  auto queuedContent = m_queuedContent[ m_queuedPlayer[ player.getId() ]->getActiveRegisterId() ];
+  auto pQPlayer = m_queuedPlayer[ player.getId() ];
 
   auto& exdData = Service< Data::ExdData >::ref();
 
-  auto content = exdData.getRow< Excel::InstanceContent >( queuedContent->getInstanceId() );
+  auto contentId = pQPlayer->m_contentIds.front();
+  auto content = exdData.getRow< Excel::InstanceContent >( contentId );
 
   // Undersized
   if( flags & 0x01 )
   {
+    auto queuedContent = m_queuedContent[ pQPlayer->getActiveRegisterId() ];
+
     auto updatePacket = makeUpdateFindContent( player.getId(), content->data().TerritoryType,
                                                CompleteRegistration, 1, static_cast< uint32_t >( player.getClass() ), FindContentFlag::Undersized );
     server.queueForPlayer( player.getCharacterId(), updatePacket );
@@ -163,57 +193,218 @@ void World::ContentFinder::completeRegistration( const Entity::Player &player, u
     auto statusPacket = makeNotifyFindContentStatus( player.getId(), content->data().TerritoryType, 2, queuedContent->m_attackerCount + queuedContent->m_rangeCount,
                                                      queuedContent->m_healerCount, queuedContent->m_tankCount, 0 );
     server.queueForPlayer( player.getCharacterId(), statusPacket );
-
-    queuedContent->m_flags |= FindContentFlag::Undersized;
-    queuedContent->setState( MatchingComplete );
   }
   else
   {
+    auto& contentQueue = getContentQueue( contentId ).queue;
+
     auto updatePacket = makeUpdateFindContent( player.getId(), content->data().TerritoryType,
                                                CompleteRegistration, 1, static_cast< uint32_t >( player.getClass() ) );
     server.queueForPlayer( player.getCharacterId(), updatePacket );
 
-    auto statusPacket = makeNotifyFindContentStatus( player.getId(), content->data().TerritoryType, 1, queuedContent->m_attackerCount + queuedContent->m_rangeCount,
-                                                     queuedContent->m_healerCount, queuedContent->m_tankCount, 0xFF );
+    // the counts shown are the waiting players the next group would be made of
+    auto statusPacket = makeNotifyFindContentStatus( player.getId(), content->data().TerritoryType, 1,
+                                                     contentQueue.getGroupCount( QueueMelee ) + contentQueue.getGroupCount( QueueRange ),
+                                                     contentQueue.getGroupCount( QueueHealer ), contentQueue.getGroupCount( QueueTank ), 0xFF );
+    server.queueForPlayer( player.getCharacterId(), statusPacket );
+  }
+}
+
+World::ContentFinder::QueueRole World::ContentFinder::getQueueRole( Common::Role role )
+{
+  switch( role )
+  {
+    case Role::Tank:
+      return QueueTank;
+    case Role::Healer:
+      return QueueHealer;
+    case Role::Melee:
+      return QueueMelee;
+    case Role::RangedPhysical:
+    case Role::RangedMagical:
+      return QueueRange;
+    case Role::Crafter:
+    case Role::Gatherer:
+    case Role::None:
+      break;
+  }
+  return QueueInvalid;
+}
+
+World::ContentFinder::ContentQueue& World::ContentFinder::getContentQueue( uint32_t contentId )
+{
+  auto it = m_contentQueues.find( contentId );
+  if( it != m_contentQueues.end() )
+    return it->second;
+
+  auto& exdData = Common::Service< Data::ExdData >::ref();
+  auto& contentQueue = m_contentQueues[ contentId ];
+
+  if( auto instanceContent = exdData.getRow< Excel::InstanceContent >( contentId ) )
+    contentQueue.territoryType = instanceContent->data().TerritoryType;
 
-    for( auto& queuedPlayer : queuedContent->m_players )
+  auto content = exdData.getRow< Excel::ContentFinderCondition >( contentId );
+  if( !content )
+    return contentQueue;
+
+  contentQueue.levelMin = content->data().LevelMin;
+
+  // contents without a member type can't be matched and are only entered undersized
+  auto contentMember = exdData.getRow< Excel::ContentMemberType >( content->data().ContentMemberType );
+  if( !contentMember )
+    return contentQueue;
+
+  Common::Util::RoleQueue< QueueEntry, QueueRoleCount >::Requirement requirement{};
+  requirement[ QueueTank ] = contentMember->data().TankCount;
+  requirement[ QueueHealer ] = contentMember->data().HealerCount;
+  requirement[ QueueMelee ] = contentMember->data().AttackerCount;
+  requirement[ QueueRange ] = contentMember->data().RangeCount;
+  contentQueue.queue = Common::Util::RoleQueue< QueueEntry, QueueRoleCount >( requirement );
+
+  return contentQueue;
+}
+
+bool World::ContentFinder::queueForContent( Entity::Player &player, const std::vector< uint32_t >& contentIds )
+{
+  auto qPlayerIt = m_queuedPlayer.find( player.getId() );
+  if( qPlayerIt != m_queuedPlayer.end() )
+  {
+    if( !qPlayerIt->second->isWaiting() )
     {
-      server.queueForPlayer( queuedPlayer->getCharacterId(), statusPacket );
+      Logger::error( "[{0}][ContentFinder] Player already matched, registerId#{1}", player.getId(), qPlayerIt->second->getActiveRegisterId() );
+      return false;
     }
+
+    // a new registration replaces the previous one
+    dequeue( *qPlayerIt->second );
+    m_queuedPlayer.erase( qPlayerIt );
+  }
+
+  auto pQPlayer = std::make_shared< QueuedPlayer >( player, 0 );
+  auto role = getQueueRole( pQPlayer->getRole() );
+
+  for( auto contentId : contentIds )
+  {
+    auto& contentQueue = getContentQueue( contentId );
+
+    // make sure the player has at least the required level
+    if( player.getLevel() < contentQueue.levelMin )
+      continue;
+
+    if( role == QueueInvalid )
+      continue;
+
+    Logger::info( "[{2}][ContentFinder] Content registered, contentId#{0} roleCount#{1}", contentId, contentQueue.queue.getCount( role ) + 1, player.getId() );
+    PlayerMgr::sendDebug( player, "Content registered, contentId#{0}", contentId );
+    pQPlayer->m_contentIds.push_back( contentId );
   }
+
+  if( pQPlayer->m_contentIds.empty() )
+  {
+    Logger::error( "[ContentFinder] No matching content could be found or generated." );
+    return false;
+  }
+
+  m_queuedPlayer[ player.getId() ] = pQPlayer;
+  enqueue( pQPlayer );
+  return true;
 }
 
-void World::ContentFinder::queueForContent( Entity::Player &player, const std::vector< uint32_t >& contentIds )
+void World::ContentFinder::enqueue( const std::shared_ptr< QueuedPlayer >& pQPlayer, bool front )
 {
-  for( auto contentId : contentIds )
+  auto role = getQueueRole( pQPlayer->getRole() );
+
+  for( auto contentId : pQPlayer->m_contentIds )
   {
-    auto contentList = getMatchingContentList( player, contentId );
+    auto& contentQueue = getContentQueue( contentId );
+    contentQueue.queue.push( role, QueueEntry{ pQPlayer, pQPlayer->m_queueTicket }, front );
+    m_dirtyContentIds.insert( contentId );
+  }
+}
 
-    if( contentList.empty() )
-    {
-      Logger::error( "[ContentFinder] No matching content could be found or generated." );
-      return;
-    }
+void World::ContentFinder::dequeue( QueuedPlayer& qPlayer, uint32_t poppedContentId )
+{
+  auto role = getQueueRole( qPlayer.getRole() );
+
+  for( auto contentId : qPlayer.m_contentIds )
+  {
+    if( contentId != poppedContentId )
+      getContentQueue( contentId ).queue.leave( role );
+  }
+
+  // invalidates every entry the player still has in the buckets
+  ++qPlayer.m_queueTicket;
+}
+
+void World::ContentFinder::matchContent( uint32_t contentId )
+{
+  auto& contentQueue = getContentQueue( contentId ).queue;
+
+  auto isAvailable = []( const QueueEntry& entry )
+  {
+    auto pQPlayer = entry.pQPlayer.lock();
+    return pQPlayer && pQPlayer->isWaiting() && pQPlayer->m_queueTicket == entry.ticket;
+  };
+
+  contentQueue.compact( isAvailable );
 
-    for( auto &content : contentList )
+  std::vector< QueueEntry > matched;
+  while( contentQueue.popMatch( matched, isAvailable ) )
+  {
+    std::vector< std::shared_ptr< QueuedPlayer > > players;
+    for( const auto& entry : matched )
+      players.push_back( entry.pQPlayer.lock() );
+
+    createGroup( contentId, players, contentId );
+    matched.clear();
+  }
+}
+
+std::shared_ptr< World::QueuedContent > World::ContentFinder::createGroup( uint32_t contentId,
+                                                                           const std::vector< std::shared_ptr< QueuedPlayer > >& players,
+                                                                           uint32_t poppedContentId )
+{
+  auto pContent = std::make_shared< QueuedContent >( getNextRegisterId(), contentId );
+
+  for( const auto& pQPlayer : players )
+  {
+    dequeue( *pQPlayer, poppedContentId );
+    pQPlayer->setActiveRegisterId( pContent->getRegisterId() );
+    pQPlayer->m_accepted = false;
+    pContent->queuePlayer( pQPlayer );
+  }
+
+  pContent->setState( MatchingComplete );
+  m_queuedContent[ pContent->getRegisterId() ] = pContent;
+
+  Logger::info( "[ContentFinder] Content matched, contentId#{0} registerId#{1} players#{2}", contentId, pContent->getRegisterId(), players.size() );
+  return pContent;
+}
+
+void World::ContentFinder::dissolveGroup( QueuedContent& content, const std::function< bool( const QueuedPlayer& ) >& requeue, uint32_t failKind )
+{
+  auto& server = Service< WorldServer >::ref();
+  auto territoryType = getContentQueue( content.getInstanceId() ).territoryType;
+
+  for( const auto& pQPlayer : content.m_players )
+  {
+    if( requeue( *pQPlayer ) )
     {
-      Logger::info( "[{2}][ContentFinder] Content registered, contentId#{0} registerId#{1}", contentId, content->getRegisterId(), player.getId() );
-      PlayerMgr::sendDebug( player, "Content registered, contentId#{0} registerId#{1}", contentId, content->getRegisterId() );
-      m_queuedContent[ content->getRegisterId() ] = content;
+      pQPlayer->setActiveRegisterId( 0 );
+      pQPlayer->m_accepted = false;
+      enqueue( pQPlayer, true );
 
-      auto qPlayerIt = m_queuedPlayer.find( player.getId() );
-      if( qPlayerIt == m_queuedPlayer.end() )
-      {
-        auto pQPlayer = std::make_shared< QueuedPlayer >( player, content->getRegisterId() );
-        m_queuedPlayer[ player.getId() ] = pQPlayer;
-      }
-      else
-      {
-        m_queuedPlayer[ player.getId() ]->setActiveRegisterId( content->getRegisterId() );
-      }
-      content->queuePlayer( m_queuedPlayer[ player.getId() ] );
+      server.queueForPlayer( pQPlayer->getCharacterId(), makeUpdateFindContent( pQPlayer->getEntityId(), territoryType, ReturnMatching ) );
+    }
+    else
+    {
+      m_queuedPlayer.erase( pQPlayer->getEntityId() );
+      server.queueForPlayer( pQPlayer->getCharacterId(), makeUpdateFindContent( pQPlayer->getEntityId(), territoryType, failKind ) );
     }
   }
+
+  content.m_players.clear();
+  content.setState( ToBeRemoved );
 }
 
 void World::QueuedContent::queuePlayer( const std::shared_ptr< QueuedPlayer >& pQPlayer )
@@ -288,94 +479,26 @@ uint32_t World::ContentFinder::getNextRegisterId()
   return ++m_nextRegisterId;
 }
 
-World::ContentFinder::QueuedContentPtrList World::ContentFinder::getMatchingContentList( Entity::Player &player, uint32_t contentFinderId )
-{
-  QueuedContentPtrList outVec;
-  for( auto& it : m_queuedContent )
-  {
-    auto& foundContent = it.second;
-    uint32_t leftContentId = foundContent->getInstanceId();
-    if( leftContentId != contentFinderId )
-      continue;
-
-    auto& exdData = Common::Service< Data::ExdData >::ref();
-    auto content = exdData.getRow< Excel::ContentFinderCondition >( contentFinderId );
-    if( !content )
-      continue;
-
-    // make sure the player has at least the required level
-    if( player.getLevel() < content->data().LevelMin )
-      continue;
-
-    if( foundContent->getState() != QueuedContentState::MatchingInProgress )
-      continue;
-
-    auto contentMember = exdData.getRow< Excel::ContentMemberType >( content->data().ContentMemberType );
-    if( !contentMember )
-      continue;
-
-    // skip if the party is already full
-    if( foundContent->m_partyMemberCount >= contentMember->data().PartyMemberCount )
-      continue;
-
-    switch( player.getRole() )
-    {
-      case Role::Tank:
-      {
-        if( contentMember->data().TankCount <= foundContent->m_tankCount )
-          continue;
-        break;
-      }
-      case Role::Healer:
-      {
-        if( contentMember->data().HealerCount <= foundContent->m_healerCount )
-          continue;
-        break;
-      }
-      case Role::RangedPhysical:
-      case Role::RangedMagical:
-      {
-        if( contentMember->data().RangeCount <= foundContent->m_rangeCount )
-          continue;
-        break;
-      }
-      case Role::Melee:
-      {
-        if( contentMember->data().AttackerCount <= foundContent->m_attackerCount )
-          continue;
-        break;
-      }
-      case Role::Crafter:
-      case Role::Gatherer:
-      case Role::None:
-        continue;
-    }
-
-    outVec.push_back( foundContent );
-  }
-
-  if( outVec.empty() )
-  {
-    auto queuedContent = std::make_shared< QueuedContent >( getNextRegisterId(), contentFinderId );
-    outVec.push_back( queuedContent );
-  }
-  return outVec;
-}
-
 void World::ContentFinder::accept( Entity::Player& player )
 {
   auto& server = Service< WorldServer >::ref();
   auto& exdData = Service< Data::ExdData >::ref();
 
-  auto queuedPlayer = m_queuedPlayer[ player.getId() ];
-  auto queuedContent = m_queuedContent[ queuedPlayer->getActiveRegisterId() ];
+  auto qPlayerIt = m_queuedPlayer.find( player.getId() );
+  if( qPlayerIt == m_queuedPlayer.end() )
+    return;
 
-  auto content = exdData.getRow< Excel::InstanceContent >( queuedContent->getInstanceId() );
+  auto queuedPlayer = qPlayerIt->second;
+  auto queuedContent = findContentByRegisterId( queuedPlayer->getActiveRegisterId() );
 
   // Something has gone quite wrong..
-  if( queuedContent->getState() != WaitingForAccept )
+  if( !queuedContent || queuedContent->getState() != WaitingForAccept || queuedPlayer->m_accepted )
     return;
 
+  auto content = exdData.getRow< Excel::InstanceContent >( queuedContent->getInstanceId() );
+
+  queuedPlayer->m_accepted = true;
+
   switch( queuedPlayer->getRole() )
   {
     case Role::Tank:
@@ -412,64 +535,51 @@ void World::ContentFinder::accept( Entity::Player& player )
 void World::ContentFinder::withdraw( Entity::Player& player )
 {
   auto& server = Service< WorldServer >::ref();
-  auto& exdData = Service< Data::ExdData >::ref();
-
-  auto queuedPlayer = m_queuedPlayer[ player.getId() ];
 
-  auto contentInfo = exdData.getRow< Excel::InstanceContent >( m_queuedContent[ queuedPlayer->getActiveRegisterId() ]->getInstanceId() );
-  if( !contentInfo )
-  {
-    Logger::error( "[{2}] Content withdraw failed, contentId#{0} registerId#{1}",
-                   m_queuedContent[ queuedPlayer->getActiveRegisterId() ]->getInstanceId(),
-                   m_queuedContent[ queuedPlayer->getActiveRegisterId() ]->getRegisterId(), player.getId() );
+  auto qPlayerIt = m_queuedPlayer.find( player.getId() );
+  if( qPlayerIt == m_queuedPlayer.end() )
     return;
-  }
+
+  auto queuedPlayer = qPlayerIt->second;
+  auto territoryType = getContentQueue( queuedPlayer->m_contentIds.front() ).territoryType;
 
   // remove the player from the global CF list
-  m_queuedPlayer.erase( player.getId() );
+  m_queuedPlayer.erase( qPlayerIt );
 
   // send packet to clear CF in the client. TODO needs to be moved elsewhere
-  auto updatePacket = makeUpdateFindContent( player.getId(), contentInfo->data().TerritoryType, SetResultFailed2 );
+  auto updatePacket = makeUpdateFindContent( player.getId(), territoryType, SetResultFailed2 );
   server.queueForPlayer( queuedPlayer->getCharacterId(), updatePacket );
 
-  // check all queued contents for the player and remove if needed
-  std::set< uint32_t > updateRegisterIdSet;
-  for( auto& content : m_queuedContent )
+  if( queuedPlayer->isWaiting() )
   {
-    if( content.second->withdrawPlayer( queuedPlayer ) )
-    {
-      Logger::info( "[{2}] Content withdrawn, contentId#{0} registerId#{1}",
-                    content.second->getInstanceId(), content.second->getRegisterId(), player.getId() );
-      updateRegisterIdSet.insert( content.second->getRegisterId() );
-    }
+    dequeue( *queuedPlayer );
+    Logger::info( "[{0}] Content withdrawn while waiting", player.getId() );
+    return;
   }
 
-  // check for each queued content if players need to be updated
-  for( auto& content : m_queuedContent )
-  {
-    auto regId = content.second->getRegisterId();
-    // if this content does not require an update, skip.
-    if( updateRegisterIdSet.count( regId ) == 0 )
-      continue;
-
-    auto queuedContentInfo = exdData.getRow< Excel::InstanceContent >( content.second->getInstanceId() );
+  auto content = findContentByRegisterId( queuedPlayer->getActiveRegisterId() );
+  if( !content || !content->withdrawPlayer( queuedPlayer ) )
+    return;
 
-    auto& playerList = content.second->m_players;
-    for( const auto& pPlayer : playerList )
-    {
-      // only update players which have this content active (shown in UI)
-      if( pPlayer->getActiveRegisterId() != regId )
-        continue;
+  Logger::info( "[{2}] Content withdrawn, contentId#{0} registerId#{1}",
+                content->getInstanceId(), content->getRegisterId(), player.getId() );
 
-      auto statusPacket = makeNotifyFindContentStatus( player.getId(), queuedContentInfo->data().TerritoryType, 3,
-                                                       content.second->m_attackerCount + content.second->m_rangeCount,
-                                                       content.second->m_healerCount, content.second->m_tankCount, 0xff );
+  // a group which has not entered yet is broken up, the rest of it goes back to the front of the queue
+  auto state = content->getState();
+  if( state == MatchingComplete || state == WaitingForAccept || state == Accepted )
+    dissolveGroup( *content, []( const QueuedPlayer& ) { return true; }, SetResultFailed2 );
+}
 
-      server.queueForPlayer( pPlayer->getCharacterId(), statusPacket );
-    }
+void World::ContentFinder::onReadyCheckTimeout( uint32_t registerId )
+{
+  auto content = findContentByRegisterId( registerId );
+  if( !content || content->getState() != WaitingForAccept )
+    return;
 
-  }
+  Logger::info( "[ContentFinder] Ready check timed out, contentId#{0} registerId#{1}", content->getInstanceId(), registerId );
 
+  // players who accepted keep their place, the others are removed from the queue
+  dissolveGroup( *content, []( const QueuedPlayer& qPlayer ) { return qPlayer.m_accepted; }, SetResultFailedAccept );
 }
 
 std::shared_ptr< World::QueuedContent > World::ContentFinder::findContentByRegisterId( uint32_t registerId )
@@ -547,7 +657,7 @@ void World::QueuedContent::setState( World::QueuedContentState state )
 //////////////////////////////////////////////////////////////////////
 
 
-World::QueuedPlayer::QueuedPlayer( const Entity::Player &player, uint8_t registerId  )
+World::QueuedPlayer::QueuedPlayer( const Entity::Player &player, uint32_t registerId  )
 {
   m_characterId = player.getCharacterId();
   m_classJob = static_cast< uint32_t >( player.getClass() );
@@ -562,16 +672,21 @@ Common::Role World::QueuedPlayer::getRole() const
   return m_role;
 }
 
-void World::QueuedPlayer::setActiveRegisterId( uint8_t registerId )
+void World::QueuedPlayer::setActiveRegisterId( uint32_t registerId )
 {
   m_activeRegisterId = registerId;
 }
 
-uint8_t World::QueuedPlayer::getActiveRegisterId() const
+uint32_t World::QueuedPlayer::getActiveRegisterId() const
 {
   return m_activeRegisterId;
 }
 
+bool World::QueuedPlayer::isWaiting() const
+{
+  return m_activeRegisterId == 0;
+}
+
 uint64_t World::QueuedPlayer::getCharacterId() const
 {
   return m_characterId;
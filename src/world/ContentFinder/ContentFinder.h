@@ -1,6 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <set>
 #include <nlohmann/json.hpp>
+#include <Util/RoleQueue.h>
 #include "../ForwardsZone.h"
 
 namespace Sapphire::World
@@ -46,13 +49,16 @@ namespace Sapphire::World
   {
     friend class ContentFinder;
   public:
-    explicit QueuedPlayer( const Entity::Player& player, uint8_t registerId );
+    explicit QueuedPlayer( const Entity::Player& player, uint32_t registerId );
     ~QueuedPlayer() = default;
 
     Sapphire::Common::Role getRole() const;
 
-    void setActiveRegisterId( uint8_t registerId );
-    uint8_t getActiveRegisterId() const;
+    void setActiveRegisterId( uint32_t registerId );
+    uint32_t getActiveRegisterId() const;
+
+    /*! waiting in the content queues, not matched into a group yet */
+    bool isWaiting() const;
 
     uint64_t getCharacterId() const;
     uint32_t getEntityId() const;
@@ -64,7 +70,13 @@ namespace Sapphire::World
     Common::Role m_role;
     uint8_t m_level;
     bool m_allowInProgress;
-    uint8_t m_activeRegisterId;
+    uint32_t m_activeRegisterId;
+    bool m_accepted{ false };
+
+    /*! contents the player waits for, roulettes are expanded into their duties */
+    std::vector< uint32_t > m_contentIds;
+    /*! bumped whenever the player leaves the queues, queue entries with an older ticket are stale */
+    uint32_t m_queueTicket{ 0 };
   };
 
   class QueuedContent
@@ -125,22 +137,68 @@ namespace Sapphire::World
     void registerContentsRequest( Entity::Player& player, const std::vector< uint32_t >& contentIds );
     void registerRandomContentRequest( Entity::Player& player, uint32_t randomContentTypeId );
 
-    QueuedContentPtrList getMatchingContentList( Sapphire::Entity::Player &player, uint32_t contentId );
-
     void accept( Entity::Player& player );
     void withdraw( Entity::Player& player );
 
+    /*! called by the ready check task, players who did not accept in time are removed from the queue */
+    void onReadyCheckTimeout( uint32_t registerId );
+
     uint32_t getNextRegisterId();
 
     std::shared_ptr< QueuedContent > findContentByRegisterId( uint32_t registerId );
     bool removeContentByRegisterId( uint32_t registerId );
 
+    static const uint32_t ReadyCheckTimeoutMs = 45000;
+
   private:
+    enum QueueRole : uint8_t
+    {
+      QueueTank,
+      QueueHealer,
+      QueueMelee,
+      QueueRange,
+      QueueRoleCount,
+      QueueInvalid = QueueRoleCount
+    };
+
+    struct QueueEntry
+    {
+      std::weak_ptr< QueuedPlayer > pQPlayer;
+      uint32_t ticket;
+    };
+
+    /*! players waiting for one content, one FIFO bucket per role */
+    struct ContentQueue
+    {
+      Common::Util::RoleQueue< QueueEntry, QueueRoleCount > queue;
+      uint16_t territoryType{ 0 };
+      uint8_t levelMin{ 0 };
+    };
+
     uint32_t m_nextRegisterId{ 0 };
     std::unordered_map< uint32_t, std::shared_ptr< QueuedContent > > m_queuedContent;
     std::unordered_map< uint32_t, std::shared_ptr< QueuedPlayer > > m_queuedPlayer;
 
-    void queueForContent( Entity::Player &player, const std::vector< uint32_t >& contentIds );
+    /*! content id to its queue, built on first use */
+    std::unordered_map< uint32_t, ContentQueue > m_contentQueues;
+    /*! contents which had players added since the last update, only these are matched */
+    std::set< uint32_t > m_dirtyContentIds;
+
+    static QueueRole getQueueRole( Common::Role role );
+    ContentQueue& getContentQueue( uint32_t contentId );
+
+    bool queueForContent( Entity::Player &player, const std::vector< uint32_t >& contentIds );
+
+    /*! adds the player to the buckets of all its contents, players returning from a failed match keep their place */
+    void enqueue( const std::shared_ptr< QueuedPlayer >& pQPlayer, bool front = false );
+    /*! removes the player from all its content queues, except the one it was just popped from */
+    void dequeue( QueuedPlayer& qPlayer, uint32_t poppedContentId = 0 );
+
+    void matchContent( uint32_t contentId );
+    std::shared_ptr< QueuedContent > createGroup( uint32_t contentId, const std::vector< std::shared_ptr< QueuedPlayer > >& players,
+                                                  uint32_t poppedContentId = 0 );
+    /*! dissolves a group before it entered the content, players in requeue go back to the front of their queues */
+    void dissolveGroup( QueuedContent& content, const std::function< bool( const QueuedPlayer& ) >& requeue, uint32_t failKind );
 
     void completeRegistration( const Entity::Player &player, uint8_t flags = 0 );
   };
@@ -1,6 +1,27 @@
 #include "Encounter.h"
 
 #include "TimelinePack.h"
+#include "TimelineActor.h"
+#include "Timepoint.h"
+
+#include <Action/Action.h>
+
+#include <Actor/BNpc.h>
+#include <Actor/EventObject.h>
+#include <Actor/Player.h>
+
+#include <Event/Director.h>
+
+#include <Manager/ActionMgr.h>
+#include <Manager/PlayerMgr.h>
+#include <Service.h>
+
+#include <Territory/Territory.h>
+#include <Territory/InstanceContent.h>
+#include <Util/UtilMath.h>
+
+#include <Network/CommonActorControl.h>
+#include <Network/Util/PacketUtil.h>
 
 namespace Sapphire
 {
@@ -89,4 +110,271 @@ namespace Sapphire
   {
     return m_pDirector;
   }
+
+  std::optional< uint32_t > Encounter::getBNpcHpPercent( uint32_t layoutId )
+  {
+    auto pBNpc = m_pTeri->getActiveBNpcByLayoutId( layoutId );
+    if( !pBNpc )
+      return std::nullopt;
+    return pBNpc->getHpPercent();
+  }
+
+  std::optional< Entity::BNpcState > Encounter::getBNpcState( uint32_t layoutId )
+  {
+    auto pBNpc = m_pTeri->getActiveBNpcByLayoutId( layoutId );
+    if( !pBNpc )
+      return std::nullopt;
+    return pBNpc->getState();
+  }
+
+  bool Encounter::hasBNpcFlags( uint32_t layoutId, uint32_t flags )
+  {
+    auto pBNpc = m_pTeri->getActiveBNpcByLayoutId( layoutId );
+    return pBNpc && pBNpc->hasFlag( flags );
+  }
+
+  bool Encounter::isBNpcCasting( uint32_t layoutId, uint32_t actionId )
+  {
+    auto pBNpc = m_pTeri->getActiveBNpcByLayoutId( layoutId );
+    return pBNpc && pBNpc->getCurrentAction() && pBNpc->getCurrentAction()->getId() == actionId;
+  }
+
+  void Encounter::spawnSubActors( TimelineActor& actor )
+  {
+    actor.spawnAllSubActors( m_pTeri );
+  }
+
+  bool Encounter::castAction( TimelinePack& pack, const TimepointDataAction& data )
+  {
+    auto pBNpc = pack.getBNpcByRef( data.m_source, shared_from_this() );
+    // todo: filter the correct target
+    // todo: tie to mechanic script?
+    // todo: mechanic should probably just be an Action::onTick, with instance/director passed to it
+    if( !pBNpc )
+      return true;
+
+    uint32_t targetId = pBNpc->getId();
+    switch( data.m_targetType )
+    {
+      case ActionTargetType::None:
+        targetId = Common::INVALID_GAME_OBJECT_ID;
+        break;
+      case ActionTargetType::Target:
+        targetId = static_cast< uint32_t >( pBNpc->getTargetId() );
+        break;
+      case ActionTargetType::Self:
+        targetId = pBNpc->getId();
+        break;
+      case ActionTargetType::Selector:
+      {
+        const auto& results = pack.getSnapshotTargetIds( data.m_selector );
+        if( data.m_selectorIndex < results.size() )
+          targetId = results[ data.m_selectorIndex ];
+      }
+      break;
+      default:
+        break;
+    }
+
+    auto& actionMgr = Common::Service< World::Manager::ActionMgr >::ref();
+    auto pAction = pBNpc->getCurrentAction();
+
+    // todo: this is probably wrong
+    if( pAction && !pAction->isInterrupted() )
+      return false;
+
+    actionMgr.handleTargetedAction( *pBNpc, data.m_actionId, targetId, m_pTeri->getNextActionResultId() );
+    //actionMgr.handlePlacedAction( *pBNpc, data.m_actionId, pBNpc->getPos(), m_pTeri->getNextActionResultId() );
+    return true;
+  }
+
+  void Encounter::setPos( TimelinePack& pack, const TimepointDataSetPos& data )
+  {
+    auto pBNpc = pack.getBNpcByRef( data.m_actor, shared_from_this() );
+    if( !pBNpc )
+      return;
+
+    auto pos = pBNpc->getPos();
+    float rot = 0.f;
+    switch( data.m_targetType )
+    {
+      case SetPosTargetType::Target:
+      {
+        auto inRange = pBNpc->getInRangeActors();
+        for( const auto& pActor : inRange )
+        {
+          if( pActor->getId() == pBNpc->getTargetId() )
+          {
+            pos = pActor->getPos();
+            rot = pActor->getRot();
+            break;
+          }
+        }
+      }
+      break;
+      case SetPosTargetType::Selector:
+      {
+        const auto& results = pack.getSnapshotResults( data.m_selector );
+        if( data.m_selectorIndex < results.size() )
+        {
+          pos = results[ data.m_selectorIndex ].m_pos;
+          rot = results[ data.m_selectorIndex ].m_rot;
+        }
+      }
+      break;
+      default:
+        break;
+    }
+
+    switch( data.m_posType )
+    {
+      case SetPosType::Absolute:
+      {
+        pBNpc->setRot( data.m_rot );
+        pBNpc->setPos( data.m_x, data.m_y, data.m_z, true );
+      }
+      break;
+      case SetPosType::Relative:
+      {
+        auto offsetPos = Common::Util::getOffsettedPosition( pos, rot, data.m_x, data.m_y, data.m_z );
+        pBNpc->setRot( rot );
+        pBNpc->setPos( offsetPos );
+      }
+      break;
+      default:
+        break;
+    }
+  }
+
+  void Encounter::playActionTimeline( TimelinePack& pack, const TimepointDataActionTimeLine& data )
+  {
+    auto pBNpc = pack.getBNpcByRef( data.m_actor, shared_from_this() );
+    if( pBNpc )
+    {
+      Network::Util::Packet::sendActorControl( pBNpc->getInRangePlayerIds(), pBNpc->getId(),
+                                               Network::ActorControl::PlayActionTimeline, data.m_actionId );
+    }
+  }
+
+  void Encounter::sendLogMessage( const TimepointDataLogMessage& data )
+  {
+    const auto& params = data.m_params;
+
+    // todo: probably should use ContentDirector
+    auto& playerMgr = Common::Service< World::Manager::PlayerMgr >::ref();
+    for( auto& player : m_pTeri->getPlayers() )
+    {
+      auto& pPlayer = player.second;
+      if( pPlayer )
+        playerMgr.sendLogMessage( *pPlayer.get(), data.m_messageId,
+                                  params[ 0 ], params[ 1 ], params[ 2 ], params[ 3 ], params[ 4 ] );
+    }
+  }
+
+  void Encounter::sendBattleTalk( TimelinePack& pack, const TimepointDataBattleTalk& data )
+  {
+    const auto& params = data.m_params;
+
+    auto pHandler = pack.getBNpcByRef( data.m_handler, shared_from_this() );
+    auto pTalker = pack.getBNpcByRef( data.m_talker, shared_from_this() );
+
+    auto handlerId = pHandler ? pHandler->getId() : Common::INVALID_GAME_OBJECT_ID;
+    auto talkerId = pTalker ? pTalker->getId() : Common::INVALID_GAME_OBJECT_ID;
+
+    // todo: use Actrl EventBattleDialog = 0x39C maybe?,
+    auto& playerMgr = Common::Service< World::Manager::PlayerMgr >::ref();
+
+    // todo: this does not always need to be a director, and can also be an eventhandler
+    //       needs further investigation
+    if( m_pDirector )
+      handlerId = m_pDirector->getDirectorId();
+
+    for( auto& player : m_pTeri->getPlayers() )
+    {
+      auto& pPlayer = player.second;
+      if( pPlayer )
+        playerMgr.sendBattleTalk( *pPlayer.get(), data.m_battleTalkId, handlerId,
+                                  data.m_kind, data.m_nameId, talkerId, static_cast< uint32_t >( data.m_length ),
+                                  params[ 0 ], params[ 1 ], params[ 2 ], params[ 3 ],
+                                  params[ 4 ], params[ 5 ], params[ 6 ], params[ 7 ] );
+    }
+  }
+
+  void Encounter::spawnBNpc( uint32_t layoutId, uint32_t flags )
+  {
+    auto pBNpc = m_pTeri->getActiveBNpcByLayoutId( layoutId );
+
+    // todo: probably have this info in the timepoint data
+    if( !pBNpc )
+      pBNpc = m_pTeri->createBNpcFromLayoutId( layoutId, 100, Common::BNpcType::Enemy );
+
+    if( pBNpc )
+    {
+      pBNpc->resetFlags( flags );
+      pBNpc->init();
+
+      m_pTeri->pushActor( pBNpc );
+    }
+  }
+
+  void Encounter::despawnBNpc( uint32_t layoutId )
+  {
+    auto pBNpc = m_pTeri->getActiveBNpcByLayoutId( layoutId );
+    if( pBNpc )
+      m_pTeri->removeActor( pBNpc );
+  }
+
+  void Encounter::setBNpcFlags( uint32_t layoutId, uint32_t flags )
+  {
+    auto pBNpc = m_pTeri->getActiveBNpcByLayoutId( layoutId );
+    if( pBNpc )
+    {
+      pBNpc->resetFlags( flags );
+      // todo: resend some bnpc packet/actrl?
+    }
+  }
+
+  void Encounter::setEObjState( uint32_t eobjId, uint32_t state )
+  {
+    // todo: event objects on quest battles
+    // todo: SetEObjAnimationFlag?
+    auto pInstance = m_pTeri->getAsInstanceContent();
+    if( !pInstance )
+      return;
+
+    auto pEObj = pInstance->getEObjById( eobjId );
+    if( pEObj )
+    {
+      pEObj->setState( state );
+      // todo: resend the eobj spawn packet?
+    }
+  }
+
+  void Encounter::setBgm( uint32_t bgmId )
+  {
+    // todo: quest battles refactor to inherit InstanceContent
+    auto pInstance = m_pTeri->getAsInstanceContent();
+    if( pInstance )
+      pInstance->setCurrentBGM( bgmId );
+  }
+
+  void Encounter::createSnapshot( TimelinePack& pack, const TimepointDataSnapshot& data )
+  {
+    auto pBNpc = pack.getBNpcByRef( data.m_actor, shared_from_this() );
+    if( !pBNpc )
+      return;
+
+    const auto& exclude = pack.getSnapshotTargetIds( data.m_excludeSelector );
+    pack.createSnapshot( data.m_selector, pBNpc, exclude );
+  }
+
+  void Encounter::onTimepoint( const TimelineActor& self, const Timepoint& timepoint, uint64_t time )
+  {
+    if( timepoint.m_description.empty() )
+      return;
+
+    auto& playerMgr = Common::Service< World::Manager::PlayerMgr >::ref();
+    for( const auto& player : m_pTeri->getPlayers() )
+      playerMgr.sendDebug( *player.second, timepoint.m_description );
+  }
 }
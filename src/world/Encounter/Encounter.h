@@ -1,4 +1,5 @@
 #include <memory>
+#include <optional>
 #include <set>
 #include <stack>
 #include <Territory/InstanceContent.h>
@@ -7,6 +8,8 @@
 
 #include "Network/PacketDef/ServerIpcs.h"
 
+#include "Forwards.h"
+
 
 namespace Sapphire
 {
@@ -54,6 +57,36 @@ namespace Sapphire
 
     Event::DirectorPtr getDirector();
 
+    //
+    // world access of the timeline, the base implementation works on the bnpcs and players of the territory
+    //
+
+    // state of the bnpc spawned for layoutId, nullopt while it is not spawned
+    virtual std::optional< uint32_t > getBNpcHpPercent( uint32_t layoutId );
+    virtual std::optional< Entity::BNpcState > getBNpcState( uint32_t layoutId );
+    virtual bool hasBNpcFlags( uint32_t layoutId, uint32_t flags );
+    virtual bool isBNpcCasting( uint32_t layoutId, uint32_t actionId );
+
+    virtual void spawnSubActors( TimelineActor& actor );
+
+    // false if the caster is still busy with another action
+    virtual bool castAction( TimelinePack& pack, const TimepointDataAction& data );
+    virtual void setPos( TimelinePack& pack, const TimepointDataSetPos& data );
+    virtual void playActionTimeline( TimelinePack& pack, const TimepointDataActionTimeLine& data );
+    virtual void sendLogMessage( const TimepointDataLogMessage& data );
+    virtual void sendBattleTalk( TimelinePack& pack, const TimepointDataBattleTalk& data );
+
+    virtual void spawnBNpc( uint32_t layoutId, uint32_t flags );
+    virtual void despawnBNpc( uint32_t layoutId );
+    virtual void setBNpcFlags( uint32_t layoutId, uint32_t flags );
+    virtual void setEObjState( uint32_t eobjId, uint32_t state );
+    virtual void setBgm( uint32_t bgmId );
+
+    virtual void createSnapshot( TimelinePack& pack, const TimepointDataSnapshot& data );
+
+    // every timepoint that went through, sends its description to the players as debug message
+    virtual void onTimepoint( const TimelineActor& self, const Timepoint& timepoint, uint64_t time );
+
   protected:
     uint64_t m_startTime{ 0 };
     std::string m_timelineName;
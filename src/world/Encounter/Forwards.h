@@ -12,6 +12,15 @@ namespace Sapphire
 
   class Encounter;
   class TimelinePack;
+  class TimelineRefResolver;
+
+  struct TimelineActorRef;
+  struct TimepointDataAction;
+  struct TimepointDataSetPos;
+  struct TimepointDataActionTimeLine;
+  struct TimepointDataLogMessage;
+  struct TimepointDataBattleTalk;
+  struct TimepointDataSnapshot;
 
   using ScheduleConditionPtr = std::shared_ptr< ScheduleCondition >;
   using EncounterPtr = std::shared_ptr< Encounter >;
@@ -5,23 +5,16 @@
 #include "TimelineActor.h"
 #include "TimelineActorState.h"
 
-#include <Action/Action.h>
-
-#include <Actor/Chara.h>
 #include <Actor/BNpc.h>
-#include <Actor/Player.h>
 
-#include <Territory/Territory.h>
-#include <Territory/InstanceContent.h>
-#include <Territory/QuestBattle.h>
+#include <Event/Director.h>
 
 namespace Sapphire
 {
   bool ConditionHp::isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
   {
-    auto pTeri = pEncounter->getTeriPtr();
-    auto pBNpc = pTeri->getActiveBNpcByLayoutId( m_layoutId );
-    if( !pBNpc )
+    auto hpPct = pEncounter->getBNpcHpPercent( m_layoutId );
+    if( !hpPct )
       return false;
 
     // todo: check time elapsed
@@ -29,22 +22,18 @@ namespace Sapphire
     switch( m_conditionType )
     {
       case ConditionType::HpPctLessThan:
-        return pBNpc->getHpPercent() < m_hp.val;
+        return *hpPct < m_hp.val;
       case ConditionType::HpPctBetween:
-      {
-        auto hpPct = pBNpc->getHpPercent();
-        return hpPct > m_hp.min && hpPct < m_hp.max;
-      }
+        return *hpPct > m_hp.min && *hpPct < m_hp.max;
     }
     return false;
   };
 
   bool ConditionDirectorVar::isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
   {
-    auto pTeri = pEncounter->getTeriPtr();
-    Event::DirectorPtr pDirector = pTeri->getAsInstanceContent();
-    if( pDirector == nullptr )
-      pDirector = pTeri->getAsQuestBattle();
+    auto pDirector = pEncounter->getDirector();
+    if( !pDirector )
+      return false;
 
     switch( m_conditionType )
     {
@@ -66,27 +55,26 @@ namespace Sapphire
 
   bool ConditionCombatState::isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
   {
-    auto pTeri = pEncounter->getTeriPtr();
-    auto pBNpc = pTeri->getActiveBNpcByLayoutId( m_layoutId );
+    auto bnpcState = pEncounter->getBNpcState( m_layoutId );
 
-    if( !pBNpc )
+    if( !bnpcState )
       return false;
 
     // todo: these should really use callbacks when the state transitions or we could miss this tick
     switch( m_combatState )
     {
       case CombatStateType::Idle:
-        return pBNpc->getState() == Entity::BNpcState::Idle;
+        return *bnpcState == Entity::BNpcState::Idle;
       case CombatStateType::Combat:
-        return pBNpc->getState() == Entity::BNpcState::Combat;
+        return *bnpcState == Entity::BNpcState::Combat;
       case CombatStateType::Retreat:
-        return pBNpc->getState() == Entity::BNpcState::Retreat;
+        return *bnpcState == Entity::BNpcState::Retreat;
       case CombatStateType::Roaming:
-        return pBNpc->getState() == Entity::BNpcState::Roaming;
+        return *bnpcState == Entity::BNpcState::Roaming;
       case CombatStateType::JustDied:
-        return pBNpc->getState() == Entity::BNpcState::JustDied;
+        return *bnpcState == Entity::BNpcState::JustDied;
       case CombatStateType::Dead:
-        return pBNpc->getState() == Entity::BNpcState::Dead;
+        return *bnpcState == Entity::BNpcState::Dead;
       default:
         break;
     }
@@ -100,36 +88,37 @@ namespace Sapphire
     return elapsed >= m_duration;
   }
 
+  uint64_t ConditionEncounterTimeElapsed::getNextCheckTime( const ConditionState& state, TimelinePack& pack, uint64_t time ) const
+  {
+    return pack.getStartTime() + m_duration;
+  }
+
   bool ConditionBNpcFlags::isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
   {
-    auto pTeri = pEncounter->getTeriPtr();
-    auto pBNpc = pTeri->getActiveBNpcByLayoutId( m_layoutId );
-    return pBNpc && pBNpc->hasFlag( m_flags );
+    return pEncounter->hasBNpcFlags( m_layoutId, m_flags );
   }
 
   bool ConditionGetAction::isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
   {
-    auto pTeri = pEncounter->getTeriPtr();
-    auto pBNpc = pTeri->getActiveBNpcByLayoutId( m_layoutId );
-    return pBNpc && pBNpc->getCurrentAction() && pBNpc->getCurrentAction()->getId() == m_actionId;
+    return pEncounter->isBNpcCasting( m_layoutId, m_actionId );
   }
 
   bool ConditionScheduleActive::isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
   {
-    return pack.isScheduleActive( m_actorName, m_scheduleName );
+    return pack.isScheduleActive( m_actorIndex, m_scheduleIndex );
   }
 
   void ConditionHp::from_json( nlohmann::json& json, Schedule& phase, ConditionType condition,
-                               const std::unordered_map< std::string, TimelineActor >& actors )
+                               const TimelineRefResolver& refs )
   {
-    ScheduleCondition::from_json( json, phase, condition, actors );
+    ScheduleCondition::from_json( json, phase, condition, refs );
 
     auto& paramData = json.at( "paramData" );
     auto actorRef = paramData.at( "sourceActor" ).get< std::string >();
 
     // resolve the actor whose hp we are checking
-    if( auto it = actors.find( actorRef ); it != actors.end() )
-      m_layoutId = it->second.m_layoutId;
+    if( auto pActor = refs.findActor( actorRef ) )
+      m_layoutId = pActor->m_layoutId;
     else
       throw std::runtime_error( fmt::format( std::string( "ConditionHp::from_json unable to find actor by name: %s" ), actorRef ) );
 
@@ -148,9 +137,9 @@ namespace Sapphire
   }
 
   void ConditionDirectorVar::from_json( nlohmann::json& json, Schedule& phase, ConditionType condition,
-                                        const std::unordered_map< std::string, TimelineActor >& actors )
+                                        const TimelineRefResolver& refs )
   {
-    ScheduleCondition::from_json( json, phase, condition, actors );
+    ScheduleCondition::from_json( json, phase, condition, refs );
 
     auto& paramData = json.at( "paramData" );
 
@@ -181,16 +170,16 @@ namespace Sapphire
   }
 
   void ConditionCombatState::from_json( nlohmann::json& json, Schedule& phase, ConditionType condition,
-                                        const std::unordered_map< std::string, TimelineActor >& actors )
+                                        const TimelineRefResolver& refs )
   {
-    ScheduleCondition::from_json( json, phase, condition, actors );
+    ScheduleCondition::from_json( json, phase, condition, refs );
 
     auto& paramData = json.at( "paramData" );
     auto actorRef = paramData.at( "sourceActor" ).get< std::string >();
 
     // resolve the actor whose name we are checking
-    if( auto it = actors.find( actorRef ); it != actors.end() )
-      m_layoutId = it->second.m_layoutId;
+    if( auto pActor = refs.findActor( actorRef ) )
+      m_layoutId = pActor->m_layoutId;
     else
       throw std::runtime_error( fmt::format( std::string( "ConditionCombatState::from_json unable to find actor by name: %s" ), actorRef ) );
 
@@ -198,9 +187,9 @@ namespace Sapphire
   }
 
   void ConditionEncounterTimeElapsed::from_json( nlohmann::json& json, Schedule& phase, ConditionType condition,
-                                                 const std::unordered_map< std::string, TimelineActor >& actors )
+                                                 const TimelineRefResolver& refs )
   {
-    ScheduleCondition::from_json( json, phase, condition, actors );
+    ScheduleCondition::from_json( json, phase, condition, refs );
 
     auto& paramData = json.at( "paramData" );
     auto duration = paramData.at( "duration" ).get< uint64_t >();
@@ -209,15 +198,15 @@ namespace Sapphire
   }
 
   void ConditionBNpcFlags::from_json( nlohmann::json& json, Schedule& phase, ConditionType condition,
-                                      const std::unordered_map< std::string, TimelineActor >& actors )
+                                      const TimelineRefResolver& refs )
   {
-    ScheduleCondition::from_json( json, phase, condition, actors );
+    ScheduleCondition::from_json( json, phase, condition, refs );
     auto& paramData = json.at( "paramData" );
     auto actorRef = paramData.at( "sourceActor" ).get< std::string >();
 
     // resolve the actor whose name we are checking
-    if( auto it = actors.find( actorRef ); it != actors.end() )
-      m_layoutId = it->second.m_layoutId;
+    if( auto pActor = refs.findActor( actorRef ) )
+      m_layoutId = pActor->m_layoutId;
     else
       throw std::runtime_error( fmt::format( std::string( "ConditionBNpcFlags::from_json unable to find actor by name: %s" ), actorRef ) );
 
@@ -226,17 +215,17 @@ namespace Sapphire
   }
 
   void ConditionGetAction::from_json( nlohmann::json& json, Schedule& phase, ConditionType condition,
-                                      const std::unordered_map< std::string, TimelineActor >& actors )
+                                      const TimelineRefResolver& refs )
   {
-    ScheduleCondition::from_json( json, phase, condition, actors );
+    ScheduleCondition::from_json( json, phase, condition, refs );
 
     auto& paramData = json.at( "paramData" );
     auto actorRef = paramData.at( "sourceActor" ).get< std::string >();
     auto actionId = paramData.at( "actionId" ).get< uint32_t >();
 
     // resolve the actor whose name we are checking
-    if( auto it = actors.find( actorRef ); it != actors.end() )
-      m_layoutId = it->second.m_layoutId;
+    if( auto pActor = refs.findActor( actorRef ) )
+      m_layoutId = pActor->m_layoutId;
     else
       throw std::runtime_error( fmt::format( std::string( "ConditionGetAction::from_json unable to find actor by name: %s" ), actorRef ) );
 
@@ -244,16 +233,18 @@ namespace Sapphire
   }
 
   void ConditionScheduleActive::from_json( nlohmann::json& json, Schedule& phase, ConditionType condition,
-                                        const std::unordered_map< std::string, TimelineActor >& actors )
+                                        const TimelineRefResolver& refs )
   {
-    ScheduleCondition::from_json( json, phase, condition, actors );
+    ScheduleCondition::from_json( json, phase, condition, refs );
 
     auto& paramData = json.at( "paramData" );
     auto actorRef = paramData.at( "sourceActor" ).get< std::string >();
     auto scheduleName = paramData.at( "scheduleName" ).get< std::string >();
 
-    m_actorName = actorRef;
-    m_scheduleName = scheduleName;
+    // unknown actors or schedules never become active
+    m_actorIndex = refs.getActorIndex( actorRef );
+    if( m_actorIndex >= 0 )
+      m_scheduleIndex = refs.getScheduleIndex( m_actorIndex, scheduleName );
   }
 
   // todo: i wrote this very sleep deprived, ensure it is actually sane
@@ -263,7 +254,7 @@ namespace Sapphire
     if( state.m_startTime == 0 )
     {
       state.m_startTime = time;
-      self.spawnAllSubActors( pEncounter->getTeriPtr() );
+      pEncounter->spawnSubActors( self );
     }
 
     if( state.m_scheduleInfo.m_startTime == 0 )
@@ -300,4 +291,12 @@ namespace Sapphire
   {
     return state.m_scheduleInfo.m_lastTimepointIndex == m_timepoints.size();
   }
+
+  uint64_t Schedule::getNextTimepointTime( const ConditionState& state ) const
+  {
+    if( state.m_scheduleInfo.m_lastTimepointIndex >= m_timepoints.size() )
+      return UINT64_MAX;
+
+    return state.m_scheduleInfo.m_startTime + m_timepoints[ state.m_scheduleInfo.m_lastTimepointIndex ].m_offset;
+  }
 }// namespace Sapphire::Encounter
\ No newline at end of file
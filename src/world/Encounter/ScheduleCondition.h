@@ -43,6 +43,8 @@ namespace Sapphire
   public:
     // todo: getters/setters
     std::string m_name;
+    // position in the schedule list of its actor
+    uint32_t m_index{ 0 };
     std::vector< Timepoint > m_timepoints;
     std::string m_description;
 
@@ -51,6 +53,9 @@ namespace Sapphire
     void reset( ConditionState& state ) const;
 
     bool completed( const ConditionState& state ) const;
+
+    // time the next timepoint of a running schedule is due
+    uint64_t getNextTimepointTime( const ConditionState& state ) const;
   };
   using SchedulePtr = std::shared_ptr< Schedule >;
 
@@ -69,7 +74,7 @@ namespace Sapphire
     ScheduleCondition() {}
     ~ScheduleCondition() {}
 
-    virtual void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const std::unordered_map< std::string, TimelineActor >& actors )
+    virtual void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const TimelineRefResolver& refs )
     {
       this->m_conditionType = condition;
       this->m_loop = json.at( "loop" ).get< bool >();
@@ -80,11 +85,16 @@ namespace Sapphire
       this->m_id = json.at( "id" ).get< uint32_t >();
     }
 
-    const std::string& getScheduleName()
+    const std::string& getScheduleName() const
     {
       return m_schedule.m_name;
     }
 
+    uint32_t getScheduleIndex() const
+    {
+      return m_schedule.m_index;
+    }
+
     void execute( ConditionState& state, TimelineActor& self, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
     {
       m_schedule.execute( state, self, pack, pEncounter, time );
@@ -138,7 +148,17 @@ namespace Sapphire
 
     bool loopReady( ConditionState& state, uint64_t time ) const
     {
-      return m_schedule.completed( state ) && m_loop && ( state.m_startTime + m_cooldown <= time );
+      return m_schedule.completed( state ) && m_loop && ( getLoopReadyTime( state ) <= time );
+    }
+
+    uint64_t getLoopReadyTime( const ConditionState& state ) const
+    {
+      return state.m_startTime + m_cooldown;
+    }
+
+    uint64_t getNextTimepointTime( const ConditionState& state ) const
+    {
+      return m_schedule.getNextTimepointTime( state );
     }
 
     virtual bool isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
@@ -146,6 +166,12 @@ namespace Sapphire
       return false;
     };
 
+    // earliest time an idle condition can become met, conditions depending on game state are checked every update
+    virtual uint64_t getNextCheckTime( const ConditionState& state, TimelinePack& pack, uint64_t time ) const
+    {
+      return time;
+    }
+
     uint32_t getId() const
     {
       return m_id;
@@ -169,7 +195,7 @@ namespace Sapphire
       };
     } m_hp;
 
-    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const std::unordered_map< std::string, TimelineActor >& actors ) override;
+    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const TimelineRefResolver& refs ) override;
 
     bool isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const override;
   };
@@ -188,7 +214,7 @@ namespace Sapphire
       uint8_t flags;
     } m_param;
 
-    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const std::unordered_map< std::string, TimelineActor >& actors ) override;
+    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const TimelineRefResolver& refs ) override;
     bool isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const override;
   };
 
@@ -197,8 +223,9 @@ namespace Sapphire
   public:
     uint64_t m_duration;
 
-    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const std::unordered_map< std::string, TimelineActor >& actors ) override;
+    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const TimelineRefResolver& refs ) override;
     bool isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const override;
+    uint64_t getNextCheckTime( const ConditionState& state, TimelinePack& pack, uint64_t time ) const override;
   };
 
   class ConditionCombatState : public ScheduleCondition
@@ -207,7 +234,7 @@ namespace Sapphire
     uint32_t m_layoutId;
     CombatStateType m_combatState;
 
-    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const std::unordered_map< std::string, TimelineActor >& actors ) override;
+    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const TimelineRefResolver& refs ) override;
     bool isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const override;
   };
 
@@ -217,7 +244,7 @@ namespace Sapphire
     uint32_t m_layoutId;
     uint32_t m_flags;
 
-    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const std::unordered_map< std::string, TimelineActor >& actors ) override;
+    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const TimelineRefResolver& refs ) override;
     bool isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const override;
   };
 
@@ -227,17 +254,17 @@ namespace Sapphire
     uint32_t m_layoutId;
     uint32_t m_actionId;
 
-    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const std::unordered_map< std::string, TimelineActor >& actors ) override;
+    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const TimelineRefResolver& refs ) override;
     bool isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const override;
   };
 
   class ConditionScheduleActive : public ScheduleCondition
   {
   public:
-    std::string m_actorName;
-    std::string m_scheduleName;
+    int32_t m_actorIndex{ -1 };
+    int32_t m_scheduleIndex{ -1 };
 
-    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const std::unordered_map< std::string, TimelineActor >& actors ) override;
+    void from_json( nlohmann::json& json, Schedule& phase, ConditionType condition, const TimelineRefResolver& refs ) override;
     bool isConditionMet( ConditionState& state, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const override;
   };
 
@@ -122,6 +122,11 @@ namespace Sapphire
     }
   }
 
+  const std::string& Selector::getName() const
+  {
+    return m_name;
+  }
+
   void Selector::createSnapshot( Entity::CharaPtr pSrc, const std::vector< uint32_t >& exclude )
   {
     m_snapshot.createSnapshot( pSrc, pSrc->getInRangeActors(), m_count, m_fillWithRandom, m_filters, exclude );
@@ -18,6 +18,8 @@ namespace Sapphire
 
   public:
     Selector(){}
+    const std::string& getName() const;
+
     void createSnapshot( Entity::CharaPtr pSrc, const std::vector< uint32_t >& exclude = {} );
     const World::AI::Snapshot::Results& getResults();
     const World::AI::Snapshot::TargetIds& getTargetIds();
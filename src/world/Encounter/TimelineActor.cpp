@@ -10,6 +10,8 @@
 
 #include <Territory/Territory.h>
 
+#include <algorithm>
+
 namespace Sapphire
 {
   const std::string& TimelineActor::getName() const
@@ -22,13 +24,12 @@ namespace Sapphire
     return m_layoutId;
   }
 
-  bool TimelineActor::isScheduleActive( const std::string& name ) const
+  bool TimelineActor::isScheduleActive( uint32_t scheduleIndex ) const
   {
-    for( const auto& condition : m_scheduleConditions )
+    for( uint32_t i = 0; i < m_scheduleConditions.size(); ++i )
     {
-      const auto& pCondition = condition.second;
-      const auto& state = m_conditionStates.at( condition.first );
-      if( pCondition->inProgress( state ) && pCondition->getScheduleName() == name )
+      const auto& pCondition = m_scheduleConditions[ i ];
+      if( pCondition->inProgress( m_conditionStates[ i ] ) && pCondition->getScheduleIndex() == scheduleIndex )
         return true;
     }
     return false;
@@ -36,57 +37,117 @@ namespace Sapphire
 
   void TimelineActor::addPhaseCondition( ScheduleConditionPtr pCondition )
   {
-    m_scheduleConditions.emplace( std::make_pair( pCondition->getId(), pCondition ) );
-    m_conditionStates[ pCondition->getId() ] = {};
-    m_conditionStates[ pCondition->getId() ].m_enabled = pCondition->isDefaultEnabled();
+    auto index = static_cast< uint32_t >( m_scheduleConditions.size() );
+
+    m_scheduleConditions.push_back( pCondition );
+    m_conditionStates.emplace_back();
+    m_conditionStates.back().m_enabled = pCondition->isDefaultEnabled();
+    m_conditionIndexById[ pCondition->getId() ] = index;
+
+    m_conditionDueTimes.push_back( NotScheduled );
+    wakeCondition( index );
+  }
+
+  void TimelineActor::scheduleCondition( uint32_t index, uint64_t dueTime )
+  {
+    m_conditionDueTimes[ index ] = dueTime;
+    if( dueTime != NotScheduled )
+      m_dueConditions.emplace( dueTime, index );
+  }
+
+  void TimelineActor::wakeCondition( uint32_t index )
+  {
+    scheduleCondition( index, 0 );
+  }
+
+  uint64_t TimelineActor::getNextDueTime( uint32_t index, TimelinePack& pack, uint64_t time ) const
+  {
+    const auto& pCondition = m_scheduleConditions[ index ];
+    const auto& state = m_conditionStates[ index ];
+
+    // disabled or finished conditions only come back through a reset or enable
+    if( !pCondition->isStateEnabled( state ) )
+      return NotScheduled;
+
+    if( pCondition->completed( state ) )
+      return pCondition->isLoopable() ? pCondition->getLoopReadyTime( state ) : NotScheduled;
+
+    // nothing happens in a running schedule until its next timepoint is due
+    if( pCondition->inProgress( state ) )
+      return std::max( pCondition->getNextTimepointTime( state ), time );
+
+    return std::max( pCondition->getNextCheckTime( state, pack, time ), time );
   }
 
   // todo: make this sane
 
   void TimelineActor::update(  EncounterPtr pEncounter, TimelinePack& pack, uint64_t time )
   {
-    // todo: handle interrupts
-    for( const auto& condition : m_scheduleConditions )
+    // collect every condition due by now, each one only once
+    m_dueScratch.clear();
+    while( !m_dueConditions.empty() && m_dueConditions.top().first <= time )
     {
-      const auto& pCondition = condition.second;
-      auto& state = m_conditionStates[ pCondition->getId() ];
+      auto [ dueTime, index ] = m_dueConditions.top();
+      m_dueConditions.pop();
 
-      // ignore if not enabled, unless overriden to enable
-      if( !pCondition->isStateEnabled( state ) )
+      if( m_conditionDueTimes[ index ] != dueTime )
         continue;
 
-      if( pCondition->completed( state ) )
+      m_conditionDueTimes[ index ] = NotScheduled;
+      m_dueScratch.push_back( index );
+    }
+
+    for( auto index : m_dueScratch )
+    {
+      updateCondition( index, pEncounter, pack, time );
+
+      // timepoints may have reset or enabled the condition already, that wakes it for the next update
+      if( m_conditionDueTimes[ index ] == NotScheduled )
+        scheduleCondition( index, getNextDueTime( index, pack, time ) );
+    }
+  }
+
+  void TimelineActor::updateCondition( uint32_t index, EncounterPtr pEncounter, TimelinePack& pack, uint64_t time )
+  {
+    // todo: handle interrupts
+    const auto& pCondition = m_scheduleConditions[ index ];
+    auto& state = m_conditionStates[ index ];
+
+    // ignore if not enabled, unless overriden to enable
+    if( !pCondition->isStateEnabled( state ) )
+      return;
+
+    if( pCondition->completed( state ) )
+    {
+      if( pCondition->isLoopable() )
       {
-        if( pCondition->isLoopable() )
-        {
-          if( pCondition->loopReady( state, time ) )
-            pCondition->reset( state );
-        }
+        if( pCondition->loopReady( state, time ) )
+          pCondition->reset( state );
       }
-      // update or execute
-      else if( pCondition->isConditionMet( state, pack, pEncounter, time ) )
+    }
+    // update or execute
+    else if( pCondition->isConditionMet( state, pack, pEncounter, time ) )
+    {
+      if( pCondition->inProgress( state ) )
       {
-        if( pCondition->inProgress( state ) )
-        {
-          pCondition->update( state, *this, pack, pEncounter, time );
-        }
-        else
-        {
-          pCondition->execute( state, *this, pack, pEncounter, time );
-
-          if( pack.getStartTime() == 0 )
-            pack.setStartTime( state.m_startTime );
-        }
+        pCondition->update( state, *this, pack, pEncounter, time );
+      }
+      else
+      {
+        pCondition->execute( state, *this, pack, pEncounter, time );
+
+        if( pack.getStartTime() == 0 )
+          pack.setStartTime( state.m_startTime );
       }
     }
   }
 
   bool TimelineActor::resetConditionState( uint32_t conditionId, bool toDefault )
   {
-    if( auto it = m_scheduleConditions.find( conditionId ); it != m_scheduleConditions.end() )
+    if( auto it = m_conditionIndexById.find( conditionId ); it != m_conditionIndexById.end() )
     {
-      auto& state = m_conditionStates.at( it->first );
-      it->second->reset( state, toDefault );
+      m_scheduleConditions[ it->second ]->reset( m_conditionStates[ it->second ], toDefault );
+      wakeCondition( it->second );
       return true;
     }
     return false;
@@ -94,10 +155,10 @@ namespace Sapphire
 
   bool TimelineActor::setConditionStateEnabled( uint32_t conditionId, bool enabled )
   {
-    if( auto it = m_conditionStates.find( conditionId ); it != m_conditionStates.end() )
+    if( auto it = m_conditionIndexById.find( conditionId ); it != m_conditionIndexById.end() )
     {
-      auto& state = m_conditionStates.at( it->first );
-      state.m_enabled = enabled;
+      m_conditionStates[ it->second ].m_enabled = enabled;
+      wakeCondition( it->second );
       return true;
     }
     return false;
@@ -105,74 +166,78 @@ namespace Sapphire
 
   void TimelineActor::resetAllConditionStates()
   {
-    for( const auto& condition : m_scheduleConditions )
+    for( uint32_t i = 0; i < m_scheduleConditions.size(); ++i )
     {
-      const auto& pCondition = condition.second;
-      auto& state = m_conditionStates.at( condition.first );
-
-      pCondition->reset( state, true );
+      m_scheduleConditions[ i ]->reset( m_conditionStates[ i ], true );
+      wakeCondition( i );
     }
   }
 
   void TimelineActor::spawnAllSubActors( TerritoryPtr pTeri )
   {
-    std::vector< std::string > toSpawn;
-    for( const auto& subActor : m_subActors )
-      if( getSubActor( subActor.first ) == nullptr )
-        toSpawn.push_back( subActor.first );
-
-    for( const auto& name : toSpawn )
-      spawnSubActor( name, pTeri );
+    for( uint32_t i = 0; i < m_subActors.size(); ++i )
+      if( m_subActors[ i ] == nullptr )
+        spawnSubActor( i, pTeri );
   }
 
 
-  void TimelineActor::addPlaceholderSubactor( const std::string& name )
+  uint32_t TimelineActor::addPlaceholderSubactor( const std::string& name )
   {
     // populate m_subActors with nullptr BNpcs
-    // then spawn them all in first timepoint and ref them by name subsequently
-    if( getSubActor( name ) == nullptr )
-      m_subActors.emplace( std::make_pair( name, nullptr ) );
+    // then spawn them all in first timepoint and ref them by index subsequently
+    auto it = std::find( m_subActorNames.begin(), m_subActorNames.end(), name );
+    if( it != m_subActorNames.end() )
+      return static_cast< uint32_t >( it - m_subActorNames.begin() );
+
+    m_subActorNames.push_back( name );
+    m_subActors.push_back( nullptr );
+    return static_cast< uint32_t >( m_subActorNames.size() - 1 );
+  }
+
+  const std::vector< std::string >& TimelineActor::getSubActorNames() const
+  {
+    return m_subActorNames;
   }
 
-  Entity::BNpcPtr TimelineActor::getBNpcByRef( const std::string& name, TerritoryPtr pTeri ) const
+  Entity::BNpcPtr TimelineActor::getBNpcByRef( int32_t subActorIndex, TerritoryPtr pTeri ) const
   {
-    if( name == m_name )
+    if( subActorIndex < 0 )
       return pTeri->getActiveBNpcByLayoutId( m_layoutId );
-    return getSubActor( name );
+    return getSubActor( static_cast< uint32_t >( subActorIndex ) );
   }
 
   void TimelineActor::resetAllSubActors( TerritoryPtr pTeri )
   {
-    for( auto& subActor : m_subActors )
+    for( auto& pSubActor : m_subActors )
     {
-      if( subActor.second )
+      if( pSubActor )
       {
         // todo: need to reset the ai on interrupt
-        auto pAction = subActor.second->getCurrentAction();
+        auto pAction = pSubActor->getCurrentAction();
         if( pAction )
           pAction->interrupt();
 
-        pTeri->removeActor( subActor.second );
-        subActor.second = nullptr;
+        pTeri->removeActor( pSubActor );
+        pSubActor = nullptr;
       }
     }
   }
 
-  Entity::BNpcPtr TimelineActor::spawnSubActor( const std::string& name, TerritoryPtr pTeri )
+  Entity::BNpcPtr TimelineActor::spawnSubActor( uint32_t index, TerritoryPtr pTeri )
   {
     // todo: retail straight up respawns sub actors, even bnpc parts (qarn adjudicator body parts respawn each time with new ids)
     auto flags = Entity::BNpcFlag::Invincible | Entity::BNpcFlag::Untargetable |
                  Entity::BNpcFlag::Immobile | Entity::BNpcFlag::AutoAttackDisabled |
                  Entity::BNpcFlag::TurningDisabled | Entity::BNpcFlag::NoDeaggro;
 
-    auto pActor = getSubActor( name );
-    if( pActor == nullptr )
+    auto pActor = getSubActor( index );
+    if( pActor == nullptr && index < m_subActors.size() )
     {
       auto pParent = pTeri->getActiveBNpcByLayoutId( m_layoutId );
       Common::BNpcType type = pParent ? pParent->getBNpcType() : Common::BNpcType::Enemy;
       
       pActor = pTeri->createBNpcFromLayoutIdNoPush( m_layoutId, 1000, type );
-      m_subActors[ name ] = pActor;
+      m_subActors[ index ] = pActor;
 
       pActor->setInvincibilityType( Common::InvincibilityIgnoreDamage );
       pActor->setFlag( flags );
@@ -183,29 +248,28 @@ namespace Sapphire
       auto& playerMgr = Common::Service< World::Manager::PlayerMgr >::ref();
       for( const auto& player : pTeri->getPlayers() )
       {
-        playerMgr.sendDebug( *player.second, fmt::format( "Spawned subactor {}", name ) );
+        playerMgr.sendDebug( *player.second, fmt::format( "Spawned subactor {}", m_subActorNames[ index ] ) );
       }
     }
 
     return pActor;
   }
 
-  Entity::BNpcPtr TimelineActor::getSubActor( const std::string& name ) const
+  Entity::BNpcPtr TimelineActor::getSubActor( uint32_t index ) const
   {
-    if( auto it = m_subActors.find( name ); it != m_subActors.end() )
-      return it->second;
+    if( index < m_subActors.size() )
+      return m_subActors[ index ];
     return nullptr;
   }
 
   void TimelineActor::resetSubActors( TerritoryPtr pTeri )
   {
-    for( auto& subActor : m_subActors )
+    for( auto& pSubActor : m_subActors )
     {
-      if( subActor.second )
+      if( pSubActor )
       {
-        auto& pBNpc = subActor.second;
-        pTeri->removeActor( pBNpc );
-        subActor.second = nullptr;
+        pTeri->removeActor( pSubActor );
+        pSubActor = nullptr;
       }
     }
   }
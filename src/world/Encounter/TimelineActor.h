@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <queue>
 
 #include "ScheduleCondition.h"
 #include "TimelineActorState.h"
@@ -16,11 +18,22 @@ namespace Sapphire
   class TimelineActor
   {
   protected:
-    std::unordered_map< uint32_t, ScheduleConditionPtr > m_scheduleConditions;
-    std::unordered_map< uint32_t, ConditionState > m_conditionStates;
+    static constexpr uint64_t NotScheduled = UINT64_MAX;
+    using DueCondition = std::pair< uint64_t, uint32_t >;
 
-    // PARENTNAME_SUBACTOR_1, ..., PARENTNAME_SUBACTOR_69
-    std::unordered_map< std::string, Entity::BNpcPtr > m_subActors;
+    // conditions are immutable and shared by every instance of the timeline, states are per instance
+    std::vector< ScheduleConditionPtr > m_scheduleConditions;
+    std::vector< ConditionState > m_conditionStates;
+    std::unordered_map< uint32_t, uint32_t > m_conditionIndexById;
+
+    // min-heap of ( due time, condition index ), entries not matching m_conditionDueTimes are stale
+    std::priority_queue< DueCondition, std::vector< DueCondition >, std::greater< DueCondition > > m_dueConditions;
+    std::vector< uint64_t > m_conditionDueTimes;
+    std::vector< uint32_t > m_dueScratch;
+
+    // PARENTNAME_SUBACTOR_1, ..., PARENTNAME_SUBACTOR_69, timepoints ref them by index
+    std::vector< std::string > m_subActorNames;
+    std::vector< Entity::BNpcPtr > m_subActors;
 
   public:
     uint32_t m_layoutId{ 0 };
@@ -29,25 +42,28 @@ namespace Sapphire
 
     TimelineActor() {}
     TimelineActor( const TimelineActor& rhs ) :
+      m_scheduleConditions( rhs.m_scheduleConditions ),
+      m_conditionStates( rhs.m_conditionStates ),
+      m_conditionIndexById( rhs.m_conditionIndexById ),
+      m_conditionDueTimes( rhs.m_scheduleConditions.size(), NotScheduled ),
+      m_subActorNames( rhs.m_subActorNames ),
+      m_subActors( rhs.m_subActorNames.size(), nullptr ),
       m_layoutId( rhs.m_layoutId ),
       m_hp( rhs.m_hp ),
-      m_name( rhs.m_name ),
-      m_scheduleConditions( rhs.m_scheduleConditions )
+      m_name( rhs.m_name )
     {
-      // yeah
-      for( const auto& subActor : rhs.m_subActors )
-        m_subActors.emplace( std::make_pair( subActor.first, nullptr ) );
-
-      m_conditionStates = rhs.m_conditionStates;
-      for( const auto& state : rhs.m_scheduleConditions )
-        state.second->reset( m_conditionStates[ state.first ], true );
+      for( uint32_t i = 0; i < m_scheduleConditions.size(); ++i )
+      {
+        m_scheduleConditions[ i ]->reset( m_conditionStates[ i ], true );
+        wakeCondition( i );
+      }
     }
 
     const std::string& getName() const;
 
     uint32_t getLayoutId() const;
 
-    bool isScheduleActive( const std::string& name ) const;
+    bool isScheduleActive( uint32_t scheduleIndex ) const;
 
     void addPhaseCondition( ScheduleConditionPtr pCondition );
 
@@ -64,14 +80,25 @@ namespace Sapphire
 
     void resetAllSubActors( TerritoryPtr pTeri );
 
-    // get self or subactor
-    Entity::BNpcPtr getBNpcByRef( const std::string& name, TerritoryPtr pTeri ) const;
+    // get self ( -1 ) or subactor
+    Entity::BNpcPtr getBNpcByRef( int32_t subActorIndex, TerritoryPtr pTeri ) const;
 
     // todo: i hate this but it's the only way to ref subactors while staying self contained
-    void addPlaceholderSubactor( const std::string& name );
+    // returns the index the subactor is referenced by
+    uint32_t addPlaceholderSubactor( const std::string& name );
 
-    Entity::BNpcPtr spawnSubActor( const std::string& name, TerritoryPtr pTeri );
-    Entity::BNpcPtr getSubActor( const std::string& name ) const;
+    const std::vector< std::string >& getSubActorNames() const;
+
+    Entity::BNpcPtr spawnSubActor( uint32_t index, TerritoryPtr pTeri );
+    Entity::BNpcPtr getSubActor( uint32_t index ) const;
     void resetSubActors( TerritoryPtr pTeri );
+
+  private:
+    // (re)schedule a condition, NotScheduled parks it until its state is touched from outside
+    void scheduleCondition( uint32_t index, uint64_t dueTime );
+    void wakeCondition( uint32_t index );
+
+    uint64_t getNextDueTime( uint32_t index, TimelinePack& pack, uint64_t time ) const;
+    void updateCondition( uint32_t index, EncounterPtr pEncounter, TimelinePack& pack, uint64_t time );
   };
 }
\ No newline at end of file
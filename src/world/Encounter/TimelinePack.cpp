@@ -28,6 +28,7 @@
 #include <Util/Util.h>
 
 #include <filesystem>
+#include <mutex>
 
 namespace Sapphire
 {
@@ -98,9 +99,79 @@ namespace Sapphire
   // parsing stuff below
   //
 
-  TimelinePack TimelinePack::getEncounterPack( const std::string& name, bool reload )
+  TimelineRefResolver::TimelineRefResolver( const std::vector< TimelineActor >& actors, const std::vector< Selector >& selectors ) :
+    m_actors( actors ),
+    m_scheduleIndexes( actors.size() )
+  {
+    for( int32_t i = 0; i < static_cast< int32_t >( actors.size() ); ++i )
+      m_actorRefs.emplace( actors[ i ].getName(), TimelineActorRef{ i, -1 } );
+
+    // actors take precedence over sub actors of the same name
+    for( int32_t i = 0; i < static_cast< int32_t >( actors.size() ); ++i )
+    {
+      const auto& subActorNames = actors[ i ].getSubActorNames();
+      for( int32_t j = 0; j < static_cast< int32_t >( subActorNames.size() ); ++j )
+        m_actorRefs.emplace( subActorNames[ j ], TimelineActorRef{ i, j } );
+    }
+
+    for( int32_t i = 0; i < static_cast< int32_t >( selectors.size() ); ++i )
+      m_selectorIndexes.emplace( selectors[ i ].getName(), i );
+  }
+
+  void TimelineRefResolver::addSchedule( uint32_t actorIndex, const std::string& name, uint32_t scheduleIndex )
+  {
+    m_scheduleIndexes[ actorIndex ].emplace( name, static_cast< int32_t >( scheduleIndex ) );
+  }
+
+  const TimelineActor* TimelineRefResolver::findActor( const std::string& name ) const
+  {
+    auto index = getActorIndex( name );
+    return index != -1 ? &m_actors[ index ] : nullptr;
+  }
+
+  int32_t TimelineRefResolver::getActorIndex( const std::string& name ) const
+  {
+    auto ref = getActorRef( name );
+    return ref.m_subActorIndex == -1 ? ref.m_actorIndex : -1;
+  }
+
+  TimelineActorRef TimelineRefResolver::getActorRef( const std::string& name ) const
+  {
+    if( auto it = m_actorRefs.find( name ); it != m_actorRefs.end() )
+      return it->second;
+    return {};
+  }
+
+  int32_t TimelineRefResolver::getSelectorIndex( const std::string& name ) const
+  {
+    if( auto it = m_selectorIndexes.find( name ); it != m_selectorIndexes.end() )
+      return it->second;
+    return -1;
+  }
+
+  int32_t TimelineRefResolver::getScheduleIndex( uint32_t actorIndex, const std::string& name ) const
+  {
+    if( actorIndex >= m_scheduleIndexes.size() )
+      return -1;
+
+    const auto& schedules = m_scheduleIndexes[ actorIndex ];
+    if( auto it = schedules.find( name ); it != schedules.end() )
+      return it->second;
+    return -1;
+  }
+
+  namespace
+  {
+    std::string timelineDirectory = "data/EncounterTimelines";
+  }
+
+  void TimelinePack::setTimelineDirectory( const std::string& path )
+  {
+    timelineDirectory = path;
+  }
+
+  std::shared_ptr< TimelinePack > TimelinePack::compileTimelinePack( const std::string& name )
   {
-    static std::unordered_map< std::string, TimelinePack > cache = {};
     const static std::unordered_map< std::string, ConditionType > conditionMap =
     {
       { "hpPctLessThan",            ConditionType::HpPctLessThan },
@@ -124,33 +195,26 @@ namespace Sapphire
       { "scheduleActive",           ConditionType::ScheduleActive }
     };
 
-    TimelinePack pack;
-    if( cache.find( name ) != cache.end() && !reload )
-      return cache.at( name );
-
-    std::string encounter_name( fmt::format( std::string( "data/EncounterTimelines/{}.json" ), name ) );
+    auto pack = std::make_shared< TimelinePack >();
+    std::string encounter_name( fmt::format( std::string( "{}/{}.json" ), timelineDirectory, name ) );
 
     std::fstream f( encounter_name );
 
     if( !f.is_open() )
-      return pack;
+      return nullptr;
 
     auto json = nlohmann::json::parse( f );
 
-    std::unordered_map< std::string, TimelineActor > actorNameMap;
-    std::unordered_map< std::string, std::map< std::string, Schedule > > actorNameSchedMap;
-
     for( const auto& selectorJ : json.at( "selectors" ).items() )
     {
       auto& selectorV = selectorJ.value();
-      auto name = selectorV.at( "name" ).get< std::string >();
       Selector selector;
       selector.from_json( selectorV );
 
-      pack.addSelector( name, selector );
+      pack->addSelector( selector );
     }
 
-    // first run through cache actor info
+    // first run through cache actor info, actors keep the order of the timeline
     for( const auto& actorJ : json.at( "actors" ).items() )
     {
       TimelineActor actor;
@@ -164,49 +228,56 @@ namespace Sapphire
       if( !subActorsJ.is_null() )
         for( const auto& subActorV : subActorsJ.items() )
           actor.addPlaceholderSubactor( subActorV.value().get< std::string >() );
-       
-      actorNameMap.emplace( std::make_pair( actor.m_name, actor ) );
+
+      for( const auto& other : pack->m_timelineActors )
+        if( other.m_name == actor.m_name )
+          throw std::runtime_error( fmt::format( std::string( "EncounterTimeline::getEncounterPack - duplicate actor by name: {}" ), actor.m_name ) );
+
+      pack->addTimelineActor( actor );
     }
 
+    TimelineRefResolver refs( pack->m_timelineActors, pack->m_selectors );
+
+    // < actorIndex, < scheduleIndex, schedule > >
+    std::vector< std::vector< Schedule > > actorSchedules( pack->m_timelineActors.size() );
+
     // build timeline info per actor
+    uint32_t actorIndex = 0;
     for( const auto& actorJ : json.at( "actors" ).items() )
     {
-      // < actorName, < schedulename, schedule > >
-      std::map< std::string, Schedule > scheduleNameMap;
-
       auto& actorV = actorJ.value();
-      std::string actorName = actorV.at( "name" );
+      auto& actor = pack->m_timelineActors[ actorIndex ];
+      auto& schedules = actorSchedules[ actorIndex ];
 
-      TimelineActor& actor = actorNameMap[ actorName ];
       // todo: are schedules linked by actor, or global in the json
       for( const auto& scheduleJ : actorV.at( "schedules" ).items() )
       {
         auto& scheduleV = scheduleJ.value();
-        const auto id = scheduleV.at( "id" ).get< uint32_t >();
         const auto& scheduleName = scheduleV.at( "name" ).get< std::string >();
         const auto& timepointsJ = scheduleV.at( "timepoints" );
         const auto& description = scheduleV.at( "description" ).get< std::string >();
 
         Schedule schedule;
         schedule.m_name = scheduleName;
+        schedule.m_index = static_cast< uint32_t >( schedules.size() );
         schedule.m_description = description;
 
-        uint64_t timepointOffset = 0;
         for( const auto& timepointJ : timepointsJ.items() )
         {
           auto& timepointV = timepointJ.value();
           Timepoint timepoint;
-          timepoint.from_json( timepointV, actorNameMap, actor.m_layoutId );
+          timepoint.from_json( timepointV, refs, actor.m_layoutId );
 
           schedule.m_timepoints.push_back( timepoint );
         }
 
-        if( scheduleNameMap.find( scheduleName ) != scheduleNameMap.end() )
+        if( refs.getScheduleIndex( actorIndex, scheduleName ) != -1 )
           throw std::runtime_error( fmt::format( std::string( "EncounterTimeline::getEncounterPack - duplicate schedule by name: {}" ), scheduleName ) );
 
-        scheduleNameMap.emplace( std::make_pair( scheduleName, schedule ) );
+        refs.addSchedule( actorIndex, scheduleName, schedule.m_index );
+        schedules.push_back( schedule );
       }
-      actorNameSchedMap[ actorName ] = scheduleNameMap;
+      ++actorIndex;
     }
 
     // build the condition list
@@ -226,16 +297,14 @@ namespace Sapphire
         throw std::runtime_error( fmt::format( std::string( "EncounterTimeline::getEncounterPack - no condition id found by name: {}" ), conditionName ) );
 
       // make sure the actor we're referencing exists
-      if( auto actorIt = actorNameMap.find( actorRef ); actorIt != actorNameMap.end() )
+      if( auto targetIndex = refs.getActorIndex( actorRef ); targetIndex != -1 )
       {
-        auto& scheduleNameMap = actorNameSchedMap[ actorRef ];
-
-        TimelineActor& actor = actorIt->second;
+        TimelineActor& actor = pack->m_timelineActors[ targetIndex ];
 
         // make sure schedule we're referencing exists
-        if( auto scheduleIt = scheduleNameMap.find( scheduleRef ); scheduleIt != scheduleNameMap.end() )
+        if( auto scheduleIndex = refs.getScheduleIndex( targetIndex, scheduleRef ); scheduleIndex != -1 )
         {
-          Schedule& schedule = scheduleIt->second;
+          Schedule& schedule = actorSchedules[ targetIndex ][ scheduleIndex ];
 
           // build the condition
           ScheduleConditionPtr pCondition = nullptr;
@@ -245,7 +314,7 @@ namespace Sapphire
             case ConditionType::HpPctBetween:
             {
               pCondition = std::make_shared< ConditionHp >();
-              pCondition->from_json( scV, schedule, condition, actorNameMap );
+              pCondition->from_json( scV, schedule, condition, refs );
             }
             break;
             case ConditionType::DirectorVarEquals:
@@ -256,37 +325,39 @@ namespace Sapphire
             case ConditionType::DirectorSeqGreaterThan:
             {
               pCondition = std::make_shared< ConditionDirectorVar >();
-              pCondition->from_json( scV, schedule, condition, actorNameMap );
+              pCondition->from_json( scV, schedule, condition, refs );
             }
             break;
             case ConditionType::EncounterTimeElapsed:
             {
               pCondition = std::make_shared< ConditionEncounterTimeElapsed >();
-              pCondition->from_json( scV, schedule, condition, actorNameMap );
+              pCondition->from_json( scV, schedule, condition, refs );
             }
             break;
             case ConditionType::CombatState:
             {
               pCondition = std::make_shared< ConditionCombatState >();
-              pCondition->from_json( scV, schedule, condition, actorNameMap );
+              pCondition->from_json( scV, schedule, condition, refs );
             }
             break;
             case ConditionType::GetAction:
             {
               pCondition = std::make_shared< ConditionGetAction >();
-              pCondition->from_json( scV, schedule, condition, actorNameMap );
+              pCondition->from_json( scV, schedule, condition, refs );
             }
             break;
             case ConditionType::ScheduleActive:
             {
               pCondition = std::make_shared< ConditionScheduleActive >();
-              pCondition->from_json( scV, schedule, condition, actorNameMap );
+              pCondition->from_json( scV, schedule, condition, refs );
             }
             break;
             default:
               break;
           }
-          actor.addPhaseCondition( pCondition );
+
+          if( pCondition )
+            actor.addPhaseCondition( pCondition );
         }
       }
       else
@@ -295,216 +366,50 @@ namespace Sapphire
       }
     }
 
-    for( const auto& actor : actorNameMap )
-      pack.addTimelineActor( actor.second );
-
-    pack.setName( name );
-
-    // todo: reload will probably kill the server when CastAction.callbacks are added
-    if( reload )
-      cache[ name ] = pack;
-    else
-      cache.emplace( std::make_pair( name, pack ) );
+    pack->setName( name );
     return pack;
   }
 
-  std::shared_ptr< TimelinePack > TimelinePack::createTimelinePack( const std::string& name )
+  std::shared_ptr< const TimelinePack > TimelinePack::getCompiledPack( const std::string& name, bool reload )
   {
-    const static std::unordered_map< std::string, ConditionType > conditionMap =
-    {
-      { "hpPctLessThan",            ConditionType::HpPctLessThan },
-      { "hpPctBetween",             ConditionType::HpPctBetween },
+    // parsed packs are never modified, instances only copy the per instance state out of them
+    static std::unordered_map< std::string, std::shared_ptr< const TimelinePack > > cache = {};
+    // instances of different territories can be created from any thread
+    static std::mutex cacheMutex;
 
-      { "directorVarEquals",        ConditionType::DirectorVarEquals },
-      { "directorVarGreaterThan",   ConditionType::DirectorVarGreaterThan },
-
-      { "directorSeqEquals",        ConditionType::DirectorSeqEquals },
-      { "directorSeqGreaterThan",   ConditionType::DirectorSeqGreaterThan },
-
-      { "directorFlagsEquals",      ConditionType::DirectorFlagsEquals },
-      { "directorFlagsGreaterThan", ConditionType::DirectorFlagsGreaterThan },
+    std::scoped_lock lock( cacheMutex );
 
-      { "encounterTimeElapsed",     ConditionType::EncounterTimeElapsed },
-
-      { "combatState",              ConditionType::CombatState },
-      { "bnpcHasFlags",             ConditionType::BNpcHasFlags },
-
-      { "getAction",                ConditionType::GetAction },
-      { "scheduleActive",           ConditionType::ScheduleActive }
-    };
-
-    auto pack = std::make_shared< TimelinePack >();
-    std::string encounter_name( fmt::format( std::string( "data/EncounterTimelines/{}.json" ), name ) );
-
-    std::fstream f( encounter_name );
-
-    if( !f.is_open() )
-      return nullptr;
-
-    auto json = nlohmann::json::parse( f );
-
-    std::unordered_map< std::string, TimelineActor > actorNameMap;
-    std::unordered_map< std::string, std::map< std::string, Schedule > > actorNameScheduleMap;
-
-    for( const auto& selectorJ : json.at( "selectors" ).items() )
+    if( !reload )
     {
-      auto& selectorV = selectorJ.value();
-      auto name = selectorV.at( "name" ).get< std::string >();
-      Selector selector;
-      selector.from_json( selectorV );
-
-      pack->addSelector( name, selector );
-    }
-
-    // first run through cache actor info
-    for( const auto& actorJ : json.at( "actors" ).items() )
-    {
-      TimelineActor actor;
-      auto& actorV = actorJ.value();
-      actor.m_hp = actorV.at( "hp" ).get< uint32_t >();
-      actor.m_layoutId = actorV.at( "layoutId" ).get< uint32_t >();
-      actor.m_name = actorV.at( "name" ).get< std::string >();
-
-      auto& subActorsJ = actorV.at( "subactors" );
-
-      if( !subActorsJ.is_null() )
-        for( const auto& subActorV : subActorsJ.items() )
-          actor.addPlaceholderSubactor( subActorV.value().get< std::string >() );
-
-      actorNameMap.emplace( std::make_pair( actor.m_name, actor ) );
-    }
-
-    // build timeline info per actor
-    for( const auto& actorJ : json.at( "actors" ).items() )
-    {
-      // < actorName, < phasename, phase > >
-      std::map< std::string, Schedule > scheduleNameMap;
-
-      auto actorV = actorJ.value();
-      std::string actorName = actorV.at( "name" );
-
-      TimelineActor& actor = actorNameMap[ actorName ];
-      // todo: are phases linked by actor, or global in the json
-      for( const auto& scheduleJ : actorV.at( "schedules" ).items() )
-      {
-        auto& scheduleV = scheduleJ.value();
-        const auto id = scheduleV.at( "id" ).get< uint32_t >();
-        const auto& scheduleName = scheduleV.at( "name" ).get< std::string >();
-        const auto& timepointsJ = scheduleV.at( "timepoints" );
-        const auto& description = scheduleV.at( "description" ).get< std::string >();
-
-        Schedule phase;
-        phase.m_name = scheduleName;
-        phase.m_description = description;
-        for( const auto& timepointJ : timepointsJ.items() )
-        {
-          auto timepointV = timepointJ.value();
-          Timepoint timepoint;
-          timepoint.from_json( timepointV, actorNameMap, actor.m_layoutId );
-
-          phase.m_timepoints.push_back( timepoint );
-        }
-
-        if( scheduleNameMap.find( scheduleName ) != scheduleNameMap.end() )
-          throw std::runtime_error( fmt::format( std::string( "EncounterTimeline::getEncounterPack - duplicate phase by name: {}" ), scheduleName ) );
-
-        scheduleNameMap.emplace( std::make_pair( scheduleName, phase ) );
-      }
-      actorNameScheduleMap[ actorName ] = scheduleNameMap;
+      if( auto it = cache.find( name ); it != cache.end() )
+        return it->second;
     }
 
-    // build the condition list
-    for( const auto& pcJ : json.at( "conditions" ).items() )
-    {
-      auto& pcV = pcJ.value();
-      auto conditionName = pcV.at( "condition" ).get< std::string >();
-      auto scheduleRef = pcV.at( "targetSchedule" ).get< std::string >();
-      auto actorRef = pcV.at( "targetActor" ).get< std::string >();
-
-      ConditionType condition;
-
-      // make sure condition exists
-      if( auto it = conditionMap.find( conditionName ); it != conditionMap.end() )
-        condition = it->second;
-      else
-        throw std::runtime_error( fmt::format( std::string( "EncounterTimeline::getEncounterPack - no condition id found by name: {}" ), conditionName ) );
-
-      // make sure the actor we're referencing exists
-      if( auto actorIt = actorNameMap.find( actorRef ); actorIt != actorNameMap.end() )
-      {
-        auto& scheduleNameMap = actorNameScheduleMap[ actorRef ];
-
-        TimelineActor& actor = actorIt->second;
+    auto pPack = compileTimelinePack( name );
+    if( !pPack )
+      return nullptr;
 
-        // make sure phase we're referencing exists
-        if( auto scheduleIt = scheduleNameMap.find( scheduleRef ); scheduleIt != scheduleNameMap.end() )
-        {
-          Schedule& schedule = scheduleIt->second;
+    // todo: reload will probably kill the server when CastAction.callbacks are added
+    cache[ name ] = pPack;
+    return pPack;
+  }
 
-          // build the condition
-          ScheduleConditionPtr pCondition = nullptr;
-          switch( condition )
-          {
-            case ConditionType::HpPctLessThan:
-            case ConditionType::HpPctBetween:
-            {
-              pCondition = std::make_shared< ConditionHp >();
-              pCondition->from_json( pcV, schedule, condition, actorNameMap );
-            }
-              break;
-            case ConditionType::DirectorVarEquals:
-            case ConditionType::DirectorVarGreaterThan:
-            case ConditionType::DirectorFlagsEquals:
-            case ConditionType::DirectorFlagsGreaterThan:
-            case ConditionType::DirectorSeqEquals:
-            case ConditionType::DirectorSeqGreaterThan:
-            {
-              pCondition = std::make_shared< ConditionDirectorVar >();
-              pCondition->from_json( pcV, schedule, condition, actorNameMap );
+  TimelinePack TimelinePack::getEncounterPack( const std::string& name, bool reload )
+  {
+    auto pPack = getCompiledPack( name, reload );
+    if( !pPack )
+      return {};
 
-            }
-              break;
-            case ConditionType::EncounterTimeElapsed:
-            {
-              pCondition = std::make_shared< ConditionEncounterTimeElapsed >();
-              pCondition->from_json( pcV, schedule, condition, actorNameMap );
-            }
-              break;
-            case ConditionType::CombatState:
-            {
-              pCondition = std::make_shared< ConditionCombatState >();
-              pCondition->from_json( pcV, schedule, condition, actorNameMap );
-            }
-              break;
-            case ConditionType::GetAction:
-            {
-              pCondition = std::make_shared< ConditionGetAction >();
-              pCondition->from_json( pcV, schedule, condition, actorNameMap );
-            }
-              break;
-            case ConditionType::ScheduleActive:
-            {
-              pCondition = std::make_shared< ConditionScheduleActive >();
-              pCondition->from_json( pcV, schedule, condition, actorNameMap );
-            }
-              break;
-            default:
-              break;
-          }
-          actor.addPhaseCondition( pCondition );
-        }
-      }
-      else
-      {
-        throw std::runtime_error( fmt::format( std::string( "EncounterTimeline::getEncounterPack - no state found by name: {}" ), scheduleRef ) );
-      }
-    }
+    return *pPack;
+  }
 
-    for( const auto& actor : actorNameMap )
-      pack->addTimelineActor( actor.second );
+  std::shared_ptr< TimelinePack > TimelinePack::createTimelinePack( const std::string& name )
+  {
+    auto pPack = getCompiledPack( name );
+    if( !pPack )
+      return nullptr;
 
-    pack->setName( name );
-    return pack;
+    return std::make_shared< TimelinePack >( *pPack );
   }
 
   void TimelinePack::setName( const std::string& name )
@@ -512,47 +417,56 @@ namespace Sapphire
     m_name = name;
   }
 
-  void TimelinePack::addSelector( const std::string& name, const Selector& selector )
+  void TimelinePack::addSelector( const Selector& selector )
   {
-    m_selectors.emplace( std::make_pair( name, selector ) );
+    m_selectors.push_back( selector );
   }
 
-  void TimelinePack::createSnapshot( const std::string& selectorName, Entity::CharaPtr pSrc, const std::vector< uint32_t >& exclude )
+  void TimelinePack::createSnapshot( int32_t selector, Entity::CharaPtr pSrc, const std::vector< uint32_t >& exclude )
   {
-    if( auto it = m_selectors.find( selectorName ); it != m_selectors.end() )
-      it->second.createSnapshot( pSrc, exclude );
+    if( selector >= 0 && selector < static_cast< int32_t >( m_selectors.size() ) )
+      m_selectors[ selector ].createSnapshot( pSrc, exclude );
   }
 
-  const World::AI::Snapshot::Results& TimelinePack::getSnapshotResults( const std::string& selectorName )
+  const World::AI::Snapshot::Results& TimelinePack::getSnapshotResults( int32_t selector )
   {
-    static World::AI::Snapshot::Results empty;
-    if( auto it = m_selectors.find( selectorName ); it != m_selectors.end() )
-      return it->second.getResults();
+    static const World::AI::Snapshot::Results empty;
+    if( selector >= 0 && selector < static_cast< int32_t >( m_selectors.size() ) )
+      return m_selectors[ selector ].getResults();
     return empty;
   }
 
-  const World::AI::Snapshot::TargetIds& TimelinePack::getSnapshotTargetIds( const std::string& selectorName )
+  const World::AI::Snapshot::TargetIds& TimelinePack::getSnapshotTargetIds( int32_t selector )
   {
-    static World::AI::Snapshot::TargetIds empty;
-    if( auto it = m_selectors.find( selectorName ); it != m_selectors.end() )
-      return it->second.getTargetIds();
+    static const World::AI::Snapshot::TargetIds empty;
+    if( selector >= 0 && selector < static_cast< int32_t >( m_selectors.size() ) )
+      return m_selectors[ selector ].getTargetIds();
     return empty;
   }
 
+  Selector* TimelinePack::getSelector( int32_t selector )
+  {
+    if( selector >= 0 && selector < static_cast< int32_t >( m_selectors.size() ) )
+      return &m_selectors[ selector ];
+    return nullptr;
+  }
+
   void TimelinePack::addTimelineActor( const TimelineActor& actor )
   {
     m_timelineActors.emplace_back( actor );
   }
 
-  Entity::BNpcPtr TimelinePack::getBNpcByRef( const std::string& name, EncounterPtr pEncounter )
+  const std::vector< TimelineActor >& TimelinePack::getTimelineActors() const
   {
-    for( const auto& actor : m_timelineActors )
-    {
-      auto pBNpc = actor.getBNpcByRef( name, pEncounter->getTeriPtr() );
-      if( pBNpc )
-        return pBNpc;
-    }
-    return nullptr;
+    return m_timelineActors;
+  }
+
+  Entity::BNpcPtr TimelinePack::getBNpcByRef( const TimelineActorRef& ref, EncounterPtr pEncounter )
+  {
+    if( !ref.valid() || ref.m_actorIndex >= static_cast< int32_t >( m_timelineActors.size() ) )
+      return nullptr;
+
+    return m_timelineActors[ ref.m_actorIndex ].getBNpcByRef( ref.m_subActorIndex, pEncounter->getTeriPtr() );
   }
 
   void TimelinePack::reset( EncounterPtr pEncounter )
@@ -576,17 +490,16 @@ namespace Sapphire
 
   void TimelinePack::update( uint64_t time )
   {
-    auto now = Common::Util::getTimeMs(); 
     for( auto& actor : m_timelineActors )
-      actor.update( m_pEncounter, *this, now );
+      actor.update( m_pEncounter, *this, time );
   }
 
-  bool TimelinePack::isScheduleActive( const std::string& actorName, const std::string& scheduleName )
+  bool TimelinePack::isScheduleActive( int32_t actorIndex, int32_t scheduleIndex )
   {
-    for( const auto& actor : m_timelineActors )
-      if( actor.getName() == actorName )
-        return actor.isScheduleActive( scheduleName );
-    return false;
+    if( actorIndex < 0 || scheduleIndex < 0 || actorIndex >= static_cast< int32_t >( m_timelineActors.size() ) )
+      return false;
+
+    return m_timelineActors[ actorIndex ].isScheduleActive( static_cast< uint32_t >( scheduleIndex ) );
   }
 
   void TimelinePack::resetConditionState( uint32_t id, bool toDefault )
@@ -29,6 +29,31 @@ namespace Sapphire
     EncounterFight
   };
 
+  // name lookups of a pack while it is compiled, everything past compile refs actors and selectors by index
+  class TimelineRefResolver
+  {
+    const std::vector< TimelineActor >& m_actors;
+    std::unordered_map< std::string, TimelineActorRef > m_actorRefs;
+    std::unordered_map< std::string, int32_t > m_selectorIndexes;
+    std::vector< std::unordered_map< std::string, int32_t > > m_scheduleIndexes;
+
+  public:
+    TimelineRefResolver( const std::vector< TimelineActor >& actors, const std::vector< Selector >& selectors );
+
+    void addSchedule( uint32_t actorIndex, const std::string& name, uint32_t scheduleIndex );
+
+    // actor itself, nullptr for sub actors or unknown names
+    const TimelineActor* findActor( const std::string& name ) const;
+    int32_t getActorIndex( const std::string& name ) const;
+
+    // actor or sub actor, invalid for unknown names
+    TimelineActorRef getActorRef( const std::string& name ) const;
+
+    // -1 for unknown names
+    int32_t getSelectorIndex( const std::string& name ) const;
+    int32_t getScheduleIndex( uint32_t actorIndex, const std::string& name ) const;
+  };
+
   // todo: actually handle solo stuff properly (or tie to zone director/content director at least)
   class TimelinePack
   {
@@ -37,7 +62,7 @@ namespace Sapphire
     std::vector< TimelineActor > m_timelineActors;
     std::string m_name;
 
-    std::unordered_map< std::string, Selector > m_selectors;
+    std::vector< Selector > m_selectors;
     
     uint64_t m_startTime{ 0 };
     std::shared_ptr< Encounter > m_pEncounter;
@@ -52,26 +77,31 @@ namespace Sapphire
       m_startTime( 0 )
     {
       for( auto& selector : m_selectors )
-        selector.second.clearResults();
+        selector.clearResults();
     }
 
     TimelinePack( TimelinePackType type ) : m_type( type ) {}
 
     void setName( const std::string& name );
 
-    void addSelector( const std::string& name, const Selector& selector );
+    void addSelector( const Selector& selector );
 
-    void createSnapshot( const std::string& selectorName, Entity::CharaPtr pSrc,
+    void createSnapshot( int32_t selector, Entity::CharaPtr pSrc,
                          const std::vector< uint32_t >& exclude );
 
-    const World::AI::Snapshot::Results& getSnapshotResults( const std::string& selectorName );
+    const World::AI::Snapshot::Results& getSnapshotResults( int32_t selector );
+
+    const World::AI::Snapshot::TargetIds& getSnapshotTargetIds( int32_t selector );
 
-    const World::AI::Snapshot::TargetIds& getSnapshotTargetIds( const std::string& selectorName );
+    // nullptr for unresolved selectors
+    Selector* getSelector( int32_t selector );
 
     void addTimelineActor( const TimelineActor& actor );
 
-    // get bnpc by internal timeline name
-    Entity::BNpcPtr getBNpcByRef( const std::string& name, EncounterPtr pEncounter );
+    const std::vector< TimelineActor >& getTimelineActors() const;
+
+    // get bnpc by the ref resolved from its internal timeline name
+    Entity::BNpcPtr getBNpcByRef( const TimelineActorRef& ref, EncounterPtr pEncounter );
 
     void reset( EncounterPtr pEncounter );
 
@@ -81,7 +111,7 @@ namespace Sapphire
 
     void update( uint64_t time );
 
-    bool isScheduleActive( const std::string& actorRef, const std::string& scheduleName );
+    bool isScheduleActive( int32_t actorIndex, int32_t scheduleIndex );
 
     void resetConditionState( uint32_t id, bool toDefault = false );
 
@@ -91,8 +121,16 @@ namespace Sapphire
 
     void setEncounter( std::shared_ptr< Encounter > pEncounter );
 
+    // directory the timelines are compiled from, data/EncounterTimelines unless set before the first compile
+    static void setTimelineDirectory( const std::string& path );
+
+    // new instance sharing the compiled conditions of the timeline, nullptr if there is no such timeline
     static TimeLinePackPtr createTimelinePack( const std::string& name );
+    static std::shared_ptr< const TimelinePack > getCompiledPack( const std::string& name, bool reload = false );
     static TimelinePack getEncounterPack( const std::string& name, bool reload = false );
+
+  private:
+    static TimeLinePackPtr compileTimelinePack( const std::string& name );
   };
 
 
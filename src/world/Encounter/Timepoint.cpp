@@ -3,26 +3,8 @@
 #include "TimelinePack.h"
 #include "Encounter.h"
 
-#include <Action/Action.h>
-
-#include <Actor/BNpc.h>
-#include <Actor/Chara.h>
-#include <Actor/EventObject.h>
-#include <Actor/Player.h>
-
 #include <Event/Director.h>
 
-#include <Manager/ActionMgr.h>
-#include <Manager/PlayerMgr.h>
-#include <Service.h>
-
-#include <Territory/QuestBattle.h>
-#include <Territory/InstanceContent.h>
-#include <Util/UtilMath.h>
-
-#include <Network/CommonActorControl.h>
-#include <Network/Util/PacketUtil.h>
-
 namespace Sapphire
 {
   const TimepointDataPtr Timepoint::getData() const
@@ -37,7 +19,7 @@ namespace Sapphire
     state.m_finished = false;
   }
 
-  void Timepoint::from_json( const nlohmann::json& json, const std::unordered_map< std::string, TimelineActor >& actors, uint32_t selfLayoutId )
+  void Timepoint::from_json( const nlohmann::json& json, const TimelineRefResolver& refs, uint32_t selfLayoutId )
   {
     const static std::unordered_map< std::string, TimepointDataType > timepointTypeMap =
     {
@@ -133,8 +115,8 @@ namespace Sapphire
         auto selectorRef = dataJ.at( "selectorName" ).get< std::string >();
         auto selectorIndex = dataJ.at( "selectorIndex" ).get< uint32_t >();
 
-        m_pData = std::make_shared< TimepointDataAction >( sourceRef, actionId, targetType,
-                                                           selectorRef, selectorIndex - 1 );
+        m_pData = std::make_shared< TimepointDataAction >( refs.getActorRef( sourceRef ), actionId, targetType,
+                                                           refs.getSelectorIndex( selectorRef ), selectorIndex - 1 );
       }
       break;
       case TimepointDataType::SetPos:
@@ -148,8 +130,8 @@ namespace Sapphire
         auto targetType = setPosTargetTypeMap.at( dataJ.at( "targetType" ).get< std::string >() );
         auto posType = setPosTypeMap.at( dataJ.at( "positionType" ).get< std::string >() );
 
-        m_pData = std::make_shared< TimepointDataSetPos >( actorRef, posType, targetType, MoveType::SetPos,
-                                                           selectorName, selectorIndex,
+        m_pData = std::make_shared< TimepointDataSetPos >( refs.getActorRef( actorRef ), posType, targetType, MoveType::SetPos,
+                                                           refs.getSelectorIndex( selectorName ), selectorIndex,
                                                            pos[ 0 ], pos[ 1 ], pos[ 2 ], rot );
       }
       break;
@@ -159,7 +141,7 @@ namespace Sapphire
         auto action = dataJ.at( "actionTimelineId" ).get< uint32_t >();
         auto actorRef = dataJ.at( "actorName" ).get< std::string >();
 
-        m_pData = std::make_shared< TimepointDataActionTimeLine >( actorRef, action );
+        m_pData = std::make_shared< TimepointDataActionTimeLine >( refs.getActorRef( actorRef ), action );
       }
       break;
       case TimepointDataType::LogMessage:
@@ -181,7 +163,7 @@ namespace Sapphire
         pBattleTalkData->m_battleTalkId = dataJ.at( "battleTalkId" ).get< uint32_t >();
         pBattleTalkData->m_kind = dataJ.at( "kind" ).get< uint32_t >();
         pBattleTalkData->m_nameId = dataJ.at( "nameId" ).get< uint32_t >();
-        pBattleTalkData->m_talkerRef = dataJ.at( "talkerActorName" ).get< std::string >();
+        pBattleTalkData->m_talker = refs.getActorRef( dataJ.at( "talkerActorName" ).get< std::string >() );
         pBattleTalkData->m_length = dataJ.at( "length" ).get< uint32_t >();
 
         m_pData = pBattleTalkData;
@@ -266,8 +248,8 @@ namespace Sapphire
         auto actorRef = dataJ.at( "despawnActor" ).get< std::string >();
 
         uint32_t layoutId = Common::INVALID_GAME_OBJECT_ID;
-        if( auto it = actors.find( actorRef ); it != actors.end() )
-          layoutId = it->second.m_layoutId;
+        if( auto pActor = refs.findActor( actorRef ) )
+          layoutId = pActor->m_layoutId;
         else
           throw std::runtime_error( fmt::format( std::string( "Timepoint::from_json: BNpcDespawn invalid actor ref: {}" ), actorRef ) );
 
@@ -287,8 +269,8 @@ namespace Sapphire
         // todo: hateSrc
 
         uint32_t layoutId = Common::INVALID_GAME_OBJECT_ID;
-        if( auto it = actors.find( actorRef ); it != actors.end() )
-          layoutId = it->second.m_layoutId;
+        if( auto pActor = refs.findActor( actorRef ) )
+          layoutId = pActor->m_layoutId;
         else
           throw std::runtime_error( fmt::format( std::string( "Timepoint::from_json: BNpcSpawn invalid actor ref: {}" ), actorRef ) );
 
@@ -304,8 +286,8 @@ namespace Sapphire
         // todo: hateSrc
 
         uint32_t layoutId = selfLayoutId;
-        //if( auto it = actors.find( actorRef ); it != actors.end() )
-        //  layoutId = it->second.m_layoutId;
+        //if( auto pActor = refs.findActor( actorRef ) )
+        //  layoutId = pActor->m_layoutId;
         //else
         //  throw std::runtime_error( fmt::format( std::string( "Timepoint::from_json: BNpcFlags invalid actor ref: {}" ), actorRef ) );
 
@@ -347,7 +329,8 @@ namespace Sapphire
         auto excludeSelector = std::string(); // dataJ.at( "excludeSelectorName" ).get< std::string >();
         // todo: use exclude selector when added to ui
 
-        m_pData = std::make_shared< TimepointDataSnapshot >( selectorName, actorRef, excludeSelector );
+        m_pData = std::make_shared< TimepointDataSnapshot >( refs.getSelectorIndex( selectorName ), refs.getActorRef( actorRef ),
+                                                             refs.getSelectorIndex( excludeSelector ) );
       }
       break;
       default:
@@ -359,17 +342,7 @@ namespace Sapphire
   {
     if( update( self, pack, pEncounter, time ) )
     {
-      auto pTeri = pEncounter->getTeriPtr();
-      const auto& players = pTeri->getPlayers();
-      // send debug msg
-      if( !m_description.empty() )
-      {
-        auto& playerMgr = Common::Service< Sapphire::World::Manager::PlayerMgr >::ref();
-
-        for( const auto& player : players )
-          playerMgr.sendDebug( *player.second, m_description );
-      }
-
+      pEncounter->onTimepoint( self, *this, time );
       return true;
     }
     return false;
@@ -377,7 +350,6 @@ namespace Sapphire
 
   bool Timepoint::update( TimelineActor& self, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const
   {
-    auto pTeri = pEncounter->getTeriPtr();
     // todo: separate execute and update?
     switch( m_type )
     {
@@ -389,123 +361,19 @@ namespace Sapphire
       case TimepointDataType::CastAction:
       {
         auto pActionData = std::dynamic_pointer_cast< TimepointDataAction, TimepointData >( m_pData );
-        auto pBNpc = pack.getBNpcByRef( pActionData->m_sourceRef, pEncounter );
-        // todo: filter the correct target
-        // todo: tie to mechanic script?
-        // todo: mechanic should probably just be an Action::onTick, with instance/director passed to it
-        if( pBNpc )
-        {
-          uint32_t targetId = pBNpc->getId();
-          switch( pActionData->m_targetType )
-          {
-            case ActionTargetType::None:
-              targetId = Common::INVALID_GAME_OBJECT_ID;
-              break;
-            case ActionTargetType::Target:
-              targetId = static_cast< uint32_t >( pBNpc->getTargetId() );
-              break;
-            case ActionTargetType::Self:
-              targetId = pBNpc->getId();
-              break;
-            case ActionTargetType::Selector:
-            {
-              const auto& results = pack.getSnapshotTargetIds( pActionData->m_selectorRef );
-              if( pActionData->m_selectorIndex < results.size() )
-                targetId = results[ pActionData->m_selectorIndex ];
-            }
-            break;
-            default:
-              break;
-          }
-          auto& actionMgr = Common::Service< Sapphire::World::Manager::ActionMgr >::ref();
-          auto pAction = pBNpc->getCurrentAction();
-
-          // todo: this is probably wrong
-          if( !pAction || pAction->isInterrupted() )
-          {
-            actionMgr.handleTargetedAction( *pBNpc, pActionData->m_actionId, targetId, pTeri->getNextActionResultId() );
-            //actionMgr.handlePlacedAction( *pBNpc, pActionData->m_actionId, pBNpc->getPos(), pTeri->getNextActionResultId() );
-          }
-          else
-          {
-            return false;
-          }
-        }
+        return pEncounter->castAction( pack, *pActionData );
       }
-      break;
       case TimepointDataType::SetPos:
       {
         auto pSetPosData = std::dynamic_pointer_cast< TimepointDataSetPos, TimepointData >( m_pData );
-        auto pBNpc = pack.getBNpcByRef( pSetPosData->m_actorRef, pEncounter );
-
-        if( pBNpc )
-        {
-          auto pos = pBNpc->getPos();
-          float rot = 0.f;
-          switch( pSetPosData->m_targetType )
-          {
-            case SetPosTargetType::Target:
-            {
-              auto inRange = pBNpc->getInRangeActors();
-              for( const auto& pActor : inRange )
-              {
-                if( pActor->getId() == pBNpc->getTargetId() )
-                {
-                  pos = pActor->getPos();
-                  rot = pActor->getRot();
-                  break;
-                }
-              }
-            }
-            break;
-            case SetPosTargetType::Selector:
-            {
-              const auto& results = pack.getSnapshotResults( pSetPosData->m_selectorName );
-              if( pSetPosData->m_selectorIndex < results.size() )
-              {
-                pos = results[ pSetPosData->m_selectorIndex ].m_pos;
-                rot = results[ pSetPosData->m_selectorIndex ].m_rot;
-              }
-            }
-            break;
-            default:
-              break;
-          }
-
-          switch( pSetPosData->m_posType )
-          {
-            case SetPosType::Absolute:
-            {
-              pBNpc->setRot( pSetPosData->m_rot );
-              pBNpc->setPos( pSetPosData->m_x, pSetPosData->m_y, pSetPosData->m_z, true );
-            }
-            break;
-            case SetPosType::Relative:
-            {
-              auto offsetPos = Common::Util::getOffsettedPosition( pos, rot, pSetPosData->m_x, pSetPosData->m_y, pSetPosData->m_z );
-              pBNpc->setRot( rot );
-              pBNpc->setPos( offsetPos );
-            }
-            break;
-            default:
-              break;
-          }
-
-        }
+        pEncounter->setPos( pack, *pSetPosData );
       }
       break;
 
       case TimepointDataType::ActionTimeline:
       {
         auto pActionTimelineData = std::dynamic_pointer_cast< TimepointDataActionTimeLine, TimepointData >( m_pData );
-        auto pBNpc = pack.getBNpcByRef( pActionTimelineData->m_actorRef, pEncounter );
-        auto action = pActionTimelineData->m_actionId;
-
-        if( pBNpc )
-        {
-          Network::Util::Packet::sendActorControl( pBNpc->getInRangePlayerIds(), pBNpc->getId(),
-                                                   Network::ActorControl::PlayActionTimeline, action );
-        }
+        pEncounter->playActionTimeline( pack, *pActionTimelineData );
       }
       break;
 
@@ -541,54 +409,13 @@ namespace Sapphire
       case TimepointDataType::LogMessage:
       {
         auto pLogMessage = std::dynamic_pointer_cast< TimepointDataLogMessage, TimepointData >( m_pData );
-        auto params = pLogMessage->m_params;
-
-        // todo: probably should use ContentDirector
-
-        {
-          auto& playerMgr = Common::Service< Sapphire::World::Manager::PlayerMgr >::ref();
-          for( auto& player : pTeri->getPlayers() )
-          {
-            auto& pPlayer = player.second;
-            if( pPlayer )
-              playerMgr.sendLogMessage( *pPlayer.get(), pLogMessage->m_messageId,
-                                        params[ 0 ], params[ 1 ], params[ 2 ], params[ 3 ], params[ 4 ] );
-          }
-        }
+        pEncounter->sendLogMessage( *pLogMessage );
       }
       break;
       case TimepointDataType::BattleTalk:
       {
-        // todo: BattleTalk
         auto pBtData = std::dynamic_pointer_cast< TimepointDataBattleTalk, TimepointData >( m_pData );
-        auto params = pBtData->m_params;
-
-        auto pHandler = pack.getBNpcByRef( pBtData->m_handlerRef, pEncounter );
-        auto pTalker = pack.getBNpcByRef( pBtData->m_talkerRef, pEncounter );
-
-        auto handlerId = pHandler ? pHandler->getId() : Common::INVALID_GAME_OBJECT_ID;
-        auto talkerId = pTalker ? pTalker->getId() : Common::INVALID_GAME_OBJECT_ID;
-
-        // todo: use Actrl EventBattleDialog = 0x39C maybe?,
-        auto& playerMgr = Common::Service< Sapphire::World::Manager::PlayerMgr >::ref();
-
-        // todo: this does not always need to be a director, and can also be an eventhandler
-        //       needs further investigation
-        Event::DirectorPtr pDirector = pEncounter->getDirector();
-
-        if( pDirector )
-          handlerId = pDirector->getDirectorId();
-
-        for( auto& player : pTeri->getPlayers() )
-        {
-
-          auto& pPlayer = player.second;
-          if( pPlayer )
-            playerMgr.sendBattleTalk( *pPlayer.get(), pBtData->m_battleTalkId, handlerId,
-                                      pBtData->m_kind, pBtData->m_nameId, talkerId, static_cast< uint32_t >( pBtData->m_length ),
-                                      params[ 0 ], params[ 1 ], params[ 2 ], params[ 3 ],
-                                      params[ 4 ], params[ 5 ], params[ 6 ], params[ 7 ] );
-        }
+        pEncounter->sendBattleTalk( pack, *pBtData );
       }
       break;
       case TimepointDataType::DirectorSeq:
@@ -699,77 +526,32 @@ namespace Sapphire
       case TimepointDataType::BNpcDespawn:
       {
         auto pDespawnData = std::dynamic_pointer_cast< TimepointDataBNpcDespawn, TimepointData >( m_pData );
-        auto pBNpc = pTeri->getActiveBNpcByLayoutId( pDespawnData->m_layoutId );
-
-        if( pBNpc )
-        {
-          pTeri->removeActor( pBNpc );
-        }
+        pEncounter->despawnBNpc( pDespawnData->m_layoutId );
       }
       break;
       case TimepointDataType::BNpcSpawn:
       {
         auto pSpawnData = std::dynamic_pointer_cast< TimepointDataBNpcSpawn, TimepointData >( m_pData );
-        auto pBNpc = pTeri->getActiveBNpcByLayoutId( pSpawnData->m_layoutId );
-
-        // todo: probably have this info in the timepoint data
-        if( !pBNpc )
-          pBNpc = pTeri->createBNpcFromLayoutId( pSpawnData->m_layoutId, 100, Common::BNpcType::Enemy );
-
-        if( pBNpc )
-        {
-          pBNpc->resetFlags( pSpawnData->m_flags );
-          pBNpc->init();
-
-          pTeri->pushActor( pBNpc );
-
-        }
+        pEncounter->spawnBNpc( pSpawnData->m_layoutId, pSpawnData->m_flags );
       }
       break;
       case TimepointDataType::BNpcFlags:
       {
         auto pBNpcFlagData = std::dynamic_pointer_cast< TimepointDataBNpcFlags, TimepointData >( m_pData );
-        auto pBNpc = pTeri->getActiveBNpcByLayoutId( pBNpcFlagData->m_layoutId );
-
-        if( pBNpc )
-        {
-          pBNpc->resetFlags( pBNpcFlagData->m_flags );
-          // todo: resend some bnpc packet/actrl?
-        }
+        pEncounter->setBNpcFlags( pBNpcFlagData->m_layoutId, pBNpcFlagData->m_flags );
       }
       break;
       case TimepointDataType::SetEObjState:
       {
-        auto pEObjData = std::dynamic_pointer_cast< TimepointDataEObjState, TimepointData >( m_pData );
-
-        auto pInstance = pTeri->getAsInstanceContent();
-        auto pQBattle = pTeri->getAsQuestBattle();
-
-        // todo: event objects on quest battles
-        // todo: SetEObjAnimationFlag?
-
-        if( pInstance )
-        {
-          auto pEObj = pInstance->getEObjById( pEObjData->m_eobjId );
-          if( pEObj )
-          {
-            pEObj->setState( pEObjData->m_state );
-            // todo: resend the eobj spawn packet?
-          }
-        }
+        // todo: SetEObjState is not parsed yet
+        if( auto pEObjData = std::dynamic_pointer_cast< TimepointDataEObjState, TimepointData >( m_pData ) )
+          pEncounter->setEObjState( pEObjData->m_eobjId, pEObjData->m_state );
       }
       break;
       case TimepointDataType::SetBgm:
       {
         auto pBgmData = std::dynamic_pointer_cast< TimepointDataBGM, TimepointData >( m_pData );
-        auto pInstance = pTeri->getAsInstanceContent();
-        auto pQBattle = pTeri->getAsQuestBattle();
-
-        // todo: quest battles refactor to inherit InstanceContent
-        if( pInstance )
-        {
-          pInstance->setCurrentBGM( pBgmData->m_bgmId );
-        }
+        pEncounter->setBgm( pBgmData->m_bgmId );
       }
       break;
       case TimepointDataType::SetCondition:
@@ -784,13 +566,7 @@ namespace Sapphire
       case TimepointDataType::Snapshot:
       {
         auto pSnapshotData = std::dynamic_pointer_cast< TimepointDataSnapshot, TimepointData >( m_pData );
-        auto pBNpc = pack.getBNpcByRef( pSnapshotData->m_actorRef, pEncounter );
-
-        if( pBNpc )
-        {
-          const auto& exclude = pack.getSnapshotTargetIds( pSnapshotData->m_excludeSelector );
-          pack.createSnapshot( pSnapshotData->m_selector, pBNpc, exclude );
-        }
+        pEncounter->createSnapshot( pack, *pSnapshotData );
       }
       break;
       default:
@@ -798,4 +574,4 @@ namespace Sapphire
     }
     return true;
   }
-}
\ No newline at end of file
+}
@@ -87,6 +87,19 @@ namespace Sapphire
     And // idx &= val
   };
 
+  // actor or sub actor of the pack, resolved from the timeline names when the pack is compiled
+  struct TimelineActorRef
+  {
+    int32_t m_actorIndex{ -1 };
+    // -1 refers to the actor itself
+    int32_t m_subActorIndex{ -1 };
+
+    bool valid() const
+    {
+      return m_actorIndex >= 0;
+    }
+  };
+
   //
   // Timepoint.m_pData objects
   //
@@ -109,56 +122,56 @@ namespace Sapphire
 
   struct TimepointDataAction : public TimepointData
   {
-    std::string m_sourceRef;
+    TimelineActorRef m_source;
     uint32_t m_actionId;
     ActionTargetType m_targetType;
-    std::string m_selectorRef;
+    int32_t m_selector;
     uint32_t m_selectorIndex;
 
-    TimepointDataAction( const std::string& sourceRef, uint32_t actionId,
-                         ActionTargetType type, const std::string& selectorRef,
+    TimepointDataAction( TimelineActorRef source, uint32_t actionId,
+                         ActionTargetType type, int32_t selector,
                          uint32_t selectorIndex = 0 ) :
       TimepointData( TimepointDataType::CastAction ),
-      m_sourceRef( sourceRef ),
+      m_source( source ),
       m_actionId( actionId ),
       m_targetType( type ),
-      m_selectorRef( selectorRef ),
+      m_selector( selector ),
       m_selectorIndex( selectorIndex )
     {
     }
   };
 
   struct TimepointDataActionTimeLine : public TimepointData {
-    std::string m_actorRef;
+    TimelineActorRef m_actor;
     uint32_t m_actionId;
 
-    TimepointDataActionTimeLine( const std::string& actorRef, uint32_t action ) :
+    TimepointDataActionTimeLine( TimelineActorRef actor, uint32_t action ) :
       TimepointData( TimepointDataType::ActionTimeline ),
-      m_actorRef( actorRef ),
+      m_actor( actor ),
       m_actionId( action )
     {
     }
   };
 
   struct TimepointDataSetPos : public TimepointData {
-    // todo: use internal id
-    std::string m_actorRef;
+    TimelineActorRef m_actor;
     MoveType m_moveType;
     SetPosType m_posType;
     SetPosTargetType m_targetType;
-    std::string m_selectorName;
+    int32_t m_selector;
     uint32_t m_selectorIndex;
     float m_x, m_y, m_z, m_rot;
 
-    TimepointDataSetPos( const std::string& actorRef,
+    TimepointDataSetPos( TimelineActorRef actor,
                         SetPosType type, SetPosTargetType targetType, MoveType moveType,
-                        const std::string& selectorName, uint32_t selectorIndex,
+                        int32_t selector, uint32_t selectorIndex,
                         float x, float y, float z, float rot ) :
       TimepointData( TimepointDataType::SetPos ),
-      m_actorRef( actorRef ),
-      m_posType( type ),
+      m_actor( actor ),
       m_moveType( moveType ),
-      m_selectorName( selectorName), m_selectorIndex( selectorIndex ),
+      m_posType( type ),
+      m_targetType( targetType ),
+      m_selector( selector ), m_selectorIndex( selectorIndex ),
       m_x( x ), m_y( y ), m_z( z ), m_rot( rot )
     {
     }
@@ -179,10 +192,10 @@ namespace Sapphire
 
   struct TimepointDataBattleTalk : public TimepointData {
     uint32_t m_battleTalkId;
-    std::string m_handlerRef;
+    TimelineActorRef m_handler;
     uint32_t m_kind;
     uint32_t m_nameId;
-    std::string m_talkerRef;
+    TimelineActorRef m_talker;
     uint32_t m_length{ 0 };
 
     uint32_t m_params[ 8 ]{ 0 };
@@ -305,14 +318,14 @@ namespace Sapphire
   struct TimepointDataSnapshot : public TimepointData
   {
     // todo: rng?
-    std::string m_selector;
-    std::string m_actorRef;
-    std::string m_excludeSelector;
+    int32_t m_selector;
+    TimelineActorRef m_actor;
+    int32_t m_excludeSelector;
 
-    TimepointDataSnapshot( const std::string& selector, const std::string& actorRef, const std::string& excludeSelector ) :
+    TimepointDataSnapshot( int32_t selector, TimelineActorRef actor, int32_t excludeSelector ) :
       TimepointData( TimepointDataType::Snapshot ),
       m_selector( selector ),
-      m_actorRef( actorRef ),
+      m_actor( actor ),
       m_excludeSelector( excludeSelector )
     {
     }
@@ -332,7 +345,7 @@ namespace Sapphire
     const TimepointDataPtr getData() const;
     void reset( TimepointState& state ) const;
 
-    void from_json( const nlohmann::json& json, const std::unordered_map< std::string, TimelineActor >& actors, uint32_t selfLayoutId );
+    void from_json( const nlohmann::json& json, const TimelineRefResolver& refs, uint32_t selfLayoutId );
     // todo: separate execute/update into onStart and onTick?
     bool update( TimelineActor& self, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const;
     bool execute( TimelineActor& self, TimelinePack& pack, EncounterPtr pEncounter, uint64_t time ) const;
@@ -119,4 +119,9 @@ void Event::EventHandler::removeNestedEvent()
 Event::ScenePlayParam* Event::EventHandler::getScenePlayParams()
 {
   return &m_scenePlayParams;
-}
\ No newline at end of file
+}
+
+void Event::EventHandler::setScriptRef( std::shared_ptr< void > scriptRef )
+{
+  m_scriptRef = std::move( scriptRef );
+}
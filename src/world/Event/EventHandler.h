@@ -173,6 +173,11 @@ namespace Sapphire::Event
 
     ScenePlayParam *getScenePlayParams();
 
+    /*!
+     * @brief Keeps the script module handling this event loaded while the event runs, see NativeScriptMgr::getEventRef
+     */
+    void setScriptRef( std::shared_ptr< void > scriptRef );
+
   protected:
     uint64_t m_actorId;
     uint32_t m_eventId;
@@ -188,6 +193,7 @@ namespace Sapphire::Event
     QuestSceneChainCallback m_questChainCallback;
     EventFinishCallback m_finishCallback;
     QuestSceneReturnCallback m_questReturnCallback;
+    std::shared_ptr< void > m_scriptRef;
   };
 
 }
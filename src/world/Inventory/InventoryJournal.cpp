@@ -0,0 +1,351 @@
+#include "InventoryJournal.h"
+#include "Item.h"
+
+#include <Database/DatabaseDef.h>
+#include <Database/Transaction.h>
+#include <Logging/Logger.h>
+#include <Service.h>
+
+#include <chrono>
+
+using namespace Sapphire;
+using namespace Sapphire::Inventory;
+
+bool InventoryJournal::Batch::isEmpty() const
+{
+  return items.empty() && slots.empty();
+}
+
+void InventoryJournal::fillItem( ItemEntry& entry, const Item& item )
+{
+  entry.catalogId = item.getId();
+  entry.stack = item.getStackSize();
+  entry.durability = item.getDurability();
+  entry.stain = item.getStain();
+  entry.pattern = item.getPattern();
+}
+
+void InventoryJournal::createItem( uint64_t characterId, uint64_t ownerId, const Item& item )
+{
+  std::scoped_lock lock( m_mutex );
+
+  auto& entry = m_characters[ characterId ].pending.items[ item.getUId() ];
+  fillItem( entry, item );
+  entry.ownerId = ownerId;
+  entry.created = true;
+  entry.deleted = false;
+}
+
+void InventoryJournal::updateItem( uint64_t characterId, const Item& item )
+{
+  std::scoped_lock lock( m_mutex );
+
+  auto& entry = m_characters[ characterId ].pending.items[ item.getUId() ];
+  fillItem( entry, item );
+  entry.updated = true;
+}
+
+void InventoryJournal::deleteItem( uint64_t characterId, uint64_t itemUId )
+{
+  std::scoped_lock lock( m_mutex );
+
+  auto& items = m_characters[ characterId ].pending.items;
+  auto it = items.find( itemUId );
+
+  // never made it to the db
+  if( it != items.end() && it->second.created )
+  {
+    items.erase( it );
+    return;
+  }
+
+  items[ itemUId ].deleted = true;
+}
+
+void InventoryJournal::setContainerSlot( uint64_t characterId, const std::string& tableName, int32_t storageId,
+                                         uint16_t slot, uint64_t value )
+{
+  std::scoped_lock lock( m_mutex );
+
+  m_characters[ characterId ].pending.slots[ { tableName, storageId, slot } ] = value;
+}
+
+void InventoryJournal::mergeFailed( Batch& pending, Batch&& failed )
+{
+  for( auto& [ uid, newer ] : pending.items )
+  {
+    auto older = failed.items.find( uid );
+    if( older == failed.items.end() )
+      continue;
+
+    auto& entry = older->second;
+    if( newer.created || newer.updated )
+    {
+      entry.catalogId = newer.catalogId;
+      entry.stack = newer.stack;
+      entry.durability = newer.durability;
+      entry.stain = newer.stain;
+      entry.pattern = newer.pattern;
+    }
+    if( newer.ownerId != 0 )
+      entry.ownerId = newer.ownerId;
+
+    entry.created |= newer.created;
+    entry.updated |= newer.updated;
+    entry.deleted = newer.deleted;
+  }
+
+  for( auto& [ uid, entry ] : failed.items )
+  {
+    // created and deleted without ever being committed
+    if( entry.created && entry.deleted )
+    {
+      pending.items.erase( uid );
+      continue;
+    }
+
+    pending.items[ uid ] = entry;
+  }
+
+  for( auto& [ key, value ] : failed.slots )
+    pending.slots.emplace( key, value );
+}
+
+std::shared_ptr< Db::Transaction > InventoryJournal::buildTransaction( uint64_t characterId,
+                                                                       const CharacterJournal& journal,
+                                                                       const Batch& batch ) const
+{
+  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
+  auto transaction = std::make_shared< Db::Transaction >();
+
+  // rows are created before a container points at them and only flagged deleted after every other write
+  for( const auto& [ uid, entry ] : batch.items )
+  {
+    if( !entry.created || entry.deleted )
+      continue;
+
+    auto stmt = db.getPreparedStatement( Db::CHARA_ITEMGLOBAL_UPSERT );
+    stmt->setUInt64( 1, entry.ownerId );
+    stmt->setUInt64( 2, uid );
+    stmt->setUInt( 3, entry.catalogId );
+    stmt->setUInt( 4, entry.stack );
+    transaction->append( stmt );
+  }
+
+  for( const auto& [ uid, entry ] : batch.items )
+  {
+    if( !entry.updated || entry.deleted )
+      continue;
+
+    auto stmt = db.getPreparedStatement( Db::CHARA_ITEMGLOBAL_UP );
+    stmt->setInt( 1, entry.stack );
+    stmt->setInt( 2, entry.durability );
+    stmt->setInt( 3, entry.stain );
+    stmt->setInt( 4, entry.pattern );
+    stmt->setInt64( 5, uid );
+    transaction->append( stmt );
+  }
+
+  // one update per container row with only the columns that changed
+  std::string query;
+  for( auto it = batch.slots.begin(); it != batch.slots.end(); ++it )
+  {
+    const auto& [ table, storageId, slot ] = it->first;
+
+    auto committed = journal.committedSlots.find( it->first );
+    if( committed == journal.committedSlots.end() || committed->second != it->second )
+    {
+      query += query.empty() ? "UPDATE " + table + " SET " : ", ";
+      query += "container_" + std::to_string( slot ) + " = " + std::to_string( it->second );
+    }
+
+    auto next = std::next( it );
+    bool rowEnd = next == batch.slots.end() || std::get< 0 >( next->first ) != table ||
+                  std::get< 1 >( next->first ) != storageId;
+    if( !rowEnd || query.empty() )
+      continue;
+
+    query += " WHERE CharacterId = " + std::to_string( characterId );
+    if( storageId >= 0 )
+      query += " AND storageId = " + std::to_string( storageId );
+
+    transaction->append( query );
+    query.clear();
+  }
+
+  for( const auto& [ uid, entry ] : batch.items )
+  {
+    if( !entry.deleted )
+      continue;
+
+    auto stmt = db.getPreparedStatement( Db::CHARA_ITEMGLOBAL_DELETE );
+    stmt->setInt64( 1, uid );
+    transaction->append( stmt );
+  }
+
+  return transaction;
+}
+
+void InventoryJournal::collectResults()
+{
+  std::vector< std::pair< uint64_t, bool > > results;
+  {
+    std::scoped_lock lock( m_resultMutex );
+    results.swap( m_results );
+  }
+
+  for( auto& [ characterId, success ] : results )
+  {
+    auto it = m_characters.find( characterId );
+    if( it == m_characters.end() || !it->second.inFlight )
+      continue;
+
+    auto& journal = it->second;
+    if( success )
+    {
+      for( auto& [ key, value ] : journal.inFlight->slots )
+        journal.committedSlots[ key ] = value;
+      journal.failedBatches = 0;
+      journal.parkedUntil.reset();
+    }
+    else
+    {
+      Logger::warn( "Inventory batch #{0} of character#{1} failed", journal.inFlight->sequence, characterId );
+      mergeFailed( journal.pending, std::move( *journal.inFlight ) );
+      onBatchFailed( characterId, journal );
+    }
+
+    journal.inFlight.reset();
+  }
+}
+
+void InventoryJournal::onBatchFailed( uint64_t characterId, CharacterJournal& journal )
+{
+  if( ++journal.failedBatches < MaxBatchRetries )
+    return;
+
+  // the transaction does not tell which statement failed, retrying every tick would fail the same way again
+  if( !journal.parkedUntil )
+    Logger::error( "Inventory changes of character#{0} failed {1} times in a row, keeping {2} item and {3} slot changes "
+                   "and retrying every {4}s", characterId, journal.failedBatches, journal.pending.items.size(),
+                   journal.pending.slots.size(), ParkedRetryInterval.count() );
+
+  journal.parkedUntil = std::chrono::steady_clock::now() + ParkedRetryInterval;
+}
+
+void InventoryJournal::flush()
+{
+  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
+
+  std::scoped_lock lock( m_mutex );
+  collectResults();
+
+  auto now = std::chrono::steady_clock::now();
+  for( auto& [ characterId, journal ] : m_characters )
+  {
+    if( journal.inFlight || journal.pending.isEmpty() )
+      continue;
+
+    if( journal.parkedUntil && now < *journal.parkedUntil )
+      continue;
+
+    journal.pending.sequence = journal.nextSequence++;
+    journal.inFlight = std::move( journal.pending );
+    journal.pending = Batch();
+
+    auto transaction = buildTransaction( characterId, journal, *journal.inFlight );
+    if( transaction->isEmpty() )
+    {
+      journal.inFlight.reset();
+      continue;
+    }
+
+    db.commitTransaction( transaction, [ this, id = characterId ]( bool success )
+    {
+      std::scoped_lock resultLock( m_resultMutex );
+      m_results.emplace_back( id, success );
+      m_resultCondition.notify_all();
+    } );
+  }
+}
+
+bool InventoryJournal::flushCharacter( uint64_t characterId )
+{
+  std::scoped_lock lock( m_mutex );
+
+  auto it = m_characters.find( characterId );
+  if( it == m_characters.end() )
+    return true;
+
+  collectResults();
+  return commitCharacter( characterId, it->second );
+}
+
+bool InventoryJournal::flushAll()
+{
+  std::scoped_lock lock( m_mutex );
+
+  collectResults();
+
+  std::size_t failed = 0;
+  for( auto& [ characterId, journal ] : m_characters )
+  {
+    if( !journal.inFlight && journal.pending.isEmpty() )
+      continue;
+
+    if( !commitCharacter( characterId, journal ) )
+      ++failed;
+  }
+
+  if( failed > 0 )
+    Logger::error( "Inventory changes of {0} characters could not be saved", failed );
+
+  return failed == 0;
+}
+
+bool InventoryJournal::commitCharacter( uint64_t characterId, CharacterJournal& journal )
+{
+  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
+
+  // the async batch has to land first, the sync commit would overtake it
+  while( journal.inFlight )
+  {
+    {
+      std::unique_lock resultLock( m_resultMutex );
+      m_resultCondition.wait_for( resultLock, std::chrono::milliseconds( 100 ), [ this ]() { return !m_results.empty(); } );
+    }
+    collectResults();
+  }
+
+  if( journal.pending.isEmpty() )
+    return true;
+
+  auto transaction = buildTransaction( characterId, journal, journal.pending );
+  if( !transaction->isEmpty() && !db.directCommitTransaction( transaction ) )
+  {
+    Logger::error( "Failed to commit inventory changes of character#{0}", characterId );
+    onBatchFailed( characterId, journal );
+    return false;
+  }
+
+  for( auto& [ key, value ] : journal.pending.slots )
+    journal.committedSlots[ key ] = value;
+  journal.pending = Batch();
+  journal.failedBatches = 0;
+  journal.parkedUntil.reset();
+
+  return true;
+}
+
+std::size_t InventoryJournal::getPendingCount()
+{
+  std::scoped_lock lock( m_mutex );
+
+  std::size_t count = 0;
+  for( auto& [ characterId, journal ] : m_characters )
+  {
+    if( journal.inFlight || !journal.pending.isEmpty() )
+      ++count;
+  }
+  return count;
+}
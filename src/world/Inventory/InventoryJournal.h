@@ -0,0 +1,175 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "ForwardsZone.h"
+
+namespace Sapphire::Db
+{
+  class Transaction;
+}
+
+namespace Sapphire::Inventory
+{
+
+  /*!
+   * @brief Collects item and container changes of characters and commits them off the world thread.
+   *
+   * Changes are recorded as the final state of an item or container slot and coalesced until the next flush,
+   * which commits one transaction per character on the async db workers. A character only ever has one
+   * transaction in flight, the next batch waits for it so batches land in the order they were recorded.
+   * Statements only write final state, a failed batch is merged below the newer changes and sent again. A character
+   * whose batches fail MaxBatchRetries times in a row is parked, its changes are kept and only retried every
+   * ParkedRetryInterval, on login and on shutdown, so a broken row does not hammer the db every tick.
+   */
+  class InventoryJournal
+  {
+  public:
+    InventoryJournal() = default;
+
+    /*!
+     * @brief Records a newly created item
+     * @param characterId The character the journal entry belongs to
+     * @param ownerId The id stored as owner of the item row
+     * @param item The item to save
+     */
+    void createItem( uint64_t characterId, uint64_t ownerId, const Item& item );
+
+    /*!
+     * @brief Records the current stack, durability, stain and pattern of an item
+     */
+    void updateItem( uint64_t characterId, const Item& item );
+
+    /*!
+     * @brief Records an item deletion, an item created since the last flush is dropped without touching the db
+     */
+    void deleteItem( uint64_t characterId, uint64_t itemUId );
+
+    /*!
+     * @brief Records the value of a container_N column
+     * @param tableName The table of the container
+     * @param storageId The storageId of the row for multi storage tables, -1 for single row tables
+     * @param slot The N of the container_N column
+     * @param value The item uid, or the amount for currency containers
+     */
+    void setContainerSlot( uint64_t characterId, const std::string& tableName, int32_t storageId, uint16_t slot,
+                           uint64_t value );
+
+    /*!
+     * @brief Commits the changes recorded since the last flush, called once per server tick
+     */
+    void flush();
+
+    /*!
+     * @brief Commits every change of a character and waits for it, blocks the calling thread
+     *
+     * Used before a character is loaded from the db, so it does not read rows with changes still in the journal.
+     *
+     * @return true if the db is up to date for this character
+     */
+    bool flushCharacter( uint64_t characterId );
+
+    /*!
+     * @brief Commits the changes of every character and waits for them, blocks the calling thread
+     *
+     * Used on shutdown, changes that still fail to commit are logged per character.
+     *
+     * @return true if nothing is left in the journal
+     */
+    bool flushAll();
+
+    /*!
+     * @return number of characters with changes that are not committed yet
+     */
+    std::size_t getPendingCount();
+
+  private:
+    static const uint32_t MaxBatchRetries = 3;
+    static constexpr std::chrono::seconds ParkedRetryInterval{ 60 };
+
+    struct ItemEntry
+    {
+      uint64_t ownerId{ 0 };
+      uint32_t catalogId{ 0 };
+      uint32_t stack{ 0 };
+      uint16_t durability{ 0 };
+      uint16_t stain{ 0 };
+      uint32_t pattern{ 0 };
+      bool created{ false };
+      bool updated{ false };
+      bool deleted{ false };
+    };
+
+    // table, storageId, slot
+    using SlotKey = std::tuple< std::string, int32_t, uint16_t >;
+
+    struct Batch
+    {
+      uint64_t sequence{ 0 };
+      std::map< uint64_t, ItemEntry > items;
+      std::map< SlotKey, uint64_t > slots;
+
+      bool isEmpty() const;
+    };
+
+    struct CharacterJournal
+    {
+      Batch pending;
+      std::optional< Batch > inFlight;
+      uint64_t nextSequence{ 1 };
+      // batches of this character that failed in a row
+      uint32_t failedBatches{ 0 };
+      // set once failedBatches reaches MaxBatchRetries, the tick flush skips the character until then
+      std::optional< std::chrono::steady_clock::time_point > parkedUntil;
+
+      /*!
+       * @brief Last committed value of every container slot written so far, unchanged slots are skipped
+       */
+      std::map< SlotKey, uint64_t > committedSlots;
+    };
+
+    static void fillItem( ItemEntry& entry, const Item& item );
+
+    /*!
+     * @brief Merges a batch that failed to commit below the newer changes recorded since
+     */
+    static void mergeFailed( Batch& pending, Batch&& failed );
+
+    std::shared_ptr< Db::Transaction > buildTransaction( uint64_t characterId, const CharacterJournal& journal,
+                                                         const Batch& batch ) const;
+
+    /*!
+     * @brief Applies the outcome of finished transactions, needs m_mutex
+     */
+    void collectResults();
+
+    /*!
+     * @brief Waits for the batch in flight, then commits the remaining changes synchronously, needs m_mutex
+     */
+    bool commitCharacter( uint64_t characterId, CharacterJournal& journal );
+
+    /*!
+     * @brief Counts a failed batch, parks the character once it reaches MaxBatchRetries
+     */
+    static void onBatchFailed( uint64_t characterId, CharacterJournal& journal );
+
+    std::mutex m_mutex;
+    std::unordered_map< uint64_t, CharacterJournal > m_characters;
+
+    // filled by the db workers: character id, success
+    std::mutex m_resultMutex;
+    std::condition_variable m_resultCondition;
+    std::vector< std::pair< uint64_t, bool > > m_results;
+  };
+
+}
@@ -6,6 +6,7 @@
 #include "Actor/Player.h"
 
 #include "Item.h"
+#include "InventoryJournal.h"
 #include "Forwards.h"
 #include "ItemContainer.h"
 
@@ -37,13 +38,15 @@ uint16_t Sapphire::ItemContainer::getEntryCount() const
 
 void Sapphire::ItemContainer::removeItem( uint16_t slotId, bool removeFromDb )
 {
-  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
   auto it = m_itemMap.find( slotId );
 
   if( it != m_itemMap.end() )
   {
     if( m_isPersistentStorage && removeFromDb )
-      db.execute( "DELETE FROM charaglobalitem WHERE itemId = " + std::to_string( it->second->getUId() ) );
+    {
+      auto& journal = Common::Service< Inventory::InventoryJournal >::ref();
+      journal.deleteItem( m_ownerCharacterId, it->second->getUId() );
+    }
 
     m_itemMap.erase( it );
 
@@ -126,4 +129,7 @@ bool Sapphire::ItemContainer::isPersistentStorage() const
   return m_isPersistentStorage;
 }
 
-
+void Sapphire::ItemContainer::setOwnerCharacterId( uint64_t characterId )
+{
+  m_ownerCharacterId = characterId;
+}
@@ -22,6 +22,9 @@ namespace Sapphire
 
     uint16_t getEntryCount() const;
 
+    /*!
+     * @param removeFromDb flags the item row deleted through the owner's InventoryJournal, persistent storage only
+     */
     void removeItem( uint16_t slotId, bool removeFromDb = true );
 
     ItemMap& getItemMap();
@@ -42,6 +45,11 @@ namespace Sapphire
 
     bool isPersistentStorage() const;
 
+    /*!
+     * @brief Sets the character whose InventoryJournal records the item rows removed from this container
+     */
+    void setOwnerCharacterId( uint64_t characterId );
+
   private:
     uint16_t m_id;
     uint16_t m_size;
@@ -50,6 +58,7 @@ namespace Sapphire
     bool m_isPersistentStorage;
     ItemMap m_itemMap;
     Entity::PlayerPtr m_pOwner;
+    uint64_t m_ownerCharacterId{ 0 };
   };
 
 }
\ No newline at end of file
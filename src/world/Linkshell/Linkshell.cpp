@@ -1,5 +1,7 @@
 #include "Linkshell.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 Sapphire::Linkshell::Linkshell( uint64_t id, std::string name, uint64_t chatChannelId,
@@ -110,9 +112,11 @@ void Sapphire::Linkshell::setName( std::string name )
 
 std::vector< uint64_t > Sapphire::Linkshell::getAllMemberIds()
 {
-  std::vector< uint64_t > allMembers( m_leaderIds.size() + m_memberIds.size() );
-  allMembers.insert( allMembers.end(), m_leaderIds.begin(), m_leaderIds.end() );
-  allMembers.insert( allMembers.end(), m_memberIds.begin(), m_memberIds.end() );
+  // leaders are usually members as well, only list them once
+  std::vector< uint64_t > allMembers;
+  allMembers.reserve( m_leaderIds.size() + m_memberIds.size() );
+  std::set_union( m_leaderIds.begin(), m_leaderIds.end(), m_memberIds.begin(), m_memberIds.end(),
+                  std::back_inserter( allMembers ) );
   return allMembers;
 }
 
@@ -1,5 +1,6 @@
 #include <Exd/ExdData.h>
 #include <Util/Util.h>
+#include <Logging/Logger.h>
 
 #include "AchievementMgr.h"
 #include <Network/Util/PacketUtil.h>
@@ -18,38 +19,119 @@ bool AchievementMgr::cacheAchievements()
 
   for( const auto& [ id, achvExdData ] : achvDat )
   {
-    uint32_t key = achvExdData->data().ConditionType;
-    auto achvType = static_cast< Common::Achievement::Type >( key );
+    auto& data = achvExdData->data();
+    auto achvType = static_cast< Common::Achievement::Type >( data.ConditionType );
 
     if( achvType == Common::Achievement::Type::None )
       continue;
 
-    // verify if achievement type has subtype
-    if( achvType == Common::Achievement::Type::General ||
-        achvType == Common::Achievement::Type::Classjob ||
-        achvType == Common::Achievement::Type::InstanceContent )
+    m_achievementDetailCacheMap[ id ] = achvExdData;
+
+    switch( achvType )
     {
-      int32_t subtype = achvExdData->data().ConditionArg[ 0 ];
-      if( subtype != 0 )
-        key = ( getKeyFromType( achvType, subtype ) ).u32;
-      else
-        continue; // ignore key types with no subtype
+      // progress stored under type:subtype, unlocked at a threshold
+      case Common::Achievement::Type::General:
+      case Common::Achievement::Type::Classjob:
+      case Common::Achievement::Type::InstanceContent:
+      {
+        int32_t subtype = data.ConditionArg[ 0 ];
+        if( subtype == 0 )
+          continue; // ignore key types with no subtype
+
+        auto key = getKeyFromType( achvType, subtype ).u32;
+        auto threshold = static_cast< uint32_t >( std::max( data.ConditionArg[ 1 ], 0 ) );
+        m_progressTriggerMap[ key ].push_back( { id, threshold } );
+        break;
+      }
+      case Common::Achievement::Type::Quest:
+      case Common::Achievement::Type::QuestAny:
+      case Common::Achievement::Type::LinkedAchievement:
+      {
+        ConditionTrigger trigger{ id, achvType != Common::Achievement::Type::QuestAny, {} };
+        for( auto arg : data.ConditionArg )
+        {
+          auto requirement = static_cast< uint32_t >( arg );
+          // quest rows are referenced with the 0x10000 sheet offset, QuestMgr and the completion flags use the 16 bit id
+          if( achvType != Common::Achievement::Type::LinkedAchievement )
+            requirement &= 0xFFFF;
+
+          // clear empty links and duplicates
+          if( requirement != 0 &&
+              std::find( trigger.requirements.begin(), trigger.requirements.end(), requirement ) == trigger.requirements.end() )
+            trigger.requirements.push_back( requirement );
+        }
+
+        auto& triggerMap = achvType == Common::Achievement::Type::LinkedAchievement ? m_linkedTriggerMap : m_questTriggerMap;
+        auto index = static_cast< uint32_t >( m_conditionTriggers.size() );
+        for( auto requirement : trigger.requirements )
+          triggerMap[ requirement ].push_back( index );
+
+        m_conditionTriggers.push_back( std::move( trigger ) );
+        break;
+      }
+      default:
+        break;
     }
+  }
 
-    // map achievement IDs to achv data
-    m_achievementKeyCacheMap[ key ].emplace_back( id );
-    // map achievement keys (either type or union key:subtype) to achievement IDs
-    m_achievementDetailCacheMap[ id ] = std::move( achvExdData );
+  // lowest thresholds first, progress checks stop at the first one out of reach
+  for( auto& [ key, triggers ] : m_progressTriggerMap )
+  {
+    std::sort( triggers.begin(), triggers.end(), []( const ProgressTrigger& a, const ProgressTrigger& b )
+    {
+      return a.threshold < b.threshold;
+    } );
   }
 
+  Logger::debug( "AchievementMgr: {} progress keys, {} quest and linked triggers",
+                 m_progressTriggerMap.size(), m_conditionTriggers.size() );
+
   return true;
 }
 
-void AchievementMgr::unlockAchievement( Entity::Player& player, uint32_t achievementId )
+void AchievementMgr::checkProgressTriggers( Entity::Player& player, uint32_t dataKey, uint32_t progress )
 {
-  auto& exdData = Common::Service< Data::ExdData >::ref();
-  auto achvExd = exdData.getRow< Excel::Achievement >( achievementId );
+  auto it = m_progressTriggerMap.find( dataKey );
+  if( it == m_progressTriggerMap.end() )
+    return;
+
+  for( const auto& trigger : it->second )
+  {
+    if( trigger.threshold > progress )
+      break;
+
+    if( !hasAchievementUnlocked( player, trigger.achievementId ) )
+      unlockAchievement( player, trigger.achievementId );
+  }
+}
+
+void AchievementMgr::checkQuestTriggers( Entity::Player& player, uint32_t questId )
+{
+  auto it = m_questTriggerMap.find( questId & 0xFFFF );
+  if( it == m_questTriggerMap.end() )
+    return;
+
+  for( auto index : it->second )
+  {
+    const auto& trigger = m_conditionTriggers[ index ];
+    if( hasAchievementUnlocked( player, trigger.achievementId ) )
+      continue;
+
+    bool unlock;
+    if( trigger.requiresAll )
+      unlock = std::all_of( trigger.requirements.begin(), trigger.requirements.end(),
+                            [ &player ]( uint32_t id ) { return player.isQuestCompleted( id ); } );
+    else
+      unlock = std::any_of( trigger.requirements.begin(), trigger.requirements.end(),
+                            [ &player ]( uint32_t id ) { return player.isQuestCompleted( id ); } );
+
+    if( unlock )
+      unlockAchievement( player, trigger.achievementId );
+  }
+}
 
+void AchievementMgr::unlockAchievement( Entity::Player& player, uint32_t achievementId )
+{
   // set flag on mask format expected by client
   uint16_t index;
   uint8_t value;
@@ -57,7 +139,6 @@ void AchievementMgr::unlockAchievement( Entity::Player& player, uint32_t achieve
 
   auto achvData = player.getAchievementData();
   achvData.unlockList[ index ] |= value;
-  player.setAchievementData( achvData );
 
   // handle player achievement history
   // todo: verify retail behavior due to client copying the last achievement unlocked
@@ -72,10 +153,10 @@ void AchievementMgr::unlockAchievement( Entity::Player& player, uint32_t achieve
   Network::Util::Packet::sendActorControl( player, player.getId(), AchievementObtainMsg, achievementId );
 
   // check and add title to player
-  auto achvTitleId = achvExd->data().Title;
-  if( achvTitleId != 0 )
+  auto pAchv = getAchievementDetail( achievementId );
+  if( pAchv && pAchv->data().Title != 0 )
   {
-    player.addTitle( achvTitleId );
+    player.addTitle( pAchv->data().Title );
   }
 
   handleLinkedAchievementsForId( player, achievementId );
@@ -94,7 +175,7 @@ std::pair< uint32_t, uint32_t > AchievementMgr::getAchievementDataById( Entity::
 {
   auto& exdData = Common::Service< Data::ExdData >::ref();
 
-  auto achvDataList = player.getAchievementData().progressData;
+  const auto& achvDataList = player.getAchievementData().progressData;
   auto achvExd = exdData.getRow< Excel::Achievement >( achievementId )->data();
   auto achvType = static_cast< Common::Achievement::Type >( achvExd.ConditionType );
 
@@ -103,8 +184,9 @@ std::pair< uint32_t, uint32_t > AchievementMgr::getAchievementDataById( Entity::
 
   // get achievement progress data, if it exists (otherwise pass 0)
   uint32_t currProg = 0;
-  if( achvDataList.count( dataKey.u32 ) )
-    currProg = achvDataList[ dataKey.u32 ];
+  auto progressIt = achvDataList.find( dataKey.u32 );
+  if( progressIt != achvDataList.end() )
+    currProg = progressIt->second;
 
   // get maximum progress for given achievement, as required by client
   uint32_t maxProg = static_cast< uint32_t >( achvExd.ConditionArg[ 1 ] );
@@ -115,51 +197,25 @@ std::pair< uint32_t, uint32_t > AchievementMgr::getAchievementDataById( Entity::
 
 void AchievementMgr::handleLinkedAchievementsForId( Entity::Player& player, uint32_t achievementId )
 {
-  auto& exdData = Common::Service< Data::ExdData >::ref();
-
-  const auto& linkedAchievementIdList = getAchievementIdByType( Common::Achievement::Type::LinkedAchievement );
+  auto it = m_linkedTriggerMap.find( achievementId );
+  if( it == m_linkedTriggerMap.end() )
+    return;
 
-  for( auto& achvId : linkedAchievementIdList )
+  for( auto index : it->second )
   {
-    // skip if achievement already unlocked
-    if( hasAchievementUnlocked( player, achvId ) )
-      continue;
+    const auto& trigger = m_conditionTriggers[ index ];
 
-    auto pAchv = getAchievementDetail( achvId );
-    if( !pAchv )
+    // skip if achievement already unlocked
+    if( hasAchievementUnlocked( player, trigger.achievementId ) )
       continue;
 
-    auto achvExdData = pAchv->data();
-
-    // if achievement has other achievements linked to it
-    if( achvExdData.ConditionType == static_cast< uint8_t >( Common::Achievement::Type::LinkedAchievement ) )
-    {
-      // get all linked achievements needed to unlock
-      std::set< int32_t > linkedAchv{ std::make_move_iterator( std::begin( achvExdData.ConditionArg ) ),
-                                      std::make_move_iterator( std::end( achvExdData.ConditionArg ) ) };
-
-      // clear empty achievement links
-      linkedAchv.erase( 0 );
-
-      // check if passed achievement ID is tied to this linked achievement
-      if( !linkedAchv.count( achievementId ) )
-        continue;
-
-      // verify if player has all the required achievements unlocked
-      bool hasAllAchievements = true;
-      for( const auto linkedAchvId : linkedAchv )
-      {
-        if( !hasAchievementUnlocked( player, linkedAchvId ) )
-        {
-          hasAllAchievements = false;
-          break;
-        }
-      }
+    // verify if player has all the required achievements unlocked
+    bool hasAllAchievements = std::all_of( trigger.requirements.begin(), trigger.requirements.end(),
+                                           [ this, &player ]( uint32_t id ) { return hasAchievementUnlocked( player, id ); } );
 
-      // unlock achievement if linked achievement conditions are met
-      if( hasAllAchievements )
-        unlockAchievement( player, achvId );
-    }
+    // unlock achievement if linked achievement conditions are met, which walks further down the links
+    if( hasAllAchievements )
+      unlockAchievement( player, trigger.achievementId );
   }
 }
 
@@ -173,21 +229,6 @@ Common::AchievementDataKey AchievementMgr::getKeyFromType( Common::Achievement::
   return dataKey;
 }
 
-std::vector< uint32_t > AchievementMgr::getAchievementIdByType( Common::Achievement::Type type ) const
-{
-  return getAchievementIdByType( static_cast< uint32_t >( type ) );
-}
-
-std::vector< uint32_t > AchievementMgr::getAchievementIdByType( uint32_t type ) const
-{
-  auto it = m_achievementKeyCacheMap.find( type );
-
-  if( it != std::end( m_achievementKeyCacheMap ) )
-    return it->second;
-  else
-    return {};
-}
-
 std::shared_ptr< Excel::ExcelStruct< Excel::Achievement > > AchievementMgr::getAchievementDetail( uint32_t achvId ) const
 {
   auto it = m_achievementDetailCacheMap.find( achvId );
@@ -66,18 +66,38 @@ namespace Sapphire::World::Manager
     /// <returns>pair of current and maximum progress</returns>
     std::pair< uint32_t, uint32_t > getAchievementDataById( Entity::Player& player, uint32_t achievementId );
   private:
+    /*! achievement unlocked once the progress stored under its data key reaches the threshold */
+    struct ProgressTrigger
+    {
+      uint32_t achievementId;
+      uint32_t threshold;
+    };
+
+    /*! achievement unlocked by completing all or any of a list of quests or achievements */
+    struct ConditionTrigger
+    {
+      uint32_t achievementId;
+      bool requiresAll;
+      std::vector< uint32_t > requirements;
+    };
+
     // map achievement IDs to achv data
     using AchievementDetailCache = std::unordered_map< uint32_t, std::shared_ptr< Excel::ExcelStruct< Excel::Achievement > > >;
-    // map achievement keys (either type or union key:subtype) to achievement IDs
-    using AchievementKeyCache = std::unordered_map< uint32_t, std::vector< uint32_t > >;
 
     AchievementDetailCache m_achievementDetailCacheMap;
-    AchievementKeyCache m_achievementKeyCacheMap;
+
+    // data key (type:subtype) to its progress triggers, ordered by threshold
+    std::unordered_map< uint32_t, std::vector< ProgressTrigger > > m_progressTriggerMap;
+
+    // quest and linked achievement triggers, referenced by index from the maps below
+    std::vector< ConditionTrigger > m_conditionTriggers;
+    // quest id to the triggers listing it
+    std::unordered_map< uint32_t, std::vector< uint32_t > > m_questTriggerMap;
+    // achievement id to the linked achievement triggers depending on it
+    std::unordered_map< uint32_t, std::vector< uint32_t > > m_linkedTriggerMap;
 
     // cache fetch functions
     std::shared_ptr< Excel::ExcelStruct< Excel::Achievement > > getAchievementDetail( uint32_t achvId ) const;
-    std::vector< uint32_t > getAchievementIdByType( Common::Achievement::Type type ) const;
-    std::vector< uint32_t > getAchievementIdByType( uint32_t type ) const;
 
     /// <summary>
     /// get a key for merged achievements (type:subtype) that have progress data
@@ -87,6 +107,21 @@ namespace Sapphire::World::Manager
     /// <returns>data key for given type:subtype</returns>
     Common::AchievementDataKey getKeyFromType( Common::Achievement::Type achvType, int32_t argument );
 
+    /// <summary>
+    /// unlock every achievement keyed on dataKey whose threshold the given progress reaches
+    /// </summary>
+    /// <param name="player"></param>
+    /// <param name="dataKey"></param>
+    /// <param name="progress"></param>
+    void checkProgressTriggers( Entity::Player& player, uint32_t dataKey, uint32_t progress );
+
+    /// <summary>
+    /// unlock quest achievements tied to a completed quest
+    /// </summary>
+    /// <param name="player"></param>
+    /// <param name="questId"></param>
+    void checkQuestTriggers( Entity::Player& player, uint32_t questId );
+
     /// <summary>
     /// parse and unlock achievements linked to a given achievement id
     /// </summary>
@@ -110,143 +145,28 @@ namespace Sapphire::World::Manager
   template<>
   inline void AchievementMgr::progressAchievement< Common::Achievement::Type, Common::Achievement::Type::General >( Entity::Player& player, int32_t subtype, uint32_t progressCount )
   {
-    auto achvData = player.getAchievementData();
-
     auto dataKey = getKeyFromType( Common::Achievement::Type::General, subtype );
 
-    if( !achvData.progressData.count( dataKey.u32 ) )
-      achvData.progressData[ dataKey.u32 ] = 0;
-
-    achvData.progressData[ dataKey.u32 ] += progressCount;
-
-    player.setAchievementData( achvData );
-
-    const auto achvIdList = getAchievementIdByType( dataKey.u32 );
-
-    for( auto achvId : achvIdList )
-    {
-      if( hasAchievementUnlocked( player, achvId ) )
-        continue;
+    auto progress = player.addAchievementProgress( dataKey.u32, progressCount );
 
-      auto pAchv = getAchievementDetail( achvId );
-      if( !pAchv )
-        continue;
-
-      auto& achvExdData = pAchv->data();
-
-      if( achvExdData.ConditionArg[ 1 ] <= static_cast< int32_t >( achvData.progressData[ dataKey.u32 ] ) )
-        unlockAchievement( player, achvId );
-    }
+    checkProgressTriggers( player, dataKey.u32, progress );
   }
 
   template<>
   inline void AchievementMgr::progressAchievement< Common::Achievement::Type, Common::Achievement::Type::Classjob >( Entity::Player& player, int32_t classJob, uint32_t unused )
   {
-    auto achvData = player.getAchievementData();
-
     auto dataKey = getKeyFromType( Common::Achievement::Type::Classjob, classJob );
 
-    if( !achvData.progressData.count( dataKey.u32 ) )
-      achvData.progressData[ dataKey.u32 ] = 0;
-
     auto level = player.getLevelForClass( static_cast< Common::ClassJob >( classJob ) );
 
-    achvData.progressData[ dataKey.u32 ] = level;
-
-    const auto achvIdList = getAchievementIdByType( dataKey.u32 );
+    player.setAchievementProgress( dataKey.u32, level );
 
-    for( auto achvId : achvIdList )
-    {
-      if( hasAchievementUnlocked( player, achvId ) )
-        continue;
-
-      auto pAchv = getAchievementDetail( achvId );
-      if( !pAchv )
-        continue;
-
-      auto& achvExdData = pAchv->data();
-
-      if( achvExdData.ConditionArg[ 1 ] <= static_cast< int32_t >( achvData.progressData[ dataKey.u32 ] ) )
-        unlockAchievement( player, achvId );
-    }
+    checkProgressTriggers( player, dataKey.u32, level );
   }
 
   template<>
   inline void AchievementMgr::progressAchievement< Common::Achievement::Type, Common::Achievement::Type::Quest >( Entity::Player& player, int32_t questId, uint32_t unused )
   {
-    auto& achvDataList = player.getAchievementData().progressData;
-
-    // get achievements that need all achv in args completed
-    const auto questAchvAllList = getAchievementIdByType( Common::Achievement::Type::Quest );
-    // get achievements that need any of the achvs in args completed
-    const auto questAchvAnyList = getAchievementIdByType( Common::Achievement::Type::QuestAny );
-
-    // handle achv type for all quests in args completed
-    for( auto achvId : questAchvAllList )
-    {
-      if( hasAchievementUnlocked( player, achvId ) )
-        continue;
-
-      auto pAchv = getAchievementDetail( achvId );
-
-      auto achvExdData = pAchv->data();
-
-      std::set< uint16_t > linkedQuests{ std::make_move_iterator( std::begin( achvExdData.ConditionArg ) ),
-                                      std::make_move_iterator( std::end( achvExdData.ConditionArg ) ) };
-
-      // clear empty achievement links
-      linkedQuests.erase( 0 );
-
-      // check if passed quest ID is tied to this achievement
-      if( !linkedQuests.count( questId ) )
-        continue;
-
-      // verify if player has all the required quests completed
-      bool hasAllAchievements = true;
-      for( const auto questId : linkedQuests )
-      {
-        if( !player.isQuestCompleted( questId ) )
-        {
-          hasAllAchievements = false;
-          break;
-        }
-      }
-
-      // unlock achievement if all required quests are completed
-      if( hasAllAchievements )
-        unlockAchievement( player, achvId );
-    }
-
-    // handle achv type for all quests in args completed
-    for( auto achvId : questAchvAnyList )
-    {
-      if( hasAchievementUnlocked( player, achvId ) )
-        continue;
-
-      auto pAchv = getAchievementDetail( achvId );
-
-      auto achvExdData = pAchv->data();
-
-      std::set< int32_t > linkedQuests{ std::make_move_iterator( std::begin( achvExdData.ConditionArg ) ),
-                                      std::make_move_iterator( std::end( achvExdData.ConditionArg ) ) };
-
-      // clear empty quest ids
-      linkedQuests.erase( 0 );
-
-      // check if passed quest ID is tied to this achievement
-      if( !linkedQuests.count( questId ) )
-        continue;
-
-      // verify if player has any of the required quests completed
-      bool hasAllAchievements = true;
-      for( const auto questId : linkedQuests )
-      {
-        if( player.isQuestCompleted( questId ) )
-        {
-          unlockAchievement( player, achvId );
-          break;
-        }
-      }
-    }
+    checkQuestTriggers( player, static_cast< uint32_t >( questId ) );
   }
 }
@@ -13,6 +13,7 @@
 
 #include <Service.h>
 #include <Exd/ExdData.h>
+#include <Util/FrameClock.h>
 
 #include <Network/PacketWrappers/EffectPacket.h>
 
@@ -173,7 +174,7 @@ void ActionMgr::bootstrapAction( Entity::Chara& src, Action::ActionPtr currentAc
 
     // todo: what do in cases of swiftcast/etc? script callback?
     currentAction->start();
-    src.setLastAttack( Common::Util::getTimeMs() );
+    src.setLastAttack( Common::Util::FrameClock::getTimeMs() );
   }
 }
 
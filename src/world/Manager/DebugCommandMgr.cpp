@@ -46,6 +46,7 @@
 #include "Manager/LinkshellMgr.h"
 #include <Random/RNGMgr.h>
 #include "Manager/MgrUtil.h"
+#include "Manager/MetricMgr.h"
 
 #include "Event/EventDefs.h"
 #include "ContentFinder/ContentFinder.h"
@@ -89,6 +90,7 @@ DebugCommandMgr::DebugCommandMgr()
   registerCommand( "facing", &DebugCommandMgr::facing, "Checks if you are facing an actor", 1 );
   registerCommand( "facing", &DebugCommandMgr::facing, "Checks if you are facing an actor", 1 );
   registerCommand( "cbt", &DebugCommandMgr::cbt, "Create, bind and teleport to an instance", 1 );
+  registerCommand( "perf", &DebugCommandMgr::perf, "Shows tick timings and server counters", 1 );
 }
 
 // clear all loaded commands
@@ -794,6 +796,22 @@ void DebugCommandMgr::serverInfo( char* data, Entity::Player& player, std::share
   PlayerMgr::sendDebug( player, "Sessions: {0}", server.getSessionCount() );
 }
 
+void DebugCommandMgr::perf( char* data, Entity::Player& player, std::shared_ptr< DebugCommand > command )
+{
+  auto& metricMgr = Common::Service< MetricMgr >::ref();
+
+  std::string params( data + command->getName().length() );
+  if( params.find( "reset" ) != std::string::npos )
+  {
+    metricMgr.resetWindows();
+    PlayerMgr::sendDebug( player, "Timing windows cleared." );
+    return;
+  }
+
+  for( const auto& line : metricMgr.getSummary() )
+    PlayerMgr::sendDebug( player, line );
+}
+
 void DebugCommandMgr::script( char* data, Entity::Player& player, std::shared_ptr< DebugCommand > command )
 {
   auto& scriptMgr = Common::Service< Scripting::ScriptMgr >::ref();
@@ -905,14 +923,27 @@ void DebugCommandMgr::instance( char* data, Entity::Player& player, std::shared_
   if( subCommand == "create" || subCommand == "cr" )
   {
     uint32_t contentFinderConditionId;
-    sscanf( params.c_str(), "%d", &contentFinderConditionId );
+    unsigned long long seed = 0;
+    auto args = sscanf( params.c_str(), "%d %llx", &contentFinderConditionId, &seed );
 
-    auto instance = terriMgr.createInstanceContent( contentFinderConditionId );
+    // a seed shown by !instance seed replays the rolls of that instance
+    auto instance = terriMgr.createInstanceContent( contentFinderConditionId, args > 1 ? seed : 0 );
     if( instance )
-      PlayerMgr::sendDebug( player, "Created instance with id#{0} -> {1}", instance->getGuId(), instance->getName() );
+    {
+      PlayerMgr::sendDebug( player, "Created instance with id#{0} -> {1}, seed {2:016X}", instance->getGuId(), instance->getName(),
+                            instance->getRandomStream().getSeed() );
+    }
     else
       PlayerMgr::sendDebug( player, "Failed to create instance with id#{0}", contentFinderConditionId );
   }
+  else if( subCommand == "seed" )
+  {
+    if( !pCurrentZone )
+      return;
+
+    PlayerMgr::sendDebug( player, "Territory id#{0} -> {1}, seed {2:016X}, root seed {3:016X}", pCurrentZone->getGuId(), pCurrentZone->getName(),
+                          pCurrentZone->getRandomStream().getSeed(), Common::Service< Common::Random::RNGMgr >::ref().getRootSeed() );
+  }
   else if( subCommand == "bind" )
   {
     uint32_t instanceId;
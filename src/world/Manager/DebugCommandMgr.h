@@ -48,6 +48,8 @@ namespace Sapphire::World::Manager
 
     void serverInfo( char* data, Entity::Player& player, std::shared_ptr< DebugCommand > command );
 
+    void perf( char* data, Entity::Player& player, std::shared_ptr< DebugCommand > command );
+
     void unlockCharacter( char* data, Entity::Player& player, std::shared_ptr< DebugCommand > command );
 
     void instance( char* data, Entity::Player& player, std::shared_ptr< DebugCommand > command );
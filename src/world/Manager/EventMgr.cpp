@@ -29,6 +29,7 @@
 #include "WorldServer.h"
 #include "Actor/Player.h"
 #include <Script/ScriptMgr.h>
+#include <Script/NativeScriptMgr.h>
 
 #include "DatCategories/InstanceObjectParser.h"
 
@@ -567,8 +568,10 @@ void EventMgr::eventStart( Entity::Player& player, uint64_t actorId, uint32_t ev
                            uint32_t eventParam2, Event::EventHandler::EventFinishCallback callback )
 {
   auto& server = Common::Service< World::WorldServer >::ref();
+  auto& scriptMgr = Common::Service< Scripting::ScriptMgr >::ref();
   auto newEvent = Event::make_EventHandler( actorId, eventId, eventType, eventParam2 );
   newEvent->setEventFinishCallback( std::move( callback ) );
+  newEvent->setScriptRef( scriptMgr.getNativeScriptHandler().getEventRef( eventId ) );
   player.addEvent( newEvent );
 
   player.setCondition( Common::PlayerCondition::InNpcEvent );
@@ -320,10 +320,40 @@ void FreeCompanyMgr::addMember( uint64_t fcId, uint64_t memberId )
     return;
 
   m_charaIdToFcIdMap[ memberId ] = fcId;
+  m_onlineSessionCache.erase( fcId );
   dbInsertMember( fcId, memberId, 0 );
   pFc->addMember( memberId, 0, 0 );
 }
 
+const std::vector< World::SessionPtr >& FreeCompanyMgr::getOnlineMemberSessions( uint64_t fcId )
+{
+  auto cacheIt = m_onlineSessionCache.find( fcId );
+  if( cacheIt != m_onlineSessionCache.end() )
+    return cacheIt->second;
+
+  auto& server = Common::Service< World::WorldServer >::ref();
+  auto& sessions = m_onlineSessionCache[ fcId ];
+
+  auto pFc = getFreeCompanyById( fcId );
+  if( !pFc )
+    return sessions;
+
+  for( auto memberId : pFc->getMemberIdList() )
+  {
+    if( auto pSession = server.getSession( memberId ) )
+      sessions.push_back( pSession );
+  }
+
+  return sessions;
+}
+
+void FreeCompanyMgr::onSessionChanged( uint64_t characterId )
+{
+  auto it = m_charaIdToFcIdMap.find( characterId );
+  if( it != m_charaIdToFcIdMap.end() )
+    m_onlineSessionCache.erase( it->second );
+}
+
 void FreeCompanyMgr::dbInsertMember( uint64_t fcId, uint64_t characterId, uint8_t hierarchyId )
 {
   auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
@@ -20,6 +20,9 @@ namespace Sapphire::World::Manager
     /*! map used for easy lookup of char id to fc id */
     std::unordered_map< uint64_t, uint64_t > m_charaIdToFcIdMap;
 
+    /*! sessions of online members per fc, built on first fan-out */
+    std::unordered_map< uint64_t, std::vector< World::SessionPtr > > m_onlineSessionCache;
+
     uint64_t m_maxFcId{ 0 };
     uint32_t m_onlinePlayers{ 0 };
 
@@ -58,6 +61,12 @@ namespace Sapphire::World::Manager
     void onFcLogout( uint64_t characterId );
     void onSignPetition( Entity::Player& source, Entity::Player& target );
 
+    // sessions of all online members, used for fc wide packets
+    const std::vector< World::SessionPtr >& getOnlineMemberSessions( uint64_t fcId );
+
+    // drop the cached sessions of the character's fc, called when it logs in or out
+    void onSessionChanged( uint64_t characterId );
+
   };
 
 }
@@ -2,8 +2,11 @@
 
 #include <Util/Util.h>
 
+#include <Service.h>
+
 #include "Actor/Player.h"
 #include "FriendListMgr.h"
+#include "PresenceMgr.h"
 
 using namespace Sapphire;
 using namespace Sapphire::World::Manager;
@@ -52,8 +55,8 @@ bool FriendListMgr::onInviteCreate( Entity::Player& source, Entity::Player& targ
   targetFLData[ targetIdx ] = hierarchy;
 
   // force db update for friendlist
-  source.updateDbFriendList();
-  target.updateDbFriendList();
+  source.updateDbFriend( target.getCharacterId(), sourceFLData[ sourceIdx ] );
+  target.updateDbFriend( source.getCharacterId(), targetFLData[ targetIdx ] );
 
   return true;
 }
@@ -79,8 +82,12 @@ bool FriendListMgr::onInviteAccept( Entity::Player& source, Entity::Player& targ
   targetFLData[ targetIdx ].data.status = Common::HierarchyStatus::Added;
   targetFLData[ targetIdx ].data.type   = Common::HierarchyType::NONE_2;
   
-  source.updateDbFriendList();
-  target.updateDbFriendList();
+  source.updateDbFriend( target.getCharacterId(), sourceFLData[ sourceIdx ] );
+  target.updateDbFriend( source.getCharacterId(), targetFLData[ targetIdx ] );
+
+  auto& presenceMgr = Common::Service< PresenceMgr >::ref();
+  presenceMgr.subscribe( source.getCharacterId(), target.getCharacterId() );
+  presenceMgr.subscribe( target.getCharacterId(), source.getCharacterId() );
   return true;
 }
 
@@ -108,8 +115,12 @@ bool FriendListMgr::onInviteDecline( Entity::Player& source, Entity::Player& tar
   sourceFLData[ sourceIdx ].u64 = 0;
   targetFLData[ targetIdx ].u64 = 0;
 
-  source.updateDbFriendList();
-  target.updateDbFriendList();
+  source.removeDbFriend( target.getCharacterId() );
+  target.removeDbFriend( source.getCharacterId() );
+
+  auto& presenceMgr = Common::Service< PresenceMgr >::ref();
+  presenceMgr.unsubscribe( source.getCharacterId(), target.getCharacterId() );
+  presenceMgr.unsubscribe( target.getCharacterId(), source.getCharacterId() );
   return true;
 }
 
@@ -137,7 +148,7 @@ bool FriendListMgr::onAssignGroup( Entity::Player& source, Entity::Player& targe
 
   sourceFLData[ sourceIdx ].data.group = group;
 
-  source.updateDbFriendList();
+  source.updateDbFriend( target.getCharacterId(), sourceFLData[ sourceIdx ] );
 
   return true;
 }
@@ -4,6 +4,7 @@
 #include "Actor/Player.h"
 #include "Inventory/ItemContainer.h"
 #include "Inventory/HousingItem.h"
+#include "Inventory/InventoryJournal.h"
 #include "Manager/ItemMgr.h"
 #include "Manager/LootTableMgr.h"
 #include <Network/PacketDef/Zone/ServerZoneDef.h>
@@ -181,13 +182,7 @@ void InventoryMgr::removeHousingItemPosition( Inventory::HousingItem& item )
 
 void InventoryMgr::saveItem( Entity::Player& player, ItemPtr item )
 {
-  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
-  auto stmt = db.getPreparedStatement( Db::CHARA_ITEMGLOBAL_INS );
-
-  stmt->setUInt( 1, player.getId() );
-  stmt->setUInt64( 2, item->getUId() );
-  stmt->setUInt( 3, item->getId() );
-  stmt->setUInt( 4, item->getStackSize() );
+  auto& journal = Common::Service< Inventory::InventoryJournal >::ref();
 
-  db.directExecute( stmt );
+  journal.createItem( player.getCharacterId(), player.getId(), *item );
 }
@@ -180,17 +180,15 @@ Common::ContainerType ItemMgr::getContainerType( uint32_t containerId )
 
 uint32_t ItemMgr::getNextUId()
 {
-  uint32_t charId;
-
-  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
-  auto pQR = db.query( "SELECT MAX(ItemId) FROM charaglobalitem" );
-
-  if( !pQR->next() )
-    return 0x00500001;
+  if( m_nextUId == 0 )
+  {
+    auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
+    auto pQR = db.query( "SELECT MAX(ItemId) FROM charaglobalitem" );
 
-  charId = pQR->getUInt( 1 ) + 1;
-  if( charId < 0x00500001 )
-    return 0x00500001;
+    m_nextUId = 0x00500001;
+    if( pQR->next() )
+      m_nextUId = std::max< uint32_t >( m_nextUId, pQR->getUInt( 1 ) + 1 );
+  }
 
-  return charId;
+  return m_nextUId++;
 }
@@ -13,6 +13,11 @@ namespace Sapphire::World::Manager
 
     ItemPtr loadItem( uint64_t uId );
 
+    /*!
+     * @brief Hands out the next free item uid
+     *
+     * Seeded from the db once, new rows are committed by the inventory journal and MAX( ItemId ) lags behind.
+     */
     uint32_t getNextUId();
 
     /*! check if weapon category qualifies the weapon as onehanded */
@@ -21,6 +26,9 @@ namespace Sapphire::World::Manager
     static bool isEquipment( uint16_t containerId );
     static uint16_t getCharaEquipSlotCategoryToArmoryId( uint8_t slotId );
     static Common::ContainerType getContainerType( uint32_t containerId );
+
+  private:
+    uint32_t m_nextUId{ 0 };
   };
 
 }
\ No newline at end of file
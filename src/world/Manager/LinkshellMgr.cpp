@@ -82,6 +82,10 @@ bool LinkshellMgr::loadLinkshells()
     m_linkshellIdMap[ linkshellId ] = lsPtr;
     m_linkshellNameMap[ name ] = lsPtr;
 
+    for( auto characterId : lsPtr->getMemberIdList() )
+      indexCharacter( linkshellId, characterId );
+    for( auto characterId : lsPtr->getInviteIdList() )
+      indexCharacter( linkshellId, characterId );
   }
 
   return true;
@@ -180,6 +184,7 @@ LinkshellPtr LinkshellMgr::createLinkshell( const std::string& name, Entity::Pla
   auto lsPtr = std::make_shared< Linkshell >( linkshellId, name, chatChannelId, masterId, memberSet, leaderSet, inviteSet );
   m_linkshellIdMap[ linkshellId ] = lsPtr;
   m_linkshellNameMap[ name ] = lsPtr;
+  indexCharacter( linkshellId, masterId );
 
   // TODO: generalize SQL update
   // TODO: handle player pkt
@@ -228,21 +233,69 @@ std::vector< LinkshellPtr > LinkshellMgr::getPlayerLinkshells( Entity::Player& p
 {
   std::vector< LinkshellPtr > lsVec;
 
-  for( const auto &[ key, value ] : m_linkshellIdMap )
+  auto it = m_charaIdToLinkshellIdMap.find( player.getCharacterId() );
+  if( it == m_charaIdToLinkshellIdMap.end() )
+    return lsVec;
+
+  for( auto lsId : it->second )
   {
+    auto lsIt = m_linkshellIdMap.find( lsId );
+    if( lsIt != m_linkshellIdMap.end() )
+      lsVec.emplace_back( lsIt->second );
+  }
 
-    auto& memberList = value->getMemberIdList();
-    auto& inviteList = value->getInviteIdList();
+  return lsVec;
+}
 
-    // find player id in LS member or invite list
-    if( memberList.count( player.getCharacterId() ) ||
-        inviteList.count( player.getCharacterId() ) )
-    {
-      lsVec.emplace_back( value );
-    }
+void LinkshellMgr::indexCharacter( uint64_t lsId, uint64_t characterId )
+{
+  m_charaIdToLinkshellIdMap[ characterId ].insert( lsId );
+  m_onlineSessionCache.erase( lsId );
+}
+
+void LinkshellMgr::unindexCharacter( uint64_t lsId, uint64_t characterId )
+{
+  m_onlineSessionCache.erase( lsId );
+
+  auto it = m_charaIdToLinkshellIdMap.find( characterId );
+  if( it == m_charaIdToLinkshellIdMap.end() )
+    return;
+
+  it->second.erase( lsId );
+  if( it->second.empty() )
+    m_charaIdToLinkshellIdMap.erase( it );
+}
+
+const std::vector< World::SessionPtr >& LinkshellMgr::getOnlineMemberSessions( uint64_t lsId )
+{
+  auto cacheIt = m_onlineSessionCache.find( lsId );
+  if( cacheIt != m_onlineSessionCache.end() )
+    return cacheIt->second;
+
+  auto& server = Common::Service< World::WorldServer >::ref();
+  auto& sessions = m_onlineSessionCache[ lsId ];
+
+  auto lsPtr = getLinkshellById( lsId );
+  if( !lsPtr )
+    return sessions;
+
+  for( auto memberId : lsPtr->getAllMemberIds() )
+  {
+    if( auto pSession = server.getSession( memberId ) )
+      sessions.push_back( pSession );
   }
 
-  return lsVec;
+  return sessions;
+}
+
+void LinkshellMgr::onSessionChanged( uint64_t characterId )
+{
+  auto it = m_charaIdToLinkshellIdMap.find( characterId );
+  if( it == m_charaIdToLinkshellIdMap.end() )
+    return;
+
+  for( auto lsId : it->second )
+    m_onlineSessionCache.erase( lsId );
 }
 
 void LinkshellMgr::invitePlayer( Entity::Player& sourcePlayer, Entity::Player& invitedPlayer, uint64_t linkshellId )
@@ -255,6 +308,7 @@ void LinkshellMgr::invitePlayer( Entity::Player& sourcePlayer, Entity::Player& i
     return Logger::warn( "Failed to invite player to linkshell - linkshell not found!" );
 
   lsPtr->addInvite( invitedPlayer.getCharacterId() );
+  indexCharacter( linkshellId, invitedPlayer.getCharacterId() );
   writeLinkshell( lsPtr->getId() );
   //sendLinkshellList( invitedPlayer );
 
@@ -286,6 +340,7 @@ void LinkshellMgr::kickPlayer( Entity::Player& sourcePlayer, Entity::Player& kic
   lsPtr->removeInvite( kickedPlayer.getCharacterId() );
   lsPtr->removeLeader( kickedPlayer.getCharacterId() );
   lsPtr->removeMember( kickedPlayer.getCharacterId() );
+  unindexCharacter( linkshellId, kickedPlayer.getCharacterId() );
   writeLinkshell( lsPtr->getId() );
   sendLinkshellList( kickedPlayer );
 
@@ -351,6 +406,7 @@ void LinkshellMgr::leaveLinkshell( uint64_t lsId, uint64_t characterId )
     return;
 
   lsPtr->removeMember( characterId );
+  unindexCharacter( lsId, characterId );
   writeLinkshell( lsId );
 
   chatChannelMgr.removeFromChannel( lsPtr->getChatChannel(), *leavingPlayer );
@@ -369,6 +425,7 @@ void LinkshellMgr::joinLinkshell( uint64_t lsId, uint64_t characterId )
 
   lsPtr->addMember( characterId );
   lsPtr->removeInvite( characterId );
+  indexCharacter( lsId, characterId );
   writeLinkshell( lsId );
 
   chatChannelMgr.addToChannel( lsPtr->getChatChannel(), *joiningPlayer );
@@ -386,6 +443,7 @@ void LinkshellMgr::addLeader( Entity::Player &sourcePlayer, Entity::Player &newL
     return Logger::warn( "Failed to promote player from linkshell - linkshell not found!" );
 
   lsPtr->addLeader( newLeaderPlayer.getCharacterId() );
+  m_onlineSessionCache.erase( linkshellId );
   writeLinkshell( lsPtr->getId() );
   sendLinkshellList( newLeaderPlayer );
 
@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include "ForwardsZone.h"
 
@@ -24,8 +26,17 @@ namespace Sapphire::World::Manager
     std::map< uint64_t, LinkshellPtr > m_linkshellIdMap;
     std::map< std::string, LinkshellPtr > m_linkshellNameMap;
 
+    /*! reverse lookup of char id to the linkshells it is a member of or invited to */
+    std::unordered_map< uint64_t, std::set< uint64_t > > m_charaIdToLinkshellIdMap;
+
+    /*! sessions of online members per linkshell, built on first fan-out */
+    std::unordered_map< uint64_t, std::vector< World::SessionPtr > > m_onlineSessionCache;
+
     LinkshellPtr getLinkshellByName( const std::string& name );
 
+    void indexCharacter( uint64_t lsId, uint64_t characterId );
+    void unindexCharacter( uint64_t lsId, uint64_t characterId );
+
   public:
     LinkshellMgr() = default;
 
@@ -58,6 +69,12 @@ namespace Sapphire::World::Manager
     void leaveLinkshell( uint64_t lsId, uint64_t characterId );
     void joinLinkshell( uint64_t lsId, uint64_t characterId );
 
+    // sessions of all online members and leaders, used for linkshell wide packets
+    const std::vector< World::SessionPtr >& getOnlineMemberSessions( uint64_t lsId );
+
+    // drop cached sessions of every linkshell of the character, called when it logs in or out
+    void onSessionChanged( uint64_t characterId );
+
   };
 
 }
@@ -7,7 +7,6 @@
 #include <Service.h>
 #include <Logging/Logger.h>
 
-#include <Random/RNGMgr.h>
 #include "LootTableMgr.h"
 
 using namespace Sapphire;
@@ -48,10 +47,8 @@ LootTablePtr LootTableMgr::getLootTableByName( const std::string& name )
     return it->second;
 }
 
-LootTableResult LootTableMgr::rollLoot( const std::string& name )
+LootTableResult LootTableMgr::rollLoot( const std::string& name, Common::Random::RandomStream& randomStream )
 {
-  auto& RNGMgr = Common::Service< Common::Random::RNGMgr >::ref();
-
   LootTableResult result;
 
   if( auto pLootTable = getLootTableByName( name ); pLootTable )
@@ -64,17 +61,15 @@ LootTableResult LootTableMgr::rollLoot( const std::string& name )
       if( !pool.enabled )
         continue;
 
-      auto pickCountGen = RNGMgr.getRandGenerator< uint32_t >( pool.pick.min, pool.pick.max );
-      uint32_t picks = pickCountGen.next();
+      uint32_t picks = randomStream.nextInt( pool.pick.min, pool.pick.max );
 
       std::vector< LootTableItem > available = pool.items;
 
       for( auto i = 0; i < picks && !available.empty(); ++i )
       {
-        const auto& item = pickWeightedItem( available );
+        const auto& item = pickWeightedItem( available, randomStream );
 
-        auto itemCountGen = RNGMgr.getRandGenerator< uint32_t >( item.quantity.min, item.quantity.max );
-        uint32_t qty = itemCountGen.next();
+        uint32_t qty = randomStream.nextInt( item.quantity.min, item.quantity.max );
 
         result.items.push_back( { item.id, qty, item.isHq } );
 
@@ -93,17 +88,16 @@ LootTableResult LootTableMgr::rollLoot( const std::string& name )
   return result;
 }
 
-const LootTableItem& LootTableMgr::pickWeightedItem( const std::vector< LootTableItem >& items )
+const LootTableItem& LootTableMgr::pickWeightedItem( const std::vector< LootTableItem >& items,
+                                                    Common::Random::RandomStream& randomStream )
 {
-  auto& RNGMgr = Common::Service< Common::Random::RNGMgr >::ref();
   // calc total weight
   uint32_t totalWeight = 0;
   for( const auto& it : items )
     totalWeight += it.weight;
 
   // roll for [1, totalWeight]
-  auto randGen = RNGMgr.getRandGenerator< uint32_t >( 1, totalWeight );
-  uint32_t roll = randGen.next();
+  uint32_t roll = randomStream.nextInt( 1, totalWeight );
 
   // get item pick
   uint32_t cumulative = 0;
@@ -6,6 +6,7 @@
 #include "ForwardsZone.h"
 
 #include <nlohmann/json.hpp>
+#include <Random/RandomStream.h>
 
 namespace Sapphire::World::Loot
 {
@@ -88,20 +89,22 @@ namespace Sapphire::World::Manager
     /// may throw if loot table is not found
     /// </summary>
     /// <param name="name"></param>
+    /// <param name="randomStream">stream of the territory the loot drops in</param>
     /// <returns>struct of loot table rolls</returns>
-    Loot::LootTableResult rollLoot( const std::string& name );
+    Loot::LootTableResult rollLoot( const std::string& name, Common::Random::RandomStream& randomStream );
 
   private:
     std::map< std::string, Loot::LootTablePtr > m_lootTableMap;
 
     /// <summary>
     /// picks a single item per weight out of a total weight of vector of items
-    /// uses weighted system and RNGMgr to select a roll
+    /// uses weighted system and the given stream to select a roll
     /// may throw if roll > total weight
     /// </summary>
     /// <param name="items"></param>
     /// <returns>singular item pick from given items</returns>
-    const Loot::LootTableItem& pickWeightedItem( const std::vector< Loot::LootTableItem >& items );
+    const Loot::LootTableItem& pickWeightedItem( const std::vector< Loot::LootTableItem >& items,
+                                                 Common::Random::RandomStream& randomStream );
   };
 
 }
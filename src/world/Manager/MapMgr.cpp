@@ -343,7 +343,7 @@ bool MapMgr::isQuestAvailable( Entity::Player& player, uint32_t questId, Excel::
 
   if( quest.TimeBegin || quest.TimeEnd )
   {
-    uint64_t curEorzeaTime = Util::getEorzeanTimeStamp();
+    uint64_t curEorzeaTime = Common::Util::getEorzeanTimeStamp();
     uint32_t convTime = 100 * ( curEorzeaTime / 3600 % 24 ) + curEorzeaTime / 60 % 60;
 
     if( quest.TimeBegin <= quest.TimeEnd )
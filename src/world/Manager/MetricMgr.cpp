@@ -0,0 +1,289 @@
+#include "MetricMgr.h"
+
+#include <Database/DatabaseDef.h>
+#include <Service.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include <fmt/format.h>
+
+#include "Network/GameConnection.h"
+#include "Manager/TerritoryMgr.h"
+#include "WorldServer.h"
+
+using namespace Sapphire;
+using namespace Sapphire::World::Manager;
+
+#ifdef SAPPHIRE_PROFILE_ALLOCATIONS
+
+namespace
+{
+  // per thread so counting stays uncontended, only the main loop thread is reported
+  thread_local uint64_t s_allocations = 0;
+}
+
+void* operator new( std::size_t size )
+{
+  ++s_allocations;
+  if( auto ptr = std::malloc( size == 0 ? 1 : size ) )
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete( void* ptr ) noexcept
+{
+  std::free( ptr );
+}
+
+void operator delete( void* ptr, std::size_t ) noexcept
+{
+  std::free( ptr );
+}
+
+uint64_t MetricMgr::getThreadAllocations()
+{
+  return s_allocations;
+}
+
+#else
+
+uint64_t MetricMgr::getThreadAllocations()
+{
+  return 0;
+}
+
+#endif
+
+MetricMgr::MetricMgr()
+{
+  for( auto& timer : m_timers )
+    timer.window.reserve( WindowSize );
+}
+
+const char* MetricMgr::getTimerName( Timer timer )
+{
+  switch( timer )
+  {
+    case Timer::Tick:
+      return "tick";
+    case Timer::Tasks:
+      return "tasks";
+    case Timer::Sessions:
+      return "sessions";
+    case Timer::Territories:
+      return "territories";
+    case Timer::Scripts:
+      return "scripts";
+    case Timer::ContentFinder:
+      return "contentfinder";
+    case Timer::Presence:
+      return "presence";
+    case Timer::Party:
+      return "party";
+    case Timer::Database:
+      return "database";
+    default:
+      return "unknown";
+  }
+}
+
+void MetricMgr::Histogram::add( uint64_t us )
+{
+  auto it = std::lower_bound( BucketBounds.begin(), BucketBounds.end(), us );
+  ++buckets[ static_cast< std::size_t >( it - BucketBounds.begin() ) ];
+  ++count;
+  sumUs += us;
+  maxUs = std::max( maxUs, us );
+}
+
+void MetricMgr::recordTime( Timer timer, uint64_t us )
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+  auto& data = m_timers[ static_cast< std::size_t >( timer ) ];
+  data.histogram.add( us );
+
+  if( data.window.size() < WindowSize )
+    data.window.push_back( us );
+  else
+    data.window[ data.windowPos ] = us;
+  data.windowPos = ( data.windowPos + 1 ) % WindowSize;
+}
+
+void MetricMgr::recordTerritoryTime( uint32_t territoryTypeId, uint64_t us )
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+  m_territoryTimes[ territoryTypeId ].add( us );
+}
+
+void MetricMgr::onTick()
+{
+  auto& server = Common::Service< World::WorldServer >::ref();
+  auto& teriMgr = Common::Service< TerritoryMgr >::ref();
+  auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
+
+  std::size_t territories = 0;
+  std::size_t players = 0;
+  std::size_t bnpcs = 0;
+  teriMgr.getPopulation( territories, players, bnpcs );
+
+  m_sessions.store( server.getSessionCount(), std::memory_order_relaxed );
+  m_territories.store( territories, std::memory_order_relaxed );
+  m_players.store( players, std::memory_order_relaxed );
+  m_bnpcs.store( bnpcs, std::memory_order_relaxed );
+  m_dbQueueDepth.store( db.getQueueSize(), std::memory_order_relaxed );
+
+  auto allocations = getThreadAllocations();
+  m_tickAllocations.store( allocations - m_lastAllocations, std::memory_order_relaxed );
+  m_allocations.store( allocations, std::memory_order_relaxed );
+  m_lastAllocations = allocations;
+}
+
+void MetricMgr::resetWindows()
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+  for( auto& timer : m_timers )
+  {
+    timer.window.clear();
+    timer.windowPos = 0;
+  }
+}
+
+void MetricMgr::renderHistogram( std::string& out, const char* name, const std::string& labels, const Histogram& histogram )
+{
+  uint64_t cumulative = 0;
+  for( std::size_t i = 0; i < BucketBounds.size(); ++i )
+  {
+    cumulative += histogram.buckets[ i ];
+    out += fmt::format( "{}_bucket{{{},le=\"{}\"}} {}\n", name, labels, BucketBounds[ i ] / 1000000.0, cumulative );
+  }
+  out += fmt::format( "{}_bucket{{{},le=\"+Inf\"}} {}\n", name, labels, histogram.count );
+  out += fmt::format( "{}_sum{{{}}} {}\n", name, labels, histogram.sumUs / 1000000.0 );
+  out += fmt::format( "{}_count{{{}}} {}\n", name, labels, histogram.count );
+}
+
+std::string MetricMgr::renderPrometheus()
+{
+  std::string out;
+
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    out += "# HELP sapphire_update_duration_seconds Time spent per main loop subsystem.\n";
+    out += "# TYPE sapphire_update_duration_seconds histogram\n";
+    for( std::size_t i = 0; i < m_timers.size(); ++i )
+    {
+      auto labels = fmt::format( "subsystem=\"{}\"", getTimerName( static_cast< Timer >( i ) ) );
+      renderHistogram( out, "sapphire_update_duration_seconds", labels, m_timers[ i ].histogram );
+    }
+
+    out += "# HELP sapphire_territory_update_duration_seconds Time spent updating territories, per territory type.\n";
+    out += "# TYPE sapphire_territory_update_duration_seconds histogram\n";
+    for( const auto& [ territoryTypeId, histogram ] : m_territoryTimes )
+    {
+      auto labels = fmt::format( "territory=\"{}\"", territoryTypeId );
+      renderHistogram( out, "sapphire_territory_update_duration_seconds", labels, histogram );
+    }
+  }
+
+  out += "# HELP sapphire_packets_in_total Client packets received per opcode.\n";
+  out += "# TYPE sapphire_packets_in_total counter\n";
+  out += "# HELP sapphire_packets_rejected_total Client packets dropped by size or rate checks per opcode.\n";
+  out += "# TYPE sapphire_packets_rejected_total counter\n";
+  auto renderHandlerStats = [ &out ]( const char* channel, const std::vector< Network::PacketHandlerStats >& stats )
+  {
+    for( const auto& entry : stats )
+    {
+      if( entry.handled == 0 && entry.rejected == 0 )
+        continue;
+
+      out += fmt::format( "sapphire_packets_in_total{{channel=\"{}\",opcode=\"0x{:04X}\",name=\"{}\"}} {}\n",
+                          channel, entry.opcode, entry.name, entry.handled );
+      out += fmt::format( "sapphire_packets_rejected_total{{channel=\"{}\",opcode=\"0x{:04X}\",name=\"{}\"}} {}\n",
+                          channel, entry.opcode, entry.name, entry.rejected );
+    }
+  };
+  renderHandlerStats( "zone", Network::GameConnection::getZoneHandlerStats() );
+  renderHandlerStats( "chat", Network::GameConnection::getChatHandlerStats() );
+
+  out += "# HELP sapphire_packets_out_total Packets queued to clients per opcode.\n";
+  out += "# TYPE sapphire_packets_out_total counter\n";
+  for( std::size_t opcode = 0; opcode < m_packetsOut.size(); ++opcode )
+  {
+    auto count = m_packetsOut[ opcode ].load( std::memory_order_relaxed );
+    if( count != 0 )
+      out += fmt::format( "sapphire_packets_out_total{{opcode=\"0x{:04X}\"}} {}\n", opcode, count );
+  }
+
+  auto renderGauge = [ &out ]( const char* name, const char* help, uint64_t value )
+  {
+    out += fmt::format( "# HELP {} {}\n# TYPE {} gauge\n{} {}\n", name, help, name, name, value );
+  };
+  renderGauge( "sapphire_sessions", "Open client sessions.", m_sessions.load( std::memory_order_relaxed ) );
+  renderGauge( "sapphire_territories", "Territory instances.", m_territories.load( std::memory_order_relaxed ) );
+  renderGauge( "sapphire_players", "Players in territories.", m_players.load( std::memory_order_relaxed ) );
+  renderGauge( "sapphire_bnpcs", "Battle npcs in territories.", m_bnpcs.load( std::memory_order_relaxed ) );
+  renderGauge( "sapphire_db_queue_depth", "Async database operations waiting for a worker.",
+               m_dbQueueDepth.load( std::memory_order_relaxed ) );
+  renderGauge( "sapphire_tick_allocations", "Heap allocations of the main loop during the last tick.",
+               m_tickAllocations.load( std::memory_order_relaxed ) );
+
+  out += "# HELP sapphire_allocations_total Heap allocations of the main loop.\n";
+  out += "# TYPE sapphire_allocations_total counter\n";
+  out += fmt::format( "sapphire_allocations_total {}\n", m_allocations.load( std::memory_order_relaxed ) );
+
+  return out;
+}
+
+std::vector< std::string > MetricMgr::getSummary()
+{
+  std::vector< std::string > lines;
+
+#ifndef SAPPHIRE_PROFILING
+  lines.emplace_back( "Built without SAPPHIRE_PROFILING, update timers are not recorded." );
+#endif
+
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    for( std::size_t i = 0; i < m_timers.size(); ++i )
+    {
+      auto window = m_timers[ i ].window;
+      if( window.empty() )
+        continue;
+
+      std::sort( window.begin(), window.end() );
+      auto percentile = [ &window ]( std::size_t p )
+      {
+        return window[ std::min( window.size() - 1, window.size() * p / 100 ) ] / 1000.0;
+      };
+
+      lines.push_back( fmt::format( "{}: p50 {:.2f}ms p95 {:.2f}ms p99 {:.2f}ms max {:.2f}ms ({} samples)",
+                                    getTimerName( static_cast< Timer >( i ) ), percentile( 50 ), percentile( 95 ),
+                                    percentile( 99 ), percentile( 100 ), window.size() ) );
+    }
+
+    // the most expensive territory types by total update time
+    std::vector< std::pair< uint32_t, const Histogram* > > territories;
+    for( const auto& [ territoryTypeId, histogram ] : m_territoryTimes )
+      territories.emplace_back( territoryTypeId, &histogram );
+
+    auto count = std::min< std::size_t >( 5, territories.size() );
+    std::partial_sort( territories.begin(), territories.begin() + count, territories.end(),
+                       []( const auto& left, const auto& right ) { return left.second->sumUs > right.second->sumUs; } );
+
+    for( std::size_t i = 0; i < count; ++i )
+    {
+      const auto& histogram = *territories[ i ].second;
+      lines.push_back( fmt::format( "territory {}: avg {:.2f}ms max {:.2f}ms over {} updates", territories[ i ].first,
+                                    histogram.sumUs / 1000.0 / histogram.count, histogram.maxUs / 1000.0, histogram.count ) );
+    }
+  }
+
+  lines.push_back( fmt::format( "sessions {} territories {} players {} bnpcs {}", m_sessions.load(), m_territories.load(),
+                                m_players.load(), m_bnpcs.load() ) );
+  lines.push_back( fmt::format( "db queue {} allocations last tick {}", m_dbQueueDepth.load(), m_tickAllocations.load() ) );
+
+  return lines;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ForwardsZone.h"
+
+namespace Sapphire::World::Manager
+{
+
+  /*!
+   * @brief Tick timings and server counters, exported as Prometheus text and shown by !perf.
+   *
+   * Subsystem and territory update times are recorded by the scoped timers in Util/ScopedTimer.h, which are
+   * compiled out unless SAPPHIRE_PROFILING is defined. Counters and gauges are always collected. Recording
+   * happens on the main loop, the metrics endpoint renders from the network thread.
+   */
+  class MetricMgr
+  {
+  public:
+    enum class Timer : uint8_t
+    {
+      Tick,
+      Tasks,
+      Sessions,
+      Territories,
+      Scripts,
+      ContentFinder,
+      Presence,
+      Party,
+      Database,
+      Count
+    };
+
+    // upper bucket bounds in microseconds, the last bucket is +Inf
+    static constexpr std::array< uint64_t, 13 > BucketBounds = { 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000,
+                                                                 100000, 250000, 500000, 1000000 };
+
+    // samples kept per timer for the percentiles of !perf
+    static constexpr std::size_t WindowSize = 1024;
+
+    MetricMgr();
+
+    static const char* getTimerName( Timer timer );
+
+    void recordTime( Timer timer, uint64_t us );
+
+    void recordTerritoryTime( uint32_t territoryTypeId, uint64_t us );
+
+    /*! counts a packet handed to a client connection */
+    void onPacketOut( uint16_t opcode )
+    {
+      m_packetsOut[ opcode ].fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    /*! called once per server tick from the main loop, samples gauges and allocations */
+    void onTick();
+
+    /*! drops the rolling windows, the exported histograms keep counting */
+    void resetWindows();
+
+    /*! @return every metric in the Prometheus text exposition format */
+    std::string renderPrometheus();
+
+    /*! @return human readable summary lines for !perf */
+    std::vector< std::string > getSummary();
+
+    /*! allocations made by the main loop thread since startup, 0 without SAPPHIRE_PROFILE_ALLOCATIONS */
+    static uint64_t getThreadAllocations();
+
+  private:
+    struct Histogram
+    {
+      std::array< uint64_t, BucketBounds.size() + 1 > buckets{};
+      uint64_t count{ 0 };
+      uint64_t sumUs{ 0 };
+      uint64_t maxUs{ 0 };
+
+      void add( uint64_t us );
+    };
+
+    struct TimerData
+    {
+      Histogram histogram;
+      std::vector< uint64_t > window;
+      std::size_t windowPos{ 0 };
+    };
+
+    static void renderHistogram( std::string& out, const char* name, const std::string& labels, const Histogram& histogram );
+
+    std::mutex m_mutex;
+    std::array< TimerData, static_cast< std::size_t >( Timer::Count ) > m_timers;
+    std::map< uint32_t, Histogram > m_territoryTimes;
+
+    std::array< std::atomic< uint32_t >, 0x10000 > m_packetsOut{};
+
+    // sampled by onTick on the main loop, read by the metrics endpoint
+    std::atomic< uint64_t > m_sessions{ 0 };
+    std::atomic< uint64_t > m_territories{ 0 };
+    std::atomic< uint64_t > m_players{ 0 };
+    std::atomic< uint64_t > m_bnpcs{ 0 };
+    std::atomic< uint64_t > m_dbQueueDepth{ 0 };
+    std::atomic< uint64_t > m_tickAllocations{ 0 };
+    std::atomic< uint64_t > m_allocations{ 0 };
+    uint64_t m_lastAllocations{ 0 };
+  };
+
+}
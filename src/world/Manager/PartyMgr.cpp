@@ -1,3 +1,6 @@
+#include <cstring>
+#include <map>
+
 #include <Common.h>
 #include <Exd/ExdData.h>
 #include <Service.h>
@@ -56,6 +59,7 @@ void PartyMgr::onJoin( Entity::Player& joiner, Entity::Player& inviter )
 
     party->MemberId.push_back( invitingPlayer.getId() );
     party->MemberId.push_back( inviteePlayer.getId() );
+    party->Members.clear();
     party->PartyCount = 2;
     party->LeaderId = invitingPlayer.getId();
   }
@@ -70,12 +74,13 @@ void PartyMgr::onJoin( Entity::Player& joiner, Entity::Player& inviter )
     ccMgr.addToChannel( party->ChatChannel, inviteePlayer );
 
     party->MemberId.push_back( inviteePlayer.getId() );
+    party->Members.clear();
     party->PartyCount++;
   }
 
   auto pcUpdateParty = makePcPartyUpdate( invitingPlayer, inviteePlayer, UpdateStatus::JOINED, party->PartyCount );
   auto members = getPartyMembers( *party );
-  sendPartyUpdate( *party );
+  queuePartyUpdate( *party );
   for( const auto& member : members )
   {
     server.queueForPlayer( member->getCharacterId(), pcUpdateParty );
@@ -139,7 +144,7 @@ void PartyMgr::onLeave( Sapphire::Entity::Player &leavingPlayer )
     if( newLeaderId != 0 )
       party->LeaderId = newLeaderId;
     party->PartyCount--;
-    sendPartyUpdate( *party );
+    queuePartyUpdate( *party );
   }
 }
 
@@ -167,7 +172,7 @@ void PartyMgr::onMoveZone( Sapphire::Entity::Player &movingPlayer )
     return;
   auto party = getParty( movingPlayer.getPartyId() );
   assert( party );
-  sendPartyUpdate( *party );
+  queuePartyUpdate( *party );
 }
 
 void PartyMgr::onMemberDisconnect( Entity::Player& disconnectingPlayer )
@@ -203,7 +208,7 @@ void PartyMgr::onMemberDisconnect( Entity::Player& disconnectingPlayer )
                                                        makeZonePacket< FFXIVIpcUpdateParty >( member->getId() ) } );
   }
 
-  sendPartyUpdate( *party );
+  queuePartyUpdate( *party );
 }
 
 void PartyMgr::onMemberRejoin( Entity::Player& joiningPlayer )
@@ -251,7 +256,7 @@ void PartyMgr::onKick( const std::string& kickPlayerName, Entity::Player& leader
       }
     }
     party->PartyCount--;
-    sendPartyUpdate( *party );
+    queuePartyUpdate( *party );
   }
 }
 
@@ -291,7 +296,7 @@ void PartyMgr::onChangeLeader( const std::string& newLeaderName, Entity::Player&
     server.queueForPlayer( member->getCharacterId(), pcUpdateParty );
   }
 
-  sendPartyUpdate( *party );
+  queuePartyUpdate( *party );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -322,7 +327,8 @@ PartyPtr PartyMgr::getParty( uint64_t partyId )
 
 std::vector< Entity::PlayerPtr > PartyMgr::getPartyMembers( Party& party )
 {
-  std::vector< Entity::PlayerPtr > members;
+  if( !party.Members.empty() || party.MemberId.empty() )
+    return party.Members;
 
   auto& playerMgr = Common::Service< World::Manager::PlayerMgr >::ref();
   for( auto& memberId : party.MemberId )
@@ -332,9 +338,9 @@ std::vector< Entity::PlayerPtr > PartyMgr::getPartyMembers( Party& party )
 
     auto pPlayer = playerMgr.getPlayer( memberId );
 
-    members.push_back( pPlayer );
+    party.Members.push_back( pPlayer );
   }
-  return members;
+  return party.Members;
 }
 
 Entity::PlayerPtr PartyMgr::getPartyLeader( Party& party )
@@ -349,46 +355,131 @@ Entity::PlayerPtr PartyMgr::getPartyLeader( Party& party )
   return pLeader;
 }
 
+void PartyMgr::onMemberChanged( Entity::Player& member, uint8_t fields )
+{
+  if( member.getPartyId() == 0 )
+    return;
+
+  auto party = getParty( member.getPartyId() );
+  if( !party )
+    return;
+
+  party->DirtyMembers[ member.getId() ] |= fields;
+  m_dirtyPartyIds.insert( party->PartyID );
+}
+
+void PartyMgr::update()
+{
+  for( auto partyId : m_dirtyPartyIds )
+  {
+    // the party might have been disbanded since it was flagged
+    auto party = getParty( partyId );
+    if( party )
+      sendPartyUpdate( *party );
+  }
+
+  m_dirtyPartyIds.clear();
+}
+
+void PartyMgr::queuePartyUpdate( Party& party )
+{
+  party.Entries.clear();
+  m_dirtyPartyIds.insert( party.PartyID );
+}
+
+void PartyMgr::updateEntry( ZoneProtoDownPartyMember& entry, Entity::Player& member, uint8_t fields )
+{
+  entry.ParentEntityId = Common::INVALID_GAME_OBJECT_ID;
+  entry.PetEntityId = Common::INVALID_GAME_OBJECT_ID;
+  entry.ObjType = 4; // 1 PC, 2 Buddy ??
+  entry.Valid = 1;
+
+  if( fields & PartyMemberField::Hp )
+  {
+    entry.Hp = member.getHp();
+    entry.HpMax = member.getMaxHp();
+  }
+
+  if( fields & PartyMemberField::Mp )
+  {
+    entry.Mp = member.getMp();
+    entry.MpMax = member.getMaxMp();
+    entry.Tp = member.getTp();
+  }
+
+  if( fields & PartyMemberField::ClassJob )
+  {
+    auto& exdData = Common::Service< Data::ExdData >::ref();
+    auto classJob = exdData.getRow< Excel::ClassJob >( static_cast< uint8_t >( member.getClass() ) );
+
+    entry.ClassJob = static_cast< uint8_t >( member.getClass() );
+    entry.Lv = member.getLevel();
+    entry.Role = classJob ? classJob->data().Role : 0;
+  }
+
+  if( fields & PartyMemberField::Zone )
+    entry.TerritoryType = member.getTerritoryTypeId();
+}
+
 void PartyMgr::sendPartyUpdate( Party& party )
 {
-  auto& exdData = Common::Service< Data::ExdData >::ref();
-  auto partyMembers = getPartyMembers( party );
-  std::vector< ZoneProtoDownPartyMember > entries;
   auto& server = Common::Service< World::WorldServer >::ref();
+  auto partyMembers = getPartyMembers( party );
 
-  for( const auto& member : partyMembers )
+  if( partyMembers.empty() )
+  {
+    party.DirtyMembers.clear();
+    return;
+  }
+
+  // a cleared entry list means the party itself changed and is always sent,
+  // otherwise only members with changed fields are rebuilt and the list is only sent if any entry differs
+  bool rebuild = party.Entries.size() != partyMembers.size();
+  bool hasChanges = rebuild;
+
+  if( rebuild )
+    party.Entries.assign( partyMembers.size(), ZoneProtoDownPartyMember{} );
+
+  for( size_t idx = 0; idx < partyMembers.size(); ++idx )
   {
-    auto classJob = exdData.getRow< Excel::ClassJob >( static_cast< uint8_t >( member->getClass() ) );
-    if( !classJob )
+    const auto& member = partyMembers[ idx ];
+    if( !member )
       continue;
 
-    ZoneProtoDownPartyMember memberEntry{};
-
-    memberEntry.ParentEntityId = Common::INVALID_GAME_OBJECT_ID;
-    memberEntry.PetEntityId = Common::INVALID_GAME_OBJECT_ID;
-    memberEntry.Hp = member->getHp();
-    memberEntry.HpMax = member->getMaxHp();
-    memberEntry.Mp = member->getMp();
-    memberEntry.MpMax = member->getMaxMp();
-    memberEntry.ClassJob = static_cast< uint8_t >( member->getClass() );
-    memberEntry.Lv = member->getLevel();
-    memberEntry.ObjType = 4; // 1 PC, 2 Buddy ??
-    memberEntry.TerritoryType = member->getTerritoryTypeId();
-    memberEntry.Valid = 1;
-    memberEntry.Tp = member->getTp();
-    memberEntry.Role = classJob->data().Role;
-    /*
-    memberEntry.CharaId = member->getContentId();
-    memberEntry.EntityId = member->getId();
-    strcpy( memberEntry.Name, member->getName().c_str() );*/
-
-    entries.push_back( memberEntry );
+    uint8_t fields = PartyMemberField::All;
+    if( !rebuild )
+    {
+      auto it = party.DirtyMembers.find( member->getId() );
+      if( it == party.DirtyMembers.end() )
+        continue;
+      fields = it->second;
+    }
+
+    auto entry = party.Entries[ idx ];
+    updateEntry( entry, *member, fields );
+
+    if( memcmp( &entry, &party.Entries[ idx ], sizeof( ZoneProtoDownPartyMember ) ) != 0 )
+    {
+      party.Entries[ idx ] = entry;
+      hasChanges = true;
+    }
   }
 
-  for( const auto& pMember : partyMembers )
+  party.DirtyMembers.clear();
+
+  if( !hasChanges )
+    return;
+
+  // members only see details of members in the same territory, so every territory in use gets one list shared by its members
+  std::map< uint32_t, std::set< uint64_t > > recipients;
+  for( const auto& member : partyMembers )
   {
-    size_t idx = 0;
+    if( member && member->isConnected() )
+      recipients[ member->getTerritoryTypeId() ].insert( member->getCharacterId() );
+  }
 
+  for( const auto& [ territoryTypeId, characterIds ] : recipients )
+  {
     auto updatePartyPacket = makeZonePacket< FFXIVIpcUpdateParty >( partyMembers[ 0 ]->getId() );
     auto& data = updatePartyPacket->data();
     data.PartyID = party.PartyID;
@@ -396,25 +487,24 @@ void PartyMgr::sendPartyUpdate( Party& party )
     data.ChatChannel = party.ChatChannel;
     data.PartyCount = party.PartyCount;
 
-    for( const auto& member : partyMembers )
+    for( size_t idx = 0; idx < partyMembers.size(); ++idx )
     {
-      bool isConnected = member->isConnected();
-      // if player is online and in the same zone as current member in party, display more data in partylist
-      bool hasInfo = isConnected && member->getTerritoryTypeId() == pMember->getTerritoryTypeId();
+      const auto& member = partyMembers[ idx ];
+      if( !member )
+        continue;
+
+      // if player is online and in the same zone as the receiving members, display more data in partylist
+      bool hasInfo = member->isConnected() && member->getTerritoryTypeId() == territoryTypeId;
 
       if( hasInfo )
-      {
-        data.Member[ idx ] = entries[ idx ];
-      }
+        data.Member[ idx ] = party.Entries[ idx ];
 
       data.Member[ idx ].CharaId = member->getCharacterId();
       data.Member[ idx ].EntityId = member->getId();
       strcpy( data.Member[ idx ].Name, member->getName().c_str() );
-
-      idx++;
     }
 
-    server.queueForPlayer( pMember->getCharacterId(), updatePartyPacket );
+    server.queueForPlayers( characterIds, updatePartyPacket );
   }
 }
 
@@ -441,4 +531,5 @@ void PartyMgr::removeMember( Party &party, const Entity::PlayerPtr& pMember )
   pMember->setPartyId( 0 );
   ccMgr.removeFromChannel( party.ChatChannel, *pMember );
   party.MemberId.erase( std::remove( party.MemberId.begin(), party.MemberId.end(), pMember->getId() ), party.MemberId.end() );
+  party.Members.clear();
 }
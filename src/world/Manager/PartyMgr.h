@@ -6,6 +6,9 @@
 #include <array>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
+
+#include <Network/PacketDef/Zone/ServerZoneDef.h>
 
 namespace Sapphire::World::Manager
 {
@@ -39,6 +42,12 @@ namespace Sapphire::World::Manager
     uint64_t ChatChannel;
     uint32_t LeaderId;
     uint8_t PartyCount;
+    /*! members resolved from MemberId, cleared whenever MemberId changes */
+    std::vector< Entity::PlayerPtr > Members;
+    /*! list entries of Members, rebuilt completely when empty */
+    std::vector< Network::Packets::WorldPackets::Server::ZoneProtoDownPartyMember > Entries;
+    /*! entity id to PartyMgr::PartyMemberField flags changed since the last update */
+    std::unordered_map< uint32_t, uint8_t > DirtyMembers;
   };
 
   using PartyPtr = std::shared_ptr< Party >;
@@ -46,6 +55,15 @@ namespace Sapphire::World::Manager
   class PartyMgr
   {
   public:
+    enum PartyMemberField : uint8_t
+    {
+      Hp = 0x01,
+      Mp = 0x02,
+      ClassJob = 0x04,
+      Zone = 0x08,
+      All = 0xFF,
+    };
+
     PartyMgr() = default;
 
     /// Perform required actions for events
@@ -64,6 +82,12 @@ namespace Sapphire::World::Manager
     void onStartReadyCheck( Entity::Player& startingPlayer, Party& party );
     void onReplyReadyCheck( Entity::Player& replyingPlayer, Party& party );
 
+    /*! flags changed fields of a member, the party list is sent with the next update if any entry changed */
+    void onMemberChanged( Entity::Player& member, uint8_t fields );
+
+    /*! sends one party list per party and territory for every party changed since the last call */
+    void update();
+
     ///////////////////////////
     PartyPtr getParty( uint64_t partyId );
 
@@ -76,7 +100,15 @@ namespace Sapphire::World::Manager
     uint64_t getNextPartyId();
     std::unordered_map< uint64_t, PartyPtr > m_partyIdMap;
 
+    /*! parties with a pending list update */
+    std::unordered_set< uint64_t > m_dirtyPartyIds;
+
+    /*! rebuilds all entries and sends the list with the next update */
+    void queuePartyUpdate( Party& party );
+
     static void sendPartyUpdate( Party& party );
+    static void updateEntry( Network::Packets::WorldPackets::Server::ZoneProtoDownPartyMember& entry,
+                             Entity::Player& member, uint8_t fields );
     static void removeMember( Party& party, const Entity::PlayerPtr& pMember );
     static std::vector< Entity::PlayerPtr > getPartyMembers( Party& party );
     static Entity::PlayerPtr getPartyLeader( Party& party );
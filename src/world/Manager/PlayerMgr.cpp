@@ -12,8 +12,11 @@
 #include <Manager/QuestMgr.h>
 #include <Manager/WarpMgr.h>
 #include <Manager/MapMgr.h>
+#include <Manager/PartyMgr.h>
+#include <Manager/PresenceMgr.h>
 
 #include <Script/ScriptMgr.h>
+#include <Inventory/InventoryJournal.h>
 #include <Common.h>
 
 #include <Database/ZoneDbConnection.h>
@@ -109,14 +112,23 @@ Sapphire::Entity::PlayerPtr PlayerMgr::addPlayer( uint64_t characterId )
 {
   auto pPlayer = Entity::make_Player();
 
+  // items still in the journal would be read in their old state
+  if( !Common::Service< Inventory::InventoryJournal >::ref().flushCharacter( characterId ) )
+    return nullptr;
+
   if( !pPlayer->loadFromDb( characterId ) )
     return nullptr;
 
+  registerPlayer( pPlayer );
+
+  return pPlayer;
+}
+
+void PlayerMgr::registerPlayer( const Entity::PlayerPtr& pPlayer )
+{
   m_playerMapById[ pPlayer->getId() ] = pPlayer;
   m_playerMapByCharacterId[ pPlayer->getCharacterId() ] = pPlayer;
   m_playerMapByName[ pPlayer->getName() ] = pPlayer;
-
-  return pPlayer;
 }
 
 Sapphire::Entity::PlayerPtr PlayerMgr::loadPlayer( uint32_t entityId )
@@ -190,12 +202,13 @@ Sapphire::Entity::PlayerPtr PlayerMgr::syncPlayer( uint64_t characterId )
     m_playerMapByName[ pPlayer->getName() ] = nullptr;
     m_playerMapByCharacterId[ pPlayer->getCharacterId() ] = nullptr;
 
+    if( !Common::Service< Inventory::InventoryJournal >::ref().flushCharacter( characterId ) )
+      return nullptr;
+
     if( !pPlayer->loadFromDb( characterId ) )
       return nullptr;
 
-    m_playerMapById[ pPlayer->getId() ] = pPlayer;
-    m_playerMapByCharacterId[ pPlayer->getCharacterId() ] = pPlayer;
-    m_playerMapByName[ pPlayer->getName() ] = pPlayer;
+    registerPlayer( pPlayer );
   }
 
   return pPlayer;
@@ -208,6 +221,9 @@ void PlayerMgr::onMobKill( Entity::Player& player, Entity::BNpc& bnpc )
 
   if( player.hasReward( Common::UnlockEntry::HuntingLog ) )
     onUpdateHuntingLog( player, bnpc.getBNpcNameId() );
+
+  auto& achvMgr = Common::Service< World::Manager::AchievementMgr >::ref();
+  achvMgr.progressAchievementByType< Common::Achievement::Type::General >( player, Common::Achievement::GeneralSubtype::EnemyDefeatCount );
 }
 
 void PlayerMgr::onSkillProc( Entity::Player& player, uint8_t index )
@@ -230,10 +246,12 @@ void PlayerMgr::sendLoginMessage( Entity::Player& player )
 
 void PlayerMgr::onLogin( Entity::Player &player )
 {
+  Common::Service< World::Manager::PresenceMgr >::ref().onLogin( player );
 }
 
 void PlayerMgr::onLogout( Entity::Player &player )
 {
+  Common::Service< World::Manager::PresenceMgr >::ref().onLogout( player );
 }
 
 void PlayerMgr::onDeath( Entity::Player& player )
@@ -301,6 +319,7 @@ void PlayerMgr::onMoveZone( Sapphire::Entity::Player& player )
 
   teri.onPlayerZoneIn( player );
 
+  Common::Service< World::Manager::PresenceMgr >::ref().onMoveZone( player );
 }
 
 void PlayerMgr::onUpdate( Entity::Player& player, uint64_t tickCount )
@@ -323,27 +342,33 @@ void PlayerMgr::checkAutoAttack( Entity::Player& player, uint64_t tickCount ) co
   if( !mainWeap || player.checkAction() || !player.isAutoattackOn() || !player.getTargetId() || player.getStance() != Common::Active )
     return;
 
-  for( const auto& actor : player.getInRangeActors() )
-  {
-    if( actor->getId() != player.getTargetId() || !actor->getAsChara()->isAlive() )
-      continue;
-    auto chara = actor->getAsChara();
+  auto& teriMgr = Common::Service< TerritoryMgr >::ref();
+  auto pZone = teriMgr.getTerritoryByGuId( player.getTerritoryId() );
+  if( !pZone )
+    return;
+
+  auto actor = pZone->getActor( static_cast< uint32_t >( player.getTargetId() ) );
+  if( !actor || actor->getId() != player.getTargetId() || !actor->isChara() || !player.isInRangeSet( actor ) )
+    return;
 
-    // default autoattack range
-    float range = 3.f + chara->getRadius() + player.getRadius() * 0.5f;
+  auto chara = actor->getAsChara();
+  if( !chara->isAlive() )
+    return;
 
-    // default autoattack range for ranged classes
-    auto classJob = player.getClass();
+  // default autoattack range
+  float range = 3.f + chara->getRadius() + player.getRadius() * 0.5f;
 
-    if( classJob == Common::ClassJob::Machinist || classJob == Common::ClassJob::Bard || classJob == Common::ClassJob::Archer )
-      range = 25.f + chara->getRadius() + player.getRadius() * 0.5f;
+  // default autoattack range for ranged classes
+  auto classJob = player.getClass();
 
-    if( ( Common::Util::distance( player.getPos(), actor->getPos() ) <= range ) &&
-        ( ( tickCount - player.getLastAttack() ) > mainWeap->getDelay() ) )
-    {
-      player.setLastAttack( tickCount );
-      player.autoAttack( actor->getAsChara() );
-    }
+  if( classJob == Common::ClassJob::Machinist || classJob == Common::ClassJob::Bard || classJob == Common::ClassJob::Archer )
+    range = 25.f + chara->getRadius() + player.getRadius() * 0.5f;
+
+  if( ( Common::Util::distance( player.getPos(), actor->getPos() ) <= range ) &&
+      ( ( tickCount - player.getLastAttack() ) > mainWeap->getDelay() ) )
+  {
+    player.setLastAttack( tickCount );
+    player.autoAttack( chara );
   }
 
 }
@@ -578,6 +603,8 @@ void PlayerMgr::onClassJobChanged( Entity::Player& player, Common::ClassJob clas
   Network::Util::Packet::sendActorControl( player.getInRangePlayerIds( true ), player.getId(), ClassJobChange, 4 );
   Network::Util::Packet::sendHudParam( player );
   Common::Service< World::Manager::MapMgr >::ref().updateQuests( player );
+  Common::Service< World::Manager::PresenceMgr >::ref().onClassJobChanged( player );
+  Common::Service< World::Manager::PartyMgr >::ref().onMemberChanged( player, World::Manager::PartyMgr::PartyMemberField::ClassJob );
 }
 
 void PlayerMgr::onLevelChanged( Entity::Player& player, uint8_t level )
@@ -595,6 +622,8 @@ void PlayerMgr::onLevelChanged( Entity::Player& player, uint8_t level )
   auto& achvMgr = Common::Service< World::Manager::AchievementMgr >::ref();
   achvMgr.progressAchievementByType< Common::Achievement::Type::Classjob >( player, static_cast< uint32_t >( player.getClass() ) );
   Common::Service< World::Manager::MapMgr >::ref().updateQuests( player );
+  Common::Service< World::Manager::PresenceMgr >::ref().onClassJobChanged( player );
+  Common::Service< World::Manager::PartyMgr >::ref().onMemberChanged( player, World::Manager::PartyMgr::PartyMemberField::ClassJob );
 }
 
 void PlayerMgr::onSongLearned( Entity::Player& player, uint8_t songId, uint32_t itemId )
@@ -22,6 +22,8 @@ namespace Sapphire::World::Manager
     Entity::PlayerPtr loadPlayer( const std::string& playerName );
     bool loadPlayers();
     Entity::PlayerPtr syncPlayer( uint64_t characterId );
+    /*! makes a loaded player known by id, character id and name */
+    void registerPlayer( const Entity::PlayerPtr& pPlayer );
 
     void onMobKill( Sapphire::Entity::Player& player, Sapphire::Entity::BNpc& bnpc );
 
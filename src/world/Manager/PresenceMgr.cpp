@@ -0,0 +1,180 @@
+#include <cstring>
+
+#include <Common.h>
+#include <Service.h>
+#include <Logging/Logger.h>
+
+#include "Actor/Player.h"
+#include "Network/Util/PacketUtil.h"
+
+#include "PlayerMgr.h"
+#include "PresenceMgr.h"
+
+using namespace Sapphire;
+using namespace Sapphire::Network::Packets::WorldPackets::Server;
+using namespace Sapphire::World::Manager;
+
+void PresenceMgr::onLogin( Entity::Player& player )
+{
+  refresh( player, PresenceChange::Login );
+  subscribeFriends( player );
+}
+
+void PresenceMgr::onLogout( Entity::Player& player )
+{
+  unsubscribeFriends( player );
+  refresh( player, PresenceChange::Logout );
+}
+
+void PresenceMgr::onMoveZone( Entity::Player& player )
+{
+  refresh( player, PresenceChange::Zone );
+}
+
+void PresenceMgr::onClassJobChanged( Entity::Player& player )
+{
+  refresh( player, PresenceChange::ClassJob );
+}
+
+void PresenceMgr::onProfileChanged( Entity::Player& player )
+{
+  refresh( player, PresenceChange::Profile );
+}
+
+void PresenceMgr::subscribe( uint64_t subscriberId, uint64_t publisherId )
+{
+  m_presenceMap[ publisherId ].subscribers.insert( subscriberId );
+}
+
+void PresenceMgr::unsubscribe( uint64_t subscriberId, uint64_t publisherId )
+{
+  auto it = m_presenceMap.find( publisherId );
+  if( it != m_presenceMap.end() )
+    it->second.subscribers.erase( subscriberId );
+}
+
+const PlayerEntry* PresenceMgr::getEntry( uint64_t characterId )
+{
+  auto it = m_presenceMap.find( characterId );
+
+  // subscriptions can create the presence before its entry is built
+  if( it == m_presenceMap.end() || it->second.entry.CharacterID == 0 )
+  {
+    auto& playerMgr = Common::Service< PlayerMgr >::ref();
+    auto pPlayer = playerMgr.getPlayer( characterId );
+    if( !pPlayer )
+      return nullptr;
+
+    return &refresh( *pPlayer, 0 ).entry;
+  }
+
+  auto& presence = it->second;
+
+  // online status changes too often to track, it is read when the entry is served
+  if( presence.pPlayer )
+    presence.entry.OnlineStatus = presence.pPlayer->getOnlineStatusMask() | presence.pPlayer->getOnlineStatusCustomMask();
+
+  return &presence.entry;
+}
+
+void PresenceMgr::update()
+{
+  if( m_pendingChanges.empty() )
+    return;
+
+  auto& playerMgr = Common::Service< PlayerMgr >::ref();
+
+  for( const auto& [ characterId, changes ] : m_pendingChanges )
+  {
+    // only logins and logouts are announced, other changes just refresh the entry
+    bool loggedIn = changes & PresenceChange::Login;
+    bool loggedOut = changes & PresenceChange::Logout;
+
+    // both within one tick, friends never saw the character change state
+    if( loggedIn == loggedOut )
+      continue;
+
+    auto it = m_presenceMap.find( characterId );
+    if( it == m_presenceMap.end() )
+      continue;
+
+    auto& presence = it->second;
+    auto message = fmt::format( loggedIn ? "{} has logged in." : "{} has logged out.", presence.entry.CharacterName );
+
+    for( auto subscriberId : presence.subscribers )
+    {
+      auto pSubscriber = playerMgr.getPlayer( subscriberId );
+      if( !pSubscriber || !pSubscriber->isConnected() )
+        continue;
+
+      Network::Util::Packet::sendChat( *pSubscriber, Common::ChatType::SystemMessage, message );
+    }
+  }
+
+  m_pendingChanges.clear();
+}
+
+PresenceMgr::Presence& PresenceMgr::refresh( Entity::Player& player, uint8_t changes )
+{
+  auto& presence = m_presenceMap[ player.getCharacterId() ];
+  auto& entry = presence.entry;
+
+  memset( &entry, 0, sizeof( PlayerEntry ) );
+  entry.CharacterID = player.getCharacterId();
+  strncpy( entry.CharacterName, player.getName().c_str(), sizeof( entry.CharacterName ) - 1 );
+
+  bool isOnline = player.isConnected() && !( changes & PresenceChange::Logout );
+
+  if( isOnline )
+  {
+    entry.TerritoryType = player.getTerritoryTypeId();
+    entry.TerritoryID = player.getTerritoryId();
+
+    entry.CurrentClassID = static_cast< uint8_t >( player.getClass() );
+    entry.SelectClassID = static_cast< uint8_t >( player.getSearchSelectClass() );
+
+    entry.CurrentLevel = player.getLevel();
+    entry.SelectLevel = player.getLevel();
+    entry.Identity = player.getGender();
+
+    // GC icon
+    entry.GrandCompanyID = player.getGc();
+    // client language J = 0, E = 1, D = 2, F = 3
+    entry.Region = 1;
+    // user language settings flag J = 1, E = 2, D = 4, F = 8
+    entry.SelectRegion = player.getSearchSelectRegion();
+    entry.OnlineStatus = player.getOnlineStatusMask() | player.getOnlineStatusCustomMask();
+
+    strcpy( entry.FcTag, "Awoo" );
+
+    presence.pPlayer = player.getAsPlayer();
+  }
+  else
+    presence.pPlayer = nullptr;
+
+  if( changes != 0 )
+    m_pendingChanges[ player.getCharacterId() ] |= changes;
+
+  return presence;
+}
+
+void PresenceMgr::subscribeFriends( Entity::Player& player )
+{
+  auto& friendList = player.getFriendListId();
+  auto& friendListData = player.getFriendListData();
+
+  for( size_t i = 0; i < friendList.size(); ++i )
+  {
+    if( friendList[ i ] != 0 && friendListData[ i ].data.status == Common::HierarchyStatus::Added )
+      subscribe( player.getCharacterId(), friendList[ i ] );
+  }
+}
+
+void PresenceMgr::unsubscribeFriends( Entity::Player& player )
+{
+  for( auto friendId : player.getFriendListId() )
+  {
+    if( friendId != 0 )
+      unsubscribe( player.getCharacterId(), friendId );
+  }
+}
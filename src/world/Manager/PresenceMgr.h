@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <Network/PacketDef/Zone/ServerZoneDef.h>
+
+#include "ForwardsZone.h"
+
+namespace Sapphire::World::Manager
+{
+
+  /*!
+   * @brief Cached social list entries and friend presence notifications.
+   *
+   * Every character shown in a friend or linkshell list has a prebuilt list entry which is refreshed
+   * when it logs in or out, changes zone, job or level, so lists are served without resolving each
+   * listed character again. Online characters subscribe to their friends and are told when one of
+   * them logs in or out; changes are collected and sent once per server tick.
+   */
+  class PresenceMgr
+  {
+  public:
+    enum PresenceChange : uint8_t
+    {
+      Login = 0x01,
+      Logout = 0x02,
+      Zone = 0x04,
+      ClassJob = 0x08,
+      Profile = 0x10,
+    };
+
+    PresenceMgr() = default;
+
+    void onLogin( Entity::Player& player );
+    void onLogout( Entity::Player& player );
+    void onMoveZone( Entity::Player& player );
+    void onClassJobChanged( Entity::Player& player );
+    /*! search info or grand company changed */
+    void onProfileChanged( Entity::Player& player );
+
+    /*! friend list changes, subscriptions only exist while the subscriber is online */
+    void subscribe( uint64_t subscriberId, uint64_t publisherId );
+    void unsubscribe( uint64_t subscriberId, uint64_t publisherId );
+
+    /*!
+     * @brief social list entry of a character, hierarchy fields are left empty
+     * @return nullptr if the character does not exist
+     */
+    const Network::Packets::WorldPackets::Server::PlayerEntry* getEntry( uint64_t characterId );
+
+    /*! sends queued presence changes to subscribers */
+    void update();
+
+  private:
+    struct Presence
+    {
+      Network::Packets::WorldPackets::Server::PlayerEntry entry{};
+      /*! set while online, used to read the live online status */
+      Entity::PlayerPtr pPlayer;
+      /*! online characters with this one on their friend list */
+      std::unordered_set< uint64_t > subscribers;
+    };
+
+    Presence& refresh( Entity::Player& player, uint8_t changes );
+
+    void subscribeFriends( Entity::Player& player );
+    void unsubscribeFriends( Entity::Player& player );
+
+    std::unordered_map< uint64_t, Presence > m_presenceMap;
+
+    /*! character id to the changes since the last update */
+    std::unordered_map< uint64_t, uint8_t > m_pendingChanges;
+  };
+
+}
@@ -5,6 +5,7 @@
 #include <queue>
 #include <ForwardsZone.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 
 namespace Sapphire::World::Manager
 {
@@ -28,7 +29,7 @@ namespace Sapphire::World::Manager
       m_targetPosition( targetPosition ),
       m_targetRotation( targetRotation ),
       m_delayTimeMs( delayTime ),
-      m_timeQueuedMs( Common::Util::getTimeMs() )
+      m_timeQueuedMs( Common::Util::FrameClock::getTimeMs() )
     {
     }
   };
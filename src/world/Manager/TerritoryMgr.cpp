@@ -7,6 +7,8 @@
 
 #include <unordered_map>
 #include <Service.h>
+#include <Util/ThreadPool.h>
+#include <Random/RNGMgr.h>
 
 #include "Actor/Player.h"
 
@@ -23,6 +25,8 @@
 #include "Territory/House.h"
 #include "Territory/Housing/HousingInteriorTerritory.h"
 
+#include "Util/ScopedTimer.h"
+
 using namespace Sapphire;
 using namespace Sapphire::World::Manager;
 
@@ -169,9 +173,28 @@ uint32_t TerritoryMgr::getInstanceContentId( uint32_t territoryTypeId ) const
   return 0;
 }
 
+void TerritoryMgr::preloadTerritories( const std::vector< TerritoryPtr >& territories )
+{
+  auto& server = Common::Service< World::WorldServer >::ref();
+  Common::Util::ThreadPool pool( server.getConfig().territory.bootstrapThreads );
+
+  std::vector< std::future< void > > jobs;
+  jobs.reserve( territories.size() );
+
+  for( const auto& pZone : territories )
+    jobs.push_back( pool.queue( [ pZone ]() { pZone->preload(); } ) );
+
+  // rethrows anything a worker ran into
+  for( auto& job : jobs )
+    job.get();
+}
+
 bool TerritoryMgr::createDefaultTerritories()
 {
   auto& exdData = Common::Service< Data::ExdData >::ref();
+  std::vector< TerritoryPtr > territories;
+
+  // constructing a zone reads exd rows, which is not thread safe, so that part stays on this thread
   // for each entry in territoryTypeExd, check if it is a normal and if so, add the zone object
   for( const auto& territory : m_territoryTypeDetailCacheMap )
   {
@@ -192,18 +215,30 @@ bool TerritoryMgr::createDefaultTerritories()
 
     auto pZone = make_Territory( territoryTypeId, guid, territoryInfo->getString( territoryData.Name ),
                                                  pPlaceName->getString( pPlaceName->data().Text.SGL ) );
+    territories.push_back( pZone );
+  }
+
+  // bnpc json and navmeshes are independent per zone, load them all at once
+  preloadTerritories( territories );
+
+  for( const auto& pZone : territories )
+  {
     pZone->init();
 
+    auto territoryTypeId = pZone->getTerritoryTypeId();
+    auto guid = pZone->getGuId();
+    auto territoryInfo = pZone->getTerritoryTypeInfo();
+
     bool hasNaviMesh = pZone->getNaviProvider() != nullptr;
 
     Logger::info( "{0}\t{1}\t{2}\t{3:<10}\t{4}\t{5}\t{6}",
                   std::to_string( territoryTypeId ),
                   guid,
-                  territoryData.IntendedUse,
-                  territoryInfo->getString( territoryData.Name ),
+                  territoryInfo->data().IntendedUse,
+                  pZone->getInternalName(),
                   ( isPrivateTerritory( territoryTypeId ) ? "PRIVATE" : "PUBLIC" ),
                   hasNaviMesh ? "NAVI" : "",
-                  pPlaceName->getString( pPlaceName->data().Text.SGL ) );
+                  pZone->getName() );
 
     InstanceIdToTerritoryPtrMap instanceMap;
     instanceMap[ guid ] = pZone;
@@ -220,6 +255,8 @@ bool TerritoryMgr::createHousingTerritories()
 {
   //separate housing zones from default
   auto& exdData = Common::Service< Data::ExdData >::ref();
+  std::vector< HousingZonePtr > housingZones;
+
   for( const auto& territory : m_territoryTypeDetailCacheMap )
   {
     auto territoryTypeId = territory.first;
@@ -240,25 +277,35 @@ bool TerritoryMgr::createHousingTerritories()
 
       auto pHousingZone = make_HousingZone( wardNum, territoryTypeId, territoryInfo->getString( territoryInfo->data().Name ),
                                                                 pPlaceName->getString( pPlaceName->data().Text.SGL ) );
-      pHousingZone->init();
-
-      Logger::info( "{0}\t{1}\t{2}\t{3:<10}\tHOUSING\t\t{4}#{5}",
-                    territoryTypeId,
-                    pHousingZone->getLandSetId(),
-                    territoryInfo->data().IntendedUse,
-                    territoryInfo->getString( territoryInfo->data().Name ),
-                    pPlaceName->getString( pPlaceName->data().Text.SGL ),
-                    wardNum );
-
-      InstanceIdToTerritoryPtrMap instanceMap;
-      instanceMap[ pHousingZone->getLandSetId() ] = pHousingZone;
-      m_guIdToTerritoryPtrMap[ pHousingZone->getLandSetId() ] = pHousingZone;
-      m_territoryTypeIdToInstanceGuidMap[ territoryTypeId ][ pHousingZone->getLandSetId() ] = pHousingZone;
-      m_territorySet.insert( { pHousingZone } );
+      housingZones.push_back( pHousingZone );
     }
 
   }
 
+  preloadTerritories( { housingZones.begin(), housingZones.end() } );
+
+  for( const auto& pHousingZone : housingZones )
+  {
+    pHousingZone->init();
+
+    auto territoryTypeId = pHousingZone->getTerritoryTypeId();
+    auto territoryInfo = pHousingZone->getTerritoryTypeInfo();
+
+    Logger::info( "{0}\t{1}\t{2}\t{3:<10}\tHOUSING\t\t{4}#{5}",
+                  territoryTypeId,
+                  pHousingZone->getLandSetId(),
+                  territoryInfo->data().IntendedUse,
+                  pHousingZone->getInternalName(),
+                  pHousingZone->getName(),
+                  pHousingZone->getWardNum() );
+
+    InstanceIdToTerritoryPtrMap instanceMap;
+    instanceMap[ pHousingZone->getLandSetId() ] = pHousingZone;
+    m_guIdToTerritoryPtrMap[ pHousingZone->getLandSetId() ] = pHousingZone;
+    m_territoryTypeIdToInstanceGuidMap[ territoryTypeId ][ pHousingZone->getLandSetId() ] = pHousingZone;
+    m_territorySet.insert( { pHousingZone } );
+  }
+
   return true;
 }
 
@@ -331,7 +378,7 @@ TerritoryPtr TerritoryMgr::createQuestBattle( uint32_t questBattleId )
   return nullptr;
 }
 
-TerritoryPtr TerritoryMgr::createInstanceContent( uint32_t contentFinderId )
+TerritoryPtr TerritoryMgr::createInstanceContent( uint32_t contentFinderId, uint64_t randomSeed )
 {
 
   auto& exdData = Common::Service< Data::ExdData >::ref();
@@ -359,8 +406,12 @@ TerritoryPtr TerritoryMgr::createInstanceContent( uint32_t contentFinderId )
   Logger::debug( "Starting instance for InstanceContent id: {0} ({1})", contentFinderId, name );
 
   auto pZone = make_InstanceContent( pInstanceContent, pContentFinderCondition, instanceContentData.TerritoryType, getNextInstanceId(), pTeri->getString( pTeri->data().Name ), name, pContentFinderCondition->data().InstanceContentId );
+  if( randomSeed != 0 )
+    pZone->setRandomSeed( randomSeed );
   pZone->init();
 
+  Logger::debug( "Instance id#{0} rolls with seed {1:016X}", pZone->getGuId(), pZone->getRandomStream().getSeed() );
+
   m_instanceContentIdToInstanceMap[ pContentFinderCondition->data().InstanceContentId ][ pZone->getGuId() ] = pZone;
   m_guIdToTerritoryPtrMap[ pZone->getGuId() ] = pZone;
   m_instanceZoneSet.insert( pZone );
@@ -470,6 +521,14 @@ TerritoryPtr TerritoryMgr::getTerritoryByGuId( uint32_t guId ) const
   return it->second;
 }
 
+Common::Random::RandomStream& TerritoryMgr::getRandomStream( const Entity::GameObject& actor ) const
+{
+  if( auto pTerritory = getTerritoryByGuId( actor.getTerritoryId() ) )
+    return pTerritory->getRandomStream();
+
+  return Common::Service< Common::Random::RNGMgr >::ref().getRNGEngine();
+}
+
 TerritoryPtr TerritoryMgr::getTerritoryByTypeId( uint32_t territoryTypeId ) const
 {
   auto zoneMap = m_territoryTypeIdToInstanceGuidMap.find( territoryTypeId );
@@ -481,15 +540,59 @@ TerritoryPtr TerritoryMgr::getTerritoryByTypeId( uint32_t territoryTypeId ) cons
 }
 
 
+void TerritoryMgr::getPopulation( std::size_t& territories, std::size_t& players, std::size_t& bnpcs ) const
+{
+  territories = m_territorySet.size() + m_instanceZoneSet.size();
+  players = 0;
+  bnpcs = 0;
+
+  for( const auto& zoneSet : { &m_territorySet, &m_instanceZoneSet } )
+  {
+    for( const auto& zone : *zoneSet )
+    {
+      players += zone->getPopCount();
+      bnpcs += zone->getBNpcCount();
+    }
+  }
+}
+
 void TerritoryMgr::updateTerritoryInstances( uint64_t tickCount )
 {
+  auto& server = Common::Service< World::WorldServer >::ref();
+  const auto& cfg = server.getConfig().territory;
 
   for( auto& zone : m_territorySet )
   {
+    if( !cfg.hibernate )
+    {
+      SAPPHIRE_PROFILE_TERRITORY( zone->getTerritoryTypeId() );
+      zone->update( tickCount );
+      continue;
+    }
+
+    if( zone->isHibernating() )
+    {
+      if( zone->canHibernate() )
+      {
+        if( tickCount - zone->getLastUpdateTime() >= cfg.hibernateWakeInterval )
+          zone->updateHibernating( tickCount );
+        continue;
+      }
+
+      zone->wake( tickCount );
+    }
+    else if( zone->canHibernate() && tickCount - zone->getLastActivityTime() > cfg.hibernateDelay )
+    {
+      zone->hibernate( tickCount );
+      continue;
+    }
+
+    SAPPHIRE_PROFILE_TERRITORY( zone->getTerritoryTypeId() );
     zone->update( tickCount );
   }
   for( auto& zone : m_instanceZoneSet )
   {
+    SAPPHIRE_PROFILE_TERRITORY( zone->getTerritoryTypeId() );
     zone->update( tickCount );
   }
   // remove internal house zones with nobody in them
@@ -16,6 +16,11 @@ namespace Sapphire::Data
   using InstanceContentPtr = std::shared_ptr< InstanceContent >;
 }
 
+namespace Sapphire::Common::Random
+{
+  class RandomStream;
+}
+
 namespace Sapphire
 {
   class Territory;
@@ -113,7 +118,8 @@ namespace Sapphire::World::Manager
     /*! creates a new instance for a given territoryTypeId */
     TerritoryPtr createTerritoryInstance( uint32_t territoryTypeId );
 
-    TerritoryPtr createInstanceContent( uint32_t contentFinderId );
+    /*! @param randomSeed seed of the instance's random stream, 0 derives it from the root seed */
+    TerritoryPtr createInstanceContent( uint32_t contentFinderId, uint64_t randomSeed = 0 );
 
     TerritoryPtr createQuestBattle( uint32_t contentFinderConditionId );
 
@@ -127,12 +133,18 @@ namespace Sapphire::World::Manager
     /*! returns a TerritoryPtr to the instance or nullptr if not found */
     TerritoryPtr getTerritoryByGuId( uint32_t guId ) const;
 
+    /*! random stream of the territory an actor is in, the shared stream if it is in none */
+    Common::Random::RandomStream& getRandomStream( const Entity::GameObject& actor ) const;
+
     /*! returns the cached detail of a territory, nullptr if not found */
     Excel::ExcelStructPtr< Excel::TerritoryType > getTerritoryDetail( uint32_t territoryTypeId ) const;
 
     /*! loop for processing territory logic, iterating all existing instances */
     void updateTerritoryInstances( uint64_t tickCount );
 
+    /*! counts territory instances and the players and battle npcs inside them */
+    void getPopulation( std::size_t& territories, std::size_t& players, std::size_t& bnpcs ) const;
+
     /*! returns a default Zone by territoryTypeId
         TODO: Mind multiple instances?! */
     TerritoryPtr getTerritoryByTypeId( uint32_t territoryTypeId ) const;
@@ -161,6 +173,9 @@ namespace Sapphire::World::Manager
     const std::pair< uint16_t, uint16_t >& getCurrentFestival() const;
 
   private:
+    /*! runs Territory::preload for every given zone on a thread pool, blocks until all are done */
+    void preloadTerritories( const std::vector< TerritoryPtr >& territories );
+
     using TerritoryTypeDetailCache = std::unordered_map< uint16_t, std::shared_ptr< Excel::ExcelStruct< Excel::TerritoryType > > >;
     using InstanceIdToTerritoryPtrMap = std::unordered_map< uint32_t, TerritoryPtr >;
     using TerritoryTypeIdToInstanceMap = std::unordered_map< uint16_t, InstanceIdToTerritoryPtrMap >;
@@ -14,6 +14,7 @@
 #include "CalcStats.h"
 
 #include "Manager/PlayerMgr.h"
+#include "Manager/TerritoryMgr.h"
 
 using namespace Sapphire::Math;
 using namespace Sapphire::Entity;
@@ -85,8 +86,6 @@ const int levelTable[61][6] =
   { 218, 354, 858, 2600, 282, 215 },
 };
 
-std::unique_ptr< Sapphire::Common::Random::RandGenerator< float > > CalcStats::rnd = nullptr;
-
 /*
    Class used for battle-related formulas and calculations.
    Big thanks to the Theoryjerks group!
@@ -577,13 +576,13 @@ std::pair< float, Sapphire::Common::CalcResultType > CalcStats::calcAutoAttackDa
 
   factor = std::floor( factor * speed( chara ) );
 
-  if( criticalHitProbability( chara ) > getRandomNumber0To100() )
+  if( criticalHitProbability( chara ) > getRandomNumber0To100( chara ) )
   {
     factor *= criticalHitBonus( chara );
     hitType = Sapphire::Common::CalcResultType::TypeCriticalDamageHp;
   }
 
-  factor *= 1.0f + ( ( getRandomNumber0To100() - 50.0f ) / 1000.0f );
+  factor *= 1.0f + ( ( getRandomNumber0To100( chara ) - 50.0f ) / 1000.0f );
 
   // todo: buffs
 
@@ -615,13 +614,13 @@ std::pair< float, Sapphire::Common::CalcResultType > CalcStats::calcActionDamage
   auto factor = Common::Util::trunc( pot * wd * ap * det, 0 );
   Sapphire::Common::CalcResultType hitType = Sapphire::Common::CalcResultType::TypeDamageHp;
 
-  if( criticalHitProbability( chara ) > getRandomNumber0To100() )
+  if( criticalHitProbability( chara ) > getRandomNumber0To100( chara ) )
   {
     factor *= criticalHitBonus( chara );
     hitType = Sapphire::Common::CalcResultType::TypeCriticalDamageHp;
   }
 
-  factor *= 1.0f + ( ( getRandomNumber0To100() - 50.0f ) / 1000.0f );
+  factor *= 1.0f + ( ( getRandomNumber0To100( chara ) - 50.0f ) / 1000.0f );
 
   // todo: buffs
 
@@ -652,13 +651,13 @@ std::pair< float, Sapphire::Common::CalcResultType > CalcStats::calcActionHealin
 
   Sapphire::Common::CalcResultType hitType = Sapphire::Common::CalcResultType::TypeRecoverHp;
 
-  if( criticalHitProbability( chara ) > getRandomNumber0To100() )
+  if( criticalHitProbability( chara ) > getRandomNumber0To100( chara ) )
   {
     factor *= criticalHitBonus( chara );
     hitType = Sapphire::Common::CalcResultType::TypeCriticalRecoverHp;
   }
 
-  factor *= 1.0f + ( ( getRandomNumber0To100() - 50.0f ) / 1000.0f );
+  factor *= 1.0f + ( ( getRandomNumber0To100( chara ) - 50.0f ) / 1000.0f );
 
   return std::pair( factor, hitType );
 }
@@ -699,11 +698,7 @@ uint32_t CalcStats::primaryStatValue( const Sapphire::Entity::Chara& chara )
   return chara.getStatValue( chara.getPrimaryStat() );
 }
 
-float CalcStats::getRandomNumber0To100()
+float CalcStats::getRandomNumber0To100( const Sapphire::Entity::Chara& chara )
 {
-  if( !rnd )
-  {
-    rnd = std::make_unique< Common::Random::RandGenerator< float > >( Common::Service< Common::Random::RNGMgr >::ref().getRandGenerator< float >( 0, 100 ) );
-  }
-  return rnd->next();
+  return Common::Service< World::Manager::TerritoryMgr >::ref().getRandomStream( chara ).nextFloat( 0.f, 100.f );
 }
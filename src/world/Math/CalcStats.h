@@ -170,8 +170,8 @@ namespace Sapphire::Math
      */
     static float calcAttackPower( const Sapphire::Entity::Chara& chara, uint32_t attackPower );
 
-    static float getRandomNumber0To100();
-    static std::unique_ptr< Common::Random::RandGenerator< float > > rnd;
+    /*! rolls from the random stream of the territory chara is in */
+    static float getRandomNumber0To100( const Sapphire::Entity::Chara& chara );
   };
 
 }
@@ -2,11 +2,13 @@
 #include <Network/CommonNetwork.h>
 #include <Util/Util.h>
 #include <Logging/Logger.h>
+#include <memory>
 #include <utility>
 
 #include <Network/Acceptor.h>
 #include <Network/PacketContainer.h>
 #include <Network/GamePacketParser.h>
+#include <Network/PacketDef/Zone/ClientZoneDef.h>
 #include <Service.h>
 
 #include "Network/PacketWrappers/PlayerSetupPacket.h"
@@ -16,6 +18,7 @@
 #include "Session.h"
 #include "Forwards.h"
 
+#include "Manager/MetricMgr.h"
 #include "Manager/PlayerMgr.h"
 
 using namespace Sapphire::Common;
@@ -31,148 +34,153 @@ GameConnection::GameConnection( Sapphire::Network::HivePtr pHive, Sapphire::Netw
   m_pAcceptor( std::move( pAcceptor ) ),
   m_conType( ConnectionType::None )
 {
-  auto setZoneHandler = [ = ]( uint16_t opcode, std::string handlerName, GameConnection::Handler pHandler )
+  m_outQueueBudget = Common::Service< World::WorldServer >::ref().getConfig().network.outQueueBudget;
+}
+
+GameConnection::~GameConnection() = default;
+
+void GameConnection::registerHandlers( HandlerTable& zoneHandlers, HandlerTable& chatHandlers )
+{
+  // the minimum size is the client struct the handler reads, handlers which don't read the payload accept any size
+  auto setZoneHandler = [ & ]( uint16_t opcode, const char* handlerName, GameConnection::Handler pHandler,
+                               uint32_t minSize = 0, PacketRateClass rateClass = PacketRateClass::Default )
   {
-    m_zoneHandlerMap[ opcode ] = pHandler;
-    m_zoneHandlerStrMap[ opcode ] = std::move( handlerName );
+    zoneHandlers.set( opcode, handlerName, pHandler, minSize, rateClass );
   };
 
-  auto setChatHandler = [ = ]( uint16_t opcode, std::string handlerName, GameConnection::Handler pHandler )
+  auto setChatHandler = [ & ]( uint16_t opcode, const char* handlerName, GameConnection::Handler pHandler,
+                               uint32_t minSize = 0, PacketRateClass rateClass = PacketRateClass::Default )
   {
-    m_chatHandlerMap[ opcode ] = pHandler;
-    m_chatHandlerStrMap[ opcode ] = std::move( handlerName );
+    chatHandlers.set( opcode, handlerName, pHandler, minSize, rateClass );
   };
 
-  setZoneHandler( Sync, "syncHandler", &GameConnection::syncHandler );
-  setZoneHandler( ClientZoneIpcType::Login, "loginHandler", &GameConnection::loginHandler );
-  setZoneHandler( ChatHandler, "ChatHandler", &GameConnection::chatHandler );
-  setZoneHandler( JoinChatChannel, "JoinChatChannel", &GameConnection::joinChatChannelHandler );
+  setZoneHandler( Sync, "syncHandler", &GameConnection::syncHandler, sizeof( Client::FFXIVIpcPingHandler ), PacketRateClass::Frequent );
+  setZoneHandler( ClientZoneIpcType::Login, "loginHandler", &GameConnection::loginHandler, sizeof( Client::FFXIVIpcLoginHandler ) );
+  setZoneHandler( ChatHandler, "ChatHandler", &GameConnection::chatHandler, sizeof( Client::FFXIVIpcChatHandler ), PacketRateClass::Chat );
+  setZoneHandler( JoinChatChannel, "JoinChatChannel", &GameConnection::joinChatChannelHandler, sizeof( Client::FFXIVIpcJoinChatChannel ) );
 
   setZoneHandler( SetLanguage, "SetLanguage", &GameConnection::setLanguageHandler );
 
   setZoneHandler( StartLogoutCountdown, "StartLogoutCountdown", &GameConnection::logoutHandler );
 
-  setZoneHandler( SetProfile, "SetProfile", &GameConnection::setProfileHandler );
+  setZoneHandler( SetProfile, "SetProfile", &GameConnection::setProfileHandler, sizeof( Client::FFXIVIpcSetSearchInfo ) );
   setZoneHandler( GetProfile, "GetProfile", &GameConnection::getProfileHandler );
   setZoneHandler( GetSearchComment, "GetSearchComment", &GameConnection::getSearchCommentHandler );
-  setZoneHandler( PcSearch, "PcSearch", &GameConnection::pcSearchHandler );
+  setZoneHandler( PcSearch, "PcSearch", &GameConnection::pcSearchHandler, sizeof( Client::FFXIVIpcPcSearch ), PacketRateClass::Heavy );
 
-  setZoneHandler( GetCommonlist, "GetCommonlist", &GameConnection::getCommonlistHandler );
-  setZoneHandler( GetCommonlistDetail, "GetCommonlistDetail", &GameConnection::getCommonlistDetailHandler );
+  setZoneHandler( GetCommonlist, "GetCommonlist", &GameConnection::getCommonlistHandler, sizeof( Client::FFXIVIpcGetCommonlist ), PacketRateClass::Heavy );
+  setZoneHandler( GetCommonlistDetail, "GetCommonlistDetail", &GameConnection::getCommonlistDetailHandler, sizeof( Client::FFXIVIpcGetCommonlistDetail ) );
 
-  setZoneHandler( GetLinkshellList, "GetLinkshellList", &GameConnection::linkshellListHandler );
-  setZoneHandler( LinkshellJoin, "LinkshellJoin", &GameConnection::linkshellJoinHandler );
-  setZoneHandler( LinkshellKick, "LinkshellKick", &GameConnection::linkshellKickHandler );
-  setZoneHandler( LinkshellLeave, "LinkshellLeave", &GameConnection::linkshellLeaveHandler );
-  setZoneHandler( LinkshellChangeMaster, "LinkshellChangeMaster", &GameConnection::linkshellChangeMasterHandler );
-  setZoneHandler( LinkshellJoinOfficial, "LinkshellJoinOfficial", &GameConnection::linkshellJoinOfficialHandler );
-  setZoneHandler( LinkshellAddLeader, "LinkshellAddLeader", &GameConnection::linkshellAddLeaderHandler );
-  setZoneHandler( LinkshellRemoveLeader, "LinkshellRemoveLeader", &GameConnection::linkshellRemoveLeaderHandler );
-  setZoneHandler( LinkshellDeclineLeader, "LinkshellDeclineLeader", &GameConnection::linkshellDeclineLeaderHandler );
+  setZoneHandler( GetLinkshellList, "GetLinkshellList", &GameConnection::linkshellListHandler, 0, PacketRateClass::Heavy );
+  setZoneHandler( LinkshellJoin, "LinkshellJoin", &GameConnection::linkshellJoinHandler, sizeof( Client::FFXIVIpcLinkshellJoin ) );
+  setZoneHandler( LinkshellKick, "LinkshellKick", &GameConnection::linkshellKickHandler, sizeof( Client::FFXIVIpcLinkshellKick ) );
+  setZoneHandler( LinkshellLeave, "LinkshellLeave", &GameConnection::linkshellLeaveHandler, sizeof( Client::FFXIVIpcLinkshellLeave ) );
+  setZoneHandler( LinkshellChangeMaster, "LinkshellChangeMaster", &GameConnection::linkshellChangeMasterHandler, sizeof( Client::FFXIVIpcLinkshellChangeMaster ) );
+  setZoneHandler( LinkshellJoinOfficial, "LinkshellJoinOfficial", &GameConnection::linkshellJoinOfficialHandler, sizeof( Client::FFXIVIpcLinkshellJoinOfficial ) );
+  setZoneHandler( LinkshellAddLeader, "LinkshellAddLeader", &GameConnection::linkshellAddLeaderHandler, sizeof( Client::FFXIVIpcLinkshellAddLeader ) );
+  setZoneHandler( LinkshellRemoveLeader, "LinkshellRemoveLeader", &GameConnection::linkshellRemoveLeaderHandler, sizeof( Client::FFXIVIpcLinkshellRemoveLeader ) );
+  setZoneHandler( LinkshellDeclineLeader, "LinkshellDeclineLeader", &GameConnection::linkshellDeclineLeaderHandler, sizeof( Client::FFXIVIpcLinkshellDeclineLeader ) );
 
   setZoneHandler( ReqExamineFcInfo, "ReqExamineFcInfo", &GameConnection::reqExamineFcInfo );
-  setZoneHandler( ZoneJump, "ZoneJump", &GameConnection::zoneJumpHandler );
-  setZoneHandler( Command, "Command", &GameConnection::commandHandler );
+  setZoneHandler( ZoneJump, "ZoneJump", &GameConnection::zoneJumpHandler, sizeof( Client::FFXIVIpcZoneJump ) );
+  setZoneHandler( Command, "Command", &GameConnection::commandHandler, sizeof( Client::FFXIVIpcClientTrigger ) );
 
-  setZoneHandler( NewDiscovery, "NewDiscovery", &GameConnection::newDiscoveryHandler );
+  setZoneHandler( NewDiscovery, "NewDiscovery", &GameConnection::newDiscoveryHandler, sizeof( Client::FFXIVIpcNewDiscovery ) );
 
-  setZoneHandler( ActionRequest, "ActionRequest", &GameConnection::actionRequest );
-  setZoneHandler( SelectGroundActionRequest, "SelectGroundActionRequest", &GameConnection::selectGroundActionRequest );
+  setZoneHandler( ActionRequest, "ActionRequest", &GameConnection::actionRequest, sizeof( Client::FFXIVIpcActionRequest ), PacketRateClass::Frequent );
+  setZoneHandler( SelectGroundActionRequest, "SelectGroundActionRequest", &GameConnection::selectGroundActionRequest, sizeof( Client::FFXIVIpcSelectGroundActionRequest ), PacketRateClass::Frequent );
 
-  setZoneHandler( GMCommand, "GMCommand", &GameConnection::gmCommandHandler );
-  setZoneHandler( GMCommandName, "GMCommandName", &GameConnection::gmCommandNameHandler );
+  setZoneHandler( GMCommand, "GMCommand", &GameConnection::gmCommandHandler, sizeof( Client::FFXIVIpcGmCommand ) );
+  setZoneHandler( GMCommandName, "GMCommandName", &GameConnection::gmCommandNameHandler, sizeof( Client::FFXIVIpcGmCommandName ) );
 
-  setZoneHandler( Move, "Move", &GameConnection::moveHandler );
+  setZoneHandler( Move, "Move", &GameConnection::moveHandler, sizeof( Client::FFXIVIpcUpdatePosition ), PacketRateClass::Frequent );
 
-  setZoneHandler( ClientItemOperation, "ItemOperation", &GameConnection::itemOperation );
+  setZoneHandler( ClientItemOperation, "ItemOperation", &GameConnection::itemOperation, sizeof( Client::FFXIVIpcClientInventoryItemOperation ) );
 
-  setZoneHandler( BuildPresetHandler, "BuildPresetHandler", &GameConnection::buildPresetHandler );
-  setZoneHandler( ClientZoneIpcType::HousingHouseName, "HousingHouseName", &GameConnection::landRenameHandler );
-  setZoneHandler( ClientZoneIpcType::HousingGreeting, "HousingUpdateHouseGreeting", &GameConnection::housingUpdateGreetingHandler );
-  setZoneHandler( HousingPlaceYardItem, "HousingPlaceYardItem", &GameConnection::reqPlaceHousingItem );
+  setZoneHandler( BuildPresetHandler, "BuildPresetHandler", &GameConnection::buildPresetHandler, sizeof( Client::FFXIVIpcBuildPresetHandler ) );
+  setZoneHandler( ClientZoneIpcType::HousingHouseName, "HousingHouseName", &GameConnection::landRenameHandler, sizeof( Client::FFXIVIpcHousingHouseName ) );
+  setZoneHandler( ClientZoneIpcType::HousingGreeting, "HousingUpdateHouseGreeting", &GameConnection::housingUpdateGreetingHandler, sizeof( Client::FFXIVIpcHousingGreeting ) );
+  setZoneHandler( HousingPlaceYardItem, "HousingPlaceYardItem", &GameConnection::reqPlaceHousingItem, sizeof( Client::FFXIVIpcHousingPlaceYardItem ) );
   setZoneHandler( HousingExteriorChange, "HousingExteriorChange", &GameConnection::reqMoveHousingItem );
 
-  setZoneHandler( StartTalkEvent, "StartTalkEvent", &GameConnection::eventHandlerTalk );
-  setZoneHandler( StartEmoteEvent, "StartEmoteEvent", &GameConnection::eventHandlerEmote );
-  setZoneHandler( StartWithinRangeEvent, "StartWithinRangeEvent", &GameConnection::eventHandlerWithinRange );
-  setZoneHandler( StartOutsideRangeEvent, "StartOutsideRangeEvent", &GameConnection::eventHandlerOutsideRange );
-  setZoneHandler( StartEnterTerritoryEvent, "StartEnterTerritoryEvent", &GameConnection::eventHandlerEnterTerritory );
-
-  setZoneHandler( ReturnEventSceneHeader, "ReturnEventSceneHeader", &GameConnection::returnEventSceneHeader );
-  setZoneHandler( ReturnEventScene2, "ReturnEventScene2", &GameConnection::returnEventScene2 );
-  setZoneHandler( ReturnEventScene4, "ReturnEventScene4", &GameConnection::returnEventScene4 );
-  setZoneHandler( ReturnEventScene8, "ReturnEventScene8", &GameConnection::returnEventScene8 );
-  setZoneHandler( ReturnEventScene16, "ReturnEventScene16", &GameConnection::returnEventScene16 );
-  setZoneHandler( ReturnEventScene32, "ReturnEventScene32", &GameConnection::returnEventScene32 );
-  setZoneHandler( ReturnEventScene64, "ReturnEventScene64", &GameConnection::returnEventScene64 );
-  setZoneHandler( ReturnEventScene128, "ReturnEventScene128", &GameConnection::returnEventScene128 );
-  setZoneHandler( ReturnEventScene255, "ReturnEventScene255", &GameConnection::returnEventScene255 );
-
-  setZoneHandler( YieldEventSceneHeader, "YieldEventSceneHeader", &GameConnection::yieldEventSceneHeader );
-  setZoneHandler( YieldEventScene2, "YieldEventScene2", &GameConnection::yieldEventScene2 );
-  setZoneHandler( YieldEventScene4, "YieldEventScene4", &GameConnection::yieldEventScene4 );
-  setZoneHandler( YieldEventScene8, "YieldEventScene8", &GameConnection::yieldEventScene8 );
-  setZoneHandler( YieldEventScene16, "YieldEventScene16", &GameConnection::yieldEventScene16 );
-  setZoneHandler( YieldEventScene32, "YieldEventScene32", &GameConnection::yieldEventScene32 );
-  setZoneHandler( YieldEventScene64, "YieldEventScene64", &GameConnection::yieldEventScene64 );
-  setZoneHandler( YieldEventScene128, "YieldEventScene128", &GameConnection::yieldEventScene128 );
-  setZoneHandler( YieldEventScene255, "YieldEventScene255", &GameConnection::yieldEventScene255 );
-
-  setZoneHandler( StartUIEvent, "StartUIEvent", &GameConnection::startUiEvent );
-
-  setZoneHandler( YieldEventSceneString8, "YieldEventSceneString8", &GameConnection::yieldEventString );
-  setZoneHandler( YieldEventSceneString16, "YieldEventSceneString16", &GameConnection::yieldEventString );
-  setZoneHandler( YieldEventSceneString32, "YieldEventSceneString32", &GameConnection::yieldEventString );
-
-  setZoneHandler( YieldEventSceneIntAndString, "YieldEventSceneIntAndString", &GameConnection::yieldEventSceneIntAndString );
+  setZoneHandler( StartTalkEvent, "StartTalkEvent", &GameConnection::eventHandlerTalk, sizeof( Client::FFXIVIpcEventHandlerTalk ) );
+  setZoneHandler( StartEmoteEvent, "StartEmoteEvent", &GameConnection::eventHandlerEmote, sizeof( Client::FFXIVIpcEventHandlerEmote ) );
+  setZoneHandler( StartWithinRangeEvent, "StartWithinRangeEvent", &GameConnection::eventHandlerWithinRange, sizeof( Client::FFXIVIpcEventHandlerWithinRange ) );
+  setZoneHandler( StartOutsideRangeEvent, "StartOutsideRangeEvent", &GameConnection::eventHandlerOutsideRange, sizeof( Client::FFXIVIpcEventHandlerOutsideRange ) );
+  setZoneHandler( StartEnterTerritoryEvent, "StartEnterTerritoryEvent", &GameConnection::eventHandlerEnterTerritory, sizeof( Client::FFXIVIpcEnterTerritoryHandler ) );
+
+  setZoneHandler( ReturnEventSceneHeader, "ReturnEventSceneHeader", &GameConnection::returnEventSceneHeader, sizeof( Client::FFXIVIpcReturnEventSceneHeader ) );
+  setZoneHandler( ReturnEventScene2, "ReturnEventScene2", &GameConnection::returnEventScene2, sizeof( Client::FFXIVIpcReturnEventScene2 ) );
+  setZoneHandler( ReturnEventScene4, "ReturnEventScene4", &GameConnection::returnEventScene4, sizeof( Client::FFXIVIpcReturnEventScene4 ) );
+  setZoneHandler( ReturnEventScene8, "ReturnEventScene8", &GameConnection::returnEventScene8, sizeof( Client::FFXIVIpcReturnEventScene8 ) );
+  setZoneHandler( ReturnEventScene16, "ReturnEventScene16", &GameConnection::returnEventScene16, sizeof( Client::FFXIVIpcReturnEventScene16 ) );
+  setZoneHandler( ReturnEventScene32, "ReturnEventScene32", &GameConnection::returnEventScene32, sizeof( Client::FFXIVIpcReturnEventScene32 ) );
+  setZoneHandler( ReturnEventScene64, "ReturnEventScene64", &GameConnection::returnEventScene64, sizeof( Client::FFXIVIpcReturnEventScene64 ) );
+  setZoneHandler( ReturnEventScene128, "ReturnEventScene128", &GameConnection::returnEventScene128, sizeof( Client::FFXIVIpcReturnEventScene128 ) );
+  setZoneHandler( ReturnEventScene255, "ReturnEventScene255", &GameConnection::returnEventScene255, sizeof( Client::FFXIVIpcReturnEventScene255 ) );
+
+  setZoneHandler( YieldEventSceneHeader, "YieldEventSceneHeader", &GameConnection::yieldEventSceneHeader, sizeof( Client::FFXIVIpcYieldEventSceneHeader ) );
+  setZoneHandler( YieldEventScene2, "YieldEventScene2", &GameConnection::yieldEventScene2, sizeof( Client::FFXIVIpcYieldEventScene2 ) );
+  setZoneHandler( YieldEventScene4, "YieldEventScene4", &GameConnection::yieldEventScene4, sizeof( Client::FFXIVIpcYieldEventScene4 ) );
+  setZoneHandler( YieldEventScene8, "YieldEventScene8", &GameConnection::yieldEventScene8, sizeof( Client::FFXIVIpcYieldEventScene8 ) );
+  setZoneHandler( YieldEventScene16, "YieldEventScene16", &GameConnection::yieldEventScene16, sizeof( Client::FFXIVIpcYieldEventScene16 ) );
+  setZoneHandler( YieldEventScene32, "YieldEventScene32", &GameConnection::yieldEventScene32, sizeof( Client::FFXIVIpcYieldEventScene32 ) );
+  setZoneHandler( YieldEventScene64, "YieldEventScene64", &GameConnection::yieldEventScene64, sizeof( Client::FFXIVIpcYieldEventScene64 ) );
+  setZoneHandler( YieldEventScene128, "YieldEventScene128", &GameConnection::yieldEventScene128, sizeof( Client::FFXIVIpcYieldEventScene128 ) );
+  setZoneHandler( YieldEventScene255, "YieldEventScene255", &GameConnection::yieldEventScene255, sizeof( Client::FFXIVIpcYieldEventScene255 ) );
+
+  setZoneHandler( StartUIEvent, "StartUIEvent", &GameConnection::startUiEvent, sizeof( Client::FFXIVIpcShopEventHandler ) );
+
+  setZoneHandler( YieldEventSceneString8, "YieldEventSceneString8", &GameConnection::yieldEventString, sizeof( Client::FFXIVIpcYieldEventSceneString8 ) );
+  setZoneHandler( YieldEventSceneString16, "YieldEventSceneString16", &GameConnection::yieldEventString, sizeof( Client::FFXIVIpcYieldEventSceneString16 ) );
+  setZoneHandler( YieldEventSceneString32, "YieldEventSceneString32", &GameConnection::yieldEventString, sizeof( Client::FFXIVIpcYieldEventSceneString32 ) );
+
+  setZoneHandler( YieldEventSceneIntAndString, "YieldEventSceneIntAndString", &GameConnection::yieldEventSceneIntAndString, sizeof( Client::FFXIVIpcYieldEventSceneIntAndString ) );
 
   setZoneHandler( RequestPenalties, "RequestPenalties", &GameConnection::cfRequestPenalties );
   setZoneHandler( RequestBonus, "RequestBonus", &GameConnection::requestBonus );
-  setZoneHandler( FindContent, "FindContent", &GameConnection::findContent );
-  setZoneHandler( Find5Contents, "Find5Contents", &GameConnection::find5Contents );
-  setZoneHandler( FindContentAsRandom, "FindContentAsRandom", &GameConnection::findContentAsRandom );
+  setZoneHandler( FindContent, "FindContent", &GameConnection::findContent, sizeof( Client::FFXIVIpcFindContent ) );
+  setZoneHandler( Find5Contents, "Find5Contents", &GameConnection::find5Contents, sizeof( Client::FFXIVIpcFind5Contents ) );
+  setZoneHandler( FindContentAsRandom, "FindContentAsRandom", &GameConnection::findContentAsRandom, sizeof( Client::FFXIVIpcFindContentAsRandom ) );
   setZoneHandler( CFCommenceHandler, "CFDutyAccepted", &GameConnection::cfDutyAccepted );
-  setZoneHandler( CancelFindContent, "CancelFindContent", &GameConnection::cancelFindContent );
-  setZoneHandler( AcceptContent, "AcceptContent", &GameConnection::acceptContent );
+  setZoneHandler( CancelFindContent, "CancelFindContent", &GameConnection::cancelFindContent, sizeof( Client::FFXIVIpcCancelFindContent ) );
+  setZoneHandler( AcceptContent, "AcceptContent", &GameConnection::acceptContent, sizeof( Client::FFXIVIpcAcceptContent ) );
 
-  setZoneHandler( ClientZoneIpcType::Config, "Config", &GameConnection::configHandler );
+  setZoneHandler( ClientZoneIpcType::Config, "Config", &GameConnection::configHandler, sizeof( Client::FFXIVIpcConfig ) );
 
-  setZoneHandler( CatalogSearch, "CatalogSearch", &GameConnection::catalogSearch );
+  setZoneHandler( CatalogSearch, "CatalogSearch", &GameConnection::catalogSearch, sizeof( Client::FFXIVIpcCatalogSearch ), PacketRateClass::Heavy );
 
-  setZoneHandler( GearSetEquip, "GearSetEquip", &GameConnection::gearSetEquip );
+  setZoneHandler( GearSetEquip, "GearSetEquip", &GameConnection::gearSetEquip, sizeof( Client::FFXIVIpcGearSetEquip ) );
 
-  setZoneHandler( MarketBoardRequestItemListingInfo, "MarketBoardRequestItemListingInfo", &GameConnection::marketBoardRequestItemInfo );
-  setZoneHandler( MarketBoardRequestItemListings, "MarketBoardRequestItemListings", &GameConnection::marketBoardRequestItemListings );
+  setZoneHandler( MarketBoardRequestItemListingInfo, "MarketBoardRequestItemListingInfo", &GameConnection::marketBoardRequestItemInfo, sizeof( Client::FFXIVIpcMarketBoardRequestItemListingInfo ), PacketRateClass::Heavy );
+  setZoneHandler( MarketBoardRequestItemListings, "MarketBoardRequestItemListings", &GameConnection::marketBoardRequestItemListings, sizeof( Client::FFXIVIpcMarketBoardRequestItemListings ), PacketRateClass::Heavy );
 
-  setChatHandler( ClientChatIpcType::ChatTo, "ChatTo", &GameConnection::tellHandler );
-  setChatHandler( ClientChatIpcType::ChatToChannel, "ChatToChannel", &GameConnection::chatToChannelHandler );
+  setChatHandler( ClientChatIpcType::ChatTo, "ChatTo", &GameConnection::tellHandler, sizeof( Client::FFXIVIpcChatTo ), PacketRateClass::Chat );
+  setChatHandler( ClientChatIpcType::ChatToChannel, "ChatToChannel", &GameConnection::chatToChannelHandler, sizeof( Client::FFXIVIpcChatToChannel ), PacketRateClass::Chat );
 
   setZoneHandler( GetFcStatus, "GetFcStatus", &GameConnection::getFcStatus );
-  setZoneHandler( GetFcProfile, "GetFcProfile", &GameConnection::getFcProfile );
+  setZoneHandler( GetFcProfile, "GetFcProfile", &GameConnection::getFcProfile, sizeof( Client::FFXIVIpcGetFcProfile ) );
 
   setZoneHandler( GetRequestItemList, "GetRequestItemList", &GameConnection::getRequestItemListHandler );
 
-  setZoneHandler( Invite, "Invite", &GameConnection::inviteHandler );
-  setZoneHandler( InviteReply, "InviteReply", &GameConnection::inviteReplyHandler );
+  setZoneHandler( Invite, "Invite", &GameConnection::inviteHandler, sizeof( Client::FFXIVIpcInvite ) );
+  setZoneHandler( InviteReply, "InviteReply", &GameConnection::inviteReplyHandler, sizeof( Client::FFXIVIpcInviteReply ) );
 
   setZoneHandler( PcPartyLeave, "PcPartyLeave", &GameConnection::pcPartyLeaveHandler );
   setZoneHandler( PcPartyDisband, "PcPartyDisband", &GameConnection::pcPartyDisbandHandler );
-  setZoneHandler( PcPartyKick, "PcPartyKick", &GameConnection::pcPartyKickHandler );
-  setZoneHandler( PcPartyChangeLeader, "PcPartyChangeLeader", &GameConnection::pcPartyChangeLeaderHandler );
+  setZoneHandler( PcPartyKick, "PcPartyKick", &GameConnection::pcPartyKickHandler, sizeof( Client::FFXIVIpcPcPartyKick ) );
+  setZoneHandler( PcPartyChangeLeader, "PcPartyChangeLeader", &GameConnection::pcPartyChangeLeaderHandler, sizeof( Client::FFXIVIpcPcPartyChangeLeader ) );
 
-  setZoneHandler( FriendlistRemove, "FriendlistRemove", &GameConnection::friendlistRemoveHandler );
-  setZoneHandler( SetFriendlistGroup, "SetFriendlistGroup", &GameConnection::setFriendlistGroupHandler );
+  setZoneHandler( FriendlistRemove, "FriendlistRemove", &GameConnection::friendlistRemoveHandler, sizeof( Client::FFXIVIpcFriendlistRemove ) );
+  setZoneHandler( SetFriendlistGroup, "SetFriendlistGroup", &GameConnection::setFriendlistGroupHandler, sizeof( Client::FFXIVIpcSetFriendlistGroup ) );
 
-  setZoneHandler( GetBlacklist, "GetBlacklist", &GameConnection::getBlacklistHandler );
-  setZoneHandler( BlacklistAdd, "BlacklistAdd", &GameConnection::blacklistAddHandler );
-  setZoneHandler( BlacklistRemove, "BlacklistRemove", &GameConnection::blacklistRemoveHandler );
+  setZoneHandler( GetBlacklist, "GetBlacklist", &GameConnection::getBlacklistHandler, sizeof( Client::FFXIVIpcGetBlacklist ), PacketRateClass::Heavy );
+  setZoneHandler( BlacklistAdd, "BlacklistAdd", &GameConnection::blacklistAddHandler, sizeof( Client::FFXIVIpcBlacklistAdd ) );
+  setZoneHandler( BlacklistRemove, "BlacklistRemove", &GameConnection::blacklistRemoveHandler, sizeof( Client::FFXIVIpcBlacklistRemove ) );
 
   setZoneHandler( GetFcInviteList, "GetFcInviteList", &GameConnection::getFcInviteListHandler );
 }
 
-GameConnection::~GameConnection() = default;
-
-
 // overwrite the parents onConnect for our game socket needs
 void GameConnection::onAccept( const std::string& host, uint16_t port )
 {
@@ -239,72 +247,203 @@ void GameConnection::queueInPacket( Packets::FFXIVARR_PACKET_RAW inPacket )
 
 void GameConnection::queueOutPacket( Packets::FFXIVPacketBasePtr outPacket )
 {
+  if( !outPacket )
+    return;
+
+  auto pendingBytes = m_pendingBytes.fetch_add( outPacket->getSize(), std::memory_order_relaxed ) + outPacket->getSize();
   m_outQueue.push( std::move( outPacket ) );
+
+  if( pendingBytes > m_outQueueBudget && !m_isCongested.exchange( true, std::memory_order_relaxed ) )
+    Logger::warn( "[{0}] Outgoing queue above {1} bytes, client is congested", m_pSession ? m_pSession->getId() : 0, m_outQueueBudget );
 }
 
 void GameConnection::queueOutPacket( std::vector< Packets::FFXIVPacketBasePtr > vector )
 {
   for( auto& packet : vector )
   {
-    m_outQueue.push( packet );
+    queueOutPacket( std::move( packet ) );
+  }
+}
+
+bool GameConnection::isCongested() const
+{
+  return m_isCongested.load( std::memory_order_relaxed );
+}
+
+void GameConnection::onSend( const std::vector< uint8_t >& buffer )
+{
+  auto size = static_cast< int64_t >( buffer.size() );
+  auto pendingBytes = m_pendingBytes.fetch_sub( size, std::memory_order_relaxed ) - size;
+
+  if( pendingBytes <= m_outQueueBudget / 2 && m_isCongested.load( std::memory_order_relaxed ) )
+    m_isCongested.store( false, std::memory_order_relaxed );
+}
+
+void GameConnection::HandlerTable::set( uint16_t opcode, const char* name, Handler pHandler, uint32_t minSize, PacketRateClass rateClass )
+{
+  auto index = m_index[ opcode ];
+  if( index == 0 )
+  {
+    m_entries.emplace_back();
+    index = static_cast< uint16_t >( m_entries.size() );
+    m_index[ opcode ] = index;
   }
+
+  auto& entry = m_entries[ index - 1 ];
+  entry.opcode = opcode;
+  entry.name = name;
+  entry.pHandler = pHandler;
+  entry.minSize = minSize;
+  entry.rateClass = rateClass;
+}
+
+std::vector< PacketHandlerStats > GameConnection::HandlerTable::getStats() const
+{
+  std::vector< PacketHandlerStats > stats;
+  stats.reserve( m_entries.size() );
+  for( const auto& entry : m_entries )
+    stats.push_back( { entry.opcode, entry.name, entry.handled.load( std::memory_order_relaxed ), entry.rejected.load( std::memory_order_relaxed ) } );
+  return stats;
+}
+
+namespace
+{
+  // both tables are filled together the first time either is used
+  template< class Table, class Register >
+  std::pair< Table, Table >& getHandlerTables( Register registerHandlers )
+  {
+    static auto pTables = [ registerHandlers ]()
+    {
+      auto pTables = std::make_unique< std::pair< Table, Table > >();
+      registerHandlers( pTables->first, pTables->second );
+      return pTables;
+    }();
+    return *pTables;
+  }
+}
+
+GameConnection::HandlerTable& GameConnection::getZoneHandlers()
+{
+  return getHandlerTables< HandlerTable >( &GameConnection::registerHandlers ).first;
+}
+
+GameConnection::HandlerTable& GameConnection::getChatHandlers()
+{
+  return getHandlerTables< HandlerTable >( &GameConnection::registerHandlers ).second;
+}
+
+std::vector< PacketHandlerStats > GameConnection::getZoneHandlerStats()
+{
+  return getZoneHandlers().getStats();
+}
+
+std::vector< PacketHandlerStats > GameConnection::getChatHandlerStats()
+{
+  return getChatHandlers().getStats();
+}
+
+bool GameConnection::validatePacket( HandlerEntry& entry, const Packets::FFXIVARR_PACKET_RAW& packet )
+{
+  // too short for the struct the handler reads, it would read past the received data
+  if( packet.data.size() < sizeof( FFXIVARR_IPC_HEADER ) + entry.minSize )
+  {
+    entry.rejected.fetch_add( 1, std::memory_order_relaxed );
+    Logger::debug( "[{0}] Dropped {1} ( {2:04X} ), size {3} below {4}", m_pSession->getId(), entry.name, entry.opcode,
+                   packet.data.size(), sizeof( FFXIVARR_IPC_HEADER ) + entry.minSize );
+    return false;
+  }
+
+  auto now = Common::Util::getTimeMs();
+  if( now - m_rateWindowStart >= 1000 )
+  {
+    m_rateWindowStart = now;
+    m_rateCounts.fill( 0 );
+  }
+
+  // packets per second and class, generous enough to never be hit by a regular client
+  static const std::array< uint32_t, static_cast< size_t >( PacketRateClass::Count ) > rateLimits = { 50, 100, 10, 10 };
+
+  auto rateClass = static_cast< size_t >( entry.rateClass );
+  if( ++m_rateCounts[ rateClass ] > rateLimits[ rateClass ] )
+  {
+    entry.rejected.fetch_add( 1, std::memory_order_relaxed );
+    if( m_rateCounts[ rateClass ] == rateLimits[ rateClass ] + 1 )
+      Logger::warn( "[{0}] Rate limit for {1} ( {2:04X} ) hit, dropping packets", m_pSession->getId(), entry.name, entry.opcode );
+    return false;
+  }
+
+  return true;
 }
 
 void GameConnection::handleZonePacket( Packets::FFXIVARR_PACKET_RAW& pPacket )
 {
   uint16_t opcode = Util::getOpCode( pPacket );
-  auto it = m_zoneHandlerMap.find( opcode );
+  auto pEntry = getZoneHandlers().get( opcode );
 
-  if( it != m_zoneHandlerMap.end() )
+  if( pEntry )
   {
-    auto itStr = m_zoneHandlerStrMap.find( opcode );
-    std::string name = itStr != m_zoneHandlerStrMap.end() ? itStr->second : "unknown";
+    if( !validatePacket( *pEntry, pPacket ) )
+      return;
+
+    pEntry->handled.fetch_add( 1, std::memory_order_relaxed );
+
     // dont display packet notification if it is a ping or pos update, don't want the spam
     if( opcode != Sync && opcode != Client::Move )
-      Logger::debug( "[{0}] Zone IPC : {1} ( {2:04X} )", m_pSession->getId(), name, opcode );
+      Logger::debug( "[{0}] Zone IPC : {1} ( {2:04X} )", m_pSession->getId(), pEntry->name, opcode );
 
-    ( this->*( it->second ) )( pPacket, *m_pSession->getPlayer() );
+    ( this->*( pEntry->pHandler ) )( pPacket, *m_pSession->getPlayer() );
   }
   else
   {
+    getZoneHandlers().m_unknown.fetch_add( 1, std::memory_order_relaxed );
+
     auto packetName = zonePacketToString( opcode );
     auto player = m_pSession->getPlayer();
     PlayerMgr::sendUrgent( *player, "Unimplemented zone IPC: {} ({:04X}) len: {}", packetName, opcode, pPacket.data.size() );
 
     Logger::debug( "[{}] Unimplemented World IPC : {} ({:04X})", m_pSession->getId(), packetName, opcode );
 
-    Logger::debug(
-      "Dump:\n{0}",
-      Util::binaryToHexDump( const_cast< uint8_t* >( &pPacket.data[ 0 ] ),
-      static_cast< uint16_t >( pPacket.segHdr.size - 0x10 ) )
-    );
+    if( Logger::isDebugEnabled() )
+    {
+      Logger::debug(
+        "Dump:\n{0}",
+        Util::binaryToHexDump( const_cast< uint8_t* >( &pPacket.data[ 0 ] ),
+        static_cast< uint16_t >( pPacket.segHdr.size - 0x10 ) )
+      );
+    }
   }
 }
 
 void GameConnection::handleChatPacket( Packets::FFXIVARR_PACKET_RAW& pPacket )
 {
   uint16_t opcode = Util::getOpCode( pPacket );
-  auto it = m_chatHandlerMap.find( opcode );
+  auto pEntry = getChatHandlers().get( opcode );
 
-  if( it != m_chatHandlerMap.end() )
+  if( pEntry )
   {
-    auto itStr = m_chatHandlerStrMap.find( opcode );
-    std::string name = itStr != m_chatHandlerStrMap.end() ? itStr->second : "Unknown";
-    // dont display packet notification if it is a ping or pos update, don't want the spam
+    if( !validatePacket( *pEntry, pPacket ) )
+      return;
 
-    Logger::debug( "[{0}] Handling Chat IPC : {1} ( {2:04X} )", m_pSession->getId(), name, opcode );
+    pEntry->handled.fetch_add( 1, std::memory_order_relaxed );
 
-    ( this->*( it->second ) )( pPacket, *m_pSession->getPlayer() );
+    Logger::debug( "[{0}] Handling Chat IPC : {1} ( {2:04X} )", m_pSession->getId(), pEntry->name, opcode );
+
+    ( this->*( pEntry->pHandler ) )( pPacket, *m_pSession->getPlayer() );
   }
   else
   {
+    getChatHandlers().m_unknown.fetch_add( 1, std::memory_order_relaxed );
+
     Logger::debug( "[{0}] Undefined Chat IPC : Unknown ( {1:04X} )", m_pSession->getId(), opcode );
 
-    Logger::debug(
-      "Dump:\n{0}",
-      Util::binaryToHexDump( const_cast< uint8_t* >( &pPacket.data[ 0 ] ),
-        static_cast< uint16_t >( pPacket.segHdr.size ) )
-    );
+    if( Logger::isDebugEnabled() )
+    {
+      Logger::debug(
+        "Dump:\n{0}",
+        Util::binaryToHexDump( const_cast< uint8_t* >( &pPacket.data[ 0 ] ),
+          static_cast< uint16_t >( pPacket.segHdr.size ) )
+      );
+    }
   }
 }
 
@@ -334,49 +473,64 @@ void GameConnection::sendPackets( Packets::PacketContainer* pPacket )
   std::vector< uint8_t > sendBuffer;
 
   pPacket->fillSendBuffer( sendBuffer );
+  m_pendingBytes.fetch_add( static_cast< int64_t >( sendBuffer.size() ), std::memory_order_relaxed );
   send( sendBuffer );
 }
 
 void GameConnection::processInQueue()
 {
   // handle the incoming game packets
-  while( m_inQueue.size() )
-  {
-    auto pPacket = m_inQueue.pop();
-    handlePacket( pPacket );
-  }
+  if( m_inQueue.drain( m_inPackets ) == 0 )
+    return;
+
+  for( auto& packet : m_inPackets )
+    handlePacket( packet );
+
+  m_inPackets.clear();
 }
 
 void GameConnection::processOutQueue()
 {
-  if( m_outQueue.size() < 1 )
+  if( m_outQueue.drain( m_outPackets ) == 0 )
     return;
 
+  auto& metricMgr = Common::Service< MetricMgr >::ref();
+  int64_t queuedSize = 0;
   size_t totalSize = 0;
 
   // create a new packet container
   PacketContainer pRP = PacketContainer( m_pSession->getId() );
 
-  // get next packet off the queue
-  while( auto pPacket = m_outQueue.pop() )
+  for( auto& pPacket : m_outPackets )
   {
-    if( pPacket->getSize() == 0 )
+    queuedSize += pPacket->getSize();
+
+    // an empty packet ends the current set
+    if( pPacket->getSize() != 0 )
     {
-      Logger::debug( "end of packet set" );
-      break;
-    }
+      if( pPacket->getSegmentType() == SEGMENTTYPE_IPC )
+        metricMgr.onPacketOut( pPacket->getIpcType() );
 
-    pRP.addPacket( pPacket );
-    totalSize += pPacket->getSize();
+      pRP.addPacket( pPacket );
+      totalSize += pPacket->getSize();
+    }
 
     // todo: figure out a good max set size and make it configurable
-    if( totalSize > 10000 )
-      break;
+    if( totalSize > 0 && ( totalSize > 10000 || pPacket->getSize() == 0 ) )
+    {
+      sendPackets( &pRP );
+      pRP = PacketContainer( m_pSession->getId() );
+      totalSize = 0;
+    }
   }
 
   if( totalSize > 0 )
     sendPackets( &pRP );
 
+  m_outPackets.clear();
+
+  // the sent containers are accounted for until written, see onSend
+  m_pendingBytes.fetch_sub( queuedSize, std::memory_order_relaxed );
 }
 
 void GameConnection::sendSinglePacket( Packets::FFXIVPacketBasePtr pPacket )
@@ -4,7 +4,10 @@
 #include <Network/Connection.h>
 
 #include <Network/CommonNetwork.h>
-#include <Util/LockedQueue.h>
+#include <Util/MpscQueue.h>
+#include <array>
+#include <atomic>
+#include <deque>
 #include <map>
 
 #include "ForwardsZone.h"
@@ -28,6 +31,24 @@ namespace Sapphire::Network
     None
   };
 
+  /*! inbound packets are limited per connection and class */
+  enum class PacketRateClass : uint8_t
+  {
+    Default,
+    Frequent,
+    Chat,
+    Heavy,
+    Count
+  };
+
+  struct PacketHandlerStats
+  {
+    uint16_t opcode;
+    const char* name;
+    uint64_t handled;
+    uint64_t rejected;
+  };
+
   class GameConnection : public Network::Connection
   {
 
@@ -35,25 +56,75 @@ namespace Sapphire::Network
     typedef void ( GameConnection::* Handler )( const Network::Packets::FFXIVARR_PACKET_RAW& inPacket,
                                                 Entity::Player& player );
 
-    using HandlerMap = std::map< uint16_t, Handler >;
-    using HandlerStrMap = std::map< uint16_t, std::string >;
-
-    AcceptorPtr m_pAcceptor;
+    struct HandlerEntry
+    {
+      uint16_t opcode{ 0 };
+      Handler pHandler{ nullptr };
+      const char* name{ nullptr };
+      /*! payload bytes following the ipc header the handler reads */
+      uint32_t minSize{ 0 };
+      PacketRateClass rateClass{ PacketRateClass::Default };
+      std::atomic< uint64_t > handled{ 0 };
+      std::atomic< uint64_t > rejected{ 0 };
+    };
+
+    /*! opcode indexed handler table, built once and shared by all connections */
+    class HandlerTable
+    {
+    public:
+      void set( uint16_t opcode, const char* name, Handler pHandler, uint32_t minSize, PacketRateClass rateClass );
+
+      /*! @return nullptr if no handler is registered for opcode */
+      HandlerEntry* get( uint16_t opcode )
+      {
+        auto index = m_index[ opcode ];
+        return index != 0 ? &m_entries[ index - 1 ] : nullptr;
+      }
+
+      std::vector< PacketHandlerStats > getStats() const;
+
+      std::atomic< uint64_t > m_unknown{ 0 };
+
+    private:
+      /*! entry index + 1, 0 if unset */
+      std::array< uint16_t, 0x10000 > m_index{};
+      std::deque< HandlerEntry > m_entries;
+    };
 
     // handler for game packets ( main type 0x03, connection type 1 )
-    HandlerMap m_zoneHandlerMap;
-    HandlerStrMap m_zoneHandlerStrMap;
+    static HandlerTable& getZoneHandlers();
 
     // handler for game packets ( main type 0x03, connection type 2 )
-    HandlerMap m_chatHandlerMap;
-    HandlerStrMap m_chatHandlerStrMap;
+    static HandlerTable& getChatHandlers();
+
+    static void registerHandlers( HandlerTable& zoneHandlers, HandlerTable& chatHandlers );
+
+    /*!
+     * @brief checks size and rate limit of a packet before it is dispatched
+     * @return false if the packet has to be dropped
+     */
+    bool validatePacket( HandlerEntry& entry, const Network::Packets::FFXIVARR_PACKET_RAW& packet );
+
+    AcceptorPtr m_pAcceptor;
 
     World::SessionPtr m_pSession;
 
-    Common::Util::LockedQueue< Network::Packets::FFXIVARR_PACKET_RAW > m_inQueue;
-    Common::Util::LockedQueue< Packets::FFXIVPacketBasePtr > m_outQueue;
+    /*! packets per rate class within the current one second window */
+    std::array< uint32_t, static_cast< size_t >( PacketRateClass::Count ) > m_rateCounts{};
+    uint64_t m_rateWindowStart{ 0 };
+
+    // filled by the network thread and other sessions, drained at once by the world thread
+    Common::Util::MpscQueue< Network::Packets::FFXIVARR_PACKET_RAW > m_inQueue{ 256 };
+    Common::Util::MpscQueue< Packets::FFXIVPacketBasePtr > m_outQueue{ 1024 };
+    std::vector< Network::Packets::FFXIVARR_PACKET_RAW > m_inPackets;
+    std::vector< Packets::FFXIVPacketBasePtr > m_outPackets;
     std::vector< uint8_t > m_packets;
 
+    /*! bytes queued or handed to the socket which are not written yet */
+    std::atomic< int64_t > m_pendingBytes{ 0 };
+    uint32_t m_outQueueBudget{ 0 };
+    std::atomic< bool > m_isCongested{ false };
+
   public:
     ConnectionType m_conType;
 
@@ -70,6 +141,8 @@ namespace Sapphire::Network
 
     void onError( const asio::error_code& error ) override;
 
+    void onSend( const std::vector< uint8_t >& buffer ) override;
+
     void handlePackets( const Packets::FFXIVARR_PACKET_HEADER& ipcHeader,
                         const std::vector< Packets::FFXIVARR_PACKET_RAW >& packetData );
 
@@ -82,6 +155,14 @@ namespace Sapphire::Network
 
     void processOutQueue();
 
+    /*!
+     * @brief the client does not keep up with its outgoing packets
+     *
+     * Set while more than Network.OutQueueBudget bytes wait to be written, packets which are
+     * superseded by the next one (e.g. movement) should not be queued for it in the meantime.
+     */
+    bool isCongested() const;
+
     void handlePacket( Network::Packets::FFXIVARR_PACKET_RAW& pPacket );
 
     void handleZonePacket( Network::Packets::FFXIVARR_PACKET_RAW& pPacket );
@@ -96,6 +177,10 @@ namespace Sapphire::Network
 
     static const char* zonePacketToString( uint32_t opcode );
 
+    /*! handled and rejected packets per registered zone and chat opcode since startup */
+    static std::vector< PacketHandlerStats > getZoneHandlerStats();
+    static std::vector< PacketHandlerStats > getChatHandlerStats();
+
     DECLARE_HANDLER( loginHandler );
 
     DECLARE_HANDLER( setLanguageHandler );
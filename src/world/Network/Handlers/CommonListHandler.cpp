@@ -9,6 +9,7 @@
 #include "Manager/LinkshellMgr.h"
 #include "Manager/PartyMgr.h"
 #include "Manager/PlayerMgr.h"
+#include "Manager/PresenceMgr.h"
 
 #include "Network/GameConnection.h"
 
@@ -70,6 +71,7 @@ void Sapphire::Network::GameConnection::getCommonlistHandler( const Packets::FFX
   // TODO: possibly move lambda func to util
   auto& server = Common::Service< World::WorldServer >::ref();
   auto& playerMgr = Common::Service< World::Manager::PlayerMgr >::ref();
+  auto& presenceMgr = Common::Service< World::Manager::PresenceMgr >::ref();
   const size_t itemsPerPage = 10;
 
   // this func paginates any commonlist entry, associating them with online player data and hierarchy ID (optional)
@@ -85,40 +87,53 @@ void Sapphire::Network::GameConnection::getCommonlistHandler( const Packets::FFX
       }
 
       auto id = idVec[ i ];
-      auto pPlayer = playerMgr.getPlayer( id );
-      
-      if( !pPlayer )
-        continue;
-        
       PlayerEntry entry{};
-      memset( &entry, 0, sizeof( PlayerEntry ) );
-      bool isConnected = pPlayer->isConnected();
 
-      if( isConnected )
+      if constexpr( std::is_same_v< std::decay_t< decltype( id ) >, uint64_t > )
       {
-        entry.TerritoryType = pPlayer->getTerritoryTypeId();
-        entry.TerritoryID = pPlayer->getTerritoryId();
+        // character id lists are served from the presence cache
+        auto pEntry = presenceMgr.getEntry( id );
+        if( !pEntry )
+          continue;
 
-        entry.CurrentClassID = static_cast< uint8_t >( pPlayer->getClass() );
-        entry.SelectClassID = static_cast< uint8_t >( pPlayer->getSearchSelectClass() );
-          
-        entry.CurrentLevel = pPlayer->getLevel();
-        entry.SelectLevel = pPlayer->getLevel();
-        entry.Identity = pPlayer->getGender();
-
-        // GC icon
-        entry.GrandCompanyID = pPlayer->getGc();
-        // client language J = 0, E = 1, D = 2, F = 3
-        entry.Region = 1;
-        // user language settings flag J = 1, E = 2, D = 4, F = 8
-        entry.SelectRegion = pPlayer->getSearchSelectRegion();
-        entry.OnlineStatus = pPlayer->getOnlineStatusMask() | pPlayer->getOnlineStatusCustomMask();
-
-        strcpy( entry.FcTag, "Awoo" );
+        entry = *pEntry;
       }
+      else
+      {
+        auto pPlayer = playerMgr.getPlayer( id );
+
+        if( !pPlayer )
+          continue;
+
+        memset( &entry, 0, sizeof( PlayerEntry ) );
+        bool isConnected = pPlayer->isConnected();
+
+        if( isConnected )
+        {
+          entry.TerritoryType = pPlayer->getTerritoryTypeId();
+          entry.TerritoryID = pPlayer->getTerritoryId();
 
-      entry.CharacterID = pPlayer->getCharacterId();
-      strcpy( entry.CharacterName, pPlayer->getName().c_str() );
+          entry.CurrentClassID = static_cast< uint8_t >( pPlayer->getClass() );
+          entry.SelectClassID = static_cast< uint8_t >( pPlayer->getSearchSelectClass() );
+
+          entry.CurrentLevel = pPlayer->getLevel();
+          entry.SelectLevel = pPlayer->getLevel();
+          entry.Identity = pPlayer->getGender();
+
+          // GC icon
+          entry.GrandCompanyID = pPlayer->getGc();
+          // client language J = 0, E = 1, D = 2, F = 3
+          entry.Region = 1;
+          // user language settings flag J = 1, E = 2, D = 4, F = 8
+          entry.SelectRegion = pPlayer->getSearchSelectRegion();
+          entry.OnlineStatus = pPlayer->getOnlineStatusMask() | pPlayer->getOnlineStatusCustomMask();
+
+          strcpy( entry.FcTag, "Awoo" );
+        }
+
+        entry.CharacterID = pPlayer->getCharacterId();
+        strcpy( entry.CharacterName, pPlayer->getName().c_str() );
+      }
 
       if( !hierarchyVec.empty() )
       {
@@ -7,6 +7,7 @@
 #include <Network/PacketContainer.h>
 #include <Network/PacketDef/Chat/ServerChatDef.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 
 #include <unordered_map>
 #include <Network/PacketDef/Zone/ClientZoneDef.h>
@@ -33,6 +34,7 @@
 #include "Manager/TerritoryMgr.h"
 #include "Manager/ChatChannelMgr.h"
 #include "Manager/PlayerMgr.h"
+#include "Manager/PresenceMgr.h"
 #include "Manager/WarpMgr.h"
 #include "Manager/ItemMgr.h"
 #include "Manager/FreeCompanyMgr.h"
@@ -62,6 +64,7 @@ void Sapphire::Network::GameConnection::setProfileHandler( const Packets::FFXIVA
   const auto selectRegion = packet.data().Region;
 
   player.setSearchInfo( selectRegion, 0, packet.data().SearchComment );
+  Common::Service< World::Manager::PresenceMgr >::ref().onProfileChanged( player );
 
   if( player.isNewAdventurer() && !( status & ( static_cast< uint64_t >( 1 ) << static_cast< uint8_t >( OnlineStatus::NewAdventurer ) ) ) )
     // mark player as not new adventurer anymore
@@ -235,7 +238,7 @@ void Sapphire::Network::GameConnection::moveHandler( const Packets::FFXIVARR_PAC
     unknownRotation = 0x7F;
   }
 
-  uint64_t currentTime = Common::Util::getTimeMs();
+  uint64_t currentTime = Common::Util::FrameClock::getTimeMs();
 
   player.m_lastMoveTime = currentTime;
   player.m_lastMoveflag = animationType;
@@ -247,7 +250,7 @@ void Sapphire::Network::GameConnection::moveHandler( const Packets::FFXIVARR_PAC
   // todo: probably move this into a builder and send the packet on Player::update if( m_dirtyFlags & DirtyFlag::Position )
   //auto movePacket = std::make_shared< MoveActorPacket >( player, headRotation, animationType, animationState, animationSpeed, unknownRotation );
   auto movePacket = std::make_shared< MoveActorPacket >( player, headRotation, data.flag, data.flag2, animationSpeed, unknownRotation );
-  server().queueForPlayers( player.getInRangePlayerIds(), movePacket );
+  server().queueDroppableForPlayers( player.getInRangePlayerIds(), movePacket );
 }
 
 void Sapphire::Network::GameConnection::configHandler( const Packets::FFXIVARR_PACKET_RAW& inPacket, Entity::Player& player )
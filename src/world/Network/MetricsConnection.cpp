@@ -0,0 +1,55 @@
+#include <Network/Acceptor.h>
+#include <Logging/Logger.h>
+#include <Service.h>
+
+#include <fmt/format.h>
+
+#include "MetricsConnection.h"
+#include "Manager/MetricMgr.h"
+
+using namespace Sapphire;
+using namespace Sapphire::Network;
+
+MetricsConnection::MetricsConnection( HivePtr pHive, AcceptorPtr pAcceptor ) :
+  Connection( std::move( pHive ) ),
+  m_pAcceptor( std::move( pAcceptor ) )
+{
+}
+
+void MetricsConnection::onAccept( const std::string& host, uint16_t port )
+{
+  auto connection = std::make_shared< MetricsConnection >( m_hive, m_pAcceptor );
+  m_pAcceptor->accept( connection );
+}
+
+void MetricsConnection::onRecv( std::vector< uint8_t >& buffer )
+{
+  if( m_responded )
+    return;
+
+  m_request.append( buffer.begin(), buffer.end() );
+
+  // wait for the end of the request headers, anything bigger than a scrape request is dropped
+  if( m_request.find( "\r\n\r\n" ) == std::string::npos )
+  {
+    if( m_request.size() > 8192 )
+      disconnect();
+    return;
+  }
+
+  m_responded = true;
+
+  auto body = Common::Service< World::Manager::MetricMgr >::ref().renderPrometheus();
+  auto response = fmt::format( "HTTP/1.1 200 OK\r\n"
+                               "Content-Type: text/plain; version=0.0.4\r\n"
+                               "Content-Length: {}\r\n"
+                               "Connection: close\r\n\r\n", body.size() );
+  response += body;
+
+  send( std::vector< uint8_t >( response.begin(), response.end() ) );
+}
+
+void MetricsConnection::onSend( const std::vector< uint8_t >& buffer )
+{
+  disconnect();
+}
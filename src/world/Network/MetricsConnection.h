@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Network/Connection.h>
+
+#include <string>
+
+namespace Sapphire::Network
+{
+
+  /*!
+   * @brief Answers every HTTP request with the metrics of MetricMgr in Prometheus text format.
+   *
+   * Only meant for a scraper on a trusted network, the request line is not looked at and the
+   * connection is closed after one response.
+   */
+  class MetricsConnection : public Connection
+  {
+  public:
+    MetricsConnection( HivePtr pHive, AcceptorPtr pAcceptor );
+
+    ~MetricsConnection() override = default;
+
+    void onAccept( const std::string& host, uint16_t port ) override;
+
+    void onRecv( std::vector< uint8_t >& buffer ) override;
+
+    void onSend( const std::vector< uint8_t >& buffer ) override;
+
+  private:
+    AcceptorPtr m_pAcceptor;
+    std::string m_request;
+    bool m_responded{ false };
+  };
+
+}
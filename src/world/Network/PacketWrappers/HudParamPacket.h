@@ -3,6 +3,7 @@
 #include <Network/GamePacket.h>
 #include <StatusEffect/StatusEffect.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Actor/Player.h>
 #include <Actor/BNpc.h>
 #include "Forwards.h"
@@ -43,7 +44,7 @@ namespace Sapphire::Network::Packets::WorldPackets::Server
       int i = 0;
       for( const auto& [ key, val ] : statusMap )
       {
-        auto timeLeft = static_cast< int32_t >( val->getDuration() - ( Common::Util::getTimeMs() - val->getStartTimeMs() ) );
+        auto timeLeft = static_cast< int32_t >( val->getDuration() - ( Common::Util::FrameClock::getTimeMs() - val->getStartTimeMs() ) );
         m_data.effect[ i ].Id = val->getId();
         m_data.effect[ i ].Source = val->getSrcActorId();
         m_data.effect[ i ].SystemParam = val->getParam();
@@ -3,6 +3,7 @@
 #include <Network/PacketDef/Zone/ServerZoneDef.h>
 #include <Network/GamePacket.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Common.h>
 #include "Actor/Player.h"
 #include "Actor/BNpc.h"
@@ -101,7 +102,7 @@ namespace Sapphire::Network::Packets::WorldPackets::Server
 
       m_data.MainTarget = static_cast< uint64_t >( bnpc.getTargetId() );
 
-      uint64_t currentTimeMs = Common::Util::getTimeMs();
+      uint64_t currentTimeMs = Common::Util::FrameClock::getTimeMs();
 
       for( auto const& effect : bnpc.getStatusEffectMap() )
       {
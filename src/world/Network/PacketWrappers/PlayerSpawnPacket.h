@@ -3,6 +3,7 @@
 #include <Network/PacketDef/Zone/ServerZoneDef.h>
 #include <Network/GamePacket.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include "Actor/Player.h"
 #include "Forwards.h"
 #include "Inventory/Item.h"
@@ -144,7 +145,7 @@ namespace Sapphire::Network::Packets::WorldPackets::Server
       //m_data.unknown_60 = 3;
       //m_data.unknown_61 = 7;
 
-      uint64_t currentTimeMs = Common::Util::getTimeMs();
+      uint64_t currentTimeMs = Common::Util::FrameClock::getTimeMs();
 
       for( auto const& effect : player.getStatusEffectMap() )
       {
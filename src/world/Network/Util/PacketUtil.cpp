@@ -3,6 +3,7 @@
 #include <Exd/ExdData.h>
 
 #include <Manager/MgrUtil.h>
+#include <Manager/PartyMgr.h>
 #include <Manager/TerritoryMgr.h>
 
 #include <Territory/Territory.h>
@@ -70,7 +71,10 @@ void Util::Packet::sendBaseParams( Entity::Player& player )
 void Util::Packet::sendHudParam( Entity::Chara& source )
 {
   if( source.isPlayer() )
+  {
     server().queueForPlayers( source.getInRangePlayerIds( true ), makeHudParam( *source.getAsPlayer() ) );
+    Common::Service< PartyMgr >::ref().onMemberChanged( *source.getAsPlayer(), PartyMgr::PartyMemberField::Hp | PartyMgr::PartyMemberField::Mp );
+  }
   else if( source.isBattleNpc() )
     server().queueForPlayers( source.getInRangePlayerIds( false ), makeHudParam( *source.getAsBNpc() ) );
   else
@@ -137,6 +137,11 @@ namespace Sapphire::ScriptAPI
     {
       return Common::Service< World::Manager::StatusEffectMgr >::ref();
     }
+
+    World::Manager::TerritoryMgr& teriMgr()
+    {
+      return Common::Service< World::Manager::TerritoryMgr >::ref();
+    }
   };
 
 
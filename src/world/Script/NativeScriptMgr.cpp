@@ -1,7 +1,11 @@
 #include "NativeScriptMgr.h"
 
 #include <Crypt/md5.h>
+#include <Logging/Logger.h>
 #include <Service.h>
+
+#include <algorithm>
+#include <filesystem>
 #include "WorldServer.h"
 
 namespace Sapphire::Scripting
@@ -11,40 +15,80 @@ namespace Sapphire::Scripting
   {
     std::scoped_lock lock( m_mutex );
 
-    auto module = m_loader.loadModule( path );
+    std::filesystem::path f( path );
+    if( m_loader.isModuleLoaded( f.stem().string() ) )
+    {
+      Logger::error( "Unable to load module '{0}' as it is already loaded", f.stem().string() );
+      return false;
+    }
+
+    auto module = m_loader.prepareModule( path );
     if( !module )
       return false;
 
-    auto scripts = m_loader.getScripts( module->handle );
-    if( !scripts )
+    installModule( module );
+    return true;
+  }
+
+  void NativeScriptMgr::installModule( ScriptInfo* info )
+  {
+    std::scoped_lock lock( m_mutex );
+
+    if( auto current = m_loader.getScriptInfo( info->library_name ) )
+      retireModule( current );
+
+    for( auto script : info->scripts )
     {
-      m_loader.unloadScript( module );
-      return false;
+      m_scripts[ script->getType() ][ script->getId() ] = script;
+      m_scriptModules[ script ] = info;
     }
 
-    //
-    bool success = false;
+    m_loader.registerModule( info );
+  }
 
-    for( int i = 0;; i++ )
+  void NativeScriptMgr::retireModule( ScriptInfo* info )
+  {
+    std::scoped_lock lock( m_mutex );
+
+    for( auto& script : info->scripts )
     {
-      if( scripts[ i ] == nullptr )
-        break;
+      auto& scripts = m_scripts[ script->getType() ];
+      auto it = scripts.find( script->getId() );
+      if( it != scripts.end() && it->second == script )
+        scripts.erase( it );
 
-      auto script = scripts[ i ];
-      module->scripts.push_back( script );
+      m_scriptModules.erase( script );
+    }
 
-      m_scripts[ script->getType() ][ script->getId() ] = script;
+    m_loader.releaseModule( info );
+    m_retiredModules.push_back( info );
+  }
 
-      success = true;
-    }
+  void NativeScriptMgr::closeRetiredModules()
+  {
+    std::scoped_lock lock( m_mutex );
 
-    if( !success )
+    for( auto it = m_retiredModules.begin(); it != m_retiredModules.end(); )
     {
-      m_loader.unloadScript( module->handle );
-      return false;
+      auto info = *it;
+      if( info->eventRef.use_count() > 1 )
+      {
+        ++it;
+        continue;
+      }
+
+      for( auto& script : info->scripts )
+        delete script;
+      info->scripts.clear();
+
+      if( !m_loader.closeModule( info ) )
+      {
+        ++it;
+        continue;
+      }
+
+      it = m_retiredModules.erase( it );
     }
-
-    return true;
   }
 
   const std::string NativeScriptMgr::getModuleExtension()
@@ -69,14 +113,16 @@ namespace Sapphire::Scripting
   {
     std::scoped_lock lock( m_mutex );
 
-    for( auto& script : info->scripts )
-    {
-      m_scripts[ script->getType() ].erase( script->getId() );
+    auto name = info->library_name;
 
-      delete script;
-    }
+    retireModule( info );
+    closeRetiredModules();
 
-    return m_loader.unloadScript( info );
+    // event handlers of the module are still running, its scripts are gone but the library stays open
+    if( std::find( m_retiredModules.begin(), m_retiredModules.end(), info ) != m_retiredModules.end() )
+      Logger::info( "Unloaded scripts of module {0}, closing it once its running events finished", name );
+
+    return true;
   }
 
   void NativeScriptMgr::queueScriptReload( const std::string& name )
@@ -87,13 +133,32 @@ namespace Sapphire::Scripting
     if( !info )
       return;
 
-    // backup actual lib path
-    std::string libPath( info->library_path );
+    m_scriptLoadQueue.push( info->library_path );
+  }
 
-    if( !unloadScript( info ) )
-      return;
+  void NativeScriptMgr::queueScriptLoad( const std::string& path )
+  {
+    std::scoped_lock lock( m_mutex );
+
+    m_scriptLoadQueue.push( path );
+  }
+
+  std::shared_ptr< void > NativeScriptMgr::getEventRef( uint32_t eventId )
+  {
+    std::scoped_lock lock( m_mutex );
+
+    for( auto& [ type, scripts ] : m_scripts )
+    {
+      auto script = scripts.find( eventId );
+      if( script == scripts.end() )
+        continue;
+
+      auto module = m_scriptModules.find( script->second );
+      if( module != m_scriptModules.end() )
+        return module->second->eventRef;
+    }
 
-    m_scriptLoadQueue.push( libPath );
+    return nullptr;
   }
 
   void NativeScriptMgr::processLoadQueue()
@@ -104,20 +169,42 @@ namespace Sapphire::Scripting
 
     while( !m_scriptLoadQueue.empty() )
     {
-      auto item = m_scriptLoadQueue.front();
+      auto path = m_scriptLoadQueue.front();
+      m_scriptLoadQueue.pop();
 
-      // if it fails, we defer the loading to the next tick
-      if( !loadScript( item ) )
-        deferredLoads.push_back( item );
+      // changed again while the previous build is being prepared, we defer the loading until that one is swapped in
+      if( m_preparingModules.count( path ) )
+      {
+        deferredLoads.push_back( path );
+        continue;
+      }
 
-      m_scriptLoadQueue.pop();
+      m_preparingModules[ path ] = m_prepareWorker.queue( [ this, path ]() { return m_loader.prepareModule( path ); } );
     }
 
-    if( !deferredLoads.empty() )
+    for( auto& item : deferredLoads )
+      m_scriptLoadQueue.push( item );
+
+    for( auto it = m_preparingModules.begin(); it != m_preparingModules.end(); )
     {
-      for( auto& item : deferredLoads )
-        m_scriptLoadQueue.push( item );
+      if( it->second.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+      {
+        ++it;
+        continue;
+      }
+
+      if( auto module = it->second.get() )
+      {
+        Logger::info( "Swapped in module {0} with {1} scripts", module->library_name, module->scripts.size() );
+        installModule( module );
+      }
+      else
+        Logger::error( "Failed to prepare module {0}, keeping the loaded version", it->first );
+
+      it = m_preparingModules.erase( it );
     }
+
+    closeRetiredModules();
   }
 
   void NativeScriptMgr::findScripts( std::set< Sapphire::Scripting::ScriptInfo* >& scripts, const std::string& search )
@@ -141,6 +228,25 @@ namespace Sapphire::Scripting
     m_loader.setCachePath( server.getConfig().scripts.cachePath );
   }
 
+  NativeScriptMgr::~NativeScriptMgr()
+  {
+    std::scoped_lock lock( m_mutex );
+
+    // opened on the prepare worker but never installed, nothing else knows about them
+    for( auto& [ path, module ] : m_preparingModules )
+    {
+      if( auto info = module.get() )
+      {
+        for( auto& script : info->scripts )
+          delete script;
+        info->scripts.clear();
+
+        m_loader.closeModule( info );
+      }
+    }
+    m_preparingModules.clear();
+  }
+
 
   std::shared_ptr< NativeScriptMgr > createNativeScriptMgr()
   {
@@ -5,6 +5,10 @@
 #include <set>
 #include <queue>
 #include <mutex>
+#include <future>
+#include <vector>
+
+#include <Util/ThreadPool.h>
 
 #include "ScriptLoader.h"
 
@@ -23,27 +27,65 @@ namespace Sapphire::Scripting
     std::unordered_map< std::size_t, std::unordered_map< uint32_t, Sapphire::ScriptAPI::ScriptObject* > > m_scripts;
 
 
+    /*!
+     * @brief The module each script in m_scripts was loaded from
+     */
+    std::unordered_map< Sapphire::ScriptAPI::ScriptObject*, ScriptInfo* > m_scriptModules;
+
     ScriptLoader m_loader;
 
     /*!
-     * @brief The queue that scripts to be reloaded are placed into.
+     * @brief The queue that paths of modules to be (re)loaded are placed into, filled from the watcher thread.
      */
     std::queue< std::string > m_scriptLoadQueue;
 
+    /*!
+     * @brief Modules being copied and opened on the prepare worker, by module path
+     */
+    std::unordered_map< std::string, std::future< ScriptInfo* > > m_preparingModules;
+
+    /*!
+     * @brief Replaced or unloaded modules, closed once no event handler references them anymore
+     */
+    std::vector< ScriptInfo* > m_retiredModules;
+
     std::recursive_mutex m_mutex;
 
+    /*!
+     * @brief Copies, opens and resolves queued modules off the world thread
+     *
+     * Declared last, it finishes its jobs before the loader goes away.
+     */
+    Common::Util::ThreadPool m_prepareWorker{ 1 };
+
     /*!
      * @brief Used to unload a script
      *
-     * Used to unload a script, clears m_scripts of any scripts assoicated with a ScriptInfo and then unloads that module
+     * Used to unload a script, clears m_scripts of any scripts assoicated with a ScriptInfo and retires that module
      *
      * @param info A pointer to the ScriptInfo object that is to be erased
      * @return true if successful, false if not
      */
     bool unloadScript( ScriptInfo* info );
 
+    /*!
+     * @brief Makes the scripts of a prepared module available, replacing a loaded module of the same name
+     */
+    void installModule( ScriptInfo* info );
+
+    /*!
+     * @brief Removes the scripts of a module from the script table and keeps it open until it is no longer referenced
+     */
+    void retireModule( ScriptInfo* info );
+
+    /*!
+     * @brief Closes every retired module which no in-flight event handler references anymore
+     */
+    void closeRetiredModules();
+
   public:
     NativeScriptMgr();
+    ~NativeScriptMgr();
 
     /*!
      * @brief Loads a script from a path
@@ -58,21 +100,42 @@ namespace Sapphire::Scripting
     /*!
      * @brief Unloads a script
      *
+     * The scripts are removed right away, the module itself is closed once no running event references it.
+     *
      * @param name The module name of the script to unload
-     * @return true if successful
+     * @return true if a module of that name was loaded
      */
     bool unloadScript( const std::string& name );
 
     /*!
      * @brief Queues a script module to be reloaded
      *
-     * Due to the nature of how this works, there's no return.
-     * It will just silently fail over and over again to infinity and beyond until the server restarts... not that should ever happen under normal circumstances.
+     * The module keeps running until the new build is prepared, then its scripts get swapped on the next tick.
+     * Due to the nature of how this works, there's no return, failures end up in the log.
      *
      * @param name The name of the module to be reloaded.
      */
     void queueScriptReload( const std::string& name );
 
+    /*!
+     * @brief Queues a module to be loaded, or reloaded if a module of the same name is loaded
+     *
+     * Safe to call from any thread, the module is copied and opened on a worker thread.
+     *
+     * @param path The path to the module to load
+     */
+    void queueScriptLoad( const std::string& path );
+
+    /*!
+     * @brief Gets a reference that keeps the module of the script for an event loaded
+     *
+     * Held by the EventHandler of the event, callbacks set by the script stay valid even if the module gets replaced.
+     *
+     * @param eventId The id of the event, as used to look up its script
+     * @return The reference, nullptr if no script handles the event
+     */
+    std::shared_ptr< void > getEventRef( uint32_t eventId );
+
     /*!
      * @brief Case-insensitive search for modules, useful for debug commands
      *
@@ -83,6 +146,8 @@ namespace Sapphire::Scripting
 
     /*!
      * @brief Called on a regular interval, allows for scripts to be loaded from the internal load queue.
+     *
+     * Hands queued modules to the prepare worker, swaps in the modules it finished and closes retired modules.
      */
     void processLoadQueue();
 
@@ -1,6 +1,7 @@
 #ifndef CORE_SCRIPTINFO_H
 #define CORE_SCRIPTINFO_H
 
+#include <memory>
 #include <vector>
 
 #include "NativeScriptApi.h"
@@ -62,6 +63,13 @@ namespace Sapphire::Scripting
      * This is tracked so when we unload this module we can call delete on each ScriptObject and correctly free it from memory.
      */
     std::vector< Sapphire::ScriptAPI::ScriptObject* > scripts;
+
+    /*!
+     * @brief Shared with every in-flight EventHandler started on a script of this module.
+     *
+     * Event callbacks point into the module code, a replaced module is only closed once this is the last reference.
+     */
+    std::shared_ptr< void > eventRef{ std::make_shared< char >() };
   };
 
 }
@@ -23,6 +23,7 @@ namespace Sapphire::World::Manager
 }
 #endif
 
+#include <atomic>
 #include <filesystem>
 #include <Manager/TerritoryMgr.h>
 #include <Manager/WarpMgr.h>
@@ -61,20 +62,18 @@ bool Sapphire::Scripting::ScriptLoader::unloadModule( ModuleHandle handle )
   return true;
 }
 
-Sapphire::Scripting::ScriptInfo* Sapphire::Scripting::ScriptLoader::loadModule( const std::string& path )
+Sapphire::Scripting::ScriptInfo* Sapphire::Scripting::ScriptLoader::prepareModule( const std::string& path )
 {
-  fs::path f( path );
+  static std::atomic< uint32_t > cacheGeneration{ 0 };
 
-  if( isModuleLoaded( f.stem().string() ) )
-  {
-    Logger::error( "Unable to load module '{0}' as it is already loaded", f.stem().string() );
-    return nullptr;
-  }
+  fs::path f( path );
 
   // copy to temp dir
   fs::path cacheDir( f.parent_path() /= m_cachePath );
   fs::create_directories( cacheDir );
-  fs::path dest( cacheDir /= f.filename().string() );
+
+  // the loader hands back the already open module for a path it knows, a reload needs a new file name
+  fs::path dest( cacheDir / ( f.stem().string() + "_" + std::to_string( ++cacheGeneration ) + f.extension().string() ) );
 
   // make sure the module has finished building before trying to copy it
   const std::string readyFile( ( f.parent_path() / f.stem() ).string() + "_LOCK" );
@@ -103,6 +102,7 @@ Sapphire::Scripting::ScriptInfo* Sapphire::Scripting::ScriptLoader::loadModule(
   {
     Logger::error( "Failed to load module from: {0}", path );
 
+    fs::remove( dest );
     return nullptr;
   }
 
@@ -114,10 +114,50 @@ Sapphire::Scripting::ScriptInfo* Sapphire::Scripting::ScriptLoader::loadModule(
   info->cache_path = dest.string();
   info->library_path = f.string();
 
-  m_scriptMap.insert( std::make_pair( f.stem().string(), info ) );
+  auto scripts = getScripts( handle );
+  for( int i = 0; scripts && scripts[ i ] != nullptr; i++ )
+    info->scripts.push_back( scripts[ i ] );
+
+  if( info->scripts.empty() )
+  {
+    Logger::error( "Module {0} does not contain any scripts", f.filename().string() );
+
+    closeModule( info );
+    return nullptr;
+  }
+
   return info;
 }
 
+void Sapphire::Scripting::ScriptLoader::registerModule( ScriptInfo* info )
+{
+  m_scriptMap[ info->library_name ] = info;
+}
+
+void Sapphire::Scripting::ScriptLoader::releaseModule( ScriptInfo* info )
+{
+  auto it = m_scriptMap.find( info->library_name );
+  if( it != m_scriptMap.end() && it->second == info )
+    m_scriptMap.erase( it );
+}
+
+bool Sapphire::Scripting::ScriptLoader::closeModule( ScriptInfo* info )
+{
+  if( !unloadModule( info->handle ) )
+  {
+    Logger::error( "failed to unload module: {0}", info->library_name );
+
+    return false;
+  }
+
+  // remove cached file
+  fs::remove( info->cache_path );
+
+  delete info;
+
+  return true;
+}
+
 Sapphire::ScriptAPI::ScriptObject** Sapphire::Scripting::ScriptLoader::getScripts( ModuleHandle handle )
 {
   using getScripts = Sapphire::ScriptAPI::ScriptObject** ( * )();
@@ -270,20 +310,13 @@ bool Sapphire::Scripting::ScriptLoader::unloadScript( ModuleHandle handle )
     if( it->second->handle == handle )
     {
       auto info = it->second;
+      m_scriptMap.erase( it );
 
-      if( unloadModule( handle ) )
-      {
-        m_scriptMap.erase( it );
-
-        // remove cached file
-        fs::remove( info->cache_path );
-
-        delete info;
-
+      if( closeModule( info ) )
         return true;
-      }
 
-      Logger::error( "failed to unload module: {0}", info->library_name );
+      // keep track of it, it is still loaded
+      m_scriptMap[ info->library_name ] = info;
 
       return false;
     }
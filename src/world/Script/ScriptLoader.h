@@ -57,13 +57,32 @@ namespace Sapphire::Scripting
     const std::string getModuleExtension();
 
     /*!
-     * @brief Load a module from a path
+     * @brief Load a module from a path and resolve its scripts, without registering it
      *
      * Internally, this will also copy the module from it's original folder into the cache folder.
+     * Every copy gets its own cache file, so a new build can be loaded while the previous one is still in use.
+     * Does not touch the module list and is safe to call from a worker thread.
      *
-     * @return A pointer to ScriptInfo if the load was successful, nullptr if it failed
+     * @return A pointer to ScriptInfo with its scripts if the load was successful, nullptr if it failed
      */
-    ScriptInfo* loadModule( const std::string& );
+    ScriptInfo* prepareModule( const std::string& );
+
+    /*!
+     * @brief Adds a prepared module to the list of loaded modules
+     */
+    void registerModule( ScriptInfo* info );
+
+    /*!
+     * @brief Removes a module from the list of loaded modules, without unloading it
+     */
+    void releaseModule( ScriptInfo* info );
+
+    /*!
+     * @brief Unloads a module which is not in the list of loaded modules, removes its cached file and frees info
+     *
+     * @return true if successful, false if not
+     */
+    bool closeModule( ScriptInfo* info );
 
     /*!
      * @brief Unload a script from it's ScriptInfo object
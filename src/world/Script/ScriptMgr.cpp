@@ -25,6 +25,7 @@
 #include "Script/ScriptMgr.h"
 
 #include "NativeScriptMgr.h"
+#include "ScriptWatcher.h"
 #include "WorldServer.h"
 
 #include "Quest/Quest.h"
@@ -43,7 +44,10 @@ Sapphire::Scripting::ScriptMgr::ScriptMgr() :
 
 Sapphire::Scripting::ScriptMgr::~ScriptMgr()
 {
-  Watchdog::unwatchAll();
+  if( m_watcher )
+    m_watcher->stop();
+  else if( m_bWatchdogStarted )
+    Watchdog::unwatchAll();
 }
 
 void Sapphire::Scripting::ScriptMgr::update()
@@ -91,9 +95,36 @@ void Sapphire::Scripting::ScriptMgr::watchDirectories()
   if( !shouldWatch )
     return;
 
+  auto onModulesChanged = [ this ]( const std::vector< fs::path >& paths )
+  {
+    for( const auto& path : paths )
+    {
+      if( m_nativeScriptMgr->isModuleLoaded( path.stem().string() ) )
+      {
+        Logger::debug( "Reloading changed script: {0}", path.stem().string() );
+
+        m_nativeScriptMgr->queueScriptReload( path.stem().string() );
+      }
+      else
+      {
+        Logger::debug( "Loading new script: {0}", path.stem().string() );
+
+        m_nativeScriptMgr->queueScriptLoad( path.string() );
+      }
+    }
+  };
+
+  m_watcher = std::make_unique< ScriptWatcher >( server.getConfig().scripts.path, m_nativeScriptMgr->getModuleExtension(),
+                                                 server.getConfig().scripts.reloadDebounceMs, onModulesChanged );
+  if( m_watcher->start() )
+    return;
+
+  m_watcher.reset();
+  m_bWatchdogStarted = true;
+
   Watchdog::watchMany( server.getConfig().scripts.path + "*" +
                        m_nativeScriptMgr->getModuleExtension(),
-                       [ this ]( const std::vector< ci::fs::path >& paths )
+                       [ this, onModulesChanged ]( const std::vector< ci::fs::path >& paths )
                        {
                          if( !m_firstScriptChangeNotificiation )
                          {
@@ -103,21 +134,7 @@ void Sapphire::Scripting::ScriptMgr::watchDirectories()
                            return;
                          }
 
-                         for( const auto& path : paths )
-                         {
-                           if( m_nativeScriptMgr->isModuleLoaded( path.stem().string() ) )
-                           {
-                             Logger::debug( "Reloading changed script: {0}", path.stem().string() );
-
-                             m_nativeScriptMgr->queueScriptReload( path.stem().string() );
-                           }
-                           else
-                           {
-                             Logger::debug( "Loading new script: {0}", path.stem().string() );
-
-                             m_nativeScriptMgr->loadScript( path.string() );
-                           }
-                         }
+                         onModulesChanged( paths );
                        } );
 }
 
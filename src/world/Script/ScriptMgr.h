@@ -11,6 +11,7 @@
 
 namespace Sapphire::Scripting
 {
+  class ScriptWatcher;
 
   class ScriptMgr
   {
@@ -28,6 +29,16 @@ namespace Sapphire::Scripting
      */
     bool m_firstScriptChangeNotificiation;
 
+    /*!
+     * @brief inotify watcher on the scripts folder, nullptr where it is not available and watchdog is used instead.
+     */
+    std::unique_ptr< ScriptWatcher > m_watcher;
+
+    /*!
+     * @brief Set once watchDirectories falls back to watchdog, unwatching would start its thread otherwise.
+     */
+    bool m_bWatchdogStarted{ false };
+
   public:
     ScriptMgr();
 
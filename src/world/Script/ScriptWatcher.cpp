@@ -0,0 +1,171 @@
+#include "ScriptWatcher.h"
+
+#ifdef __linux__
+
+#include <Logging/Logger.h>
+
+#include <cstring>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  // how often the thread wakes up to check debounce timers and the stop flag without any events
+  const int PollIntervalMs = 100;
+
+  // the build copies the module next to a <target>_LOCK file and removes it once the copy is complete
+  bool isLocked( const fs::path& path )
+  {
+    auto stem = path.stem().string();
+    if( fs::exists( path.parent_path() / ( stem + "_LOCK" ) ) )
+      return true;
+
+    // module targets get a lib prefix on linux, the lock file is named after the target
+    return stem.rfind( "lib", 0 ) == 0 && fs::exists( path.parent_path() / ( stem.substr( 3 ) + "_LOCK" ) );
+  }
+}
+
+Sapphire::Scripting::ScriptWatcher::ScriptWatcher( std::string path, std::string extension, uint32_t debounceMs,
+                                                   ChangeCallback callback ) :
+  m_path( std::move( path ) ),
+  m_extension( std::move( extension ) ),
+  m_debounce( debounceMs ),
+  m_callback( std::move( callback ) )
+{
+}
+
+Sapphire::Scripting::ScriptWatcher::~ScriptWatcher()
+{
+  stop();
+}
+
+bool Sapphire::Scripting::ScriptWatcher::start()
+{
+  m_fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+  if( m_fd < 0 )
+  {
+    Logger::error( "ScriptWatcher: inotify_init1 failed: {0}", strerror( errno ) );
+    return false;
+  }
+
+  m_watch = inotify_add_watch( m_fd, m_path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO );
+  if( m_watch < 0 )
+  {
+    Logger::error( "ScriptWatcher: unable to watch {0}: {1}", m_path, strerror( errno ) );
+    close( m_fd );
+    m_fd = -1;
+    return false;
+  }
+
+  m_running = true;
+  m_thread = std::thread( [ this ]() { run(); } );
+
+  Logger::info( "ScriptWatcher: watching {0} for changed modules", m_path );
+  return true;
+}
+
+void Sapphire::Scripting::ScriptWatcher::stop()
+{
+  m_running = false;
+  if( m_thread.joinable() )
+    m_thread.join();
+
+  if( m_fd >= 0 )
+  {
+    close( m_fd );
+    m_fd = -1;
+  }
+}
+
+void Sapphire::Scripting::ScriptWatcher::run()
+{
+  pollfd pfd{ m_fd, POLLIN, 0 };
+
+  while( m_running )
+  {
+    if( poll( &pfd, 1, PollIntervalMs ) > 0 && ( pfd.revents & POLLIN ) )
+      readEvents();
+
+    flushSettled();
+  }
+}
+
+void Sapphire::Scripting::ScriptWatcher::readEvents()
+{
+  alignas( inotify_event ) char buffer[ 4096 ];
+
+  while( true )
+  {
+    auto length = read( m_fd, buffer, sizeof( buffer ) );
+    if( length <= 0 )
+      return;
+
+    for( char* ptr = buffer; ptr < buffer + length; )
+    {
+      auto event = reinterpret_cast< const inotify_event* >( ptr );
+      ptr += sizeof( inotify_event ) + event->len;
+
+      if( event->len == 0 || ( event->mask & IN_ISDIR ) )
+        continue;
+
+      fs::path file( event->name );
+      if( file.extension() != m_extension )
+        continue;
+
+      m_pending[ ( fs::path( m_path ) / file ).string() ] = std::chrono::steady_clock::now();
+    }
+  }
+}
+
+void Sapphire::Scripting::ScriptWatcher::flushSettled()
+{
+  if( m_pending.empty() )
+    return;
+
+  auto now = std::chrono::steady_clock::now();
+  std::vector< fs::path > settled;
+
+  for( auto it = m_pending.begin(); it != m_pending.end(); )
+  {
+    fs::path path( it->first );
+    if( now - it->second < m_debounce || isLocked( path ) )
+    {
+      ++it;
+      continue;
+    }
+
+    settled.push_back( path );
+    it = m_pending.erase( it );
+  }
+
+  if( !settled.empty() )
+    m_callback( settled );
+}
+
+#else
+
+Sapphire::Scripting::ScriptWatcher::ScriptWatcher( std::string path, std::string extension, uint32_t debounceMs,
+                                                   ChangeCallback callback ) :
+  m_path( std::move( path ) ),
+  m_extension( std::move( extension ) ),
+  m_debounce( debounceMs ),
+  m_callback( std::move( callback ) )
+{
+}
+
+Sapphire::Scripting::ScriptWatcher::~ScriptWatcher() = default;
+
+bool Sapphire::Scripting::ScriptWatcher::start()
+{
+  return false;
+}
+
+void Sapphire::Scripting::ScriptWatcher::stop()
+{
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef CORE_SCRIPTWATCHER_H
+#define CORE_SCRIPTWATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Sapphire::Scripting
+{
+
+  /*!
+   * @brief Watches the script folder through inotify and reports modules once they stopped changing.
+   *
+   * A build writes a module in several steps, every change restarts the debounce timer of that module so only the
+   * finished file gets reported. Runs on its own thread, the callback is invoked from that thread.
+   * Only available on Linux, ScriptMgr falls back to the watchdog polling watcher elsewhere.
+   */
+  class ScriptWatcher
+  {
+  public:
+    using ChangeCallback = std::function< void( const std::vector< std::filesystem::path >& ) >;
+
+    ScriptWatcher( std::string path, std::string extension, uint32_t debounceMs, ChangeCallback callback );
+
+    ~ScriptWatcher();
+
+    /*!
+     * @brief Adds the inotify watch on the script folder and starts the watcher thread
+     *
+     * @return true if the folder is being watched
+     */
+    bool start();
+
+    /*!
+     * @brief Stops and joins the watcher thread, pending changes are dropped
+     */
+    void stop();
+
+  private:
+    void run();
+
+    void readEvents();
+
+    /*!
+     * @brief Reports every pending module which has not changed for the debounce time and is not locked by a build
+     */
+    void flushSettled();
+
+    std::string m_path;
+    std::string m_extension;
+    std::chrono::milliseconds m_debounce;
+    ChangeCallback m_callback;
+
+    int m_fd{ -1 };
+    int m_watch{ -1 };
+    std::atomic< bool > m_running{ false };
+    std::thread m_thread;
+
+    /*!
+     * @brief Modules which changed and have not been reported yet, with the time of their last change
+     */
+    std::unordered_map< std::string, std::chrono::steady_clock::time_point > m_pending;
+  };
+
+}
+
+#endif // CORE_SCRIPTWATCHER_H
@@ -1,6 +1,7 @@
 #include <filesystem>
 
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Network/PacketContainer.h>
 #include <Logging/Logger.h>
 #include <Service.h>
@@ -155,7 +156,7 @@ void Sapphire::World::Session::startReplay( const std::string& path )
   for( auto set : loadedSets )
   {
     uint64_t setTime = std::get< 0 >( set );
-    m_replayCache.emplace_back( Common::Util::getTimeMs() + ( ( setTime - startTime ) / 1 ), std::get< 1 >( set ) );
+    m_replayCache.emplace_back( Common::Util::FrameClock::getTimeMs() + ( ( setTime - startTime ) / 1 ), std::get< 1 >( set ) );
 
     Logger::info( "Registering {0} for {1}, oldTime {2}", std::get< 1 >( set ), setTime - startTime, setTime );
   }
@@ -176,7 +177,7 @@ void Sapphire::World::Session::processReplay()
   test:
   for( const auto& set : m_replayCache )
   {
-    if( (std::get< 0 >( set ) ) <= Common::Util::getTimeMs() )
+    if( (std::get< 0 >( set ) ) <= Common::Util::FrameClock::getTimeMs() )
     {
       m_pZoneConnection->injectPacket( std::get< 1 >( set ), *getPlayer().get() );
       m_replayCache.erase( m_replayCache.begin() + at );
@@ -223,7 +224,7 @@ void Sapphire::World::Session::update()
   m_pZoneConnection->processInQueue();
 
   // SESSION LOGIC
-  m_pPlayer->update( Common::Util::getTimeMs() );
+  m_pPlayer->update( Common::Util::FrameClock::getTimeMs() );
 
   if( Common::Util::getTimeSeconds() - static_cast< uint32_t >( getLastSqlTime() ) > 10 )
   {
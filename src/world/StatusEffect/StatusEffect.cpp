@@ -1,5 +1,6 @@
 #include <Exd/ExdData.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Network/PacketDef/Zone/ServerZoneDef.h>
 #include <Logging/Logger.h>
 
@@ -14,6 +15,8 @@
 #include "Common.h"
 #include "Manager/PlayerMgr.h"
 #include "Manager/StatusEffectMgr.h"
+#include "Manager/TerritoryMgr.h"
+#include "Territory/Territory.h"
 
 #include "Inventory/Item.h"
 
@@ -108,7 +111,7 @@ std::pair< ParamModifier, uint32_t > Sapphire::StatusEffect::StatusEffect::getTi
 
 void Sapphire::StatusEffect::StatusEffect::onTick()
 {
-  m_lastTick = Util::getTimeMs();
+  m_lastTick = Util::FrameClock::getTimeMs();
 
   auto& scriptMgr = Common::Service< Scripting::ScriptMgr >::ref();
   bool hasScript = scriptMgr.onStatusTick( m_targetActor, *this );
@@ -211,6 +214,11 @@ uint32_t Sapphire::StatusEffect::StatusEffect::getTargetActorId() const
   return m_targetActor->getId();
 }
 
+Sapphire::Entity::CharaPtr Sapphire::StatusEffect::StatusEffect::getTargetActor() const
+{
+  return m_targetActor;
+}
+
 uint16_t Sapphire::StatusEffect::StatusEffect::getParam() const
 {
   return m_param;
@@ -244,7 +252,7 @@ void Sapphire::StatusEffect::StatusEffect::delModifier( Common::ParamModifier pa
 
 void Sapphire::StatusEffect::StatusEffect::applyStatus()
 {
-  m_startTime = Util::getTimeMs();
+  m_startTime = Util::FrameClock::getTimeMs();
   auto& scriptMgr = Common::Service< Scripting::ScriptMgr >::ref();
 
   if( m_modifiers.empty() )
@@ -270,6 +278,8 @@ void Sapphire::StatusEffect::StatusEffect::removeStatus()
   auto& scriptMgr = Common::Service< Scripting::ScriptMgr >::ref();
 
   m_modifiers.clear();
+  // invalidates its queue entries, also when it is removed during its own tick
+  m_scheduledTime = 0;
 
   m_targetActor->calculateStats();
 
@@ -350,10 +360,40 @@ void Sapphire::StatusEffect::StatusEffect::setSlot( uint8_t slot )
 void Sapphire::StatusEffect::StatusEffect::refresh()
 {
   applyStatus();
+
+  // the new start time moves the expiry, a shorter duration would otherwise only expire on the old schedule
+  const auto& effects = m_targetActor->getStatusEffectMap();
+  auto it = effects.find( m_slot );
+  if( it == effects.end() || it->second.get() != this )
+    return;
+
+  auto& teriMgr = Common::Service< World::Manager::TerritoryMgr >::ref();
+  if( auto pZone = teriMgr.getTerritoryByGuId( m_targetActor->getTerritoryId() ) )
+    pZone->getStatusEffectQueue().schedule( it->second );
 }
 
 void Sapphire::StatusEffect::StatusEffect::refresh( uint32_t newDuration )
 {
   m_duration = newDuration;
   refresh();
-}
\ No newline at end of file
+}
+uint64_t Sapphire::StatusEffect::StatusEffect::getNextDueTime() const
+{
+  // ticks and expiry trigger once strictly past their time
+  uint64_t nextDue = m_lastTick + m_tickRate + 1;
+
+  if( m_duration > 0 )
+    nextDue = std::min( nextDue, m_startTime + m_duration + 1 );
+
+  return nextDue;
+}
+
+uint64_t Sapphire::StatusEffect::StatusEffect::getScheduledTime() const
+{
+  return m_scheduledTime;
+}
+
+void Sapphire::StatusEffect::StatusEffect::setScheduledTime( uint64_t scheduledTime )
+{
+  m_scheduledTime = scheduledTime;
+}
@@ -46,6 +46,7 @@ public:
   Entity::CharaPtr getSrcActor() const;
 
   uint32_t getTargetActorId() const;
+  Entity::CharaPtr getTargetActor() const;
 
   uint64_t getLastTickMs() const;
 
@@ -74,6 +75,13 @@ public:
 
   void refresh( uint32_t newDuration );
 
+  /*! @return time the effect has to be looked at next, its next tick or its expiry */
+  uint64_t getNextDueTime() const;
+
+  /*! time the effect is queued for in its territory, 0 while it is not queued */
+  uint64_t getScheduledTime() const;
+  void setScheduledTime( uint64_t scheduledTime );
+
 private:
   uint32_t m_id;
   Entity::CharaPtr m_sourceActor;
@@ -90,6 +98,7 @@ private:
   World::Action::GroundAOE m_groundAOE{};
   std::unordered_map< Common::ParamModifier, int32_t > m_modifiers;
   uint8_t m_slot;
+  uint64_t m_scheduledTime{ 0 };
 
   void refresh();
 };
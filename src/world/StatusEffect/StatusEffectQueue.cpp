@@ -0,0 +1,91 @@
+#include "StatusEffectQueue.h"
+
+#include <algorithm>
+
+#include <Network/CommonActorControl.h>
+
+#include "Actor/Chara.h"
+#include "Network/Util/PacketUtil.h"
+#include "Territory/Territory.h"
+
+#include "StatusEffect.h"
+
+using namespace Sapphire;
+using namespace Sapphire::Network::ActorControl;
+
+void StatusEffect::StatusEffectQueue::schedule( const StatusEffectPtr& pEffect )
+{
+  auto dueTime = pEffect->getNextDueTime();
+
+  // older entries of this effect no longer match the scheduled time and get dropped when they come up
+  pEffect->setScheduledTime( dueTime );
+  m_queue.schedule( dueTime, pEffect );
+}
+
+void StatusEffect::StatusEffectQueue::scheduleAll( Entity::Chara& chara )
+{
+  for( const auto& [ slot, pEffect ] : chara.getStatusEffectMap() )
+    schedule( pEffect );
+}
+
+void StatusEffect::StatusEffectQueue::update( Territory& territory, uint64_t tickCount )
+{
+  m_dueScratch.clear();
+  if( m_queue.popDue( tickCount, m_dueScratch ) == 0 )
+    return;
+
+  for( const auto& [ dueTime, effectRef ] : m_dueScratch )
+  {
+    auto pEffect = effectRef.lock();
+
+    // removed or rescheduled in the meantime
+    if( !pEffect || pEffect->getScheduledTime() != dueTime )
+      continue;
+
+    processEffect( territory, pEffect, tickCount );
+  }
+
+  for( const auto& pChara : m_dirtyCharas )
+    Network::Util::Packet::sendHudParam( *pChara );
+
+  m_dirtyCharas.clear();
+}
+
+void StatusEffect::StatusEffectQueue::processEffect( Territory& territory, const StatusEffectPtr& pEffect, uint64_t tickCount )
+{
+  auto pTarget = pEffect->getTargetActor();
+
+  // the chara moved on, the territory it is in now queued the effect on the same due time, only drop this entry
+  if( !pTarget || territory.getActor( pTarget->getId() ) != pTarget )
+    return;
+
+  auto duration = pEffect->getDuration();
+  bool expired = duration > 0 && ( tickCount - pEffect->getStartTimeMs() ) > duration;
+  bool tickDue = ( tickCount - pEffect->getLastTickMs() ) > pEffect->getTickRate();
+
+  if( expired )
+  {
+    pTarget->removeStatusEffect( pEffect->getSlot(), false );
+    Network::Util::Packet::sendActorControl( pTarget->getInRangePlayerIds( pTarget->isPlayer() ), pTarget->getId(),
+                                             StatusEffectLose, pEffect->getId() );
+
+    if( std::find( m_dirtyCharas.begin(), m_dirtyCharas.end(), pTarget ) == m_dirtyCharas.end() )
+      m_dirtyCharas.push_back( pTarget );
+  }
+
+  // expiring effects still get their final tick
+  if( tickDue )
+  {
+    pEffect->setLastTick( tickCount );
+    pEffect->onTick();
+  }
+
+  // scripts may have removed the effect during its tick
+  if( !expired && pEffect->getScheduledTime() != 0 )
+    schedule( pEffect );
+}
+
+std::size_t StatusEffect::StatusEffectQueue::size() const
+{
+  return m_queue.size();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Util/TimerQueue.h>
+
+#include "ForwardsZone.h"
+
+namespace Sapphire::StatusEffect
+{
+
+  /*!
+   * @brief Territory wide timer queue driving status effect ticks and expirations.
+   *
+   * Every effect applied to a chara in the territory is queued on its next tick or expiry, whichever
+   * comes first, so an update only touches effects that are actually due. Status list packets for charas
+   * which lost effects are sent once per chara at the end of the update.
+   */
+  class StatusEffectQueue
+  {
+  public:
+    /*! queues the effect on its next tick or expiry, replaces any earlier schedule of the same effect */
+    void schedule( const StatusEffectPtr& pEffect );
+
+    /*! queues every effect of the chara, used when it enters the territory */
+    void scheduleAll( Entity::Chara& chara );
+
+    void update( Territory& territory, uint64_t tickCount );
+
+    std::size_t size() const;
+
+  private:
+    void processEffect( Territory& territory, const StatusEffectPtr& pEffect, uint64_t tickCount );
+
+    Common::Util::TimerQueue< std::weak_ptr< StatusEffect > > m_queue;
+    std::vector< std::pair< uint64_t, std::weak_ptr< StatusEffect > > > m_dueScratch;
+
+    // charas that lost effects during this update and need a new status list
+    std::vector< Entity::CharaPtr > m_dirtyCharas;
+  };
+
+}
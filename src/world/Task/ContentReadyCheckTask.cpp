@@ -0,0 +1,30 @@
+#include "ContentReadyCheckTask.h"
+
+#include <Logging/Logger.h>
+#include <Service.h>
+
+#include <ContentFinder/ContentFinder.h>
+
+using namespace Sapphire::World;
+
+ContentReadyCheckTask::ContentReadyCheckTask( uint64_t delayTime, uint32_t registerId ) :
+  Task( delayTime ),
+  m_registerId( registerId )
+{
+}
+
+void ContentReadyCheckTask::onQueue()
+{
+  Logger::debug( { __FUNCTION__ } );
+}
+
+void ContentReadyCheckTask::execute()
+{
+  auto& contentFinder = Common::Service< ContentFinder >::ref();
+  contentFinder.onReadyCheckTimeout( m_registerId );
+}
+
+std::string ContentReadyCheckTask::toString()
+{
+  return fmt::format( "ContentReadyCheckTask: registerId#{}, ElapsedTimeMs: {}", m_registerId, getDelayTimeMs() );
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <ForwardsZone.h>
+#include "Task.h"
+
+namespace Sapphire::World
+{
+
+class ContentReadyCheckTask : public Task
+{
+public:
+  ContentReadyCheckTask( uint64_t delayTime, uint32_t registerId );
+
+  void onQueue() override;
+  void execute() override;
+  std::string toString() override;
+private:
+  uint32_t m_registerId;
+};
+
+template< typename... Args >
+std::shared_ptr< ContentReadyCheckTask > makeContentReadyCheckTask( Args... args )
+{
+  return std::make_shared< ContentReadyCheckTask >( args... );
+}
+
+}
@@ -4,6 +4,7 @@
 #include <Logging/Logger.h>
 #include <Manager/PlayerMgr.h>
 #include <Manager/LootTableMgr.h>
+#include <Manager/TerritoryMgr.h>
 #include <Manager/MgrUtil.h>
 #include "WorldServer.h"
 #include <Service.h>
@@ -32,7 +33,8 @@ void LootBNpcTask::execute()
   if( !pPlayer )
     return;
 
-  auto lootResult = lootTableMgr.rollLoot( m_lootTable );
+  auto& teriMgr = Common::Service< World::Manager::TerritoryMgr >::ref();
+  auto lootResult = lootTableMgr.rollLoot( m_lootTable, teriMgr.getRandomStream( *pPlayer ) );
   // todo: make this a task? it's too fast and good to be retail-like
   for( auto resultItem : lootResult.items )
   {
@@ -1,10 +1,11 @@
 #include <cstdint>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include "Task.h"
 
 Sapphire::World::Task::Task( uint64_t delayTime ) :
   m_delayTimeMs( delayTime ),
-  m_timeQueuedMs( Common::Util::getTimeMs() )
+  m_timeQueuedMs( Common::Util::FrameClock::getTimeMs() )
 {
 
 }
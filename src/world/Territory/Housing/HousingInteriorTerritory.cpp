@@ -44,8 +44,21 @@ Sapphire::World::Territory::Housing::HousingInteriorTerritory::HousingInteriorTe
 
 Housing::HousingInteriorTerritory::~HousingInteriorTerritory() = default;
 
+void Sapphire::World::Territory::Housing::HousingInteriorTerritory::preload()
+{
+  if( m_bPreloaded )
+    return;
+
+  // interiors are created on demand and never pathed, only their bnpcs are loaded
+  loadBNpcs();
+
+  m_bPreloaded = true;
+}
+
 bool Sapphire::World::Territory::Housing::HousingInteriorTerritory::init()
 {
+  preload();
+
   updateHousingObjects();
 
   return true;
@@ -193,10 +206,10 @@ void Sapphire::World::Territory::Housing::HousingInteriorTerritory::spawnHousing
     objectSpawnPkt->data().ContainerIndex = static_cast< uint8_t >( slot );
 
     objectSpawnPkt->data().Furniture.patternId = item->getAdditionalData() & 0xFFFF;
-    objectSpawnPkt->data().Furniture.dir = Util::floatToUInt16Rot( item->getRot() );
-    objectSpawnPkt->data().Furniture.pos[ 0 ] = Util::floatToUInt16( item->getPos().x );
-    objectSpawnPkt->data().Furniture.pos[ 1 ] = Util::floatToUInt16( item->getPos().y );
-    objectSpawnPkt->data().Furniture.pos[ 2 ] = Util::floatToUInt16( item->getPos().z );
+    objectSpawnPkt->data().Furniture.dir = Common::Util::floatToUInt16Rot( item->getRot() );
+    objectSpawnPkt->data().Furniture.pos[ 0 ] = Common::Util::floatToUInt16( item->getPos().x );
+    objectSpawnPkt->data().Furniture.pos[ 1 ] = Common::Util::floatToUInt16( item->getPos().y );
+    objectSpawnPkt->data().Furniture.pos[ 2 ] = Common::Util::floatToUInt16( item->getPos().z );
 
     server.queueForPlayer( player.second->getCharacterId(), objectSpawnPkt );
   }
@@ -210,10 +223,10 @@ void Sapphire::World::Territory::Housing::HousingInteriorTerritory::updateHousin
   auto& server = Common::Service< World::WorldServer >::ref();
   auto& obj = m_housingObjects[ slot ];
 
-  obj.pos[ 0 ] = Util::floatToUInt16( pos.x );
-  obj.pos[ 1 ] = Util::floatToUInt16( pos.y );
-  obj.pos[ 2 ] = Util::floatToUInt16( pos.z );
-  obj.dir = Util::floatToUInt16Rot( rot );
+  obj.pos[ 0 ] = Common::Util::floatToUInt16( pos.x );
+  obj.pos[ 1 ] = Common::Util::floatToUInt16( pos.y );
+  obj.pos[ 2 ] = Common::Util::floatToUInt16( pos.z );
+  obj.dir = Common::Util::floatToUInt16Rot( rot );
 
   // todo: how does this update on other clients?
 
@@ -15,6 +15,7 @@ namespace Sapphire::World::Territory::Housing
 
     virtual ~HousingInteriorTerritory();
 
+    void preload() override;
     bool init() override;
 
     void onPlayerZoneIn( Entity::Player& player ) override;
@@ -38,8 +38,20 @@ Sapphire::HousingZone::HousingZone( uint8_t wardNum, uint16_t territoryTypeId,
 {
 }
 
+void Sapphire::HousingZone::preload()
+{
+  if( m_bPreloaded )
+    return;
+
+  // wards are not pathed, so unlike the default zones they don't need a navmesh
+  loadBNpcs();
+
+  m_bPreloaded = true;
+}
+
 bool Sapphire::HousingZone::init()
 {
+  preload();
 
   auto& db = Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::ref();
   {
@@ -269,6 +281,17 @@ void Sapphire::HousingZone::onUpdate( uint64_t tickCount )
   }
 }
 
+void Sapphire::HousingZone::onHibernateUpdate( uint64_t tickCount )
+{
+  Territory::onHibernateUpdate( tickCount );
+
+  // land price devaluation has to keep running for empty wards
+  for( const auto& pLandItr : m_landPtrMap )
+  {
+    pLandItr.second->update( tickCount );
+  }
+}
+
 uint8_t Sapphire::HousingZone::getWardNum() const
 {
   return m_wardNum;
@@ -33,10 +33,12 @@ namespace Sapphire
 
     virtual ~HousingZone() = default;
 
+    void preload() override;
     bool init() override;
 
     void onPlayerZoneIn( Entity::Player& player ) override;
     void onUpdate( uint64_t tickCount ) override;
+    void onHibernateUpdate( uint64_t tickCount ) override;
 
     void sendLandSet( Entity::Player& player );
     void sendLandUpdate( uint16_t landId );
@@ -2,6 +2,7 @@
 #include <Common.h>
 #include <Logging/Logger.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Util/UtilMath.h>
 #include <Exd/ExdData.h>
 #include <Network/CommonActorControl.h>
@@ -786,7 +787,7 @@ void Sapphire::InstanceContent::terminate( uint8_t reason )
   else
     sendDutyFailed( false );
 
-  m_instanceTerminateTime = Util::getTimeMs();
+  m_instanceTerminateTime = Util::FrameClock::getTimeMs();
   setState( InstanceContentState::Terminate );
 }
 
@@ -9,32 +9,36 @@
 #include <Exd.h>
 
 #include <algorithm>
+#include <cstring>
 #include <execution>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <Logging/Logger.h>
 #include <Service.h>
 #include <Util/UtilMath.h>
+#include <Util/ThreadPool.h>
+
+#include "WorldServer.h"
 
 #include "DatCategories/DatCommon.h"
 #include "datReader/DatCategories/bg/lgb.h"
 
-Sapphire::InstanceObjectCache::InstanceObjectCache()
-{
-  auto& exdData = Common::Service< Sapphire::Data::ExdData >::ref();
-  auto teriList = exdData.getRows< Excel::TerritoryType >();
-
-  size_t count = 0;
-  for( const auto& [ id, territoryType ] : teriList ) {
-    // show some loading indication...
-    if( count++ % 10 == 0 )
-      std::cout << ".";
-
-    auto path = territoryType->getString( territoryType->data().LVB );
-
-    if( path.empty() )
-      continue;
+namespace fs = std::filesystem;
 
-    path = std::string( "bg/" ) + path.substr( 0, path.find( "/level/" ) );
+namespace
+{
+  // reads and parses the bg/planmap/planevent/planner lgb files of a single territory
+  std::vector< LGB_FILE > loadLgbFiles( const std::string& path )
+  {
+    auto& exdData = Sapphire::Common::Service< Sapphire::Data::ExdData >::ref();
 
     // TODO: it does feel like this needs to be streamlined into the datReader instead of being done here...
     std::string bgLgbPath( path + "/level/bg.lgb" );
@@ -56,7 +60,7 @@ Sapphire::InstanceObjectCache::InstanceObjectCache()
       if( exdData.getGameData()->doesFileExist( bgLgbPath ) )
         bgFile = exdData.getGameData()->getFile( bgLgbPath );
       else
-        continue;
+        return {};
 
       planmap_file = exdData.getGameData()->getFile( planmapLgbPath );
       planevent_file = exdData.getGameData()->getFile( planeventLgbPath );
@@ -64,99 +68,294 @@ Sapphire::InstanceObjectCache::InstanceObjectCache()
     catch( std::runtime_error& )
     {
       // ignore files that aren't found
-      continue;
+      return {};
     }
 
     bgSection = bgFile->access_data_sections().at( 0 );
     planmapSection = planmap_file->access_data_sections().at( 0 );
     planeventSection = planevent_file->access_data_sections().at( 0 );
 
-    std::vector< std::string > stringList;
-
-    uint32_t offset1 = 0x20;
-
     LGB_FILE bgLgb( &bgSection[ 0 ], "bg" );
     LGB_FILE planmapLgb( &planmapSection[ 0 ], "planmap" );
     LGB_FILE planeventLgb( &planeventSection[ 0 ], "planevent" );
 
-    uint32_t max_index = 0;
-
-    std::vector< LGB_FILE > lgbList;
-
     try
     {
       planner_file = exdData.getGameData()->getFile( plannerLgbPath );
       plannerSection = planner_file->access_data_sections().at( 0 );
       LGB_FILE plannerLgb( &plannerSection[ 0 ], "planner" );
 
-      lgbList = { bgLgb, planmapLgb, planeventLgb, plannerLgb };
+      return { bgLgb, planmapLgb, planeventLgb, plannerLgb };
     }
     catch( std::runtime_error& )
     {
-      lgbList = { bgLgb, planmapLgb, planeventLgb };
+      return { bgLgb, planmapLgb, planeventLgb };
     }
+  }
 
-    for( const auto& lgb : lgbList )
+  const char SnapshotMagic[ 8 ] = { 'S', 'A', 'P', 'P', 'L', 'G', 'B', 0 };
+
+  // bump when the record layout changes, changed lgb structs are caught by the layout hash
+  const uint32_t SnapshotVersion = 1;
+
+  struct SnapshotHeader
+  {
+    char magic[ 8 ];
+    uint32_t version;
+    uint32_t recordCount;
+    uint64_t dataHash;
+    uint64_t layoutHash;
+    uint64_t recordsSize;
+  };
+
+  // followed by the lgb struct of the object, its name and padding up to the next record
+  struct SnapshotRecord
+  {
+    uint16_t territoryId;
+    uint16_t assetType;
+    uint32_t size;
+  };
+
+  const size_t RecordAlignment = 8;
+
+  size_t paddedSize( size_t size )
+  {
+    return ( size + RecordAlignment - 1 ) & ~( RecordAlignment - 1 );
+  }
+
+  uint64_t fnv1a( uint64_t hash, const void* data, size_t size )
+  {
+    auto bytes = static_cast< const uint8_t* >( data );
+    for( size_t i = 0; i < size; ++i )
     {
-      for( const auto& group : lgb.groups )
+      hash ^= bytes[ i ];
+      hash *= 0x100000001B3ull;
+    }
+    return hash;
+  }
+
+  const uint64_t FnvOffset = 0xCBF29CE484222325ull;
+
+  uint64_t snapshotLayoutHash()
+  {
+    const uint32_t sizes[] = {
+      sizeof( SnapshotHeader ), sizeof( SnapshotRecord ), sizeof( InstanceObject ), sizeof( MapRangeData ),
+      sizeof( ExitRangeData ), sizeof( PopRangeData ), sizeof( EObjData ), sizeof( ENPCData ), sizeof( EventRangeData )
+    };
+    return fnv1a( FnvOffset, sizes, sizeof( sizes ) );
+  }
+
+  /*!
+   * @brief Hashes the game version and the size and write time of every sqpack index
+   *
+   * The version file changes with every patch, the index files catch sqpacks modified in between
+   * without reading the data files themselves.
+   *
+   * @return the hash, 0 if the data folder could not be read
+   */
+  uint64_t hashGameData( const std::string& dataPath )
+  {
+    try
+    {
+      auto hash = FnvOffset;
+
+      std::ifstream verFile( dataPath + "/../ffxivgame.ver", std::ios::binary );
+      std::string version( ( std::istreambuf_iterator< char >( verFile ) ), std::istreambuf_iterator< char >() );
+      hash = fnv1a( hash, version.data(), version.size() );
+
+      std::vector< fs::path > indexFiles;
+      for( const auto& entry : fs::recursive_directory_iterator( dataPath ) )
       {
-        for( const auto& pEntry : group.entries )
+        if( entry.is_regular_file() && entry.path().extension().string().rfind( ".index", 0 ) == 0 )
+          indexFiles.push_back( entry.path() );
+      }
+
+      if( indexFiles.empty() )
+        return 0;
+
+      // directory iteration order is not stable between runs
+      std::sort( indexFiles.begin(), indexFiles.end() );
+
+      for( const auto& file : indexFiles )
+      {
+        auto name = fs::relative( file, dataPath ).generic_string();
+        uint64_t size = fs::file_size( file );
+        int64_t writeTime = fs::last_write_time( file ).time_since_epoch().count();
+
+        hash = fnv1a( hash, name.data(), name.size() );
+        hash = fnv1a( hash, &size, sizeof( size ) );
+        hash = fnv1a( hash, &writeTime, sizeof( writeTime ) );
+      }
+
+      return hash == 0 ? 1 : hash;
+    }
+    catch( const fs::filesystem_error& e )
+    {
+      Sapphire::Logger::warn( "InstanceObjectCache: unable to hash game data, snapshot disabled: {}", e.what() );
+      return 0;
+    }
+  }
+
+  // read only view of a whole file, mapped where possible so the kernel only pages in what gets read
+  class MappedFile
+  {
+  public:
+    explicit MappedFile( const std::string& path )
+    {
+#ifndef _WIN32
+      int fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+      if( fd < 0 )
+        return;
+
+      struct stat info{};
+      if( fstat( fd, &info ) == 0 && info.st_size > 0 )
+      {
+        auto map = mmap( nullptr, static_cast< size_t >( info.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( map != MAP_FAILED )
         {
-          switch( pEntry->getType() )
-          {
-            case eAssetType::MapRange:
-            {
-              auto pMapRange = std::reinterpret_pointer_cast< MapRangeEntry >( pEntry );
-              m_mapRangeCache.insert( id, pMapRange );
-
-              break;
-            }
-            case eAssetType::ExitRange:
-            {
-              auto pExitRange = std::reinterpret_pointer_cast< ExitRangeEntry >( pEntry );
-              m_exitRangeCache.insert( id, pExitRange );
-
-              break;
-            }
-            case eAssetType::PopRange:
-            {
-              auto pPopRange = std::reinterpret_pointer_cast< PopRangeEntry >( pEntry );
-              m_popRangeCache.insert( id, pPopRange );
-              break;
-            }
-            case eAssetType::CollisionBox:
-            {
-              //auto pEObj = std::reinterpret_pointer_cast< LGB_ENPC_ENTRY >( pEntry );
-
-              //Logger::debug( "CollisionBox {}", pEntry->header.nameOffset );
-              break;
-            }
-            case eAssetType::EventObject:
-            {
-              auto pEObj = std::reinterpret_pointer_cast< EventObjectEntry >( pEntry );
-              m_eobjCache.insert( 0, pEObj );
-              m_eobjBaseInstanceMap.emplace( std::make_pair( id, pEObj->header.BaseId ), pEObj->header.InstanceID );
-              break;
-            }
-            case eAssetType::EventNPC:
-            {
-              auto pENpc = std::reinterpret_pointer_cast< EventNPCEntry >( pEntry );
-              m_enpcCache.insert( id, pENpc );
-              break;
-            }
-            case eAssetType::EventRange:
-            {
-              auto pEventRange = std::reinterpret_pointer_cast< EventRangeEntry >( pEntry );
-              m_eventRangeCache.insert( 0, pEventRange );
-              break;
-            }
-          }
+          madvise( map, static_cast< size_t >( info.st_size ), MADV_SEQUENTIAL );
+          m_data = static_cast< const char* >( map );
+          m_size = static_cast< size_t >( info.st_size );
         }
       }
+
+      close( fd );
+#else
+      std::ifstream in( path, std::ios::binary );
+      m_buffer.assign( std::istreambuf_iterator< char >( in ), std::istreambuf_iterator< char >() );
+      m_data = m_buffer.data();
+      m_size = m_buffer.size();
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+      if( m_data )
+        munmap( const_cast< char* >( m_data ), m_size );
+#endif
+    }
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    const char* data() const
+    {
+      return m_data;
+    }
+
+    size_t size() const
+    {
+      return m_size;
     }
+
+  private:
+    const char* m_data{ nullptr };
+    size_t m_size{ 0 };
+#ifdef _WIN32
+    std::vector< char > m_buffer;
+#endif
+  };
+
+  template< typename EntryT >
+  void appendRecord( std::vector< char >& out, uint16_t territoryId, const InstanceObjectEntry& entry )
+  {
+    const auto& typed = static_cast< const EntryT& >( entry );
+
+    // the name is stored right behind the struct, the entry constructors resolve it through the Name offset
+    auto data = typed.header;
+    data.Name = sizeof( data );
+
+    SnapshotRecord record{ territoryId, static_cast< uint16_t >( entry.getType() ),
+                           static_cast< uint32_t >( sizeof( data ) + typed.name.size() + 1 ) };
+
+    auto begin = out.size();
+    out.resize( begin + sizeof( record ) + paddedSize( record.size ), 0 );
+
+    auto pos = out.data() + begin;
+    std::memcpy( pos, &record, sizeof( record ) );
+    pos += sizeof( record );
+    std::memcpy( pos, &data, sizeof( data ) );
+    std::memcpy( pos + sizeof( data ), typed.name.c_str(), typed.name.size() + 1 );
   }
 
-  std::cout << std::endl;
+  void appendRecord( std::vector< char >& out, uint16_t territoryId, const InstanceObjectEntry& entry )
+  {
+    switch( entry.getType() )
+    {
+      case eAssetType::MapRange:
+        return appendRecord< MapRangeEntry >( out, territoryId, entry );
+      case eAssetType::ExitRange:
+        return appendRecord< ExitRangeEntry >( out, territoryId, entry );
+      case eAssetType::PopRange:
+        return appendRecord< PopRangeEntry >( out, territoryId, entry );
+      case eAssetType::EventObject:
+        return appendRecord< EventObjectEntry >( out, territoryId, entry );
+      case eAssetType::EventNPC:
+        return appendRecord< EventNPCEntry >( out, territoryId, entry );
+      case eAssetType::EventRange:
+        return appendRecord< EventRangeEntry >( out, territoryId, entry );
+      default:
+        return;
+    }
+  }
+
+  template< typename EntryT, typename DataT >
+  std::shared_ptr< InstanceObjectEntry > readRecord( const char* data, uint32_t size )
+  {
+    if( size <= sizeof( DataT ) )
+      return nullptr;
+
+    InstanceObject base{};
+    std::memcpy( &base, data, sizeof( base ) );
+    if( base.Name != static_cast< int32_t >( sizeof( DataT ) ) )
+      return nullptr;
+
+    // the constructors only copy out of the buffer, it does not outlive the mapping
+    auto pEntry = std::make_shared< EntryT >( const_cast< char* >( data ), 0 );
+    pEntry->m_buf = nullptr;
+    return pEntry;
+  }
+
+  std::shared_ptr< InstanceObjectEntry > readRecord( eAssetType type, const char* data, uint32_t size )
+  {
+    switch( type )
+    {
+      case eAssetType::MapRange:
+        return readRecord< MapRangeEntry, MapRangeData >( data, size );
+      case eAssetType::ExitRange:
+        return readRecord< ExitRangeEntry, ExitRangeData >( data, size );
+      case eAssetType::PopRange:
+        return readRecord< PopRangeEntry, PopRangeData >( data, size );
+      case eAssetType::EventObject:
+        return readRecord< EventObjectEntry, EObjData >( data, size );
+      case eAssetType::EventNPC:
+        return readRecord< EventNPCEntry, ENPCData >( data, size );
+      case eAssetType::EventRange:
+        return readRecord< EventRangeEntry, EventRangeData >( data, size );
+      default:
+        return nullptr;
+    }
+  }
+}
+
+Sapphire::InstanceObjectCache::InstanceObjectCache()
+{
+  auto& config = Common::Service< World::WorldServer >::ref().getConfig();
+  const auto& snapshotPath = config.territory.snapshotPath;
+
+  auto dataHash = snapshotPath.empty() ? 0 : hashGameData( config.global.general.dataPath );
+
+  if( dataHash == 0 )
+  {
+    loadFromGameData( nullptr );
+  }
+  else if( !loadSnapshot( snapshotPath, dataHash ) )
+  {
+    std::vector< char > records;
+    auto recordCount = loadFromGameData( &records );
+    writeSnapshot( snapshotPath, dataHash, records, recordCount );
+  }
 
   Logger::debug(
     "InstanceObjectCache Cached: MapRange: {} ExitRange: {} PopRange: {} EventObj: {} EventNpc: {} EventRange: {}",
@@ -164,6 +363,236 @@ Sapphire::InstanceObjectCache::InstanceObjectCache()
   );
 }
 
+uint32_t Sapphire::InstanceObjectCache::loadFromGameData( std::vector< char >* snapshot )
+{
+  auto& exdData = Common::Service< Sapphire::Data::ExdData >::ref();
+  auto& server = Common::Service< World::WorldServer >::ref();
+  auto teriList = exdData.getRows< Excel::TerritoryType >();
+
+  // parsing is independent per territory, only filling the caches has to happen on this thread
+  Common::Util::ThreadPool pool( server.getConfig().territory.bootstrapThreads );
+  std::vector< std::pair< uint16_t, std::future< std::vector< LGB_FILE > > > > jobs;
+
+  for( const auto& [ id, territoryType ] : teriList )
+  {
+    auto path = territoryType->getString( territoryType->data().LVB );
+
+    if( path.empty() )
+      continue;
+
+    path = std::string( "bg/" ) + path.substr( 0, path.find( "/level/" ) );
+
+    jobs.emplace_back( id, pool.queue( [ path ]() { return loadLgbFiles( path ); } ) );
+  }
+
+  uint32_t cached = 0;
+  size_t count = 0;
+  for( auto& [ id, job ] : jobs )
+  {
+    // show some loading indication...
+    if( count++ % 10 == 0 )
+      std::cout << ".";
+
+    auto lgbList = job.get();
+
+    for( const auto& lgb : lgbList )
+    {
+      for( const auto& group : lgb.groups )
+      {
+        for( const auto& pEntry : group.entries )
+        {
+          if( !insertEntry( id, pEntry ) )
+            continue;
+
+          ++cached;
+          if( snapshot )
+            appendRecord( *snapshot, id, *pEntry );
+        }
+      }
+    }
+  }
+
+  std::cout << std::endl;
+
+  return cached;
+}
+
+bool Sapphire::InstanceObjectCache::insertEntry( uint16_t territoryId, const std::shared_ptr< InstanceObjectEntry >& pEntry )
+{
+  switch( pEntry->getType() )
+  {
+    case eAssetType::MapRange:
+    {
+      auto pMapRange = std::reinterpret_pointer_cast< MapRangeEntry >( pEntry );
+      m_mapRangeCache.insert( territoryId, pMapRange );
+      return true;
+    }
+    case eAssetType::ExitRange:
+    {
+      auto pExitRange = std::reinterpret_pointer_cast< ExitRangeEntry >( pEntry );
+      m_exitRangeCache.insert( territoryId, pExitRange );
+      return true;
+    }
+    case eAssetType::PopRange:
+    {
+      auto pPopRange = std::reinterpret_pointer_cast< PopRangeEntry >( pEntry );
+      m_popRangeCache.insert( territoryId, pPopRange );
+      return true;
+    }
+    case eAssetType::CollisionBox:
+    {
+      //auto pEObj = std::reinterpret_pointer_cast< LGB_ENPC_ENTRY >( pEntry );
+
+      //Logger::debug( "CollisionBox {}", pEntry->header.nameOffset );
+      return false;
+    }
+    case eAssetType::EventObject:
+    {
+      auto pEObj = std::reinterpret_pointer_cast< EventObjectEntry >( pEntry );
+      m_eobjCache.insert( 0, pEObj );
+      m_eobjBaseInstanceMap.emplace( std::make_pair( territoryId, pEObj->header.BaseId ), pEObj->header.InstanceID );
+      return true;
+    }
+    case eAssetType::EventNPC:
+    {
+      auto pENpc = std::reinterpret_pointer_cast< EventNPCEntry >( pEntry );
+      m_enpcCache.insert( territoryId, pENpc );
+      return true;
+    }
+    case eAssetType::EventRange:
+    {
+      auto pEventRange = std::reinterpret_pointer_cast< EventRangeEntry >( pEntry );
+      m_eventRangeCache.insert( 0, pEventRange );
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool Sapphire::InstanceObjectCache::loadSnapshot( const std::string& path, uint64_t dataHash )
+{
+  std::error_code ec;
+  if( !fs::exists( path, ec ) )
+    return false;
+
+  MappedFile file( path );
+  if( file.size() < sizeof( SnapshotHeader ) )
+  {
+    Logger::warn( "InstanceObjectCache: unable to read snapshot {}, rebuilding it", path );
+    return false;
+  }
+
+  SnapshotHeader header{};
+  std::memcpy( &header, file.data(), sizeof( header ) );
+
+  if( std::memcmp( header.magic, SnapshotMagic, sizeof( SnapshotMagic ) ) != 0 || header.version != SnapshotVersion ||
+      header.layoutHash != snapshotLayoutHash() )
+  {
+    Logger::info( "InstanceObjectCache: snapshot {} has an outdated format, rebuilding it", path );
+    return false;
+  }
+
+  if( header.dataHash != dataHash )
+  {
+    Logger::info( "InstanceObjectCache: snapshot {} was built from different game data, rebuilding it", path );
+    return false;
+  }
+
+  // every record is checked before the first one is cached, a damaged file must not leave the caches half filled
+  std::vector< std::pair< uint16_t, std::shared_ptr< InstanceObjectEntry > > > entries;
+  entries.reserve( header.recordCount );
+
+  const char* pos = file.data() + sizeof( header );
+  const char* end = file.data() + file.size();
+  bool damaged = header.recordsSize != static_cast< uint64_t >( end - pos );
+
+  for( uint32_t i = 0; i < header.recordCount && !damaged; ++i )
+  {
+    SnapshotRecord record{};
+    if( static_cast< size_t >( end - pos ) < sizeof( record ) )
+    {
+      damaged = true;
+      break;
+    }
+
+    std::memcpy( &record, pos, sizeof( record ) );
+    pos += sizeof( record );
+
+    if( record.size == 0 || paddedSize( record.size ) > static_cast< size_t >( end - pos ) || pos[ record.size - 1 ] != 0 )
+    {
+      damaged = true;
+      break;
+    }
+
+    auto pEntry = readRecord( static_cast< eAssetType >( record.assetType ), pos, record.size );
+    if( !pEntry )
+    {
+      damaged = true;
+      break;
+    }
+
+    entries.emplace_back( record.territoryId, std::move( pEntry ) );
+    pos += paddedSize( record.size );
+  }
+
+  if( damaged || pos != end )
+  {
+    Logger::warn( "InstanceObjectCache: snapshot {} is damaged, rebuilding it", path );
+    return false;
+  }
+
+  for( const auto& [ territoryId, pEntry ] : entries )
+    insertEntry( territoryId, pEntry );
+
+  Logger::info( "InstanceObjectCache: loaded {} objects from snapshot {}", entries.size(), path );
+  return true;
+}
+
+void Sapphire::InstanceObjectCache::writeSnapshot( const std::string& path, uint64_t dataHash,
+                                                   const std::vector< char >& records, uint32_t recordCount ) const
+{
+  std::error_code ec;
+  fs::path target( path );
+  if( target.has_parent_path() )
+    fs::create_directories( target.parent_path(), ec );
+
+  // a server killed while writing must not leave a truncated snapshot behind for the next start
+  auto tmpPath = path + ".tmp";
+
+  SnapshotHeader header{};
+  std::memcpy( header.magic, SnapshotMagic, sizeof( SnapshotMagic ) );
+  header.version = SnapshotVersion;
+  header.recordCount = recordCount;
+  header.dataHash = dataHash;
+  header.layoutHash = snapshotLayoutHash();
+  header.recordsSize = records.size();
+
+  {
+    std::ofstream out( tmpPath, std::ios::binary | std::ios::trunc );
+    out.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+    out.write( records.data(), static_cast< std::streamsize >( records.size() ) );
+
+    if( !out )
+    {
+      Logger::warn( "InstanceObjectCache: unable to write snapshot {}", tmpPath );
+      out.close();
+      fs::remove( tmpPath, ec );
+      return;
+    }
+  }
+
+  fs::rename( tmpPath, target, ec );
+  if( ec )
+  {
+    Logger::warn( "InstanceObjectCache: unable to replace snapshot {}: {}", path, ec.message() );
+    fs::remove( tmpPath, ec );
+    return;
+  }
+
+  Logger::info( "InstanceObjectCache: wrote {} objects to snapshot {}", recordCount, path );
+}
+
 
 Sapphire::InstanceObjectCache::MapRangePtr
   Sapphire::InstanceObjectCache::getMapRange( uint16_t zoneId, uint32_t mapRangeId )
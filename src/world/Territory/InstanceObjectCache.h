@@ -4,8 +4,11 @@
 #include <memory>
 #include <unordered_map>
 #include <map>
+#include <string>
+#include <vector>
 #include <Common.h>
 
+class InstanceObjectEntry;
 struct MapRangeEntry;
 struct ExitRangeEntry;
 struct PopRangeEntry;
@@ -117,6 +120,35 @@ namespace Sapphire
     EventRangePtr getEventRange( uint32_t eventRangeId );
 
   private:
+    /*!
+     * @brief Parses the lgb files of every territory and fills the caches
+     * @param snapshot Receives the snapshot records of every cached object when not null
+     * @return number of cached objects
+     */
+    uint32_t loadFromGameData( std::vector< char >* snapshot );
+
+    /*!
+     * @brief Fills the caches from a snapshot written by a previous start
+     *
+     * The snapshot is memory mapped and only accepted if its format version and game data hash match,
+     * a missing, stale or damaged snapshot leaves the caches untouched.
+     *
+     * @return true if every object was loaded from the snapshot
+     */
+    bool loadSnapshot( const std::string& path, uint64_t dataHash );
+
+    /*!
+     * @brief Writes the records collected by loadFromGameData, replaces an existing snapshot only once complete
+     */
+    void writeSnapshot( const std::string& path, uint64_t dataHash, const std::vector< char >& records,
+                        uint32_t recordCount ) const;
+
+    /*!
+     * @brief Sorts a parsed object into its cache, objects of other asset types are ignored
+     * @return true if the object was cached
+     */
+    bool insertEntry( uint16_t territoryId, const std::shared_ptr< InstanceObjectEntry >& pEntry );
+
     ObjectCache< MapRangeEntry > m_mapRangeCache;
     ObjectCache< ExitRangeEntry > m_exitRangeCache;
     ObjectCache< PopRangeEntry > m_popRangeCache;
@@ -2,6 +2,7 @@
 #include <Common.h>
 #include <Logging/Logger.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Util/UtilMath.h>
 #include <Exd/ExdData.h>
 #include <Network/CommonActorControl.h>
@@ -123,10 +124,10 @@ void Sapphire::QuestBattle::onUpdate( uint64_t tickCount )
 
       if( m_instanceCommenceTime == 0 )
       {
-        m_instanceCommenceTime = Util::getTimeMs() + instanceStartDelay;
+        m_instanceCommenceTime = Util::FrameClock::getTimeMs() + instanceStartDelay;
         return;
       }
-      else if( Util::getTimeMs() < m_instanceCommenceTime )
+      else if( Util::FrameClock::getTimeMs() < m_instanceCommenceTime )
         return;
 
       onEnterSceneFinish( *m_pPlayer );
@@ -5,6 +5,7 @@
 
 #include <Logging/Logger.h>
 #include <Util/Util.h>
+#include <Util/FrameClock.h>
 #include <Util/UtilMath.h>
 #include <Network/GamePacket.h>
 #include <Exd/ExdData.h>
@@ -73,7 +74,7 @@ Territory::Territory( uint16_t territoryTypeId, uint32_t guId, const std::string
   m_nextEObjId( START_EOBJ_ID ),
   m_nextActorId( START_GAMEOBJECT_ID ),
   m_lastUpdate( 0 ),
-  m_lastActivityTime( Common::Util::getTimeMs() ),
+  m_lastActivityTime( Common::Util::FrameClock::getTimeMs() ),
   m_inRangeDistance( 80.f )
 {
   auto& exdData = Common::Service< Data::ExdData >::ref();
@@ -92,7 +93,7 @@ Territory::Territory( uint16_t territoryTypeId, uint32_t guId, const std::string
   m_ident.territoryTypeId = territoryTypeId;
   loadWeatherRates();
 
-  loadBNpcs();
+  m_randomStream = Common::Service< Common::Random::RNGMgr >::ref().createStream( guId );
 
   m_currentWeather = getNextWeather();
 }
@@ -124,8 +125,23 @@ void Territory::loadWeatherRates()
 
 Territory::~Territory() = default;
 
+void Territory::preload()
+{
+  if( m_bPreloaded )
+    return;
+
+  loadBNpcs();
+
+  auto& naviMgr = Common::Service< Common::Navi::NaviMgr >::ref();
+  naviMgr.setupTerritory( m_bgPath, m_guId );
+
+  m_bPreloaded = true;
+}
+
 bool Territory::init()
 {
+  preload();
+
   auto& scriptMgr = Common::Service< Scripting::ScriptMgr >::ref();
 
   if( scriptMgr.onZoneInit( *this ) )
@@ -134,11 +150,7 @@ bool Territory::init()
   }
 
   auto& naviMgr = Common::Service< Common::Navi::NaviMgr >::ref();
-  std::string lvb = m_territoryTypeInfo->getString( m_territoryTypeInfo->data().LVB );
-
-  naviMgr.setupTerritory( lvb, m_guId );
-
-  m_pNaviProvider = naviMgr.getNaviProvider( lvb, m_guId );
+  m_pNaviProvider = naviMgr.getNaviProvider( m_bgPath, m_guId );
 
   if( !m_pNaviProvider )
   {
@@ -227,6 +239,18 @@ void Territory::pushActor( const Entity::GameObjectPtr& pActor )
 
   pActor->setCellId( { cx, cy } );
 
+  // actors pushed again without being removed keep their handle
+  bool isNewActor = m_actorTable.resolve( pActor->getHandle() ) != pActor;
+  if( isNewActor )
+  {
+    pActor->setHandle( m_actorTable.insert( pActor ) );
+    m_actorIdHandles[ pActor->getId() ] = pActor->getHandle();
+
+    // effects brought along from another zone are driven by this one now
+    if( auto pChara = pActor->getAsChara() )
+      m_statusEffectQueue.scheduleAll( *pChara );
+  }
+
   uint32_t cellX = getPosX( pActor->getPos().x );
   uint32_t cellY = getPosY( pActor->getPos().z );
 
@@ -252,6 +276,9 @@ void Territory::pushActor( const Entity::GameObjectPtr& pActor )
   {
     auto pPlayer = pActor->getAsPlayer();
 
+    if( m_bHibernating )
+      wake( Common::Util::FrameClock::getTimeMs() );
+
     if( m_pNaviProvider )
       agentId = m_pNaviProvider->addAgent( pPlayer->getPos(), pPlayer->getRadius() );
     pPlayer->setAgentId( agentId );
@@ -275,6 +302,8 @@ void Territory::pushActor( const Entity::GameObjectPtr& pActor )
     }
 
     m_bNpcMap[ pBNpc->getId() ] = pBNpc;
+    if( isNewActor )
+      m_bNpcLayoutIdHandles.emplace( pBNpc->getLayoutId(), pBNpc->getHandle() );
     updateCellActivity( cx, cy, 1 );
   }
   else if( pActor->isEventObj() )
@@ -329,6 +358,16 @@ void Territory::removeActor( const Entity::GameObjectPtr& pActor )
     if( m_pNaviProvider )
       m_pNaviProvider->removeAgent( pActor->getAsChara()->getAgentId() );
     m_bNpcMap.erase( pActor->getId() );
+
+    auto range = m_bNpcLayoutIdHandles.equal_range( pActor->getAsBNpc()->getLayoutId() );
+    for( auto it = range.first; it != range.second; ++it )
+    {
+      if( it->second == pActor->getHandle() )
+      {
+        m_bNpcLayoutIdHandles.erase( it );
+        break;
+      }
+    }
   }
   else if( pActor->isEventObj() )
   {
@@ -343,6 +382,16 @@ void Territory::removeActor( const Entity::GameObjectPtr& pActor )
       m_bNpcAreaObjects.erase( pArea->getOwnerId() );
   }
 
+  auto idIt = m_actorIdHandles.find( pActor->getId() );
+  if( idIt != m_actorIdHandles.end() && idIt->second == pActor->getHandle() )
+    m_actorIdHandles.erase( idIt );
+
+  if( m_actorTable.resolve( pActor->getHandle() ) == pActor )
+  {
+    m_actorTable.remove( pActor->getHandle() );
+    pActor->setHandle( Common::Util::InvalidHandle );
+  }
+
   // remove from lists of other actors
   pActor->removeFromInRange();
   pActor->clearInRangeSet();
@@ -418,6 +467,11 @@ std::size_t Territory::getPopCount() const
   return m_playerMap.size();
 }
 
+std::size_t Territory::getBNpcCount() const
+{
+  return m_bNpcMap.size();
+}
+
 bool Territory::checkWeather()
 {
   if( m_weatherOverride != Common::Weather::None )
@@ -446,7 +500,7 @@ void Territory::updateBNpcs( uint64_t tickCount )
     return;
 
   m_lastMobUpdate = tickCount;
-  uint64_t currTime = Common::Util::getTimeSeconds();
+  uint64_t currTime = Common::Util::FrameClock::getTimeSeconds();
 
   // Update loop may move actors from cell to cell, breaking iterator validity
   std::vector< Entity::BNpcPtr > activeBNpc;
@@ -484,10 +538,16 @@ uint64_t Territory::getLastActivityTime() const
   return m_lastActivityTime;
 }
 
+uint64_t Territory::getLastUpdateTime() const
+{
+  return m_lastUpdate;
+}
+
 bool Territory::update( uint64_t tickCount )
 {
   //TODO: this should be moved to a updateWeather call and pulled out of updateSessions
-  bool changedWeather = checkWeather();
+  bool changedWeather = checkWeather() || m_bWeatherChangedOnWake;
+  m_bWeatherChangedOnWake = false;
 
   auto dt = static_cast< float >( std::difftime( tickCount, m_lastUpdate ) / 1000.f );
 
@@ -495,6 +555,7 @@ bool Territory::update( uint64_t tickCount )
     m_pNaviProvider->updateCrowd( dt );
 
   updateSessions( tickCount, changedWeather );
+  m_statusEffectQueue.update( *this, tickCount );
   onUpdate( tickCount );
 
   if( !m_playerMap.empty() )
@@ -512,6 +573,66 @@ bool Territory::update( uint64_t tickCount )
   return true;
 }
 
+bool Territory::canHibernate() const
+{
+  return m_playerMap.empty();
+}
+
+bool Territory::isHibernating() const
+{
+  return m_bHibernating;
+}
+
+void Territory::hibernate( uint64_t tickCount )
+{
+  if( m_bHibernating )
+    return;
+
+  // park crowd agents, otherwise they resume their stale corridors on wake
+  if( m_pNaviProvider )
+  {
+    for( const auto& [ id, pBNpc ] : m_bNpcMap )
+    {
+      if( pBNpc->pathingActive() )
+        m_pNaviProvider->resetMoveTarget( pBNpc->getAgentId() );
+    }
+  }
+
+  m_bHibernating = true;
+  m_lastUpdate = tickCount;
+
+  Logger::debug( "Territory#{0}|{1} is now hibernating", getGuId(), getTerritoryTypeId() );
+}
+
+void Territory::wake( uint64_t tickCount )
+{
+  if( !m_bHibernating )
+    return;
+
+  m_bHibernating = false;
+
+  // weather and respawns are purely time based, one pass catches up on everything missed while asleep
+  m_bWeatherChangedOnWake = checkWeather();
+  updateSpawnPoints();
+
+  // the crowd was not stepped while asleep, don't hand it the whole sleep duration as a single dt
+  m_lastUpdate = tickCount;
+  m_lastActivityTime = tickCount;
+
+  Logger::debug( "Territory#{0}|{1} woke up", getGuId(), getTerritoryTypeId() );
+}
+
+void Territory::updateHibernating( uint64_t tickCount )
+{
+  onHibernateUpdate( tickCount );
+  m_lastUpdate = tickCount;
+}
+
+void Territory::onHibernateUpdate( uint64_t tickCount )
+{
+  checkWeather();
+}
+
 void Territory::updateSessions( uint64_t tickCount, bool changedWeather )
 {
   auto& server = Common::Service< World::WorldServer >::ref();
@@ -565,7 +686,7 @@ bool Territory::isCellActive( uint32_t x, uint32_t y )
   uint32_t posY;
 
   CellPtr pCell;
-  uint32_t time = Common::Util::getTimeSeconds();
+  uint32_t time = Common::Util::FrameClock::getTimeSeconds();
 
   for( posX = startX; posX <= endX; posX++ )
   {
@@ -604,12 +725,12 @@ void Territory::updateCellActivity( uint32_t x, uint32_t y, int32_t radius )
           pCell = create( posX, posY );
           pCell->init( posX, posY );
           pCell->setActivity( true );
-          pCell->setLastActiveTime( Common::Util::getTimeSeconds() );
+          pCell->setLastActiveTime( Common::Util::FrameClock::getTimeSeconds() );
         }
       }
       else
       {
-        pCell->setLastActiveTime( Common::Util::getTimeSeconds() );
+        pCell->setLastActiveTime( Common::Util::FrameClock::getTimeSeconds() );
         //Cell is now active
         if( isCellActive( posX, posY ) && !pCell->isActive() )
         {
@@ -817,6 +938,16 @@ QuestBattlePtr Territory::getAsQuestBattle()
   return std::dynamic_pointer_cast< QuestBattle, Territory >( shared_from_this() );
 }
 
+Common::Random::RandomStream& Territory::getRandomStream()
+{
+  return m_randomStream;
+}
+
+void Territory::setRandomSeed( uint64_t seed )
+{
+  m_randomStream.reseed( seed );
+}
+
 uint32_t Territory::getNextEObjId()
 {
   return ++m_nextEObjId;
@@ -852,7 +983,7 @@ void Territory::updateSpawnPoints()
 
   for( auto& spawn : m_spawnInfo )
   {
-    if( !spawn.bnpcPtr && ( Common::Util::getTimeSeconds() - spawn.timeOfDeath ) > spawn.infoPtr->PopInterval )
+    if( !spawn.bnpcPtr && ( Common::Util::FrameClock::getTimeSeconds() - spawn.timeOfDeath ) > spawn.infoPtr->PopInterval )
     {
       auto pBNpc = std::make_shared< Entity::BNpc >( getNextActorId(), spawn.infoPtr, *this );
       pBNpc->init();
@@ -862,7 +993,7 @@ void Territory::updateSpawnPoints()
     }
     else if( spawn.bnpcPtr && !spawn.bnpcPtr->isAlive() )
     {
-      spawn.timeOfDeath = Common::Util::getTimeSeconds();
+      spawn.timeOfDeath = Common::Util::FrameClock::getTimeSeconds();
       spawn.bnpcPtr.reset();
     }
   }
@@ -911,24 +1042,50 @@ Entity::BNpcPtr Territory::getActiveBNpcByEntityId( uint32_t entityId )
 
 Entity::BNpcPtr Territory::getActiveBNpcByLayoutId( uint32_t instanceId )
 {
-  for( const auto& bnpcIt : m_bNpcMap )
-  {
-    if( bnpcIt.second->getLayoutId() == instanceId )
-      return bnpcIt.second;
-  }
-  return nullptr;
+  auto it = m_bNpcLayoutIdHandles.find( instanceId );
+  if( it == m_bNpcLayoutIdHandles.end() )
+    return nullptr;
+
+  auto pActor = m_actorTable.resolve( it->second );
+  return pActor ? pActor->getAsBNpc() : nullptr;
 }
 
 Entity::BNpcPtr Territory::getActiveBNpcByLayoutIdAndTriggerOwner( uint32_t instanceId, uint32_t triggerOwnerId )
 {
-  for( const auto& bnpcIt : m_bNpcMap )
+  auto range = m_bNpcLayoutIdHandles.equal_range( instanceId );
+  for( auto it = range.first; it != range.second; ++it )
   {
-    if( bnpcIt.second->getLayoutId() == instanceId && bnpcIt.second->getTriggerOwnerId() == triggerOwnerId )
-      return bnpcIt.second;
+    auto pActor = m_actorTable.resolve( it->second );
+    if( pActor && pActor->getAsBNpc()->getTriggerOwnerId() == triggerOwnerId )
+      return pActor->getAsBNpc();
   }
   return nullptr;
 }
 
+Entity::GameObjectPtr Territory::resolveActor( Common::Util::Handle handle ) const
+{
+  return m_actorTable.resolve( handle );
+}
+
+Entity::GameObjectPtr Territory::getActor( uint32_t actorId ) const
+{
+  auto it = m_actorIdHandles.find( actorId );
+  if( it == m_actorIdHandles.end() )
+    return nullptr;
+
+  return m_actorTable.resolve( it->second );
+}
+
+const std::vector< Entity::GameObjectPtr >& Territory::getActors() const
+{
+  return m_actorTable.getObjects();
+}
+
+StatusEffect::StatusEffectQueue& Territory::getStatusEffectQueue()
+{
+  return m_statusEffectQueue;
+}
+
 std::shared_ptr< Common::Navi::NaviProvider > Territory::getNaviProvider()
 {
   return m_pNaviProvider;
@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <Common.h>
+#include <Util/HandleTable.h>
 
 #include "Cell.h"
 #include "CellHandler.h"
@@ -17,6 +18,9 @@
 #include <cstring>
 #include <Exd/Structs.h>
 #include <Navi/NaviProvider.h>
+#include <Random/RandomStream.h>
+
+#include "StatusEffect/StatusEffectQueue.h"
 
 namespace Sapphire
 {
@@ -52,6 +56,14 @@ namespace Sapphire
     std::unordered_map< uint32_t, Entity::AreaObjectPtr > m_playerAreaObjects;
     std::unordered_map< uint32_t, Entity::AreaObjectPtr > m_bNpcAreaObjects;
 
+    /*! every actor currently in the zone, addressed by generational handles */
+    Common::Util::HandleTable< Entity::GameObject > m_actorTable;
+    std::unordered_map< uint32_t, Common::Util::Handle > m_actorIdHandles;
+    std::unordered_multimap< uint32_t, Common::Util::Handle > m_bNpcLayoutIdHandles;
+
+    /*! ticks and expiry of every status effect on charas in the zone */
+    StatusEffect::StatusEffectQueue m_statusEffectQueue;
+
     std::unordered_map< uint32_t, std::shared_ptr< Common::BNpcCacheEntry > > m_bNpcBaseMap;
 
     Common::Weather m_currentWeather;
@@ -63,6 +75,10 @@ namespace Sapphire
 
     uint64_t m_lastActivityTime{};
 
+    bool m_bHibernating{};
+    // weather moved on while hibernating, players that entered meanwhile are told with the next update
+    bool m_bWeatherChangedOnWake{};
+
     FestivalPair m_currentFestival;
 
     std::shared_ptr< Excel::ExcelStruct< Excel::TerritoryType > > m_territoryTypeInfo;
@@ -79,6 +95,11 @@ namespace Sapphire
 
     float m_inRangeDistance;
 
+    bool m_bPreloaded{};
+
+    /*! all combat, loot and spawn rolls of this territory, derived from the root seed */
+    Common::Random::RandomStream m_randomStream;
+
   public:
     Territory();
 
@@ -101,6 +122,12 @@ namespace Sapphire
 
     uint64_t getLastActivityTime() const;
 
+    uint64_t getLastUpdateTime() const;
+
+    /*! loads the zone's static data from disk ( bnpc spawns, navmesh ), does not touch
+        any shared state and can therefore run on a worker thread */
+    virtual void preload();
+
     virtual bool init();
 
     virtual uint32_t getTerritoryTypeId() const;
@@ -119,6 +146,9 @@ namespace Sapphire
 
     virtual void onUpdate( uint64_t tickCount );
 
+    /*! reduced update, run at the wake-up cadence while the zone is hibernating */
+    virtual void onHibernateUpdate( uint64_t tickCount );
+
     virtual void onAddEObj( Entity::EventObjectPtr object ) {};
 
     virtual void onEnterTerritory( Entity::Player& player, uint32_t eventId, uint16_t param1, uint16_t param2 );
@@ -150,6 +180,11 @@ namespace Sapphire
 
     uint32_t getGuId() const;
 
+    Common::Random::RandomStream& getRandomStream();
+
+    /*! restarts the random stream, an instance seeded like a previous one rolls the same outcomes again */
+    void setRandomSeed( uint64_t seed );
+
     uint32_t getNextEObjId();
 
     uint32_t getNextActorId();
@@ -162,6 +197,8 @@ namespace Sapphire
 
     std::size_t getPopCount() const;
 
+    std::size_t getBNpcCount() const;
+
     void loadWeatherRates();
 
     bool loadBNpcs();
@@ -171,6 +208,19 @@ namespace Sapphire
 
     bool update( uint64_t tickCount );
 
+    /*! returns true if nothing in the zone requires regular updates */
+    virtual bool canHibernate() const;
+
+    bool isHibernating() const;
+
+    /*! stops regular updates and parks crowd agents until wake() is called */
+    void hibernate( uint64_t tickCount );
+
+    /*! resumes regular updates, fast-forwarding weather and spawn timers */
+    void wake( uint64_t tickCount );
+
+    void updateHibernating( uint64_t tickCount );
+
     void updateSessions( uint64_t tickCount, bool changedWeather );
 
     Entity::EventObjectPtr addEObj( const std::string& name, uint32_t objectId, uint32_t mapLink, uint32_t instanceId,
@@ -190,6 +240,15 @@ namespace Sapphire
 
     Entity::EventObjectPtr getEObj( uint32_t objId );
 
+    /*! @return actor referenced by handle, nullptr if it left the zone in the meantime */
+    Entity::GameObjectPtr resolveActor( Common::Util::Handle handle ) const;
+
+    Entity::GameObjectPtr getActor( uint32_t actorId ) const;
+
+    const std::vector< Entity::GameObjectPtr >& getActors() const;
+
+    StatusEffect::StatusEffectQueue& getStatusEffectQueue();
+
     Entity::PlayerPtr getPlayer( uint32_t playerId );
 
     const std::unordered_map< uint32_t, Entity::PlayerPtr >& getPlayers();
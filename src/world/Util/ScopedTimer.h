@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <Service.h>
+
+#include "Manager/MetricMgr.h"
+
+namespace Sapphire::World::Util
+{
+  /*!
+   * @brief Records the time until the end of the enclosing scope in MetricMgr.
+   *
+   * Use the SAPPHIRE_PROFILE_* macros instead of this class, they are empty unless the world server is built
+   * with SAPPHIRE_PROFILING.
+   */
+  class ScopedTimer
+  {
+  public:
+    explicit ScopedTimer( Manager::MetricMgr::Timer timer ) :
+      m_timer( timer ),
+      m_start( std::chrono::steady_clock::now() )
+    {
+    }
+
+    ScopedTimer( Manager::MetricMgr::Timer timer, uint32_t territoryTypeId ) :
+      m_timer( timer ),
+      m_territoryTypeId( territoryTypeId ),
+      m_start( std::chrono::steady_clock::now() )
+    {
+    }
+
+    ScopedTimer( const ScopedTimer& ) = delete;
+    ScopedTimer& operator=( const ScopedTimer& ) = delete;
+
+    ~ScopedTimer()
+    {
+      auto us = static_cast< uint64_t >(
+        std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - m_start ).count() );
+
+      auto& metricMgr = Common::Service< Manager::MetricMgr >::ref();
+      if( m_territoryTypeId != 0 )
+        metricMgr.recordTerritoryTime( m_territoryTypeId, us );
+      else
+        metricMgr.recordTime( m_timer, us );
+    }
+
+  private:
+    Manager::MetricMgr::Timer m_timer;
+    uint32_t m_territoryTypeId{ 0 };
+    std::chrono::steady_clock::time_point m_start;
+  };
+}
+
+#define SAPPHIRE_PROFILE_CONCAT_( a, b ) a##b
+#define SAPPHIRE_PROFILE_CONCAT( a, b ) SAPPHIRE_PROFILE_CONCAT_( a, b )
+
+#ifdef SAPPHIRE_PROFILING
+// times the rest of the enclosing scope as one of the MetricMgr::Timer subsystems
+#define SAPPHIRE_PROFILE_SCOPE( timer ) \
+  Sapphire::World::Util::ScopedTimer SAPPHIRE_PROFILE_CONCAT( profileTimer, __LINE__ )( Sapphire::World::Manager::MetricMgr::Timer::timer )
+// times the rest of the enclosing scope as the update of a territory type
+#define SAPPHIRE_PROFILE_TERRITORY( territoryTypeId ) \
+  Sapphire::World::Util::ScopedTimer SAPPHIRE_PROFILE_CONCAT( profileTimer, __LINE__ )( Sapphire::World::Manager::MetricMgr::Timer::Territories, territoryTypeId )
+#else
+#define SAPPHIRE_PROFILE_SCOPE( timer ) do {} while( 0 )
+#define SAPPHIRE_PROFILE_TERRITORY( territoryTypeId ) do {} while( 0 )
+#endif
@@ -0,0 +1,164 @@
+#include "SpawnBudget.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <Service.h>
+#include <Util/Util.h>
+#include <Util/FrameClock.h>
+#include <Util/UtilMath.h>
+
+#include "Actor/Player.h"
+#include "Actor/BNpc.h"
+#include "Manager/TerritoryMgr.h"
+#include "Territory/Territory.h"
+
+using namespace Sapphire;
+using namespace Sapphire::World;
+
+namespace
+{
+  struct SpawnCandidate
+  {
+    Entity::GameObjectPtr pActor;
+    float score;
+  };
+}
+
+Util::SpawnBudget::SpawnBudget( Entity::Player& owner ) :
+  m_owner( owner )
+{
+}
+
+void Util::SpawnBudget::requestSpawn( uint32_t actorId )
+{
+  if( m_spawnedActors.find( actorId ) != m_spawnedActors.end() )
+    return;
+
+  m_pendingSpawns.emplace( actorId, Common::Util::FrameClock::getTimeMs() );
+}
+
+void Util::SpawnBudget::cancelSpawn( uint32_t actorId )
+{
+  m_pendingSpawns.erase( actorId );
+  m_spawnedActors.erase( actorId );
+}
+
+void Util::SpawnBudget::clear()
+{
+  m_pendingSpawns.clear();
+  m_spawnedActors.clear();
+}
+
+bool Util::SpawnBudget::hasPendingSpawns() const
+{
+  return !m_pendingSpawns.empty();
+}
+
+float Util::SpawnBudget::getPriorityScore( Entity::GameObject& actor ) const
+{
+  float score = Common::Util::distance( m_owner.getPos(), actor.getPos() );
+
+  if( m_owner.getTargetId() == actor.getId() )
+    score -= 100.f;
+
+  auto pChara = actor.getAsChara();
+  if( pChara && pChara->getTargetId() == m_owner.getId() )
+    score -= 100.f;
+
+  if( actor.isPlayer() )
+  {
+    auto partyId = m_owner.getPartyId();
+    if( partyId != 0 && actor.getAsPlayer()->getPartyId() == partyId )
+      score -= 50.f;
+  }
+  else if( actor.isBattleNpc() )
+  {
+    if( actor.getAsBNpc()->hateListHasActor( m_owner.getAsChara() ) )
+      score -= 60.f;
+  }
+
+  return score;
+}
+
+void Util::SpawnBudget::update( uint64_t tickCount )
+{
+  if( m_pendingSpawns.empty() )
+    return;
+
+  auto& teriMgr = Common::Service< Manager::TerritoryMgr >::ref();
+  auto pZone = teriMgr.getTerritoryByGuId( m_owner.getTerritoryId() );
+  if( !pZone )
+    return;
+
+  auto pOwner = m_owner.getAsPlayer();
+
+  std::vector< SpawnCandidate > candidates;
+  candidates.reserve( m_pendingSpawns.size() );
+
+  for( auto it = m_pendingSpawns.begin(); it != m_pendingSpawns.end(); )
+  {
+    auto pActor = pZone->getActor( it->first );
+    if( !pActor || !m_owner.isInRangeSet( pActor ) )
+    {
+      it = m_pendingSpawns.erase( it );
+      continue;
+    }
+
+    // actors waiting for a while slowly gain priority so they don't starve
+    auto waitTime = tickCount > it->second ? tickCount - it->second : 0;
+    auto score = getPriorityScore( *pActor ) - std::min( static_cast< float >( waitTime ) / 1000.f, 10.f );
+
+    candidates.push_back( { pActor, score } );
+    ++it;
+  }
+
+  std::sort( candidates.begin(), candidates.end(),
+             []( const SpawnCandidate& a, const SpawnCandidate& b ) { return a.score < b.score; } );
+
+  // spawned actors that may be swapped out, least important one at the back
+  std::vector< SpawnCandidate > swapCandidates;
+  bool swapCandidatesBuilt = false;
+
+  uint32_t spawnCount = 0;
+  for( auto& candidate : candidates )
+  {
+    if( spawnCount >= MaxSpawnsPerUpdate )
+      break;
+
+    if( !m_owner.hasFreeActorSpawnId() )
+    {
+      if( !swapCandidatesBuilt )
+      {
+        for( const auto& [ actorId, spawnTime ] : m_spawnedActors )
+        {
+          if( tickCount < spawnTime + SwapGracePeriodMs )
+            continue;
+
+          auto pActor = pZone->getActor( actorId );
+          if( pActor )
+            swapCandidates.push_back( { pActor, getPriorityScore( *pActor ) } );
+        }
+
+        std::sort( swapCandidates.begin(), swapCandidates.end(),
+                   []( const SpawnCandidate& a, const SpawnCandidate& b ) { return a.score < b.score; } );
+        swapCandidatesBuilt = true;
+      }
+
+      // candidates are sorted, none of the remaining ones will win a swap either
+      if( swapCandidates.empty() || swapCandidates.back().score < candidate.score + SwapScoreMargin )
+        break;
+
+      auto pVictim = swapCandidates.back().pActor;
+      swapCandidates.pop_back();
+
+      pVictim->despawn( pOwner );
+      m_pendingSpawns[ pVictim->getId() ] = tickCount;
+    }
+
+    m_pendingSpawns.erase( candidate.pActor->getId() );
+    m_spawnedActors[ candidate.pActor->getId() ] = tickCount;
+    candidate.pActor->spawn( pOwner );
+    ++spawnCount;
+  }
+}
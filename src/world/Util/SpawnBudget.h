@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <ForwardsZone.h>
+
+namespace Sapphire::World::Util
+{
+  /*!
+   * @brief Decides which in-range actors get one of the limited client spawn slots of a player.
+   *
+   * Actors entering range are only queued here. Every player update the queue is ranked and at most
+   * MaxSpawnsPerUpdate actors are spawned. With all slots taken, a clearly more important actor
+   * replaces the least important spawned one, which goes back to the queue.
+   */
+  class SpawnBudget
+  {
+  public:
+    // spawn packets sent per player update, spreads a zone-in over a few ticks
+    static constexpr uint32_t MaxSpawnsPerUpdate = 12;
+    // spawned actors can't be swapped out during this period to avoid flickering
+    static constexpr uint64_t SwapGracePeriodMs = 5000;
+    // score difference required before a spawned actor is swapped for a queued one
+    static constexpr float SwapScoreMargin = 10.f;
+
+    explicit SpawnBudget( Entity::Player& owner );
+
+    void requestSpawn( uint32_t actorId );
+
+    /*! actor left range or got despawned, forget about it */
+    void cancelSpawn( uint32_t actorId );
+
+    void clear();
+
+    void update( uint64_t tickCount );
+
+    bool hasPendingSpawns() const;
+
+  private:
+    /*! lower is more important, roughly the distance minus relationship bonuses */
+    float getPriorityScore( Entity::GameObject& actor ) const;
+
+    Entity::Player& m_owner;
+
+    // actor id -> time the spawn was requested / the actor got spawned
+    std::unordered_map< uint32_t, uint64_t > m_pendingSpawns;
+    std::unordered_map< uint32_t, uint64_t > m_spawnedActors;
+  };
+
+}
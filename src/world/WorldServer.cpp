@@ -3,12 +3,16 @@
 #include <Network/Connection.h>
 #include <Network/Hive.h>
 #include <Network/PacketContainer.h>
+#include <thread>
 
 #include "Network/GameConnection.h"
+#include "Network/MetricsConnection.h"
 #include "WorldServer.h"
 
 #include <Version.h>
 #include <Logging/Logger.h>
+#include <Util/CrashHandler.h>
+#include <Util/FrameClock.h>
 #include <Config/ConfigMgr.h>
 
 #include <Exd/ExdData.h>
@@ -48,14 +52,19 @@
 #include "Manager/QuestMgr.h"
 #include "Manager/PartyMgr.h"
 #include "Manager/FriendListMgr.h"
+#include "Manager/PresenceMgr.h"
 #include "Manager/BlacklistMgr.h"
 #include "Manager/WarpMgr.h"
 #include "Manager/FreeCompanyMgr.h"
 #include "Manager/MapMgr.h"
+#include "Manager/MetricMgr.h"
 
 #include "ContentFinder/ContentFinder.h"
 
 #include "Territory/InstanceObjectCache.h"
+#include "Inventory/InventoryJournal.h"
+
+#include "Util/ScopedTimer.h"
 
 #include <Navi/NaviMgr.h>
 #include <Random/RNGMgr.h>
@@ -109,16 +118,28 @@ bool WorldServer::loadSettings( int32_t argc, char* argv[] )
   m_config.scripts.hotSwap = configMgr.getValue( "Scripts", "HotSwap", true );
   m_config.scripts.path = configMgr.getValue< std::string >( "Scripts", "Path", "./compiledscripts/" );
   m_config.scripts.cachePath = configMgr.getValue< std::string >( "Scripts", "CachePath", "./cache/" );
+  m_config.scripts.reloadDebounceMs = configMgr.getValue< uint32_t >( "Scripts", "ReloadDebounce", 500 );
 
   m_config.navigation.meshPath = configMgr.getValue< std::string >( "Navigation", "MeshPath", "navi" );
 
+  m_config.territory.hibernate = configMgr.getValue( "Territory", "Hibernate", true );
+  m_config.territory.hibernateDelay = configMgr.getValue< uint32_t >( "Territory", "HibernateDelay", 60000 );
+  m_config.territory.hibernateWakeInterval = configMgr.getValue< uint32_t >( "Territory", "HibernateWakeInterval", 10000 );
+  m_config.territory.bootstrapThreads = configMgr.getValue< uint32_t >( "Territory", "BootstrapThreads", 0 );
+  m_config.territory.snapshotPath = configMgr.getValue< std::string >( "Territory", "Snapshot", "snapshot/lgb.bin" );
+
   m_config.network.disconnectTimeout = configMgr.getValue< uint16_t >( "Network", "DisconnectTimeout", 20 );
   m_config.network.listenIp = configMgr.getValue< std::string >( "Network", "ListenIp", "0.0.0.0" );
   m_config.network.listenPort = configMgr.getValue< uint16_t >( "Network", "ListenPort", 54992 );
   m_config.network.inRangeDistance = configMgr.getValue< float >( "Network", "InRangeDistance", 80.f );
+  m_config.network.outQueueBudget = configMgr.getValue< uint32_t >( "Network", "OutQueueBudget", 262144 );
+
+  m_config.metrics.listenIp = configMgr.getValue< std::string >( "Metrics", "ListenIp", "127.0.0.1" );
+  m_config.metrics.listenPort = configMgr.getValue< uint16_t >( "Metrics", "ListenPort", 54993 );
 
   m_config.motd = configMgr.getValue< std::string >( "General", "MotD", "" );
   m_config.skipOpening = configMgr.getValue( "General", "SkipOpening", false );
+  m_config.randomSeed = std::stoull( configMgr.getValue< std::string >( "General", "RandomSeed", "0" ), nullptr, 0 );
 
   m_config.housing.defaultEstateName = configMgr.getValue< std::string >( "Housing", "DefaultEstateName", "Estate #{}" );
 
@@ -212,8 +233,12 @@ void WorldServer::run( int32_t argc, char* argv[] )
   }
   Common::Service< Db::DbWorkerPool< Db::ZoneDbConnection > >::set( pDb );
 
-  auto pRNGMgr = std::make_shared< Common::Random::RNGMgr >();
+  auto pMetricMgr = std::make_shared< Manager::MetricMgr >();
+  Common::Service< Manager::MetricMgr >::set( pMetricMgr );
+
+  auto pRNGMgr = std::make_shared< Common::Random::RNGMgr >( m_config.randomSeed );
   Common::Service< Common::Random::RNGMgr >::set( pRNGMgr );
+  Logger::info( "RNGMgr: Root seed 0x{:016X}", pRNGMgr->getRootSeed() );
 
   auto pPlayerMgr = std::make_shared< Manager::PlayerMgr >();
   Logger::info( "Loading all players" );
@@ -345,6 +370,18 @@ void WorldServer::run( int32_t argc, char* argv[] )
     return;
   }
 
+  if( m_config.metrics.listenPort != 0 )
+  {
+    try
+    {
+      Network::addServerToHive< Network::MetricsConnection >( m_config.metrics.listenIp, m_config.metrics.listenPort, hive );
+      Logger::info( "Metrics endpoint running on {0}:{1}", m_config.metrics.listenIp, m_config.metrics.listenPort );
+    } catch( std::exception& e )
+    {
+      Logger::error( "Error starting metrics endpoint: {0}", e.what() );
+    }
+  }
+
   std::vector< std::thread > thread_list;
   thread_list.emplace_back( std::thread( std::bind( &Network::Hive::run, hive.get() ) ) );
 
@@ -353,9 +390,11 @@ void WorldServer::run( int32_t argc, char* argv[] )
   auto pInventoryMgr = std::make_shared< Manager::InventoryMgr >();
   auto pEventMgr = std::make_shared< Manager::EventMgr >();
   auto pItemMgr = std::make_shared< Manager::ItemMgr >();
+  auto pInventoryJournal = std::make_shared< Inventory::InventoryJournal >();
   auto pQuestMgr = std::make_shared< Manager::QuestMgr >();
   auto pPartyMgr = std::make_shared< Manager::PartyMgr >();
   auto pFriendMgr = std::make_shared< Manager::FriendListMgr >();
+  auto pPresenceMgr = std::make_shared< Manager::PresenceMgr >();
   auto pBlacklistMgr = std::make_shared< Manager::BlacklistMgr >();
   auto contentFinder = std::make_shared< ContentFinder >();
   auto taskMgr = std::make_shared< Manager::TaskMgr >();
@@ -366,9 +405,11 @@ void WorldServer::run( int32_t argc, char* argv[] )
   Common::Service< Manager::InventoryMgr >::set( pInventoryMgr );
   Common::Service< Manager::EventMgr >::set( pEventMgr );
   Common::Service< Manager::ItemMgr >::set( pItemMgr );
+  Common::Service< Inventory::InventoryJournal >::set( pInventoryJournal );
   Common::Service< Manager::QuestMgr >::set( pQuestMgr );
   Common::Service< Manager::PartyMgr >::set( pPartyMgr );
   Common::Service< Manager::FriendListMgr >::set( pFriendMgr );
+  Common::Service< Manager::PresenceMgr >::set( pPresenceMgr );
   Common::Service< Manager::BlacklistMgr >::set( pBlacklistMgr );
   Common::Service< ContentFinder >::set( contentFinder );
   Common::Service< Manager::TaskMgr >::set( taskMgr );
@@ -377,8 +418,17 @@ void WorldServer::run( int32_t argc, char* argv[] )
 
   Logger::info( "World server running on {0}:{1}", m_ip, m_port );
 
+  Common::Util::CrashHandler::setShutdownHandler( []() { Common::Service< WorldServer >::ref().stop(); } );
+
   mainLoop();
 
+  Logger::info( "World server shutting down" );
+
+  // the tick flush is async, anything not committed yet would be lost with the process
+  pInventoryJournal->flushAll();
+
+  hive->getService().stop();
+
   for( auto& thread_entry : thread_list )
   {
     thread_entry.join();
@@ -414,14 +464,25 @@ void WorldServer::mainLoop()
   auto& contentFinder = Common::Service< ContentFinder >::ref();
 
   auto& taskMgr = Common::Service< World::Manager::TaskMgr >::ref();
+  auto& presenceMgr = Common::Service< World::Manager::PresenceMgr >::ref();
+  auto& partyMgr = Common::Service< World::Manager::PartyMgr >::ref();
+  auto& metricMgr = Common::Service< World::Manager::MetricMgr >::ref();
+  auto& inventoryJournal = Common::Service< Inventory::InventoryJournal >::ref();
 
   while( isRunning() )
   {
-    auto tickCount = Common::Util::getTimeMs();
+    // simulation time for this iteration, sessions and the db keep alive run on the wall clock
+    auto tickCount = Common::Util::FrameClock::advance();
 
     auto currTime = Common::Util::getTimeSeconds();
-    taskMgr.update( tickCount );
-    updateSessions( currTime );
+    {
+      SAPPHIRE_PROFILE_SCOPE( Tasks );
+      taskMgr.update( tickCount );
+    }
+    {
+      SAPPHIRE_PROFILE_SCOPE( Sessions );
+      updateSessions( currTime );
+    }
 
     if( tickCount - m_lastServerTick < 300 )
     {
@@ -430,12 +491,36 @@ void WorldServer::mainLoop()
     }
     m_lastServerTick = tickCount;
 
-    terriMgr.updateTerritoryInstances( tickCount );
-    scriptMgr.update();
-    contentFinder.update();
-
+    {
+      SAPPHIRE_PROFILE_SCOPE( Tick );
+      {
+        SAPPHIRE_PROFILE_SCOPE( Territories );
+        terriMgr.updateTerritoryInstances( tickCount );
+      }
+      {
+        SAPPHIRE_PROFILE_SCOPE( Scripts );
+        scriptMgr.update();
+      }
+      {
+        SAPPHIRE_PROFILE_SCOPE( ContentFinder );
+        contentFinder.update();
+      }
+      {
+        SAPPHIRE_PROFILE_SCOPE( Presence );
+        presenceMgr.update();
+      }
+      {
+        SAPPHIRE_PROFILE_SCOPE( Party );
+        partyMgr.update();
+      }
+      {
+        SAPPHIRE_PROFILE_SCOPE( Database );
+        inventoryJournal.flush();
+        DbKeepAlive( currTime );
+      }
+    }
 
-    DbKeepAlive( currTime );
+    metricMgr.onTick();
   }
 }
 
@@ -512,6 +597,7 @@ bool WorldServer::createSession( uint32_t sessionId )
 
   m_sessionMapById[ sessionId ] = newSession;
   m_sessionMapByCharacterId[ newSession->getPlayer()->getCharacterId() ] = newSession;
+  onSessionChanged( newSession->getPlayer()->getCharacterId() );
 
   return true;
 }
@@ -524,6 +610,7 @@ void WorldServer::removeSession( uint32_t sessionId )
 
   m_sessionMapById.erase( sessionId );
   m_sessionMapByCharacterId.erase( pSession->getPlayer()->getCharacterId() );
+  onSessionChanged( pSession->getPlayer()->getCharacterId() );
 }
 
 SessionPtr WorldServer::getSession( uint32_t id )
@@ -552,6 +639,7 @@ void WorldServer::removeSession( const Entity::Player& player )
 {
   m_sessionMapById.erase( player.getId() );
   m_sessionMapByCharacterId.erase( player.getCharacterId() );
+  onSessionChanged( player.getCharacterId() );
 }
 
 bool WorldServer::isRunning() const
@@ -559,6 +647,11 @@ bool WorldServer::isRunning() const
   return m_bRunning;
 }
 
+void WorldServer::stop()
+{
+  m_bRunning = false;
+}
+
 Sapphire::Common::Config::WorldConfig& WorldServer::getConfig()
 {
   return m_config;
@@ -595,6 +688,20 @@ void WorldServer::queueForPlayers( const std::set< uint64_t >& characterIds, Sap
     queueForPlayer( characterId, pPacket );
 }
 
+void WorldServer::queueDroppableForPlayers( const std::set< uint64_t >& characterIds, Sapphire::Network::Packets::FFXIVPacketBasePtr pPacket )
+{
+  for( auto& characterId : characterIds )
+  {
+    auto pSession = getSession( characterId );
+    if( !pSession )
+      continue;
+
+    auto pZoneCon = pSession->getZoneConnection();
+    if( pZoneCon && !pZoneCon->isCongested() )
+      pZoneCon->queueOutPacket( pPacket );
+  }
+}
+
 void WorldServer::queueForPlayer( uint64_t characterId, std::vector< Sapphire::Network::Packets::FFXIVPacketBasePtr > packets )
 {
   auto pSession = getSession( characterId );
@@ -620,40 +727,33 @@ void WorldServer::queueForPlayers( const std::set< uint64_t >& characterIds, std
 
 void WorldServer::queueForLinkshell( uint64_t lsId, Sapphire::Network::Packets::FFXIVPacketBasePtr pPacket, std::set< uint64_t > exceptionCharIdList )
 {
-  auto lsMgr = Common::Service< Manager::LinkshellMgr >::ref();
-
-  auto ls = lsMgr.getLinkshellById( lsId );
-  if( !ls )
-    return;
-
-  auto members = ls->getAllMemberIds();
-
-  for( const auto& memberId : members )
-  {
-    if( exceptionCharIdList.count( memberId ) )
-      continue;
-
-    queueForPlayer( memberId, pPacket );
-  }
-
+  auto& lsMgr = Common::Service< Manager::LinkshellMgr >::ref();
+  queueForSessions( lsMgr.getOnlineMemberSessions( lsId ), pPacket, exceptionCharIdList );
 }
 
 void WorldServer::queueForFreeCompany( uint64_t fcId, Sapphire::Network::Packets::FFXIVPacketBasePtr pPacket, std::set< uint64_t > exceptionCharIdList )
 {
-  auto fcMgr = Common::Service< Manager::FreeCompanyMgr >::ref();
-
-  auto fc = fcMgr.getFreeCompanyById( fcId );
-  if( !fc )
-    return;
-
-  auto members = fc->getMemberIdList();
+  auto& fcMgr = Common::Service< Manager::FreeCompanyMgr >::ref();
+  queueForSessions( fcMgr.getOnlineMemberSessions( fcId ), pPacket, exceptionCharIdList );
+}
 
-  for( const auto& memberId : members )
+void WorldServer::queueForSessions( const std::vector< SessionPtr >& sessions, Sapphire::Network::Packets::FFXIVPacketBasePtr pPacket,
+                                    const std::set< uint64_t >& exceptionCharIdList )
+{
+  for( const auto& pSession : sessions )
   {
-    if( exceptionCharIdList.count( memberId ) )
+    if( exceptionCharIdList.count( pSession->getPlayer()->getCharacterId() ) )
       continue;
 
-    queueForPlayer( memberId, pPacket );
+    auto pZoneCon = pSession->getZoneConnection();
+    if( pZoneCon )
+      pZoneCon->queueOutPacket( pPacket );
   }
+}
 
+void WorldServer::onSessionChanged( uint64_t characterId )
+{
+  // group fan-out caches sessions of online members, they need to be rebuilt
+  Common::Service< Manager::LinkshellMgr >::ref().onSessionChanged( characterId );
+  Common::Service< Manager::FreeCompanyMgr >::ref().onSessionChanged( characterId );
 }
\ No newline at end of file
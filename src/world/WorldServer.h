@@ -2,6 +2,7 @@
 
 #include <Common.h>
 
+#include <atomic>
 #include <mutex>
 #include <map>
 #include <set>
@@ -39,6 +40,11 @@ namespace Sapphire::World
 
     bool isRunning() const;
 
+    /*!
+     * @brief Ends the main loop, run saves the pending inventory changes before it returns
+     */
+    void stop();
+
     void printBanner() const;
 
     bool loadSettings( int32_t argc, char* argv[] );
@@ -49,6 +55,9 @@ namespace Sapphire::World
     void queueForPlayer( uint64_t characterId, std::vector< Sapphire::Network::Packets::FFXIVPacketBasePtr > packets );
     void queueForPlayers(  const std::set< uint64_t >& characterIds, std::vector< Sapphire::Network::Packets::FFXIVPacketBasePtr > packets );
 
+    /*! for packets superseded by the next one (movement), congested clients are skipped */
+    void queueDroppableForPlayers( const std::set< uint64_t >& characterIds, Sapphire::Network::Packets::FFXIVPacketBasePtr pPacket );
+
     void queueForLinkshell( uint64_t lsId, Sapphire::Network::Packets::FFXIVPacketBasePtr pPacket, std::set< uint64_t > exceptionCharIdList = {} );
     void queueForFreeCompany( uint64_t fcId, Sapphire::Network::Packets::FFXIVPacketBasePtr pPacket, std::set< uint64_t > exceptionCharIdList = {} );
 
@@ -59,7 +68,7 @@ namespace Sapphire::World
     std::string m_ip;
     int64_t m_lastDBPingTime;
     uint64_t m_lastServerTick{ 0 };
-    bool m_bRunning;
+    std::atomic< bool > m_bRunning;
     uint16_t m_worldId;
 
     std::string m_configName;
@@ -70,6 +79,10 @@ namespace Sapphire::World
     std::map< uint32_t, SessionPtr > m_sessionMapById;
     std::map< uint64_t, SessionPtr > m_sessionMapByCharacterId;
 
+    void queueForSessions( const std::vector< SessionPtr >& sessions, Sapphire::Network::Packets::FFXIVPacketBasePtr pPacket,
+                           const std::set< uint64_t >& exceptionCharIdList );
+    void onSessionChanged( uint64_t characterId );
+
   public:
     void updateSessions( uint32_t currTime );
 